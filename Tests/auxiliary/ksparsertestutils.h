@@ -0,0 +1,62 @@
+/*  Checks shared by the KSParser tests
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "ksparser.h"
+
+#include <QtTest/QtTest>
+
+/**
+ * @short Check that the typed rows of a parser have the values of the QHash
+ * rows of another parser of the same file and sequence
+ *
+ * @param hash_parser parser read with HasNextRow() and ReadNextRow()
+ * @param typed_parser parser read with the typed ReadNextRow()
+ * @param sequence sequence of both parsers
+ */
+inline void compareTypedRows(KSParser &hash_parser, KSParser &typed_parser,
+                             const QList<QPair<QString, KSParser::DataTypes>> &sequence)
+{
+    QList<QHash<QString, QVariant>> hash_rows;
+    while (hash_parser.HasNextRow())
+    {
+        QHash<QString, QVariant> row_content = hash_parser.ReadNextRow();
+        if (row_content[sequence.first().first].toString() != KSParser::EBROKEN_QSTRING)
+            hash_rows.append(row_content);
+    }
+
+    KSParser::Row row;
+    for (const auto &row_content : hash_rows)
+    {
+        QVERIFY(typed_parser.ReadNextRow(row));
+        for (int i = 0; i < sequence.size(); ++i)
+        {
+            const QString &field = sequence[i].first;
+            QCOMPARE(typed_parser.Column(field), i);
+            switch (sequence[i].second)
+            {
+                case KSParser::D_INT:
+                    QCOMPARE(row.toInt(i), row_content[field].toInt());
+                    break;
+                case KSParser::D_FLOAT:
+                    QCOMPARE(row.toFloat(i), row_content[field].toFloat());
+                    break;
+                case KSParser::D_DOUBLE:
+                    QCOMPARE(row.toDouble(i), row_content[field].toDouble());
+                    break;
+                default:
+                    QCOMPARE(row.toString(i), row_content[field].toString());
+                    break;
+            }
+        }
+    }
+    QVERIFY(!typed_parser.ReadNextRow(row));
+}
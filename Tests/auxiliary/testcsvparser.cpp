@@ -25,6 +25,9 @@
 
 #include "testcsvparser.h"
 
+#include "ksparsertestutils.h"
+#include "kspaths.h"
+
 #include <QDir>
 #include <QTemporaryFile>
 
@@ -34,6 +37,9 @@ TestCSVParser::TestCSVParser() : QObject()
 
 void TestCSVParser::initTestCase()
 {
+    // Keep the snapshots out of the user cache
+    QStandardPaths::setTestModeEnabled(true);
+
     /*
      * Justification for doing this instead of simply creating a file:
      * To add/change tests, we'll need to modify 2 places. The file and this class.
@@ -130,6 +136,9 @@ void TestCSVParser::cleanupTestCase()
  *  4. Truncated row
  *  5. Row with no matching quote
  *  6. Attempt to read missing file
+ *  7. Typed rows
+ *  8. Rows read from a snapshot
+ *  9. Decimal conversion of the typed rows
  *
 */
 
@@ -262,6 +271,110 @@ void TestCSVParser::CSVIgnoreHasNextRow()
     }
 }
 
+void TestCSVParser::CSVTypedRows()
+{
+    /*
+     * Test 7. The typed rows have the values of the rows read as QHash
+    */
+    KSParser hash_parser(test_file_name_, '#', sequence_);
+    KSParser typed_parser(test_file_name_, '#', sequence_);
+    compareTypedRows(hash_parser, typed_parser, sequence_);
+}
+
+void TestCSVParser::CSVSnapshot()
+{
+    /*
+     * Test 8. The typed rows read back from a snapshot are the rows split from
+     * the file, until the file changes. A copy of the file is changed.
+    */
+    QFile source(test_file_name_);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QTemporaryFile copy;
+    QVERIFY(copy.open());
+    copy.write(source.readAll());
+    copy.close();
+
+    QFile::remove(KSPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+                  "snapshots/testcsvparser.snapshot");
+
+    QList<QStringList> parsed_rows;
+    KSParser::Row row;
+    KSParser parser(copy.fileName(), '#', sequence_);
+    QVERIFY(!parser.UseSnapshot("testcsvparser"));
+    while (parser.ReadNextRow(row))
+    {
+        QStringList fields;
+        for (int i = 0; i < sequence_.size(); ++i)
+            fields.append(row.toString(i));
+        parsed_rows.append(fields);
+    }
+    QVERIFY(!parsed_rows.isEmpty());
+
+    KSParser snapshot_parser(copy.fileName(), '#', sequence_);
+    QVERIFY(snapshot_parser.UseSnapshot("testcsvparser"));
+    for (const auto &fields : parsed_rows)
+    {
+        QVERIFY(snapshot_parser.ReadNextRow(row));
+        for (int i = 0; i < sequence_.size(); ++i)
+            QCOMPARE(row.toString(i), fields[i]);
+        QCOMPARE(row.toInt(5), fields[5].toInt());
+        QCOMPARE(row.toFloat(9), fields[9].toFloat());
+    }
+    QVERIFY(!snapshot_parser.ReadNextRow(row));
+
+    QVERIFY(copy.open());
+    QVERIFY(copy.seek(copy.size()));
+    copy.write("#\n");
+    copy.close();
+
+    KSParser changed_parser(copy.fileName(), '#', sequence_);
+    QVERIFY(!changed_parser.UseSnapshot("testcsvparser"));
+}
+
+void TestCSVParser::CSVParseDouble()
+{
+    /*
+     * Test 9. The typed rows convert numbers as Qt does, on the exact path
+     * and on the fallback path
+    */
+    const QList<QByteArray> numbers = {
+        // Exact path, with exponents
+        "0", "-0", "42", " 2.5 ", "-3.141", ".5", "5.", "+.5e1", "1e3", "1.5E-3", "-2.5e+10",
+        "6.02214076e23", "1e22", "1e-22", "9007199254740991",
+        // Fallback path: large exponents, long mantissas
+        "1e23", "1e-23", "1.7976931348623157e308", "4.9e-324", "1e400", "9007199254740993",
+        "12345678901234567890", "0.1234567890123456789", "3.14159265358979323846",
+        // Not numbers
+        "", "1e", "1e+", "e5", "-", "abc", "1.2.3", "12a"
+    };
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    for (const QByteArray &number : numbers)
+        file.write(number + ",\n");
+    file.close();
+
+    QList<QPair<QString, KSParser::DataTypes>> sequence;
+    sequence.append(qMakePair(QString("number"), KSParser::D_DOUBLE));
+    sequence.append(qMakePair(QString("empty"), KSParser::D_SKIP));
+
+    KSParser parser(file.fileName(), '#', sequence);
+    KSParser::Row row;
+    for (const QByteArray &number : numbers)
+    {
+        QVERIFY(parser.ReadNextRow(row));
+
+        // As the QHash rows convert it
+        bool ok         = false;
+        double expected = QString::fromLatin1(number).toDouble(&ok);
+        if (!ok)
+            expected = KSParser::EBROKEN_DOUBLE;
+        // Exactly the same double
+        QVERIFY2(row.toDouble(0) == expected, number.constData());
+    }
+    QVERIFY(!parser.ReadNextRow(row));
+}
+
 void TestCSVParser::CSVReadMissingFile()
 {
     /*
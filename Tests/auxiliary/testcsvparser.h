@@ -36,6 +36,9 @@ class TestCSVParser : public QObject
     void CSVEmptyRow();
     void CSVNoRow();
     void CSVIgnoreHasNextRow();
+    void CSVTypedRows();
+    void CSVSnapshot();
+    void CSVParseDouble();
     void CSVReadMissingFile();
 
   private:
@@ -17,6 +17,8 @@
 
 #include "testfwparser.h"
 
+#include "ksparsertestutils.h"
+
 #include <QDir>
 #include <QTemporaryFile>
 
@@ -152,10 +154,20 @@ void TestFWParser::NoRow()
     }
 }
 
+void TestFWParser::FWTypedRows()
+{
+    /*
+     * Test 4: The typed rows have the values of the rows read as QHash
+    */
+    KSParser hash_parser(test_file_name_, '#', sequence_, widths_);
+    KSParser typed_parser(test_file_name_, '#', sequence_, widths_);
+    compareTypedRows(hash_parser, typed_parser, sequence_);
+}
+
 void TestFWParser::FWReadMissingFile()
 {
     /*
-     * Test 4:
+     * Test 5:
      * This tests how the parser reacts if there is no file with the
      * given path.
     */
@@ -34,6 +34,7 @@ class TestFWParser : public QObject
     void MixedInputs();
     void OnlySpaceRow();
     void NoRow();
+    void FWTypedRows();
     void FWReadMissingFile();
 
   private:
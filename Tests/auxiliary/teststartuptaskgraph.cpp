@@ -0,0 +1,146 @@
+/*  Tests of StartupTaskGraph
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "teststartuptaskgraph.h"
+
+#include "auxiliary/startuptaskgraph.h"
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QThread>
+
+namespace
+{
+/** @short Names of the tasks in the order they finished, from any thread */
+class Journal
+{
+  public:
+    StartupTaskGraph::Task task(const QString &name, bool result = true)
+    {
+        return [this, name, result]()
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Names.append(name);
+            return result;
+        };
+    }
+
+    QStringList names() const
+    {
+        QMutexLocker locker(&m_Mutex);
+        return m_Names;
+    }
+
+  private:
+    mutable QMutex m_Mutex;
+    QStringList m_Names;
+};
+}
+
+void TestStartupTaskGraph::testDependencyOrder()
+{
+    Journal journal;
+    StartupTaskGraph tasks;
+
+    // Added in the reverse order of their dependencies, alternating the threads
+    tasks.addTask("D", journal.task("D"), QStringList() << "B" << "C", StartupTaskGraph::MainThread);
+    tasks.addTask("C", journal.task("C"), QStringList() << "A", StartupTaskGraph::Background);
+    tasks.addTask("B", journal.task("B"), QStringList() << "A", StartupTaskGraph::MainThread);
+    tasks.addTask("A", journal.task("A"), QStringList(), StartupTaskGraph::Background);
+
+    QVERIFY(tasks.run());
+    QVERIFY(tasks.failedTasks().isEmpty());
+
+    const QStringList names = journal.names();
+    QCOMPARE(names.size(), 4);
+    QCOMPARE(names.first(), QString("A"));
+    QCOMPARE(names.last(), QString("D"));
+    for (const QString &name : names)
+        QVERIFY(tasks.duration(name) >= 0);
+}
+
+void TestStartupTaskGraph::testMainThreadOrder()
+{
+    Journal journal;
+    StartupTaskGraph tasks;
+    QThread *mainThread = QThread::currentThread();
+    bool inMainThread   = true;
+
+    for (const QString &name : QStringList() << "1" << "2" << "3")
+    {
+        StartupTaskGraph::Task record = journal.task(name);
+        tasks.addTask(name, [&, record]()
+        {
+            inMainThread = inMainThread && QThread::currentThread() == mainThread;
+            return record();
+        });
+    }
+
+    QVERIFY(tasks.run());
+    QVERIFY(inMainThread);
+    QCOMPARE(journal.names(), QStringList() << "1" << "2" << "3");
+}
+
+void TestStartupTaskGraph::testBackgroundInParallel()
+{
+    StartupTaskGraph tasks;
+    QSemaphore first, second;
+
+    // Each task waits for the other one to start, which only succeeds if they run at the same time
+    tasks.addTask("First", [&]()
+    {
+        first.release();
+        return second.tryAcquire(1, 10000);
+    }, QStringList(), StartupTaskGraph::Background);
+    tasks.addTask("Second", [&]()
+    {
+        second.release();
+        return first.tryAcquire(1, 10000);
+    }, QStringList(), StartupTaskGraph::Background);
+
+    if (QThreadPool::globalInstance()->maxThreadCount() < 2)
+        QSKIP("The thread pool cannot run two tasks at once");
+
+    QVERIFY(tasks.run());
+}
+
+void TestStartupTaskGraph::testFailedDependency()
+{
+    Journal journal;
+    StartupTaskGraph tasks;
+
+    tasks.addTask("A", journal.task("A", false), QStringList(), StartupTaskGraph::Background);
+    tasks.addTask("B", journal.task("B"), QStringList() << "A");
+    tasks.addTask("C", journal.task("C"), QStringList() << "B", StartupTaskGraph::Background);
+    tasks.addTask("D", journal.task("D"));
+
+    QVERIFY(!tasks.run());
+    QCOMPARE(journal.names().toSet(), QSet<QString>() << "A" << "D");
+
+    const QStringList failed = tasks.failedTasks();
+    QCOMPARE(failed.toSet(), QSet<QString>() << "A" << "B" << "C");
+    QCOMPARE(tasks.duration("B"), qint64(-1));
+}
+
+void TestStartupTaskGraph::testMissingDependency()
+{
+    Journal journal;
+    StartupTaskGraph tasks;
+
+    tasks.addTask("A", journal.task("A"), QStringList() << "Unknown");
+    tasks.addTask("B", journal.task("B"), QStringList() << "C");
+    tasks.addTask("C", journal.task("C"), QStringList() << "B");
+
+    QVERIFY(!tasks.run());
+    QVERIFY(journal.names().isEmpty());
+    QCOMPARE(tasks.failedTasks().toSet(), QSet<QString>() << "A" << "B" << "C");
+}
+
+QTEST_GUILESS_MAIN(TestStartupTaskGraph)
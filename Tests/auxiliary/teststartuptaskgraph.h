@@ -0,0 +1,29 @@
+/*  Tests of StartupTaskGraph
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+/**
+ * @class TestStartupTaskGraph
+ * @short Check the order, the threads and the failures of the startup tasks
+ */
+class TestStartupTaskGraph : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void testDependencyOrder();
+    void testMainThreadOrder();
+    void testBackgroundInParallel();
+    void testFailedDependency();
+    void testMissingDependency();
+};
@@ -16,12 +16,22 @@
 #include "ekos/profileeditor.h"
 #endif
 #include "kstars.h"
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skymap.h"
+#include "skycomponents/catalogcomponent.h"
+#include "skycomponents/skyobjectnameindex.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skyobjects/skyobject.h"
+#include "skyobjects/starobject.h"
+#include "tools/starhopper.h"
 
 #include <KActionCollection>
 #include <KTipDialog>
 #include <KCrash/KCrash>
 
 #include <QFuture>
+#include <QTemporaryDir>
 #include <QtConcurrentRun>
 #include <QtTest/QtTest>
 
@@ -296,4 +306,184 @@ void KStarsUiTests::removeEkosProfile()
 }
 #endif
 
+void KStarsUiTests::catalogPageEviction()
+{
+    // The catalog pages are read and deleted by the sky map, so this runs in the main thread
+    while (!kstarsInstance->isGUIReady())
+    {
+        QCoreApplication::instance()->processEvents();
+        usleep(20*1000);
+    }
+
+    // Four galaxies around 12h and four around 0h, so that a narrow view holds only one group
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath("paged.cat");
+    QFile file(filename);
+
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream stream(&file);
+    stream << "# Delimiter: ,\n# Name: UiTestPaged\n# Prefix: UTP\n# Color: #ff0000\n# Epoch: 2000\n";
+    stream << "# ID  RA  Dc  Tp  Nm  Mg\n";
+    for (int i = 0; i < 8; ++i)
+        stream << QString("%1,%2:00:00,+0%3:00:00,8,Paged %1,8.0\n").arg(i + 1).arg(i < 4 ? 12 : 0).arg(i % 4);
+    file.close();
+
+    KStarsData *data = KStarsData::Instance();
+    QVERIFY(data->catalogdb()->AddCatalogContents(filename));
+    const QString name = data->catalogdb()->GetCatalogName(filename);
+
+    // Page the catalog and keep a single object in memory, in equatorial coordinates to ignore the horizon
+    const QStringList catalogNames = Options::showCatalogNames();
+    const QList<int> showCatalog   = Options::showCatalog();
+    const uint pagingThreshold     = Options::catalogPagingThreshold();
+    const uint pageCacheSize       = Options::catalogPageCacheSize();
+    const bool showDeepSky         = Options::showDeepSky();
+    const bool useAltAz            = Options::useAltAz();
+    const double zoomFactor        = Options::zoomFactor();
+
+    Options::setShowCatalogNames(QStringList(catalogNames) << name);
+    Options::setShowCatalog(QList<int>(showCatalog) << 1);
+    Options::setCatalogPagingThreshold(1);
+    Options::setCatalogPageCacheSize(1);
+    Options::setShowDeepSky(true);
+    Options::setUseAltAz(false);
+    data->skyComposite()->reloadDeepSky();
+
+    CatalogComponent *catalog = nullptr;
+    for (SkyComponent *component : data->skyComposite()->customCatalogs())
+    {
+        if (static_cast<CatalogComponent *>(component)->name() == name)
+            catalog = static_cast<CatalogComponent *>(component);
+    }
+    QVERIFY(catalog != nullptr);
+    QVERIFY(catalog->isPaged());
+
+    SkyMap *map = kstarsInstance->map();
+    auto drawAt = [map](double hours) {
+        SkyPoint center(hours, 1.5);
+        map->setFocus(&center);
+        map->setDestination(center);
+        map->forceUpdateNow();
+    };
+
+    map->setZoomFactor(2000);
+    drawAt(12);
+    SkyObject *focused = nullptr;
+    for (SkyObject *obj : catalog->objectList())
+    {
+        if (obj->ra().Hours() > 11.9 && obj->ra().Hours() < 12.1)
+            focused = obj;
+    }
+    QVERIFY(focused != nullptr);
+    const QString focusedName = focused->name();
+    map->setClickedObject(focused);
+    map->setFocusObject(focused);
+
+    // The focused object keeps its page while the view moves away
+    drawAt(0);
+    QVERIFY(catalog->objectList().contains(focused));
+    QCOMPARE(focused->name(), focusedName);
+
+    // Its page is deleted once released
+    map->setClickedObject(nullptr);
+    map->setFocusObject(nullptr);
+    drawAt(0);
+    QVERIFY(!catalog->objectList().contains(focused));
+
+    Options::setShowCatalogNames(catalogNames);
+    Options::setShowCatalog(showCatalog);
+    Options::setCatalogPagingThreshold(pagingThreshold);
+    Options::setCatalogPageCacheSize(pageCacheSize);
+    Options::setShowDeepSky(showDeepSky);
+    Options::setUseAltAz(useAltAz);
+    data->catalogdb()->RemoveCatalog(name);
+    data->skyComposite()->reloadDeepSky();
+    map->setZoomFactor(zoomFactor);
+}
+
+void KStarsUiTests::findByName_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<int>("type");
+
+    QTest::newRow("Sun") << "Sun" << int(SkyObject::PLANET);
+    QTest::newRow("Moon") << "moon" << int(SkyObject::MOON);
+    QTest::newRow("Jupiter") << "Jupiter" << int(SkyObject::PLANET);
+    QTest::newRow("Ceres") << "Ceres" << int(SkyObject::ASTEROID);
+    QTest::newRow("M 31") << "M 31" << int(SkyObject::GALAXY);
+    QTest::newRow("Sirius") << "sirius" << int(SkyObject::STAR);
+}
+
+void KStarsUiTests::findByName()
+{
+    QFETCH(QString, name);
+    QFETCH(int, type);
+
+    while (!kstarsInstance->isGUIReady())
+    {
+        QCoreApplication::instance()->processEvents();
+        usleep(20*1000);
+    }
+
+    SkyMapComposite *composite = KStarsData::Instance()->skyComposite();
+    SkyObject *obj             = composite->findByName(name);
+    QVERIFY(obj != nullptr);
+    QCOMPARE(int(obj->type()), type);
+
+    // Solar system bodies missing from the name index, like the moons of the planets, are still found
+    if (obj->type() == SkyObject::PLANET || obj->type() == SkyObject::MOON || obj->type() == SkyObject::ASTEROID)
+    {
+        composite->nameIndex()->remove(obj);
+        QCOMPARE(composite->findByName(name), obj);
+        composite->nameIndex()->insert(obj);
+    }
+}
+
+void KStarsUiTests::starHopBenchmark_data()
+{
+    QTest::addColumn<QString>("source");
+    QTest::addColumn<QString>("destination");
+    QTest::addColumn<float>("maglim");
+
+    QTest::newRow("Altair to M 27 at mag 8") << "Altair" << "M 27" << 8.0f;
+    QTest::newRow("Altair to M 27 at mag 10") << "Altair" << "M 27" << 10.0f;
+    QTest::newRow("Vega to M 13 at mag 10") << "Vega" << "M 13" << 10.0f;
+}
+
+void KStarsUiTests::starHopBenchmark()
+{
+    QFETCH(QString, source);
+    QFETCH(QString, destination);
+    QFETCH(float, maglim);
+
+    // Star hopping uses the sky components, so it runs in the main thread once they are loaded
+    while (!kstarsInstance->isGUIReady())
+    {
+        QCoreApplication::instance()->processEvents();
+        usleep(20*1000);
+    }
+
+    SkyObject *src  = KStarsData::Instance()->objectNamed(source);
+    SkyObject *dest = KStarsData::Instance()->objectNamed(destination);
+
+    QVERIFY(src != nullptr);
+    QVERIFY(dest != nullptr);
+
+    StarHopper hopper;
+    QList<StarObject *> *path = nullptr;
+    const float fov = 1.0;
+
+    QBENCHMARK
+    {
+        delete path;
+        path = hopper.computePath(*src, *dest, fov, maglim);
+    }
+    QVERIFY(path != nullptr);
+    QVERIFY(!path->isEmpty());
+    // The path stops one hop before the star within half a field of view of the destination
+    QVERIFY(path->last()->angularDistanceTo(dest).Degrees() <= 1.5 * fov);
+    delete path;
+}
+
 QTEST_MAIN(KStarsUiTests);
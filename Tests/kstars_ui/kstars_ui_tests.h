@@ -33,4 +33,9 @@ class KStarsUiTests : public QObject
     void verifyEkosProfile();
     void removeEkosProfile();
 #endif
+    void catalogPageEviction();
+    void findByName_data();
+    void findByName();
+    void starHopBenchmark_data();
+    void starHopBenchmark();
 };
@@ -0,0 +1,203 @@
+/*  Tests of VisibilityWindowSolver
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "test_visibilitywindowsolver.h"
+
+#include "auxiliary/dms.h"
+#include "geolocation.h"
+#include "ksmoon.h"
+#include "ksnumbers.h"
+#include "skycomponents/artificialhorizoncomponent.h"
+#include "time/kstarsdatetime.h"
+
+#include <cmath>
+
+namespace
+{
+/// Margin around the ends of the windows within which the sampling is not checked, in days
+const double EDGE_MARGIN = 30.0 / 86400.0;
+
+/** @return an observer at 52 degrees north */
+GeoLocation observer()
+{
+    return GeoLocation(dms(-1.5), dms(52.0));
+}
+
+/** @return the start of the searched interval */
+double startJD()
+{
+    return KStarsDateTime(QDate(2018, 6, 21), QTime(0, 0), Qt::UTC).djd();
+}
+
+/** @return Vega */
+SkyPoint vega()
+{
+    return SkyPoint(dms("18:36:56.3", false), dms("38:47:01", true));
+}
+
+/** @return target in horizontal coordinates at jd */
+SkyPoint horizontal(const SkyPoint &target, const GeoLocation &geo, double jd)
+{
+    CachingDms LST = geo.GSTtoLST(KStarsDateTime(jd).gst());
+    SkyPoint p     = target;
+    p.EquatorialToHorizontal(&LST, geo.lat());
+    return p;
+}
+}
+
+void TestVisibilityWindowSolver::compareSampling(const QVector<VisibilityWindowSolver::Window> &windows,
+                                                 double startJD, double endJD, const std::function<bool(double)> &clear,
+                                                 const std::function<bool(double)> &ambiguous)
+{
+    for (double jd = startJD; jd <= endJD; jd += 1.0 / 1440.0)
+    {
+        bool inside = false, nearEdge = false;
+        for (const VisibilityWindowSolver::Window &window : windows)
+        {
+            inside   = inside || (window.start <= jd && jd <= window.end);
+            nearEdge = nearEdge || (fabs(jd - window.start) < EDGE_MARGIN && window.start > startJD) ||
+                       (fabs(jd - window.end) < EDGE_MARGIN && window.end < endJD);
+        }
+
+        if (nearEdge || (ambiguous && ambiguous(jd)))
+            continue;
+
+        QCOMPARE(inside, clear(jd));
+    }
+}
+
+void TestVisibilityWindowSolver::testAltitudeWindows()
+{
+    const GeoLocation geo = observer();
+    const SkyPoint target = vega();
+
+    VisibilityWindowSolver solver(&geo);
+    solver.setMinAltitude(30);
+    const QVector<VisibilityWindowSolver::Window> windows = solver.windows(target, startJD(), startJD() + 2);
+
+    QVERIFY(!windows.isEmpty());
+    compareSampling(windows, startJD(), startJD() + 2,
+                    [&](double jd) { return horizontal(target, geo, jd).alt().Degrees() >= 30; });
+}
+
+void TestVisibilityWindowSolver::testWideRegion()
+{
+    // A wall from azimuth 200 to 140 through the north, over 180 degrees wide
+    ArtificialHorizonSnapshot horizon;
+    horizon.addRegion({ 200, 300, 40, 140, 140, 40, 300, 200 }, { 0, 0, 0, 0, 80, 80, 80, 80 });
+
+    QVERIFY(!horizon.isVisible(350, 40));
+    QVERIFY(!horizon.isVisible(10, 40));
+    QVERIFY(!horizon.isVisible(250, 10));
+    QVERIFY(!horizon.isVisible(100, 10));
+    QVERIFY(horizon.isVisible(170, 40));
+    QVERIFY(horizon.isVisible(10, 85));
+    QCOMPARE(horizon.resolution(), 80.0);
+
+    // Dubhe is circumpolar and passes behind the wall below the pole
+    const GeoLocation geo = observer();
+    const SkyPoint target(dms("11:03:43.7", false), dms("61:45:03", true));
+
+    VisibilityWindowSolver solver(&geo);
+    solver.setHorizon(&horizon);
+    const QVector<VisibilityWindowSolver::Window> windows = solver.windows(target, startJD(), startJD() + 2);
+
+    QVERIFY(!windows.isEmpty());
+    compareSampling(windows, startJD(), startJD() + 2,
+                    [&](double jd)
+                    {
+                        const SkyPoint p = horizontal(target, geo, jd);
+                        return horizon.isVisible(p.az().Degrees(), p.alt().Degrees());
+                    });
+}
+
+void TestVisibilityWindowSolver::testNarrowRegion()
+{
+    const GeoLocation geo = observer();
+    const SkyPoint target = vega();
+
+    // A region of 0.6 degree around the position of Vega at some time, crossed in less than the longest step
+    const double blockedJD = startJD() + 0.9;
+    const SkyPoint p       = horizontal(target, geo, blockedJD);
+    QVERIFY(p.alt().Degrees() > 10);
+
+    const double az = p.az().Degrees(), alt = p.alt().Degrees();
+    ArtificialHorizonSnapshot horizon;
+    horizon.addRegion({ az - 0.3, az + 0.3, az + 0.3, az - 0.3 }, { alt - 0.3, alt - 0.3, alt + 0.3, alt + 0.3 });
+    QVERIFY(!horizon.isVisible(az, alt));
+
+    VisibilityWindowSolver solver(&geo);
+    solver.setHorizon(&horizon);
+    const QVector<VisibilityWindowSolver::Window> windows = solver.windows(target, startJD(), startJD() + 2);
+
+    for (const VisibilityWindowSolver::Window &window : windows)
+        QVERIFY(blockedJD < window.start || blockedJD > window.end);
+
+    compareSampling(windows, startJD(), startJD() + 2,
+                    [&](double jd)
+                    {
+                        const SkyPoint q = horizontal(target, geo, jd);
+                        return q.alt().Degrees() >= 0 && horizon.isVisible(q.az().Degrees(), q.alt().Degrees());
+                    });
+}
+
+void TestVisibilityWindowSolver::testMoonDown()
+{
+    const QVector<VisibilityWindowSolver::MoonSample> track =
+        VisibilityWindowSolver::sampleMoon(startJD(), startJD() + 2);
+    if (track.isEmpty())
+        QSKIP("The lunar data files are not installed");
+
+    const GeoLocation geo = observer();
+    KSMoon moon;
+    auto moonAt = [&](double jd)
+    {
+        KSNumbers num(jd);
+        moon.findGeocentricPosition(&num, nullptr);
+        return SkyPoint(moon.ra(), moon.dec());
+    };
+
+    // A target next to the Moon, with no altitude limit
+    const SkyPoint target = moonAt(startJD() + 1);
+    const double minSeparation = 30;
+
+    VisibilityWindowSolver solver(&geo);
+    solver.setMinAltitude(-90);
+    solver.setMinMoonSeparation(minSeparation);
+    solver.setMoonTrack(&track);
+    const QVector<VisibilityWindowSolver::Window> windows = solver.windows(target, startJD(), startJD() + 2);
+
+    // The parallax moves the Moon by up to a degree from its geocentric position
+    auto ambiguous = [&](double jd)
+    {
+        const SkyPoint m = moonAt(jd);
+        return fabs(horizontal(m, geo, jd).alt().Degrees()) < 1.5 ||
+               fabs(m.angularDistanceTo(&target).Degrees() - minSeparation) < 1.5;
+    };
+    compareSampling(windows, startJD(), startJD() + 2,
+                    [&](double jd)
+                    {
+                        const SkyPoint m = moonAt(jd);
+                        return horizontal(m, geo, jd).alt().Degrees() < 0 ||
+                               m.angularDistanceTo(&target).Degrees() >= minSeparation;
+                    },
+                    ambiguous);
+
+    // The target is close to the Moon while it is down, which must not exclude it
+    bool closeWhileDown = false;
+    for (const VisibilityWindowSolver::Window &window : windows)
+    {
+        for (double jd = window.start; jd <= window.end && !closeWhileDown; jd += 1.0 / 24.0)
+            closeWhileDown = moonAt(jd).angularDistanceTo(&target).Degrees() < minSeparation;
+    }
+    QVERIFY(closeWhileDown);
+}
+
+QTEST_GUILESS_MAIN(TestVisibilityWindowSolver)
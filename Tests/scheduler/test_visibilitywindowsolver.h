@@ -0,0 +1,46 @@
+/*  Tests of VisibilityWindowSolver
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "visibilitywindowsolver.h"
+
+#include <QtTest/QtTest>
+
+#include <functional>
+
+class ArtificialHorizonSnapshot;
+class GeoLocation;
+class SkyPoint;
+
+/**
+ * @class TestVisibilityWindowSolver
+ * @short Check the visibility windows against a brute force sampling of the constraints
+ */
+class TestVisibilityWindowSolver : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void testAltitudeWindows();
+    void testWideRegion();
+    void testNarrowRegion();
+    void testMoonDown();
+
+  private:
+    /**
+     * @short Check that the windows hold the times for which clear returns true, sampled every minute
+     * Samples closer than the precision of the solver to the ends of a window, and those for which
+     * ambiguous returns true, are not checked.
+     */
+    void compareSampling(const QVector<VisibilityWindowSolver::Window> &windows, double startJD, double endJD,
+                         const std::function<bool(double)> &clear,
+                         const std::function<bool(double)> &ambiguous = std::function<bool(double)>());
+};
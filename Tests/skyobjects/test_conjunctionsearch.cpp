@@ -0,0 +1,294 @@
+/*  Tests of ConjunctionSearch
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "test_conjunctionsearch.h"
+
+#include "auxiliary/dms.h"
+#include "conjunctionsearch.h"
+#include "geolocation.h"
+#include "ksasteroid.h"
+#include "ksnumbers.h"
+#include "ksplanet.h"
+#include "kssun.h"
+#include "time/kstarsdatetime.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+/// Interval between the samples of the reference, in days
+const double SAMPLE_STEP = 1.0 / 24.0;
+
+/// Results closer than this to the maximum separation may be missed by either side, in degrees
+const double THRESHOLD_MARGIN = 0.05;
+
+/// Longest search, in milliseconds
+const int TIMEOUT = 120000;
+
+/** @return an observer at 52 degrees north */
+GeoLocation observer()
+{
+    return GeoLocation(dms(-1.5), dms(52.0));
+}
+
+/** @return the Earth, whose series the planets need */
+KSPlanet *newEarth()
+{
+    return new KSPlanet("Earth", QString(), QColor("white"), 12756.28);
+}
+
+/** @return the topocentric separation of object and target at jd, like the refinement of the search */
+double separationAt(double jd, SkyObject *object, KSPlanetBase *target, KSPlanetBase *earth, const GeoLocation &geo,
+                    bool opposition)
+{
+    KSNumbers num(jd);
+    earth->findGeocentricCoords(&num, nullptr);
+    CachingDms LST(geo.GSTtoLST(KStarsDateTime(static_cast<long double>(jd)).gst()));
+
+    KSPlanetBase *planet = dynamic_cast<KSPlanetBase *>(object);
+    if (planet)
+        planet->findPosition(&num, geo.lat(), &LST, earth);
+    else
+        object->updateCoordsNow(&num);
+    target->findPosition(&num, geo.lat(), &LST, earth);
+
+    const double distance = object->angularDistanceTo(target).Degrees();
+    return opposition ? 180.0 - distance : distance;
+}
+
+/** @return the first night of the conjunction tests */
+double marsStart()
+{
+    return double(KStarsDateTime(QDate(2020, 1, 1), QTime(0, 0), Qt::UTC).djd());
+}
+
+/** @return the end of the conjunction tests */
+double marsStop()
+{
+    return marsStart() + 40;
+}
+
+/**
+ * @short Stars near the path of Mars during the conjunction tests
+ * Each star is offset in declination from the position of Mars at one date, the last one
+ * beyond the maximum separation of the tests.
+ */
+std::vector<std::unique_ptr<SkyObject>> marsStars()
+{
+    const double days[]    = { 8, 16, 24, 32 };
+    const double offsets[] = { 0.0, 0.4, -0.7, 3.0 };
+
+    std::unique_ptr<KSPlanet> earth(newEarth());
+    KSPlanet mars(KSPlanetBase::MARS);
+
+    std::vector<std::unique_ptr<SkyObject>> stars;
+    for (int i = 0; i < 4; ++i)
+    {
+        KSNumbers num(marsStart() + days[i]);
+        earth->findGeocentricCoords(&num, nullptr);
+        mars.findGeocentricCoords(&num, earth.get());
+
+        // Back to the catalog coordinates the search precesses again
+        SkyPoint apparent(mars.ra(), mars.dec());
+        const SkyPoint catalog = apparent.deprecess(&num);
+        stars.emplace_back(new SkyObject(SkyObject::STAR, catalog.ra(), dms(catalog.dec().Degrees() + offsets[i]),
+                                         5.0, QString("Star %1").arg(i)));
+    }
+    return stars;
+}
+
+QList<SkyObject *> pointers(const std::vector<std::unique_ptr<SkyObject>> &objects)
+{
+    QList<SkyObject *> result;
+    for (const auto &object : objects)
+        result.append(object.get());
+    return result;
+}
+}
+
+void TestConjunctionSearch::initTestCase()
+{
+    std::unique_ptr<KSPlanet> earth(newEarth());
+    KSPlanet mars(KSPlanetBase::MARS);
+    if (!earth->loadData() || !mars.loadData())
+        QSKIP("The planetary data files are not installed");
+}
+
+QVector<TestConjunctionSearch::Conjunction> TestConjunctionSearch::search(const QList<SkyObject *> &objects,
+                                                                          const KSPlanetBase &target, double startJD,
+                                                                          double stopJD, double maxSeparation,
+                                                                          bool opposition)
+{
+    QVector<Conjunction> conjunctions;
+    ConjunctionSearch search;
+    connect(&search, &ConjunctionSearch::conjunctionFound,
+            [&](const QString &object1, const QString &, long double jd, const dms &separation)
+            { conjunctions.append(Conjunction { object1, double(jd), separation.Degrees() }); });
+
+    const GeoLocation geo = observer();
+    QSignalSpy finished(&search, &ConjunctionSearch::finished);
+    search.start(objects, target, &geo, startJD, stopJD, dms(maxSeparation), opposition);
+    if (!finished.wait(TIMEOUT))
+        QTest::qFail("The search did not finish", __FILE__, __LINE__);
+    return conjunctions;
+}
+
+void TestConjunctionSearch::compareWithSampling(const QVector<Conjunction> &conjunctions,
+                                                const QList<SkyObject *> &objects, const KSPlanetBase &target,
+                                                double startJD, double stopJD, double maxSeparation, bool opposition)
+{
+    const GeoLocation geo = observer();
+    std::unique_ptr<KSPlanet> earth(newEarth());
+    std::unique_ptr<KSPlanetBase> body(dynamic_cast<KSPlanetBase *>(target.clone()));
+
+    for (SkyObject *object : objects)
+    {
+        std::unique_ptr<SkyObject> copy(object->clone());
+        QVector<double> jds, separations;
+        for (double jd = startJD; jd <= stopJD; jd += SAMPLE_STEP)
+        {
+            jds.append(jd);
+            separations.append(separationAt(jd, copy.get(), body.get(), earth.get(), geo, opposition));
+        }
+
+        auto isMinimum = [&](int j)
+        { return separations.at(j) < separations.at(j - 1) && separations.at(j) <= separations.at(j + 1); };
+
+        QVector<Conjunction> found;
+        for (const Conjunction &conjunction : conjunctions)
+        {
+            if (conjunction.name == object->name())
+                found.append(conjunction);
+        }
+
+        // Every sampled minimum is found, at least as close
+        for (int j = 1; j + 1 < jds.size(); ++j)
+        {
+            if (!isMinimum(j) || separations.at(j) >= maxSeparation - THRESHOLD_MARGIN)
+                continue;
+
+            bool matched = false;
+            for (const Conjunction &conjunction : found)
+                matched = matched || (fabs(conjunction.jd - jds.at(j)) <= SAMPLE_STEP &&
+                                      conjunction.separation <= separations.at(j) + 1e-6);
+            QVERIFY2(matched, qPrintable(QString("%1 missed at JD %2").arg(object->name()).arg(jds.at(j), 0, 'f', 3)));
+        }
+
+        // Every result is a sampled minimum
+        for (const Conjunction &conjunction : found)
+        {
+            QVERIFY(conjunction.separation < maxSeparation);
+            if (conjunction.separation >= maxSeparation - THRESHOLD_MARGIN)
+                continue;
+
+            bool matched = false;
+            for (int j = 1; j + 1 < jds.size(); ++j)
+                matched = matched || (isMinimum(j) && fabs(conjunction.jd - jds.at(j)) <= SAMPLE_STEP);
+            QVERIFY2(matched, qPrintable(QString("%1 at JD %2 is no minimum")
+                                             .arg(object->name())
+                                             .arg(conjunction.jd, 0, 'f', 3)));
+        }
+    }
+}
+
+void TestConjunctionSearch::testCoarsePass()
+{
+    const std::vector<std::unique_ptr<SkyObject>> stars = marsStars();
+    const QList<SkyObject *> objects = pointers(stars);
+    const KSPlanet mars(KSPlanetBase::MARS);
+    const double maxSeparation = 1.0;
+
+    const QVector<Conjunction> conjunctions = search(objects, mars, marsStart(), marsStop(), maxSeparation, false);
+    QCOMPARE(conjunctions.size(), 3);
+    compareWithSampling(conjunctions, objects, mars, marsStart(), marsStop(), maxSeparation, false);
+}
+
+void TestConjunctionSearch::testRefinePass()
+{
+    const std::vector<std::unique_ptr<SkyObject>> stars = marsStars();
+    const QList<SkyObject *> objects = pointers(stars);
+    const KSPlanet mars(KSPlanetBase::MARS);
+
+    const QVector<Conjunction> conjunctions = search(objects, mars, marsStart(), marsStop(), 1.0, false);
+    QVERIFY(!conjunctions.isEmpty());
+
+    const GeoLocation geo = observer();
+    std::unique_ptr<KSPlanet> earth(newEarth());
+    std::unique_ptr<KSPlanet> target(mars.clone());
+    for (const Conjunction &conjunction : conjunctions)
+    {
+        SkyObject *star = nullptr;
+        for (const auto &s : stars)
+        {
+            if (s->name() == conjunction.name)
+                star = s.get();
+        }
+        QVERIFY(star != nullptr);
+        std::unique_ptr<SkyObject> copy(star->clone());
+
+        // The separation reported is the topocentric one, at a minimum within a few minutes
+        const double separation = separationAt(conjunction.jd, copy.get(), target.get(), earth.get(), geo, false);
+        QVERIFY(fabs(separation - conjunction.separation) < 1e-5);
+        for (double minutes : { -10.0, 10.0 })
+        {
+            const double jd = conjunction.jd + minutes / 1440.0;
+            QVERIFY(separationAt(jd, copy.get(), target.get(), earth.get(), geo, false) > conjunction.separation);
+        }
+    }
+}
+
+void TestConjunctionSearch::testDeletedObjects()
+{
+    // Ceres, at opposition in August 2020
+    auto ceres = [] { return new KSAsteroid(1, "Ceres", QString(), 2458600.5, 2.7691652, 0.0760090, dms(10.59407),
+                                            dms(73.59764), dms(80.30553), dms(77.37209), 3.34, 0.12); };
+    const double startJD = double(KStarsDateTime(QDate(2020, 7, 1), QTime(0, 0), Qt::UTC).djd());
+    const double stopJD  = startJD + 120;
+    const double maxSeparation = 20.0;
+    const KSSun sun;
+
+    QVector<Conjunction> conjunctions;
+    ConjunctionSearch search;
+    connect(&search, &ConjunctionSearch::conjunctionFound,
+            [&](const QString &object1, const QString &, long double jd, const dms &separation)
+            { conjunctions.append(Conjunction { object1, double(jd), separation.Degrees() }); });
+
+    // The objects are copied by start(), the asteroid lists may be reloaded during the search
+    const GeoLocation geo = observer();
+    QSignalSpy finished(&search, &ConjunctionSearch::finished);
+    std::unique_ptr<KSAsteroid> deleted(ceres());
+    search.start(QList<SkyObject *>() << deleted.get(), sun, &geo, startJD, stopJD, dms(maxSeparation), true);
+    deleted.reset();
+    QVERIFY(finished.wait(TIMEOUT));
+
+    QCOMPARE(conjunctions.size(), 1);
+    QCOMPARE(conjunctions.first().name, QString("Ceres"));
+
+    // The refinement reduces the orbit like the sky map, Ceres itself differs very little
+    std::unique_ptr<KSAsteroid> reference(ceres());
+    std::unique_ptr<KSPlanet> earth(newEarth());
+    std::unique_ptr<KSSun> target(sun.clone());
+    double closest = 180, closestJD = 0;
+    for (double jd = startJD; jd <= stopJD; jd += SAMPLE_STEP)
+    {
+        const double separation = separationAt(jd, reference.get(), target.get(), earth.get(), geo, true);
+        if (separation < closest)
+        {
+            closest   = separation;
+            closestJD = jd;
+        }
+    }
+    QVERIFY(fabs(conjunctions.first().separation - closest) < 0.01);
+    QVERIFY(fabs(conjunctions.first().jd - closestJD) < 1.0);
+}
+
+QTEST_GUILESS_MAIN(TestConjunctionSearch)
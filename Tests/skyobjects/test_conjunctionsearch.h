@@ -0,0 +1,53 @@
+/*  Tests of ConjunctionSearch
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class KSPlanetBase;
+class SkyObject;
+
+/**
+ * @class TestConjunctionSearch
+ * @short Check the conjunctions and oppositions found against an hourly sampling of the separations
+ */
+class TestConjunctionSearch : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void testCoarsePass();
+    void testRefinePass();
+    void testDeletedObjects();
+
+  private:
+    /** @short A result of the search */
+    struct Conjunction
+    {
+        QString name;
+        double jd { 0 };
+        double separation { 0 };
+    };
+
+    /** @short Run a search to its end and return its results */
+    QVector<Conjunction> search(const QList<SkyObject *> &objects, const KSPlanetBase &target, double startJD,
+                                double stopJD, double maxSeparation, bool opposition);
+
+    /**
+     * @short Compare the results with the minima of the separations sampled every hour
+     * Every sampled minimum below the maximum separation must be found within an hour, and
+     * every result must be such a minimum, except near the maximum separation.
+     */
+    void compareWithSampling(const QVector<Conjunction> &conjunctions, const QList<SkyObject *> &objects,
+                             const KSPlanetBase &target, double startJD, double stopJD, double maxSeparation,
+                             bool opposition);
+};
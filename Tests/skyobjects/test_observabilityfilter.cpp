@@ -0,0 +1,137 @@
+/*  Tests of ObservabilityFilter
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "test_observabilityfilter.h"
+
+#include "auxiliary/dms.h"
+#include "geolocation.h"
+#include "observabilityfilter.h"
+#include "skyobject.h"
+#include "time/kstarsdatetime.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+/// Largest altitude change in a minute, in degrees
+const double MINUTE_TOLERANCE = 0.5;
+
+/**
+ * @short Sample the altitude of point every step seconds from start, until before end, as the
+ * wizard did before
+ * @return true if the altitude is in [minAlt, maxAlt] at one of the samples
+ */
+bool sampled(const SkyPoint &point, const GeoLocation &geo, const KStarsDateTime &start, const KStarsDateTime &end,
+             double step, double minAlt, double maxAlt)
+{
+    SkyPoint p = point;
+    for (KStarsDateTime t = start; t < end; t = t.addSecs(step))
+    {
+        dms LST = geo.GSTtoLST(t.gst());
+        p.EquatorialToHorizontal(&LST, geo.lat());
+
+        if (p.alt().Degrees() >= minAlt && p.alt().Degrees() <= maxAlt)
+            return true;
+    }
+    return false;
+}
+
+/** @return the evening of the tests, from 18:00 to midnight */
+KStarsDateTime evening()
+{
+    return KStarsDateTime(QDate(2018, 6, 21), QTime(18, 0), Qt::UTC);
+}
+
+/** @return the end of the evening of the tests */
+KStarsDateTime midnight()
+{
+    return KStarsDateTime(QDate(2018, 6, 22), QTime(0, 0), Qt::UTC);
+}
+}
+
+void TestObservabilityFilter::compareWithSampling(const GeoLocation &geo, const KStarsDateTime &start,
+                                                  const KStarsDateTime &end, double minAlt, double maxAlt)
+{
+    std::vector<std::unique_ptr<SkyObject>> stars;
+    QVector<SkyObject *> objects;
+    for (int ra = 0; ra < 360; ra += 5)
+    {
+        for (int dec = -85; dec <= 85; dec += 5)
+        {
+            stars.emplace_back(new SkyObject(SkyObject::STAR, dms(double(ra)), dms(double(dec)), 5.0, "star"));
+            objects.append(stars.back().get());
+        }
+    }
+
+    ObservabilityFilter filter(&geo, start, end);
+    filter.setAltitudeRange(minAlt, maxAlt);
+    const QBitArray mask = filter.apply(objects);
+    QCOMPARE(mask.size(), objects.size());
+
+    int observable = 0;
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        const SkyObject &star = *objects.at(i);
+        QCOMPARE(mask.testBit(i), filter.isObservable(&star));
+        if (mask.testBit(i))
+            ++observable;
+
+        if (sampled(star, geo, start, end, 3600, minAlt, maxAlt))
+        {
+            QVERIFY2(mask.testBit(i), qPrintable(star.ra().toHMSString() + ' ' + star.dec().toDMSString()));
+        }
+        else if (mask.testBit(i))
+        {
+            // Found between two hourly samples
+            QVERIFY2(sampled(star, geo, start, end.addSecs(60), 60, minAlt - MINUTE_TOLERANCE,
+                             maxAlt + MINUTE_TOLERANCE),
+                     qPrintable(star.ra().toHMSString() + ' ' + star.dec().toDMSString()));
+        }
+    }
+
+    // Neither all nor none of the stars
+    QVERIFY(observable > 0);
+    QVERIFY(observable < objects.size());
+}
+
+void TestObservabilityFilter::testNorthernEvening()
+{
+    compareWithSampling(GeoLocation(dms(-1.5), dms(52.0)), evening(), midnight(), 15.0, 90.0);
+}
+
+void TestObservabilityFilter::testSouthernEvening()
+{
+    compareWithSampling(GeoLocation(dms(18.4), dms(-33.9)), evening(), midnight(), 15.0, 90.0);
+}
+
+void TestObservabilityFilter::testAltitudeBand()
+{
+    // The stars culminating above the band are only in it for part of the interval
+    compareWithSampling(GeoLocation(dms(-1.5), dms(52.0)), evening(), midnight(), 30.0, 60.0);
+}
+
+void TestObservabilityFilter::testWholeDay()
+{
+    const GeoLocation geo(dms(-1.5), dms(52.0));
+    const KStarsDateTime start = evening();
+    const KStarsDateTime end   = start.addSecs(25 * 3600.0);
+    compareWithSampling(geo, start, end, 15.0, 90.0);
+
+    // Over a whole day, only the declination matters
+    ObservabilityFilter filter(&geo, start, end);
+    filter.setAltitudeRange(15.0, 90.0);
+    const SkyObject rising(SkyObject::STAR, dms(90.0), dms(-20.0), 5.0, "star");
+    const SkyObject hidden(SkyObject::STAR, dms(90.0), dms(-30.0), 5.0, "star");
+    QVERIFY(filter.isObservable(&rising));
+    QVERIFY(!filter.isObservable(&hidden));
+}
+
+QTEST_GUILESS_MAIN(TestObservabilityFilter)
@@ -0,0 +1,40 @@
+/*  Tests of ObservabilityFilter
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class GeoLocation;
+class KStarsDateTime;
+
+/**
+ * @class TestObservabilityFilter
+ * @short Check the observability masks against the hourly sampling the wizard used before
+ */
+class TestObservabilityFilter : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void testNorthernEvening();
+    void testSouthernEvening();
+    void testAltitudeBand();
+    void testWholeDay();
+
+  private:
+    /**
+     * @short Compare the mask of a grid of stars with the altitudes sampled every hour
+     * Every star found by the sampling must pass, and the stars found between two samples
+     * must be in the range at some minute of the interval.
+     */
+    void compareWithSampling(const GeoLocation &geo, const KStarsDateTime &start, const KStarsDateTime &end,
+                             double minAlt, double maxAlt);
+};
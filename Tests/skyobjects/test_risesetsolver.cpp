@@ -0,0 +1,224 @@
+/*  Tests of RiseSetSolver
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "test_risesetsolver.h"
+
+#include "auxiliary/dms.h"
+#include "geolocation.h"
+#include "ksmoon.h"
+#include "ksnumbers.h"
+#include "ksplanet.h"
+#include "kssun.h"
+#include "ksutils.h"
+#include "risesetsolver.h"
+#include "time/kstarsdatetime.h"
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+/// Agreement expected between the solver and SkyObject, in seconds
+const double TOLERANCE = 60.0;
+
+/** @return the difference in seconds between the time of day of jd and time, within half a day */
+double secondsApart(double jd, const QTime &time)
+{
+    const double seconds    = (jd + 0.5 - floor(jd + 0.5)) * 86400.0;
+    const double difference = seconds - QTime(0, 0).msecsTo(time) / 1000.0;
+    return difference - 86400.0 * std::round(difference / 86400.0);
+}
+
+/** @return an observer at 52 degrees north, where the test stars are circumpolar or never rise */
+GeoLocation observer()
+{
+    return GeoLocation(dms(-1.5), dms(52.0));
+}
+
+/** @return the date of the tests */
+KStarsDateTime testDate()
+{
+    return KStarsDateTime(QDate(2018, 6, 21), QTime(12, 0), Qt::UTC);
+}
+
+/** @return the altitude at jd of a position in degrees, in degrees */
+double altitude(const GeoLocation &geo, double jd, double ra, double dec)
+{
+    const double hourAngle = KStarsDateTime(jd).gst().Degrees() + geo.lng()->Degrees() - ra;
+    const double sinAlt    = sin(geo.lat()->radians()) * sin(dec * dms::DegToRad) +
+                          cos(geo.lat()->radians()) * cos(dec * dms::DegToRad) * cos(hourAngle * dms::DegToRad);
+    return asin(sinAlt) / dms::DegToRad;
+}
+
+/** @return true if the series of the Earth and body are installed */
+bool hasSeries(KSPlanetBase *body)
+{
+    KSPlanet earth("Earth", QString(), QColor("white"), 12756.28);
+    return earth.loadData() && body->loadData();
+}
+}
+
+void TestRiseSetSolver::compareEvents(const SkyObject &object, const GeoLocation &geo, const KStarsDateTime &dt)
+{
+    const SkyPoint p = object.recomputeCoords(dt, &geo);
+
+    RiseSetSolver solver(&geo);
+    QCOMPARE(solver.add(p.ra().Degrees(), p.dec().Degrees(), object.elevationCorrection().Degrees()), 0);
+
+    QVector<RiseSetSolver::Events> events;
+    solver.solve(double(dt.djd()), events);
+    QCOMPARE(events.size(), 1);
+
+    const RiseSetSolver::Events &e = events.first();
+    QVERIFY(!std::isnan(e.rise));
+    QVERIFY(!std::isnan(e.set));
+    QVERIFY(e.rise < e.transit && e.transit < e.set);
+    QVERIFY(!e.circumpolar && !e.neverRises);
+
+    // SkyObject counts the hour angle in solar hours, so ask for the times around the transit
+    const KStarsDateTime transit(static_cast<long double>(e.transit));
+    QVERIFY(fabs(secondsApart(e.transit, object.transitTimeUT(transit, &geo))) < TOLERANCE);
+    QVERIFY(fabs(secondsApart(e.rise, object.riseSetTimeUT(transit, &geo, true))) < TOLERANCE);
+    QVERIFY(fabs(secondsApart(e.set, object.riseSetTimeUT(transit, &geo, false))) < TOLERANCE);
+    QVERIFY(fabs(e.transitAltitude - object.transitAltitude(transit, &geo).Degrees()) < 1e-3);
+}
+
+void TestRiseSetSolver::testRisingStar()
+{
+    // Sirius
+    const SkyObject star(SkyObject::STAR, dms("06:45:08.9", false), dms("-16:42:58", true), -1.46, "Sirius");
+    compareEvents(star, observer(), testDate());
+}
+
+void TestRiseSetSolver::testCircumpolarStar()
+{
+    // Dubhe
+    const SkyObject star(SkyObject::STAR, dms("11:03:43.7", false), dms("61:45:03", true), 1.79, "Dubhe");
+    const GeoLocation geo = observer();
+    const KStarsDateTime dt = testDate();
+
+    RiseSetSolver solver(&geo);
+    const SkyPoint p = star.recomputeCoords(dt, &geo);
+    solver.add(p.ra().Degrees(), p.dec().Degrees(), star.elevationCorrection().Degrees());
+
+    QVector<RiseSetSolver::Events> events;
+    solver.solve(double(dt.djd()), events);
+
+    const RiseSetSolver::Events &e = events.first();
+    QVERIFY(e.circumpolar);
+    QVERIFY(!e.neverRises);
+    QVERIFY(std::isnan(e.rise) && std::isnan(e.set));
+    QVERIFY(!star.riseSetTime(dt, &geo, true).isValid());
+    QVERIFY(!star.riseSetTime(dt, &geo, false).isValid());
+
+    const KStarsDateTime transit(static_cast<long double>(e.transit));
+    QVERIFY(fabs(secondsApart(e.transit, star.transitTimeUT(transit, &geo))) < TOLERANCE);
+    QVERIFY(fabs(e.transitAltitude - star.transitAltitude(transit, &geo).Degrees()) < 1e-3);
+}
+
+void TestRiseSetSolver::testNeverRisingStar()
+{
+    // Canopus
+    const SkyObject star(SkyObject::STAR, dms("06:23:57.1", false), dms("-52:41:44", true), -0.74, "Canopus");
+    const GeoLocation geo = observer();
+    const KStarsDateTime dt = testDate();
+
+    RiseSetSolver solver(&geo);
+    solver.add(&star);
+
+    QVector<RiseSetSolver::Events> events;
+    solver.solve(double(dt.djd()), events);
+
+    const RiseSetSolver::Events &e = events.first();
+    QVERIFY(e.neverRises);
+    QVERIFY(!e.circumpolar);
+    QVERIFY(std::isnan(e.rise) && std::isnan(e.set));
+    QVERIFY(e.transitAltitude < 0);
+    QVERIFY(!star.riseSetTime(dt, &geo, true).isValid());
+    QVERIFY(!star.riseSetTime(dt, &geo, false).isValid());
+}
+
+void TestRiseSetSolver::checkMotion(KSPlanetBase *body, RiseSetSolver::Events &events, RiseSetSolver::Events &fixed)
+{
+    std::unique_ptr<KSPlanet> earth(new KSPlanet("Earth", QString(), QColor("white"), 12756.28));
+    // Geocentric positions from the series, as the clones need KStarsData to move
+    RiseSetSolver::Motion motion = [&](double jd, double &ra, double &dec)
+    {
+        KSNumbers num(jd);
+        earth->findGeocentricCoords(&num, nullptr);
+        body->findGeocentricCoords(&num, earth.get());
+        ra  = body->ra().Degrees();
+        dec = body->dec().Degrees();
+    };
+
+    const GeoLocation geo = observer();
+    const double jd       = double(testDate().djd());
+    const double horizon  = body->elevationCorrection().Degrees();
+    RiseSetSolver solver(&geo);
+
+    events = solver.solve(motion, horizon, jd);
+    QVERIFY(!std::isnan(events.rise));
+    QVERIFY(!std::isnan(events.set));
+    QVERIFY(events.rise < events.transit && events.transit < events.set);
+    QVERIFY(fabs(events.transit - jd) <= 0.5);
+
+    // One second of the iterations is about a hundredth of a degree
+    double ra, dec;
+    motion(events.transit, ra, dec);
+    const double hourAngle = KStarsDateTime(events.transit).gst().Degrees() + geo.lng()->Degrees() - ra;
+    QVERIFY(fabs(KSUtils::reduceAngle(hourAngle, -180.0, 180.0)) < 0.01);
+    QVERIFY(fabs(events.transitAltitude - altitude(geo, events.transit, ra, dec)) < 0.01);
+
+    motion(events.rise, ra, dec);
+    QVERIFY(fabs(altitude(geo, events.rise, ra, dec) - horizon) < 0.01);
+    motion(events.set, ra, dec);
+    QVERIFY(fabs(altitude(geo, events.set, ra, dec) - horizon) < 0.01);
+
+    motion(jd, ra, dec);
+    QCOMPARE(solver.add(ra, dec, horizon), 0);
+    QVector<RiseSetSolver::Events> solved;
+    solver.solve(jd, solved);
+    fixed = solved.first();
+}
+
+void TestRiseSetSolver::testSun()
+{
+    KSSun sun;
+    QCOMPARE(sun.elevationCorrection().Degrees(), -0.8333);
+    if (!hasSeries(&sun))
+        QSKIP("The planetary data files are not installed");
+
+    RiseSetSolver::Events events, fixed;
+    checkMotion(&sun, events, fixed);
+    if (QTest::currentTestFailed())
+        return;
+
+    // The Sun moves about a degree a day, the position of noon is within minutes
+    QVERIFY(fabs(events.rise - fixed.rise) * 86400.0 < 300);
+    QVERIFY(fabs(events.set - fixed.set) * 86400.0 < 300);
+}
+
+void TestRiseSetSolver::testMoon()
+{
+    KSMoon moon;
+    QCOMPARE(moon.elevationCorrection().Degrees(), -0.8333);
+    if (!hasSeries(&moon))
+        QSKIP("The lunar data files are not installed");
+
+    RiseSetSolver::Events events, fixed;
+    checkMotion(&moon, events, fixed);
+    if (QTest::currentTestFailed())
+        return;
+
+    // The Moon moves its own diameter in an hour, a fixed position is off by much more than a minute
+    QVERIFY(fabs(events.rise - fixed.rise) * 86400.0 > 600 || fabs(events.set - fixed.set) * 86400.0 > 600);
+}
+
+QTEST_GUILESS_MAIN(TestRiseSetSolver)
@@ -0,0 +1,48 @@
+/*  Tests of RiseSetSolver
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "risesetsolver.h"
+
+#include <QtTest/QtTest>
+
+class GeoLocation;
+class KSPlanetBase;
+class KStarsDateTime;
+class SkyObject;
+
+/**
+ * @class TestRiseSetSolver
+ * @short Check the batch rise, transit and set times against those of SkyObject, and the
+ * iterated ones of the Sun and the Moon against their motion
+ */
+class TestRiseSetSolver : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void testRisingStar();
+    void testCircumpolarStar();
+    void testNeverRisingStar();
+    void testSun();
+    void testMoon();
+
+  private:
+    /** @short Compare the events solved around dt with riseSetTimeUT() and transitTimeUT() */
+    void compareEvents(const SkyObject &object, const GeoLocation &geo, const KStarsDateTime &dt);
+
+    /**
+     * @short Check the events of a moving body iterated around the test date against its positions
+     * The body is at its horizon at the rise and the set, and on the meridian at the transit.
+     * @param fixed the events of the body fixed at its position of the test date
+     */
+    void checkMotion(KSPlanetBase *body, RiseSetSolver::Events &events, RiseSetSolver::Events &fixed);
+};
@@ -21,16 +21,50 @@
 #include "catalogentrydata.h"
 #include "kstars/version.h"
 #include "../kstars/auxiliary/kspaths.h"
+#include "../kstars/htmesh/HTMesh.h"
+#include "../kstars/htmesh/MeshIterator.h"
 #include "starobject.h"
 #include "deepskyobject.h"
 #include "skycomponent.h"
 
+#include <QElapsedTimer>
 #include <QSqlTableModel>
 #include <QSqlRecord>
-#include <QSqlQuery>
 
 #include <catalog_debug.h>
 
+namespace
+{
+/// Position tolerance of the fuzzy cross-match, in degrees
+const double FUZZ_POSITION = 0.0016;
+
+/// Magnitude tolerance of the fuzzy cross-match
+const double FUZZ_MAGNITUDE = 0.1;
+
+/// Largest change of a declination from B1950 to J2000, in degrees, with some margin
+const double PRECESSION_MARGIN = 0.3;
+
+/// Columns read by CatalogDB::CreateObject(), in this order
+const char *OBJECT_COLUMNS = "Epoch, Type, RA, Dec, Magnitude, Prefix, "
+                             "IDNumber, LongName, MajorAxis, MinorAxis, "
+                             "PositionAngle, Flux";
+
+/// Precesses ra and dec, in degrees, from a B1950 catalog to J2000
+void toJ2000(double &ra, double &dec, float epoch)
+{
+    if (epoch != 1950)
+        return;
+
+    SkyPoint t;
+    t.set(dms(ra), dms(dec));
+    t.B1950ToJ2000();
+    ra  = t.ra().Degrees();
+    dec = t.dec().Degrees();
+}
+}
+
+const int CatalogDB::TRIXEL_LEVEL = 3;
+
 bool CatalogDB::Initialize()
 {
     skydb_         = QSqlDatabase::addDatabase("QSQLITE", "skydb");
@@ -58,6 +92,7 @@ bool CatalogDB::Initialize()
         {
             FirstRun();
         }
+        UpgradeSchema();
     }
     skydb_.close();
     return true;
@@ -106,7 +141,8 @@ void CatalogDB::FirstRun()
                   "Add1 VARCHAR DEFAULT NULL,"
                   "Add2 INTEGER DEFAULT NULL,"
                   "Add3 INTEGER DEFAULT NULL,"
-                  "Add4 INTEGER DEFAULT NULL)");
+                  "Add4 INTEGER DEFAULT NULL,"
+                  "Trixel INTEGER DEFAULT NULL)");
 
     for (int i = 0; i < tables.count(); ++i)
     {
@@ -119,6 +155,71 @@ void CatalogDB::FirstRun()
     return;
 }
 
+void CatalogDB::UpgradeSchema()
+{
+    QSqlQuery columns(skydb_);
+    bool has_trixel = false;
+    if (columns.exec("PRAGMA table_info(DSO)"))
+    {
+        while (columns.next() && !has_trixel)
+            has_trixel = (columns.value(1).toString() == "Trixel");
+    }
+    columns.clear();
+
+    skydb_.transaction();
+
+    if (!has_trixel)
+    {
+        qCInfo(KSTARS_CATALOG) << "Indexing the DSO table by trixel";
+
+        QSqlQuery add_column(skydb_);
+        if (!add_column.exec("ALTER TABLE DSO ADD COLUMN Trixel INTEGER DEFAULT NULL"))
+            qCWarning(KSTARS_CATALOG) << add_column.lastError();
+
+        // Rows left without designation by RemoveCatalog() are assumed J2000, they are still cross-matched
+        QVector<QPair<int, Trixel>> trixels;
+        QSqlQuery rows(skydb_);
+        rows.setForwardOnly(true);
+        if (rows.exec("SELECT DSO.UID, DSO.RA, DSO.Dec, MIN(IFNULL(Catalog.Epoch, 2000.0)) FROM DSO "
+                      "LEFT JOIN ObjectDesignation ON ObjectDesignation.UID_DSO = DSO.UID "
+                      "LEFT JOIN Catalog ON Catalog.id = ObjectDesignation.id_Catalog GROUP BY DSO.UID"))
+        {
+            while (rows.next())
+                trixels.append(qMakePair(rows.value(0).toInt(), TrixelOf(rows.value(1).toDouble(),
+                                                                         rows.value(2).toDouble(),
+                                                                         rows.value(3).toFloat())));
+        }
+        else
+        {
+            qCWarning(KSTARS_CATALOG) << rows.lastError();
+        }
+        rows.clear();
+
+        QSqlQuery set_trixel(skydb_);
+        set_trixel.prepare("UPDATE DSO SET Trixel = :trixel WHERE UID = :uid");
+        for (const auto &row : trixels)
+        {
+            set_trixel.bindValue(":trixel", row.second);
+            set_trixel.bindValue(":uid", row.first);
+            if (!set_trixel.exec())
+                qCWarning(KSTARS_CATALOG) << set_trixel.lastError();
+        }
+    }
+
+    QStringList indexes;
+    indexes.append("CREATE INDEX IF NOT EXISTS DSO_Trixel ON DSO (Trixel, Dec)");
+    indexes.append("CREATE INDEX IF NOT EXISTS ObjectDesignation_Catalog ON ObjectDesignation (id_Catalog)");
+    indexes.append("CREATE INDEX IF NOT EXISTS ObjectDesignation_DSO ON ObjectDesignation (UID_DSO)");
+    for (const QString &index : indexes)
+    {
+        QSqlQuery query(skydb_);
+        if (!query.exec(index))
+            qCWarning(KSTARS_CATALOG) << query.lastError();
+    }
+
+    skydb_.commit();
+}
+
 CatalogDB::~CatalogDB()
 {
     skydb_.close();
@@ -253,55 +354,123 @@ void CatalogDB::ClearDSOEntries(int catalog_id)
     skydb_.close();
 }
 
-int CatalogDB::FindFuzzyEntry(const double ra, const double dec, const double magnitude)
+int CatalogDB::FindFuzzyEntry(const double ra, const double dec, const double magnitude, const float epoch)
+{
+    EntryQueries queries(skydb_);
+    if (!PrepareEntryQueries(queries))
+        return -1;
+    return FindFuzzyEntry(ra, dec, magnitude, epoch, queries.fuzzy);
+}
+
+int CatalogDB::FindFuzzyEntry(double ra, double dec, double magnitude, float epoch, QSqlQuery &query)
 {
     /*
      * FIXME (spacetime): Match the incoming entry with the ones from the db
      * with certain fuzz. If found, store it in rowuid
      * This Fuzz has not been established after due discussion
     */
-    //skydb_.open();
-    QSqlTableModel dsoentries(nullptr, skydb_);
-
-    QString filter = "((RA - " + QString().setNum(ra) +
-                     ") between -0.0016 and 0.0016) and "
-                     "((Dec - " +
-                     QString().setNum(dec) +
-                     ") between -0.0016 and 0.0016) and"
-                     "((Magnitude - " +
-                     QString().setNum(magnitude) + ") between -0.1 and 0.1)";
-    //   qDebug() << filter;
-    dsoentries.setTable("DSO");
-    dsoentries.setFilter(filter);
-    dsoentries.select();
-
-    int entry_count   = dsoentries.rowCount();
-    QSqlRecord record = dsoentries.record(0);
 
-    int returnval = -1;
-    if (entry_count > 0)
-        returnval = record.value("UID").toInt();
+    // The positions are compared in J2000, like the trixels. The rows are in the
+    // epoch of their catalogs, so the declinations are preselected with a margin.
+    toJ2000(ra, dec, epoch);
 
-    dsoentries.clear();
-    //skydb_.close();
-    //   qDebug() << returnval;
-    return returnval;
+    // Trixels covering the fuzz box, whose half diagonal is at most sqrt(2) * FUZZ_POSITION
+    Mesh()->intersect(ra, dec, FUZZ_POSITION * sqrt(2.0));
+
+    MeshIterator region(mesh_.get());
+    while (region.hasNext())
+    {
+        query.bindValue(":trixel", region.next());
+        query.bindValue(":dec_min", dec - FUZZ_POSITION - PRECESSION_MARGIN);
+        query.bindValue(":dec_max", dec + FUZZ_POSITION + PRECESSION_MARGIN);
+        query.bindValue(":mag_min", magnitude - FUZZ_MAGNITUDE);
+        query.bindValue(":mag_max", magnitude + FUZZ_MAGNITUDE);
+        if (!query.exec())
+        {
+            qCWarning(KSTARS_CATALOG) << query.lastError();
+            return -1;
+        }
+
+        int returnval = -1;
+        while (returnval == -1 && query.next())
+        {
+            double row_ra = query.value(1).toDouble(), row_dec = query.value(2).toDouble();
+            toJ2000(row_ra, row_dec, query.value(3).toFloat());
+            if (fabs(row_ra - ra) <= FUZZ_POSITION && fabs(row_dec - dec) <= FUZZ_POSITION)
+                returnval = query.value(0).toInt();
+        }
+        query.finish();
+        if (returnval != -1)
+            return returnval;
+    }
+
+    return -1;
+}
+
+HTMesh *CatalogDB::Mesh()
+{
+    if (!mesh_)
+        mesh_.reset(new HTMesh(TRIXEL_LEVEL, TRIXEL_LEVEL));
+    return mesh_.get();
+}
+
+Trixel CatalogDB::TrixelOf(double ra, double dec, float epoch)
+{
+    toJ2000(ra, dec, epoch);
+    return Mesh()->index(ra, dec);
+}
+
+bool CatalogDB::PrepareEntryQueries(EntryQueries &queries)
+{
+    queries.fuzzy.setForwardOnly(true);
+    // Rows without designation are J2000, as in UpgradeSchema()
+    bool ok = queries.fuzzy.prepare("SELECT DSO.UID, DSO.RA, DSO.Dec, MIN(IFNULL(Catalog.Epoch, 2000.0)) FROM DSO "
+                                    "LEFT JOIN ObjectDesignation ON ObjectDesignation.UID_DSO = DSO.UID "
+                                    "LEFT JOIN Catalog ON Catalog.id = ObjectDesignation.id_Catalog "
+                                    "WHERE DSO.Trixel = :trixel AND "
+                                    "DSO.Dec BETWEEN :dec_min AND :dec_max AND "
+                                    "DSO.Magnitude BETWEEN :mag_min AND :mag_max GROUP BY DSO.UID");
+    ok = ok && queries.dso.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
+                                   " MajorAxis, MinorAxis, Flux, Trixel) VALUES (:RA, :Dec, :Type,"
+                                   " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
+                                   " :Flux, :Trixel)");
+    ok = ok && queries.designation.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                                           ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
+    ok = ok && queries.next_designation.prepare(
+                   "INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                   ", IDNumber) VALUES (:catid, :rowuid, :longname,"
+                   "(SELECT MAX(ISNULL(IDNumber,1))+1 FROM ObjectDesignation WHERE id_Catalog = :catid) )");
+    if (!ok)
+    {
+        qCWarning(KSTARS_CATALOG) << "Failed to prepare the catalog entry queries!";
+        qCWarning(KSTARS_CATALOG) << LastError();
+    }
+    return ok;
 }
 
 bool CatalogDB::AddEntry(const CatalogEntryData &catalog_entry, int catid)
 {
+    // Opens and closes the database, so before opening it here
+    CatalogData catalog_data;
+    GetCatalogData(catalog_entry.catalog_name, catalog_data);
+
     if (!skydb_.open())
     {
         qCWarning(KSTARS_CATALOG) << "Failed to open database to add catalog entry!";
         qCWarning(KSTARS_CATALOG) << LastError();
         return false;
     }
-    bool retVal = _AddEntry(catalog_entry, catid);
+    bool retVal = false;
+    {
+        EntryQueries queries(skydb_);
+        if (PrepareEntryQueries(queries))
+            retVal = _AddEntry(catalog_entry, catid, catalog_data.epoch, queries);
+    }
     skydb_.close();
     return retVal;
 }
 
-bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
+bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid, float epoch, EntryQueries &queries)
 {
     // Verification step
     // If RA, Dec are Null, it denotes an invalid object and should not be written
@@ -322,16 +491,11 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
     // out the lastInsertId
 
     // Part 2: Fuzzy Match or Create New Entry
-    int rowuid = FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
-    //skydb_.open();
+    int rowuid = FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude, epoch, queries.fuzzy);
 
     if (rowuid == -1) //i.e. No fuzzy match found. Proceed to add new entry
     {
-        QSqlQuery add_query(skydb_);
-        add_query.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
-                          " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
-                          " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
-                          " :Flux)");
+        QSqlQuery &add_query = queries.dso;
         add_query.bindValue(":RA", catalog_entry.ra);
         add_query.bindValue(":Dec", catalog_entry.dec);
         add_query.bindValue(":Type", catalog_entry.type);
@@ -340,6 +504,7 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         add_query.bindValue(":MajorAxis", catalog_entry.major_axis);
         add_query.bindValue(":MinorAxis", catalog_entry.minor_axis);
         add_query.bindValue(":Flux", catalog_entry.flux);
+        add_query.bindValue(":Trixel", TrixelOf(catalog_entry.ra, catalog_entry.dec, epoch));
         if (!add_query.exec())
         {
             qCWarning(KSTARS_CATALOG) << "Custom Catalog Insert Query FAILED!";
@@ -349,38 +514,14 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
 
         // Find UID of the Row just added
         rowuid = add_query.lastInsertId().toInt();
-        add_query.clear();
+        add_query.finish();
     }
     int ID = catalog_entry.ID;
 
-    /* TODO(spacetime)
-     * Possible Bugs in QSQL Db with SQLite
-     * 1) Unless the db is closed and opened again, the next queries
-     *    fail.
-     * 2) unless I clear the resources, db close fails. The doc says
-     *    this is to be rarely used.
-     */
-
-    // Find ID of catalog
-    //skydb_.close();
-    //catid = FindCatalog(catalog_entry.catalog_name);
-
     // Part 3: Add in Object Designation
-    //skydb_.open();
-    QSqlQuery add_od(skydb_);
+    QSqlQuery &add_od = (ID >= 0) ? queries.designation : queries.next_designation;
     if (ID >= 0)
-    {
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
         add_od.bindValue(":id", ID);
-    }
-    else
-    {
-        //qWarning() << "FIXME: This query has not been tested!!!!";
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname,"
-                       "(SELECT MAX(ISNULL(IDNumber,1))+1 FROM ObjectDesignation WHERE id_Catalog = :catid) )");
-    }
     add_od.bindValue(":catid", catid);
     add_od.bindValue(":rowuid", rowuid);
     add_od.bindValue(":longname", catalog_entry.long_name);
@@ -392,8 +533,7 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         qWarning() << skydb_.lastError();
         retVal = false;
     }
-    add_od.clear();
-    //skydb_.close();
+    add_od.finish();
 
     return retVal;
 }
@@ -481,37 +621,67 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
         KSParser catalog_text_parser(filename, '#', sequence, delimiter);
 
         int catid = FindCatalog(catalog_name);
-
+        CatalogData catalog_data;
+        GetCatalogData(catalog_name, catalog_data);
+
+        // Custom catalogs can be large, so they are read as typed rows
+        const int id_column   = catalog_text_parser.Column("ID");
+        const int name_column = catalog_text_parser.Column("Nm");
+        const int ra_column   = catalog_text_parser.Column("RA");
+        const int dec_column  = catalog_text_parser.Column("Dc");
+        const int type_column = catalog_text_parser.Column("Tp");
+        const int mag_column  = catalog_text_parser.Column("Mg");
+        const int pa_column   = catalog_text_parser.Column("PA");
+        const int maj_column  = catalog_text_parser.Column("Mj");
+        const int min_column  = catalog_text_parser.Column("Mn");
+        const int flux_column = catalog_text_parser.Column("Flux");
+
+        QElapsedTimer timer;
+        timer.start();
+        int count = 0;
+
+        // One transaction and statements prepared once, so the rows are only appended to the database
         skydb_.open();
         skydb_.transaction();
-
-        QHash<QString, QVariant> row_content;
-        while (catalog_text_parser.HasNextRow())
+        std::unique_ptr<EntryQueries> queries(new EntryQueries(skydb_));
+        if (!PrepareEntryQueries(*queries))
         {
-            row_content = catalog_text_parser.ReadNextRow();
+            queries.reset();
+            skydb_.rollback();
+            skydb_.close();
+            return false;
+        }
 
+        KSParser::Row row;
+        while (catalog_text_parser.ReadNextRow(row))
+        {
             CatalogEntryData catalog_entry;
 
-            dms read_ra(row_content["RA"].toString(), false);
-            dms read_dec(row_content["Dc"].toString(), true);
-            //qDebug()<<row_content["Nm"].toString();
+            dms read_ra(row.toString(ra_column), false);
+            dms read_dec(row.toString(dec_column), true);
             catalog_entry.catalog_name   = catalog_name;
-            catalog_entry.ID             = row_content["ID"].toInt();
-            catalog_entry.long_name      = row_content["Nm"].toString();
+            catalog_entry.ID             = row.toInt(id_column);
+            catalog_entry.long_name      = row.toString(name_column);
             catalog_entry.ra             = read_ra.Degrees();
             catalog_entry.dec            = read_dec.Degrees();
-            catalog_entry.type           = row_content["Tp"].toInt();
-            catalog_entry.magnitude      = row_content["Mg"].toFloat();
-            catalog_entry.position_angle = row_content["PA"].toFloat();
-            catalog_entry.major_axis     = row_content["Mj"].toFloat();
-            catalog_entry.minor_axis     = row_content["Mn"].toFloat();
-            catalog_entry.flux           = row_content["Flux"].toFloat();
-
-            _AddEntry(catalog_entry, catid);
+            catalog_entry.type           = row.toInt(type_column);
+            catalog_entry.magnitude      = row.toFloat(mag_column);
+            catalog_entry.position_angle = row.toFloat(pa_column);
+            catalog_entry.major_axis     = row.toFloat(maj_column);
+            catalog_entry.minor_axis     = row.toFloat(min_column);
+            catalog_entry.flux           = row.toFloat(flux_column);
+
+            if (_AddEntry(catalog_entry, catid, catalog_data.epoch, *queries))
+                ++count;
         }
 
+        // The statements must be released before the database is closed
+        queries.reset();
         skydb_.commit();
         skydb_.close();
+
+        qCInfo(KSTARS_CATALOG) << "Added" << count << "objects to catalog" << catalog_name << "in" << timer.elapsed()
+                               << "ms";
     }
     return true;
 }
@@ -836,18 +1006,14 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
 
     skydb_.open();
     QSqlQuery get_query(skydb_);
-    get_query.prepare("SELECT Epoch, Type, RA, Dec, Magnitude, Prefix, "
-                      "IDNumber, LongName, MajorAxis, MinorAxis, "
-                      "PositionAngle, Flux FROM ObjectDesignation JOIN DSO "
-                      "JOIN Catalog WHERE Catalog.id = :catID AND "
-                      "ObjectDesignation.id_Catalog = Catalog.id AND "
-                      "ObjectDesignation.UID_DSO = DSO.UID");
+    get_query.setForwardOnly(true);
+    get_query.prepare(QString("SELECT %1 FROM ObjectDesignation JOIN DSO "
+                              "JOIN Catalog WHERE Catalog.id = :catID AND "
+                              "ObjectDesignation.id_Catalog = Catalog.id AND "
+                              "ObjectDesignation.UID_DSO = DSO.UID")
+                          .arg(OBJECT_COLUMNS));
     get_query.bindValue(":catID", selected_catalog);
 
-    //     qWarning() << get_query.lastQuery();
-    //     qWarning() << get_query.lastError();
-    //     qWarning() << FindCatalog(catalog);
-
     if (!get_query.exec())
     {
         qWarning() << get_query.lastQuery();
@@ -856,91 +1022,165 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
 
     while (get_query.next())
     {
-        int cat_epoch       = get_query.value(0).toInt();
-        unsigned char iType = get_query.value(1).toInt();
-        dms RA(get_query.value(2).toDouble());
-        dms Dec(get_query.value(3).toDouble());
-        float mag                = get_query.value(4).toFloat();
-        QString catPrefix        = get_query.value(5).toString();
-        int id_number_in_catalog = get_query.value(6).toInt();
-        QString lname            = get_query.value(7).toString();
-        float a                  = get_query.value(8).toFloat();
-        float b                  = get_query.value(9).toFloat();
-        float PA                 = get_query.value(10).toFloat();
-        float flux               = get_query.value(11).toFloat();
-        QString name;
-
-        if (!includeCatalogDesignation && !lname.isEmpty())
-        {
-            name  = lname;
-            lname = QString();
-        }
+        sky_list.append(CreateObject(get_query, catalog_ptr, includeCatalogDesignation, object_names));
+    }
+
+    get_query.clear();
+    skydb_.close();
+}
+
+int CatalogDB::GetObjectCount(int catalog_id)
+{
+    skydb_.open();
+
+    int count = 0;
+    {
+        QSqlQuery count_query(skydb_);
+        count_query.prepare("SELECT COUNT(*) FROM ObjectDesignation WHERE id_Catalog = :catID");
+        count_query.bindValue(":catID", catalog_id);
+        if (count_query.exec() && count_query.next())
+            count = count_query.value(0).toInt();
         else
-            name = catPrefix + ' ' + QString::number(id_number_in_catalog);
+            qCWarning(KSTARS_CATALOG) << count_query.lastError();
+    }
 
-        SkyPoint t;
-        t.set(RA, Dec);
+    skydb_.close();
+    return count;
+}
 
-        if (cat_epoch == 1950)
-        {
-            // Assume B1950 epoch
-            t.B1950ToJ2000(); // t.ra() and t.dec() are now J2000.0
-            // coordinates
-        }
-        else if (cat_epoch == 2000)
+bool CatalogDB::GetObjectsInTrixels(int catalog_id, const QVector<Trixel> &trixels,
+                                    QHash<Trixel, QList<SkyObject *>> &sky_lists, CatalogComponent *catalog_pointer,
+                                    bool includeCatalogDesignation)
+{
+    if (!skydb_.open())
+    {
+        qCWarning(KSTARS_CATALOG) << LastError();
+        return false;
+    }
+
+    bool retVal = true;
+    {
+        QSqlQuery get_query(skydb_);
+        get_query.setForwardOnly(true);
+        get_query.prepare(QString("SELECT %1 FROM ObjectDesignation JOIN DSO "
+                                  "JOIN Catalog WHERE DSO.Trixel = :trixel AND "
+                                  "ObjectDesignation.id_Catalog = :catID AND "
+                                  "ObjectDesignation.UID_DSO = DSO.UID AND "
+                                  "Catalog.id = ObjectDesignation.id_Catalog")
+                              .arg(OBJECT_COLUMNS));
+
+        // The names are only needed by the name index of fully loaded catalogs
+        QList<QPair<int, QString>> names;
+        for (Trixel trixel : trixels)
         {
-            // Do nothing
+            get_query.bindValue(":trixel", trixel);
+            get_query.bindValue(":catID", catalog_id);
+            if (!get_query.exec())
             {
+                qCWarning(KSTARS_CATALOG) << get_query.lastError();
+                retVal = false;
+                break;
             }
+
+            QList<SkyObject *> &sky_list = sky_lists[trixel];
+            while (get_query.next())
+            {
+                sky_list.append(CreateObject(get_query, catalog_pointer, includeCatalogDesignation, names));
+            }
+            get_query.finish();
+            names.clear();
         }
-        else
-        {
-            // FIXME: What should we do?
-            // FIXME: This warning will be printed for each line in the
-            //        catalog rather than once for the entire catalog
-            qWarning() << "Unknown epoch while dealing with custom "
-                          "catalog. Will ignore the epoch and assume"
-                          " J2000.0";
-        }
+    }
+
+    skydb_.close();
+    return retVal;
+}
 
-        RA  = t.ra();
-        Dec = t.dec();
+SkyObject *CatalogDB::CreateObject(const QSqlQuery &query, CatalogComponent *catalog_ptr,
+                                   bool includeCatalogDesignation, QList<QPair<int, QString>> &object_names)
+{
+    int cat_epoch       = query.value(0).toInt();
+    unsigned char iType = query.value(1).toInt();
+    dms RA(query.value(2).toDouble());
+    dms Dec(query.value(3).toDouble());
+    float mag                = query.value(4).toFloat();
+    QString catPrefix        = query.value(5).toString();
+    int id_number_in_catalog = query.value(6).toInt();
+    QString lname            = query.value(7).toString();
+    float a                  = query.value(8).toFloat();
+    float b                  = query.value(9).toFloat();
+    float PA                 = query.value(10).toFloat();
+    float flux               = query.value(11).toFloat();
+    QString name;
+
+    if (!includeCatalogDesignation && !lname.isEmpty())
+    {
+        name  = lname;
+        lname = QString();
+    }
+    else
+        name = catPrefix + ' ' + QString::number(id_number_in_catalog);
 
-        // FIXME: It is a bad idea to create objects in one class
-        // (using new) and delete them in another! The objects created
-        // here are usually deleted by CatalogComponent! See
-        // CatalogComponent::loadData for more information!
+    SkyPoint t;
+    t.set(RA, Dec);
 
-        if (iType == 0) // Add a star
+    if (cat_epoch == 1950)
+    {
+        // Assume B1950 epoch
+        t.B1950ToJ2000(); // t.ra() and t.dec() are now J2000.0
+        // coordinates
+    }
+    else if (cat_epoch == 2000)
+    {
+        // Do nothing
         {
-            StarObject *o = new StarObject(RA, Dec, mag, lname);
-
-            sky_list.append(o);
         }
-        else // Add a deep-sky object
-        {
-            DeepSkyObject *o = new DeepSkyObject(iType, RA, Dec, mag, name, QString(), lname, catPrefix, a, b, -PA);
+    }
+    else
+    {
+        // FIXME: What should we do?
+        // FIXME: This warning will be printed for each line in the
+        //        catalog rather than once for the entire catalog
+        qWarning() << "Unknown epoch while dealing with custom "
+                      "catalog. Will ignore the epoch and assume"
+                      " J2000.0";
+    }
 
-            o->setFlux(flux);
-            o->setCustomCatalog(catalog_ptr);
+    RA  = t.ra();
+    Dec = t.dec();
 
-            sky_list.append(o);
+    // FIXME: It is a bad idea to create objects in one class
+    // (using new) and delete them in another! The objects created
+    // here are usually deleted by CatalogComponent! See
+    // CatalogComponent::loadData for more information!
 
-            // Add name to the list of object names
-            if (!name.isEmpty())
-            {
-                object_names.append(qMakePair<int, QString>(iType, name));
-            }
-        }
+    SkyObject *object = nullptr;
+    if (iType == 0) // Add a star
+    {
+        object = new StarObject(RA, Dec, mag, lname);
+    }
+    else // Add a deep-sky object
+    {
+        DeepSkyObject *o = new DeepSkyObject(iType, RA, Dec, mag, name, QString(), lname, catPrefix, a, b, -PA);
+
+        o->setFlux(flux);
+        o->setCustomCatalog(catalog_ptr);
 
-        if (!lname.isEmpty() && lname != name)
+        object = o;
+
+        // Add name to the list of object names
+        if (!name.isEmpty())
         {
-            object_names.append(qMakePair<int, QString>(iType, lname));
+            object_names.append(qMakePair<int, QString>(iType, name));
         }
     }
 
-    get_query.clear();
-    skydb_.close();
+    if (!lname.isEmpty() && lname != name)
+    {
+        object_names.append(qMakePair<int, QString>(iType, lname));
+    }
+
+    return object;
 }
 
 QList<QPair<QString, KSParser::DataTypes>> CatalogDB::buildParserSequence(const QStringList &Columns)
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ksparser.h"
+#include "typedef.h"
 
 #include <KLocalizedString>
 #ifndef KSTARS_LITE
@@ -26,7 +27,11 @@
 
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QSqlQuery>
 
+#include <memory>
+
+class HTMesh;
 class SkyObject;
 class CatalogComponent;
 class CatalogData;
@@ -38,11 +43,18 @@ class CatalogEntryData;
  *    hence, the uid is a qint64 i.e. a 64 bit signed integer. Coincidentally,
  *    this is the max limit of an int in Sqlite3.
  *    Hence, the db is compatible with the uid, but doesn't use it as of now.
+ * 2) Each DSO row stores the trixel of its J2000 position in a mesh of level
+ *    TRIXEL_LEVEL, the level of the mesh of the sky map.  The (Trixel, Dec)
+ *    index serves both the fuzzy cross-match of the imports and the region
+ *    queries of GetObjectsInTrixels().
  */
 
 class CatalogDB
 {
   public:
+    /** @short Level of the mesh indexing the DSO table, the one of the sky map mesh */
+    static const int TRIXEL_LEVEL;
+
     /**
      * @brief Initializes the database and sets up pointers to Catalog DB
      * Performs the following actions:
@@ -100,9 +112,10 @@ class CatalogDB
      *
      * @param ra Right Ascension of new object to be added
      * @param dec Declination of new object to be added
+     * @param epoch Epoch of ra and dec, 1950 or 2000
      * @return int RowUID of the new row
      **/
-    int FindFuzzyEntry(const double ra, const double dec, const double magnitude);
+    int FindFuzzyEntry(const double ra, const double dec, const double magnitude, const float epoch = 2000.);
 
     /**
      * @brief Removes the catalog from the database and refreshes the listing.
@@ -132,6 +145,30 @@ class CatalogDB
                        QList<QPair<int, QString>> &object_names, CatalogComponent *catalog_pointer,
                        bool includeCatalogDesignation = true);
 
+    /**
+     * @brief Returns the number of objects of the catalog
+     *
+     * @param catalog_id Database ID of the catalog, see FindCatalog()
+     * @return int
+     **/
+    int GetObjectCount(int catalog_id);
+
+    /**
+     * @brief Creates the objects of a catalog lying in the given trixels
+     * Only the requested part of the catalog is read, so a large catalog can be
+     * paged in as the sky map moves instead of being loaded whole.
+     *
+     * @param catalog_id Database ID of the catalog, see FindCatalog()
+     * @param trixels Trixels of a mesh of level TRIXEL_LEVEL
+     * @param sky_lists Objects of each trixel (assigns), the caller owns them
+     * @param catalog_pointer pointer to the catalogcomponent objects
+     * @param includeCatalogDesignation see GetAllObjects()
+     * @return false if the query failed
+     **/
+    bool GetObjectsInTrixels(int catalog_id, const QVector<Trixel> &trixels,
+                             QHash<Trixel, QList<SkyObject *>> &sky_lists, CatalogComponent *catalog_pointer,
+                             bool includeCatalogDesignation = true);
+
     /**
      * @brief Get information about the catalog like Prefix etc
      *
@@ -170,6 +207,27 @@ class CatalogDB
     void AddCatalog(const CatalogData &catalog_data);
 
   private:
+    /**
+     * @brief Statements used to add entries, prepared once and reused for every
+     * row of an import.  Only valid while the database stays open.
+     **/
+    struct EntryQueries
+    {
+        explicit EntryQueries(const QSqlDatabase &db) : fuzzy(db), dso(db), designation(db), next_designation(db) {}
+
+        QSqlQuery fuzzy;
+        QSqlQuery dso;
+        QSqlQuery designation;
+        QSqlQuery next_designation;
+    };
+
+    /**
+     * @brief Prepares the statements of queries on the opened database
+     *
+     * @return false if a statement could not be prepared
+     **/
+    bool PrepareEntryQueries(EntryQueries &queries);
+
     /**
      * @brief Used to add a cross referenced entry into the database
      *
@@ -178,9 +236,51 @@ class CatalogDB
      *
      * @param catalog_entry Data structure with entry details
      * @param catid Category ID in the database
+     * @param epoch Epoch of the catalog, 1950 or 2000
+     * @param queries Statements prepared by PrepareEntryQueries()
      * @return false if adding was unsuccessful
      **/
-    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid);
+    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid, float epoch, EntryQueries &queries);
+
+    /**
+     * @brief returns the UID of a DSO row matching the position and magnitude
+     * with certain fuzz, -1 if none found. The positions are compared in J2000.
+     *
+     * @param query The fuzzy statement prepared by PrepareEntryQueries()
+     **/
+    int FindFuzzyEntry(double ra, double dec, double magnitude, float epoch, QSqlQuery &query);
+
+    /**
+     * @brief Returns the mesh indexing the DSO table, creating it on first use
+     **/
+    HTMesh *Mesh();
+
+    /**
+     * @brief Returns the trixel of the given position, in degrees of the given epoch
+     **/
+    Trixel TrixelOf(double ra, double dec, float epoch);
+
+    /**
+     * @brief Creates the object of the current row of a query selecting
+     * the columns of GetAllObjects() and GetObjectsInTrixels()
+     *
+     * @param names Names of the object to add to the name lists (appends)
+     * @return the new object, owned by the caller
+     **/
+    SkyObject *CreateObject(const QSqlQuery &query, CatalogComponent *catalog_pointer, bool includeCatalogDesignation,
+                            QList<QPair<int, QString>> &names);
+
+    /**
+     * @brief Adds the columns and indexes missing in a database created by an older version
+     *
+     * @return void
+     **/
+    void UpgradeSchema();
+
+    /**
+     * @brief Mesh computing the trixels of the DSO table, see Mesh()
+     **/
+    std::unique_ptr<HTMesh> mesh_;
 
     /**
      * @brief Database object for the sky object. Assigned and Initialized by Initialize()
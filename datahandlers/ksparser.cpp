@@ -17,7 +17,165 @@
 
 #include "ksparser.h"
 
+#include "kspaths.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+/// Identifies the snapshot files
+const quint32 SNAPSHOT_MAGIC = 0x4B535053;
+
+/// Version of the snapshot format, to be increased when it changes
+const quint32 SNAPSHOT_VERSION = 2;
+
+/// Largest integer below which all integers are exact doubles
+const quint64 EXACT_MANTISSA = quint64(1) << 53;
+
+/// Powers of ten which are exact doubles
+const double EXACT_POWERS[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/** @return true if c is removed by QString::trimmed(), for ASCII */
+inline bool isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/** @short Remove the white spaces around [begin, end) */
+inline void trim(const char *&begin, const char *&end)
+{
+    while (begin < end && isSpace(*begin))
+        ++begin;
+    while (end > begin && isSpace(end[-1]))
+        --end;
+}
+
+/** @short Convert a field like QString::toInt(), false if it is not an integer */
+bool parseInt(const char *begin, const char *end, int &value)
+{
+    trim(begin, end);
+
+    bool negative = false;
+    if (begin < end && (*begin == '+' || *begin == '-'))
+        negative = *begin++ == '-';
+    if (begin == end)
+        return false;
+
+    qint64 result = 0;
+    for (; begin < end; ++begin)
+    {
+        if (*begin < '0' || *begin > '9')
+            return false;
+        result = 10 * result + (*begin - '0');
+        if (result > qint64(std::numeric_limits<int>::max()) + 1)
+            return false;
+    }
+    if (!negative && result > std::numeric_limits<int>::max())
+        return false;
+
+    value = int(negative ? -result : result);
+    return true;
+}
+
+/**
+ * @short Convert a field like QString::toDouble(), false if it is not a number
+ * Decimal numbers with up to 15 significant digits and small exponents, which
+ * are the values of the catalogs, are converted exactly from their digits.
+ * The others are left to Qt.
+ */
+bool parseDouble(const char *begin, const char *end, double &value)
+{
+    trim(begin, end);
+
+    const char *c = begin;
+    bool negative = false;
+    if (c < end && (*c == '+' || *c == '-'))
+        negative = *c++ == '-';
+
+    quint64 mantissa = 0;
+    int exponent     = 0;
+    bool digits      = false;
+    bool exact       = true;
+    for (; c < end && *c >= '0' && *c <= '9'; ++c)
+    {
+        mantissa = 10 * mantissa + (*c - '0');
+        exact    = exact && mantissa < EXACT_MANTISSA;
+        digits   = true;
+    }
+    if (c < end && *c == '.')
+    {
+        for (++c; c < end && *c >= '0' && *c <= '9'; ++c)
+        {
+            mantissa = 10 * mantissa + (*c - '0');
+            exact    = exact && mantissa < EXACT_MANTISSA;
+            digits   = true;
+            --exponent;
+        }
+    }
+    if (c < end && (*c == 'e' || *c == 'E') && digits)
+    {
+        ++c;
+        bool negativeExponent = false;
+        if (c < end && (*c == '+' || *c == '-'))
+            negativeExponent = *c++ == '-';
+
+        int e = 0;
+        const char *first = c;
+        for (; c < end && *c >= '0' && *c <= '9' && e < 1000; ++c)
+            e = 10 * e + (*c - '0');
+        if (c == first)
+            exact = false;
+        exponent += negativeExponent ? -e : e;
+    }
+
+    if (digits && exact && c == end && exponent >= -22 && exponent <= 22)
+    {
+        value = double(mantissa);
+        value = exponent < 0 ? value / EXACT_POWERS[-exponent] : value * EXACT_POWERS[exponent];
+        if (negative)
+            value = -value;
+        return true;
+    }
+
+    // Long mantissas, large exponents, infinities...
+    bool ok = false;
+    value   = QByteArray::fromRawData(begin, int(end - begin)).toDouble(&ok);
+    return ok;
+}
+
+/** @short Advance begin by count UTF-16 characters of the UTF-8 text, returning how many were available */
+int advance(const char *&begin, const char *end, int count)
+{
+    int advanced = 0;
+    while (advanced < count && begin < end)
+    {
+        const uchar lead = uchar(*begin);
+        int length = 1;
+        if (lead >= 0xF0)
+            length = 4;
+        else if (lead >= 0xE0)
+            length = 3;
+        else if (lead >= 0xC0)
+            length = 2;
+
+        // Characters out of the BMP take two UTF-16 units
+        advanced += length == 4 ? 2 : 1;
+        begin = qMin(begin + length, end);
+    }
+    return advanced;
+}
+}
 
 const int KSParser::EBROKEN_INT         = 0;
 const double KSParser::EBROKEN_DOUBLE   = 0.0;
@@ -62,6 +220,329 @@ QHash<QString, QVariant> KSParser::ReadNextRow()
     return (this->*readFunctionPtr)();
 }
 
+bool KSParser::ReadNextRow(Row &row)
+{
+    if (snapshot_reading_)
+        return ReadSnapshotRow(row);
+    if (!MapFile())
+        return false;
+
+    while (mapped_pos_ < mapped_end_)
+    {
+        const char *begin = mapped_pos_;
+        const char *end   = static_cast<const char *>(memchr(begin, '\n', mapped_end_ - begin));
+        if (end == nullptr)
+            end = mapped_end_;
+        mapped_pos_ = qMin(end + 1, mapped_end_);
+
+        // Line ends are removed as by QTextStream::readLine()
+        if (end > begin && end[-1] == '\r')
+            --end;
+        if (begin < end && *begin == comment_char_)
+            continue;
+
+        const bool fixed_width = readFunctionPtr == &KSParser::ReadFixedWidthRow;
+        if (fixed_width ? SplitFixedWidthRow(begin, end, row) : SplitCSVRow(begin, end, row))
+        {
+            if (snapshot_recording_)
+                RecordSnapshotRow(row);
+            return true;
+        }
+    }
+
+    // The whole file was split, the snapshot can be written
+    if (snapshot_recording_)
+        WriteSnapshot();
+    return false;
+}
+
+int KSParser::Column(const QString &name) const
+{
+    for (int i = 0; i < name_type_sequence_.length(); ++i)
+    {
+        if (name_type_sequence_[i].first == name)
+            return i;
+    }
+    return -1;
+}
+
+bool KSParser::MapFile()
+{
+    if (mapped_)
+        return mapped_pos_ != nullptr;
+    mapped_ = true;
+
+    if (readFunctionPtr == &KSParser::DummyRow)
+        return false;
+
+    mapped_file_.setFileName(filename_);
+    if (!mapped_file_.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Unable to open file: " << filename_;
+        return false;
+    }
+
+    // Nothing to map in an empty file
+    static const char empty = 0;
+    mapped_pos_ = mapped_end_ = &empty;
+    if (mapped_file_.size() == 0)
+        return true;
+
+    const uchar *data = mapped_file_.map(0, mapped_file_.size());
+    if (data == nullptr)
+    {
+        qWarning() << "Unable to map file: " << filename_;
+        mapped_pos_ = mapped_end_ = nullptr;
+        return false;
+    }
+    mapped_pos_ = reinterpret_cast<const char *>(data);
+    mapped_end_ = mapped_pos_ + mapped_file_.size();
+
+    // Skip the byte order mark, as QTextStream does
+    if (mapped_end_ - mapped_pos_ >= 3 && memcmp(mapped_pos_, "\xEF\xBB\xBF", 3) == 0)
+        mapped_pos_ += 3;
+    return true;
+}
+
+bool KSParser::SplitCSVRow(const char *begin, const char *end, Row &row)
+{
+    pieces_.clear();
+    const char *start = begin;
+    for (const char *c = begin; c < end; ++c)
+    {
+        if (*c == delimiter_)
+        {
+            pieces_.append(Row::Field(start, c));
+            start = c + 1;
+        }
+    }
+    pieces_.append(Row::Field(start, end));
+
+    // No delimiter
+    if (pieces_.size() == 1)
+        return false;
+
+    // Join the pieces of quoted fields, as CombineQuoteParts() does
+    row.fields_.clear();
+    for (int i = 0; i < pieces_.size(); ++i)
+    {
+        const char *field_begin = pieces_[i].first;
+        const char *field_end   = pieces_[i].second;
+
+        if (field_begin < field_end && *field_begin == '"')
+        {
+            ++field_begin;
+
+            // Until a piece ending with a quote, or an empty one
+            const char *piece_begin = field_begin;
+            while (field_end > piece_begin && field_end[-1] != '"' && i + 1 < pieces_.size())
+            {
+                ++i;
+                piece_begin = pieces_[i].first;
+                field_end   = pieces_[i].second;
+            }
+            // Remove the closing quote
+            if (field_end > piece_begin)
+                --field_end;
+        }
+        row.fields_.append(Row::Field(field_begin, qMax(field_begin, field_end)));
+    }
+
+    // Skip incomplete rows
+    return row.fields_.size() == name_type_sequence_.length();
+}
+
+bool KSParser::SplitFixedWidthRow(const char *begin, const char *end, Row &row)
+{
+    if (name_type_sequence_.length() != (width_sequence_.length() + 1))
+    {
+        qWarning() << "Unequal fields and widths! Skipping row!";
+        return false;
+    }
+
+    row.fields_.clear();
+    const char *c = begin;
+    for (int width : width_sequence_)
+    {
+        const char *field_begin = c;
+        // Skip the lines too short for all fields but the last one
+        if (advance(c, end, width) < width)
+            return false;
+
+        const char *field_end = c;
+        trim(field_begin, field_end);
+        row.fields_.append(Row::Field(field_begin, field_end));
+    }
+
+    const char *field_end = end;
+    trim(c, field_end);
+    row.fields_.append(Row::Field(c, field_end));
+    return true;
+}
+
+QString KSParser::Row::toString(int column) const
+{
+    if (column < 0 || column >= fields_.size())
+        return QString();
+    const Field &field = fields_[column];
+    return QString::fromUtf8(field.first, int(field.second - field.first));
+}
+
+int KSParser::Row::toInt(int column) const
+{
+    int value = EBROKEN_INT;
+    if (column >= 0 && column < fields_.size() && !parseInt(fields_[column].first, fields_[column].second, value))
+        value = EBROKEN_INT;
+    return value;
+}
+
+float KSParser::Row::toFloat(int column) const
+{
+    const double value = toDouble(column);
+    if (std::isfinite(value) && std::fabs(value) > std::numeric_limits<float>::max())
+        return EBROKEN_FLOAT;
+    return float(value);
+}
+
+double KSParser::Row::toDouble(int column) const
+{
+    double value = EBROKEN_DOUBLE;
+    if (column >= 0 && column < fields_.size() &&
+        !parseDouble(fields_[column].first, fields_[column].second, value))
+        value = EBROKEN_DOUBLE;
+    return value;
+}
+
+bool KSParser::Row::equals(int column, const char *text) const
+{
+    if (column < 0 || column >= fields_.size())
+        return false;
+    const Field &field = fields_[column];
+    const size_t length = field.second - field.first;
+    return length == strlen(text) && memcmp(field.first, text, length) == 0;
+}
+
+bool KSParser::UseSnapshot(const QString &name)
+{
+    QFile source(filename_);
+    if (!source.open(QIODevice::ReadOnly))
+        return false;
+
+    // The key changes with the contents of the file and with the way they are converted
+    QByteArray format;
+    QDataStream formatStream(&format, QIODevice::WriteOnly);
+    formatStream << SNAPSHOT_VERSION << qint8(comment_char_) << qint8(delimiter_) << width_sequence_;
+    for (const auto &field : name_type_sequence_)
+        formatStream << field.first << qint32(field.second);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&source);
+    hash.addData(format);
+    snapshot_key_  = hash.result();
+    snapshot_path_ = KSPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "snapshots/" + name + ".snapshot";
+
+    snapshot_file_.setFileName(snapshot_path_);
+    if (snapshot_file_.open(QIODevice::ReadOnly))
+    {
+        QDataStream header(&snapshot_file_);
+        header.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0, version = 0;
+        header >> magic >> version;
+        if (header.status() == QDataStream::Ok && magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION)
+        {
+            QByteArray key;
+            quint64 size = 0;
+            header >> key >> snapshot_rows_ >> size;
+
+            const qint64 offset = snapshot_file_.pos();
+            if (header.status() == QDataStream::Ok && key == snapshot_key_ &&
+                size == quint64(snapshot_file_.size() - offset))
+            {
+                // The fields are read in place from the mapped file
+                const uchar *data = snapshot_file_.map(0, snapshot_file_.size());
+                if (data != nullptr)
+                {
+                    snapshot_pos_     = reinterpret_cast<const char *>(data) + offset;
+                    snapshot_end_     = snapshot_pos_ + size;
+                    snapshot_reading_ = true;
+                    return true;
+                }
+            }
+        }
+        snapshot_file_.close();
+    }
+
+    // Record the fields while splitting the file, to write the snapshot at the end
+    if (readFunctionPtr != &KSParser::DummyRow)
+    {
+        snapshot_recording_ = true;
+        snapshot_rows_      = 0;
+    }
+    return false;
+}
+
+bool KSParser::ReadSnapshotRow(Row &row)
+{
+    if (snapshot_rows_ == 0)
+        return false;
+    --snapshot_rows_;
+
+    // Each field is saved as its length followed by its bytes
+    row.fields_.clear();
+    for (int i = 0; i < name_type_sequence_.length(); ++i)
+    {
+        if (snapshot_end_ - snapshot_pos_ < qint64(sizeof(quint32)))
+            break;
+        const quint32 length = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(snapshot_pos_));
+        snapshot_pos_ += sizeof(quint32);
+        if (quint64(snapshot_end_ - snapshot_pos_) < length)
+            break;
+
+        row.fields_.append(Row::Field(snapshot_pos_, snapshot_pos_ + length));
+        snapshot_pos_ += length;
+    }
+
+    if (row.fields_.size() != name_type_sequence_.length())
+    {
+        qWarning() << "Truncated snapshot" << snapshot_path_;
+        snapshot_rows_ = 0;
+        return false;
+    }
+    return true;
+}
+
+void KSParser::RecordSnapshotRow(const Row &row)
+{
+    for (const Row::Field &field : row.fields_)
+    {
+        uchar length[sizeof(quint32)];
+        qToLittleEndian<quint32>(quint32(field.second - field.first), length);
+        snapshot_data_.append(reinterpret_cast<const char *>(length), sizeof(length));
+        snapshot_data_.append(field.first, int(field.second - field.first));
+    }
+    ++snapshot_rows_;
+}
+
+void KSParser::WriteSnapshot()
+{
+    snapshot_recording_ = false;
+
+    QDir().mkpath(QFileInfo(snapshot_path_).absolutePath());
+    QSaveFile file(snapshot_path_);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        QDataStream header(&file);
+        header.setVersion(QDataStream::Qt_5_0);
+        header << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << snapshot_key_ << snapshot_rows_
+               << quint64(snapshot_data_.size());
+        file.write(snapshot_data_);
+        if (!file.commit())
+            qWarning() << "Unable to write snapshot" << snapshot_path_;
+    }
+    snapshot_data_.clear();
+}
+
 QHash<QString, QVariant> KSParser::ReadCSVRow()
 {
     /**
@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include <QFile>
 #include <QHash>
 #include <QList>
+#include <QPair>
 #include <QVariant>
+#include <QVector>
 
 #include "ksfilereader.h"
 
@@ -43,6 +46,19 @@
  * In case of failure, the parser returns a Dummy Row. So if you see the
  * string "Null" in the returned QHash, it signifies the parserencountered an
  * unexpected error.
+ *
+ * Large files can also be read with the typed ReadNextRow(Row &), which
+ * builds no QHash nor QString per row:
+ * 1) look up the column indexes once with Column()
+ * 2) KSParser::Row row;
+ *    while (KSParserObject.ReadNextRow(row)) {
+ *      int id = row.toInt(id_column);
+ *      ...
+ *    }
+ *
+ * Large data files read at every launch can also call UseSnapshot() before
+ * reading the typed rows: the split fields are then saved to a binary
+ * snapshot once, and read back from it as long as the file is unchanged.
  **/
 class KSParser
 {
@@ -72,6 +88,35 @@ class KSParser
         D_SKIP
     };
 
+    /**
+     * @brief A row read by the typed ReadNextRow(Row &).
+     * The fields point into the mapped file, or into the mapped snapshot, and
+     * are converted when requested,
+     * whatever their data type in the sequence. A column out of the sequence,
+     * e.g. Column() of a missing field, reads as an empty string or 0, and so
+     * does a field which cannot be converted.
+     * The row stays valid until the next read or the destruction of the parser.
+     **/
+    class Row
+    {
+      public:
+        QString toString(int column) const;
+        int toInt(int column) const;
+        float toFloat(int column) const;
+        double toDouble(int column) const;
+
+        /**
+         * @brief Returns True if the field is the given Latin-1 text, without converting it
+         **/
+        bool equals(int column, const char *text) const;
+
+      private:
+        friend class KSParser;
+
+        typedef QPair<const char *, const char *> Field;
+        QVector<Field> fields_;
+    };
+
     /**
      * @brief Returns a CSV parsing instance of a KSParser type object.
      *
@@ -138,6 +183,39 @@ class KSParser
     // Too many warnings when const: datahandlers/ksparser.h:131:27: warning:
     // type qualifiers ignored on function return type [-Wignored-qualifiers]
 
+    /**
+     * @brief Typed alternative to ReadNextRow() and HasNextRow().
+     * Reads the file through a memory map, skipping the same lines as
+     * ReadNextRow(), or through the snapshot if UseSnapshot() found one.
+     * It never returns a dummy row.
+     * Both ways of reading must not be mixed on the same parser.
+     *
+     * @param row Receives the fields of the row, its storage is reused
+     * @return false at the end of the file, or if it cannot be read
+     **/
+    bool ReadNextRow(Row &row);
+
+    /**
+     * @brief Returns the column of a field in the sequence, for the typed rows
+     *
+     * @param name Name of the field
+     * @return int index of the field, -1 if it is not in the sequence
+     **/
+    int Column(const QString &name) const;
+
+    /**
+     * @brief Read the typed rows from a binary snapshot of the file, if it is unchanged
+     * Must be called before reading the first row. The snapshot holds the split
+     * fields of each row. It is kept in the cache directory under the given name
+     * and is keyed by a hash of the file contents and of the field sequence. If it
+     * is missing or outdated, the file is parsed and the snapshot is written once
+     * the last row was read. It has no effect on the QHash rows of ReadNextRow().
+     *
+     * @param name Name of the snapshot, unique for the file
+     * @return true if the rows are read from the snapshot
+     **/
+    bool UseSnapshot(const QString &name);
+
     /**
      * @brief Wrapper function for KSFileReader setProgress
      *
@@ -180,6 +258,47 @@ class KSParser
      **/
     QHash<QString, QVariant> ReadFixedWidthRow();
 
+    /**
+     * @brief Maps the file for the typed rows, once.
+     *
+     * @return bool False if the file cannot be mapped
+     **/
+    bool MapFile();
+
+    /**
+     * @brief Splits a CSV line of the mapped file like ReadCSVRow() does,
+     * quotes included.
+     *
+     * @return bool False if the line has to be skipped
+     **/
+    bool SplitCSVRow(const char *begin, const char *end, Row &row);
+
+    /**
+     * @brief Splits a fixed width line of the mapped file like
+     * ReadFixedWidthRow() does. The widths count UTF-16 characters.
+     *
+     * @return bool False if the line has to be skipped
+     **/
+    bool SplitFixedWidthRow(const char *begin, const char *end, Row &row);
+
+    /**
+     * @brief Points the fields of the row to the next row of the snapshot.
+     *
+     * @return bool False after the last row, or if the snapshot is truncated
+     **/
+    bool ReadSnapshotRow(Row &row);
+
+    /**
+     * @brief Appends the fields of a row split from the file to the snapshot
+     * being recorded.
+     **/
+    void RecordSnapshotRow(const Row &row);
+
+    /**
+     * @brief Writes the recorded snapshot, once the whole file was split.
+     **/
+    void WriteSnapshot();
+
     /**
      * @brief Returns a default value row.
      * Values are according to the current assigned sequence.
@@ -217,4 +336,22 @@ class KSParser
     QList<QPair<QString, DataTypes>> name_type_sequence_;
     QList<int> width_sequence_;
     char delimiter_ { 0 };
+
+    // Snapshot read in place of the file, or being recorded while parsing it
+    QString snapshot_path_;
+    QByteArray snapshot_key_;
+    QFile snapshot_file_;
+    QByteArray snapshot_data_;
+    const char *snapshot_pos_ { nullptr };
+    const char *snapshot_end_ { nullptr };
+    quint32 snapshot_rows_ { 0 };
+    bool snapshot_reading_ { false };
+    bool snapshot_recording_ { false };
+
+    // File mapped for the typed rows
+    QFile mapped_file_;
+    const char *mapped_pos_ { nullptr };
+    const char *mapped_end_ { nullptr };
+    bool mapped_ { false };
+    QVector<Row::Field> pieces_;
 };
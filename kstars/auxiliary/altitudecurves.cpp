@@ -0,0 +1,135 @@
+/*  Altitude curves of many objects over a time grid
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "altitudecurves.h"
+
+#include "geolocation.h"
+#include "kstarsdatetime.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+AltitudeCurves::AltitudeCurves(const GeoLocation *geo, const KStarsDateTime &start, double step, int count)
+    : m_Geo(geo), m_StartJD(start.djd()), m_Step(step / 24.0)
+{
+    geo->lat()->SinCos(m_SinLat, m_CosLat);
+
+    // The sidereal time grows linearly with the UT, only the first point needs the full computation
+    const double startLST = geo->GSTtoLST(start.gst()).Degrees();
+
+    m_LST.resize(count);
+    m_CosLST.resize(count);
+    m_SinLST.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        m_LST[i]         = startLST + i * m_Step * dms::SiderealRate;
+        const double lst = m_LST[i] * dms::DegToRad;
+        m_CosLST[i]      = cos(lst);
+        m_SinLST[i]      = sin(lst);
+    }
+}
+
+QVector<double> AltitudeCurves::fixedCurve(const SkyPoint &p) const
+{
+    QVector<double> altitudes(size());
+    evaluate(p.ra().Degrees(), p.dec().Degrees(), altitudes.data());
+    return altitudes;
+}
+
+QVector<double> AltitudeCurves::curve(const SkyObject *object) const
+{
+    if (!object->isSolarSystem())
+        return fixedCurve(*object);
+
+    QVector<double> altitudes(size());
+    evaluate(track(object), altitudes.data());
+    return altitudes;
+}
+
+QVector<QVector<double>> AltitudeCurves::curves(const QList<SkyObject *> &objects) const
+{
+    // The positions of the moving objects are computed here, the rest only reads plain data
+    QVector<Track> tracks(objects.size());
+    QVector<int> indexes(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        indexes[i] = i;
+        if (objects.at(i)->isSolarSystem())
+            tracks[i] = track(objects.at(i));
+        else
+            tracks[i] = Track { { objects.at(i)->ra().Degrees() }, { objects.at(i)->dec().Degrees() } };
+    }
+
+    QVector<QVector<double>> result(objects.size(), QVector<double>(size()));
+    QVector<double> *curve = result.data();
+
+    QtConcurrent::blockingMap(indexes, [&](const int &i)
+    {
+        if (tracks.at(i).ra.size() == 1)
+            evaluate(tracks.at(i).ra.first(), tracks.at(i).dec.first(), curve[i].data());
+        else
+            evaluate(tracks.at(i), curve[i].data());
+    });
+
+    return result;
+}
+
+AltitudeCurves::Track AltitudeCurves::track(const SkyObject *object) const
+{
+    Track track;
+    track.ra.reserve(size());
+    track.dec.reserve(size());
+
+    for (int i = 0; i < size(); ++i)
+    {
+        const KStarsDateTime ut(m_StartJD + i * m_Step);
+        const SkyPoint p = object->recomputeCoords(ut, m_Geo);
+        track.ra.append(p.ra().Degrees());
+        track.dec.append(p.dec().Degrees());
+    }
+
+    return track;
+}
+
+void AltitudeCurves::evaluate(double ra, double dec, double *altitudes) const
+{
+    const double sinDec = sin(dec * dms::DegToRad);
+    const double cosDec = cos(dec * dms::DegToRad);
+
+    // sin(alt) = sin(lat) sin(dec) + cos(lat) cos(dec) cos(LST - ra), the cosine of the difference being expanded
+    const double a       = m_SinLat * sinDec;
+    const double b       = m_CosLat * cosDec * cos(ra * dms::DegToRad);
+    const double c       = m_CosLat * cosDec * sin(ra * dms::DegToRad);
+    const double *cosLST = m_CosLST.constData();
+    const double *sinLST = m_SinLST.constData();
+    const int count      = size();
+
+    for (int i = 0; i < count; ++i)
+        altitudes[i] = a + b * cosLST[i] + c * sinLST[i];
+
+    for (int i = 0; i < count; ++i)
+        altitudes[i] = asin(qBound(-1.0, altitudes[i], 1.0)) / dms::DegToRad;
+}
+
+void AltitudeCurves::evaluate(const Track &track, double *altitudes) const
+{
+    const int count = size();
+    for (int i = 0; i < count; ++i)
+    {
+        const double ra  = track.ra.at(i);
+        const double dec = track.dec.at(i);
+
+        const double sinAlt = m_SinLat * sin(dec * dms::DegToRad) +
+                              m_CosLat * cos(dec * dms::DegToRad) * cos((m_LST.at(i) - ra) * dms::DegToRad);
+        altitudes[i] = asin(qBound(-1.0, sinAlt, 1.0)) / dms::DegToRad;
+    }
+}
@@ -0,0 +1,84 @@
+/*  Altitude curves of many objects over a time grid
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QList>
+#include <QVector>
+
+class GeoLocation;
+class KStarsDateTime;
+class SkyObject;
+class SkyPoint;
+
+/**
+ * @class AltitudeCurves
+ * @short Computes the altitude of objects at regularly spaced times.
+ *
+ * The local sidereal time of every point of the grid is computed once, with its sine and
+ * cosine, so that the altitude of a fixed object only takes a few multiplications and an
+ * arcsine per point.  These loops run over plain arrays and are vectorized by the compiler.
+ *
+ * Solar system objects move on the sky during the day: their positions are computed on
+ * clones at every point, the major bodies being read from the EphemerisCache.  This is done
+ * from the calling thread, as it may use the sky composite; the curves are then evaluated
+ * in parallel.
+ */
+class AltitudeCurves
+{
+  public:
+    /**
+     * @param geo the observer location
+     * @param start the time of the first point, UT
+     * @param step the time between two points, in hours
+     * @param count the number of points
+     */
+    AltitudeCurves(const GeoLocation *geo, const KStarsDateTime &start, double step, int count);
+
+    /** @return the number of points of the curves */
+    int size() const { return m_CosLST.size(); }
+
+    /** @return the altitudes in degrees of a point fixed on the sky, with its current coordinates */
+    QVector<double> fixedCurve(const SkyPoint &p) const;
+
+    /** @return the altitudes in degrees of an object, solar system objects being moved along the grid */
+    QVector<double> curve(const SkyObject *object) const;
+
+    /** @return the altitude curves of objects, in the same order */
+    QVector<QVector<double>> curves(const QList<SkyObject *> &objects) const;
+
+  private:
+    /** @short Positions of a moving object at the points, in degrees */
+    struct Track
+    {
+        QVector<double> ra;
+        QVector<double> dec;
+    };
+
+    /** @return the positions of a solar system object at the points of the grid */
+    Track track(const SkyObject *object) const;
+
+    /** @short Fill altitudes with the curve of a point fixed at ra and dec in degrees */
+    void evaluate(double ra, double dec, double *altitudes) const;
+
+    /** @short Fill altitudes with the curve of a moving object */
+    void evaluate(const Track &track, double *altitudes) const;
+
+    const GeoLocation *m_Geo { nullptr };
+    double m_StartJD { 0 };
+    /// Time between two points, in days
+    double m_Step { 0 };
+    double m_SinLat { 0 };
+    double m_CosLat { 1 };
+    QVector<double> m_CosLST;
+    QVector<double> m_SinLST;
+    /// Sidereal times of the points, in degrees
+    QVector<double> m_LST;
+};
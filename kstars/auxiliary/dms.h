@@ -378,6 +378,11 @@ class dms
          */
     static constexpr double DegToRad = { M_PI / 180.0 };
 
+    /** SiderealRate is the change of the hour angle of a fixed point on the sky
+         * in one day of Universal Time, in degrees.
+         */
+    static constexpr double SiderealRate = { 360.98564736629 };
+
     /** @short Static function to create a DMS object from a QString.
          *
          * There are several ways to specify the angle:
@@ -175,7 +175,7 @@ void GeoLocation::TopocentricVelocity(double vtopo[], const dms &gst)
     vtopo[2] = 0.;
 }
 
-double GeoLocation::LMST(double jd)
+double GeoLocation::LMST(double jd) const
 {
     int divresult;
     double ut, tu, gmst, theta;
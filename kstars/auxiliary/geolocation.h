@@ -266,7 +266,7 @@ class GeoLocation
     /** @Return Local Mean Sidereal Time.
          * @param jd Julian date
          */
-    double LMST(double jd);
+    double LMST(double jd) const;
 
     bool isReadOnly() const;
     void setReadOnly(bool value);
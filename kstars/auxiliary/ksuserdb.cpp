@@ -29,6 +29,47 @@
 
 #include <kstars_debug.h>
 
+namespace
+{
+/** @short Run query with the values bound to its positional placeholders, in the writer thread */
+bool execute(QSqlQuery &query, const QVariantList &values)
+{
+    for (int i = 0; i < values.size(); ++i)
+        query.bindValue(i, values.at(i));
+    const bool success = query.exec();
+    if (!success)
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError();
+    query.finish();
+    return success;
+}
+
+/**
+ * @short Insert a row of table in the writer thread
+ * Like QSqlTableModel::insertRecord(), the values of columns table does not have are
+ * ignored, as well as those of the generated columns.
+ */
+bool insertRecord(KSUserDBWriter &writer, const QString &table, const QVariantMap &values,
+                  const QStringList &generated = QStringList())
+{
+    const QSqlRecord record = writer.database().record(table);
+
+    QStringList columns, placeholders;
+    QVariantList bound;
+    for (QVariantMap::const_iterator iter = values.begin(); iter != values.end(); ++iter)
+    {
+        if (!record.contains(iter.key()) || generated.contains(iter.key()))
+            continue;
+        columns.append(iter.key());
+        placeholders.append("?");
+        bound.append(iter.value());
+    }
+
+    return execute(writer.query(QString("INSERT INTO %1 (%2) VALUES (%3)")
+                                    .arg(table, columns.join(", "), placeholders.join(", "))),
+                   bound);
+}
+}
+
 /*
  * TODO (spacetime):
  * The database supports storing logs. But it needs to be implemented.
@@ -39,7 +80,9 @@
 
 KSUserDB::~KSUserDB()
 {
-    userdb_.close();
+    // Writes the pending tasks
+    writer_.reset();
+    statements_.clear();
 }
 
 bool KSUserDB::Initialize()
@@ -64,6 +107,18 @@ bool KSUserDB::Initialize()
     else
     {
         qCDebug(KSTARS) << "Opened the User DB. Ready.";
+
+        // Readers do not block the writer in WAL mode, and the commits do not wait for the disk.
+        // The log is checkpointed by the connection whose commit makes it grow past 1000 pages,
+        // mostly the one of the writer thread.
+        QSqlQuery pragma(userdb_);
+        for (const QString &statement : { "PRAGMA journal_mode=WAL", "PRAGMA synchronous=NORMAL" })
+        {
+            if (!pragma.exec(statement))
+                qCWarning(KSTARS) << pragma.lastError();
+        }
+        pragma.finish();
+
         if (first_run == true)
             FirstRun();
         else
@@ -296,10 +351,40 @@ bool KSUserDB::Initialize()
             }
         }
     }
-    userdb_.close();
+
+    // The connection stays open, the writer opens its own
+    writer_.reset(new KSUserDBWriter(dbfile));
+    writer_->start();
     return true;
 }
 
+void KSUserDB::Flush()
+{
+    if (writer_)
+        writer_->flush();
+}
+
+void KSUserDB::Enqueue(const KSUserDBWriter::Task &task)
+{
+    if (writer_)
+        writer_->enqueue(task);
+    else
+        qCWarning(KSTARS) << "User database is not initialized, write dropped.";
+}
+
+QSqlQuery &KSUserDB::Prepared(const QString &statement)
+{
+    auto query = statements_.find(statement);
+    if (query == statements_.end())
+    {
+        query = statements_.insert(statement, QSqlQuery(userdb_));
+        query->setForwardOnly(true);
+        if (!query->prepare(statement))
+            qCWarning(KSTARS) << query->lastError();
+    }
+    return *query;
+}
+
 QSqlError KSUserDB::LastError()
 {
     // error description is in QSqlError::text()
@@ -493,7 +578,7 @@ bool KSUserDB::RebuildDB()
 */
 void KSUserDB::AddObserver(const QString &name, const QString &surname, const QString &contact)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel users(nullptr, userdb_);
     users.setTable("user");
     users.setFilter("Name LIKE \'" + name + "\' AND Surname LIKE \'" + surname + "\'");
@@ -517,13 +602,11 @@ void KSUserDB::AddObserver(const QString &name, const QString &surname, const QS
         users.setData(users.index(row, 3), contact);
         users.submitAll();
     }
-
-    userdb_.close();
 }
 
 bool KSUserDB::FindObserver(const QString &name, const QString &surname)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel users(nullptr, userdb_);
     users.setTable("user");
     users.setFilter("Name LIKE \'" + name + "\' AND Surname LIKE \'" + surname + "\'");
@@ -532,14 +615,13 @@ bool KSUserDB::FindObserver(const QString &name, const QString &surname)
     int observer_count = users.rowCount();
 
     users.clear();
-    userdb_.close();
     return (observer_count > 0);
 }
 
 // TODO(spacetime): This method is currently unused.
 bool KSUserDB::DeleteObserver(const QString &id)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel users(nullptr, userdb_);
     users.setTable("user");
     users.setFilter("id = \'" + id + "\'");
@@ -551,18 +633,17 @@ bool KSUserDB::DeleteObserver(const QString &id)
     int observer_count = users.rowCount();
 
     users.clear();
-    userdb_.close();
     return (observer_count > 0);
 }
 QSqlDatabase KSUserDB::GetDatabase()
 {
-    userdb_.open();
+    Flush();
     return userdb_;
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
 {
-    userdb_.open();
+    Flush();
     observer_list.clear();
     QSqlTableModel users(nullptr, userdb_);
     users.setTable("user");
@@ -580,7 +661,6 @@ void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
     }
 
     users.clear();
-    userdb_.close();
 }
 #endif
 
@@ -588,65 +668,37 @@ void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
 
 void KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
 {
-    userdb_.open();
-    QSqlTableModel darkframe(nullptr, userdb_);
-    darkframe.setTable("darkframe");
-    darkframe.select();
-
-    QSqlRecord record = darkframe.record();
-
-    // Remove PK so that it gets auto-incremented later
-    record.remove(0);
-    // Remove timestamp so that it gets auto-generated
-    record.remove(7);
-
-    for (QVariantMap::const_iterator iter = oneFrame.begin(); iter != oneFrame.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    darkframe.insertRecord(-1, record);
-
-    darkframe.submitAll();
-
-    userdb_.close();
+    // The id and the timestamp are generated by the database
+    Enqueue([oneFrame](KSUserDBWriter &writer)
+            { return insertRecord(writer, "darkframe", oneFrame, QStringList() << "id" << "timestamp"); });
 }
 
-bool KSUserDB::DeleteDarkFrame(const QString &filename)
+void KSUserDB::DeleteDarkFrame(const QString &filename)
 {
-    userdb_.open();
-    QSqlTableModel darkframe(nullptr, userdb_);
-    darkframe.setTable("darkframe");
-    darkframe.setFilter("filename = \'" + filename + "\'");
-
-    darkframe.select();
-
-    darkframe.removeRows(0, 1);
-    darkframe.submitAll();
-
-    userdb_.close();
-
-    return true;
+    Enqueue(
+        [filename](KSUserDBWriter &writer)
+        { return execute(writer.query("DELETE FROM darkframe WHERE filename = ?"), QVariantList() << filename); });
 }
 
 void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 {
     darkFrames.clear();
 
-    userdb_.open();
-    QSqlTableModel darkframe(nullptr, userdb_);
-    darkframe.setTable("darkframe");
-    darkframe.select();
+    Flush();
+    QSqlQuery &darkframe = Prepared("SELECT * FROM darkframe");
+    if (!darkframe.exec())
+        qCWarning(KSTARS) << darkframe.lastError();
 
-    for (int i = 0; i < darkframe.rowCount(); ++i)
+    while (darkframe.next())
     {
         QVariantMap recordMap;
-        QSqlRecord record = darkframe.record(i);
+        QSqlRecord record = darkframe.record();
         for (int j = 1; j < record.count(); j++)
             recordMap[record.fieldName(j)] = record.value(j);
 
         darkFrames.append(recordMap);
     }
-
-    userdb_.close();
+    darkframe.finish();
 }
 
 
@@ -654,60 +706,38 @@ void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 
 void KSUserDB::AddHIPSSource(const QMap<QString,QString> &oneSource)
 {
-    userdb_.open();
-    QSqlTableModel HIPSSource(nullptr, userdb_);
-    HIPSSource.setTable("hips");
-    HIPSSource.select();
-
-    QSqlRecord record = HIPSSource.record();
-
+    QVariantMap values;
     for (QMap<QString,QString>::const_iterator iter = oneSource.begin(); iter != oneSource.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    HIPSSource.insertRecord(-1, record);
-
-    HIPSSource.submitAll();
+        values[iter.key()] = iter.value();
 
-    userdb_.close();
+    Enqueue([values](KSUserDBWriter &writer) { return insertRecord(writer, "hips", values); });
 }
 
-bool KSUserDB::DeleteHIPSSource(const QString &ID)
+void KSUserDB::DeleteHIPSSource(const QString &ID)
 {
-    userdb_.open();
-    QSqlTableModel HIPSSource(nullptr, userdb_);
-    HIPSSource.setTable("hips");
-    HIPSSource.setFilter("ID = \'" + ID + "\'");
-
-    HIPSSource.select();
-
-    HIPSSource.removeRows(0, 1);
-    HIPSSource.submitAll();
-
-    userdb_.close();
-
-    return true;
+    Enqueue([ID](KSUserDBWriter &writer)
+                   { return execute(writer.query("DELETE FROM hips WHERE ID = ?"), QVariantList() << ID); });
 }
 
 void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 {
     HIPSSources.clear();
 
-    userdb_.open();
-    QSqlTableModel HIPSSource(nullptr, userdb_);
-    HIPSSource.setTable("hips");
-    HIPSSource.select();
+    Flush();
+    QSqlQuery &HIPSSource = Prepared("SELECT * FROM hips");
+    if (!HIPSSource.exec())
+        qCWarning(KSTARS) << HIPSSource.lastError();
 
-    for (int i = 0; i < HIPSSource.rowCount(); ++i)
+    while (HIPSSource.next())
     {
         QMap<QString,QString> recordMap;
-        QSqlRecord record = HIPSSource.record(i);
+        QSqlRecord record = HIPSSource.record();
         for (int j = 1; j < record.count(); j++)
             recordMap[record.fieldName(j)] = record.value(j).toString();
 
         HIPSSources.append(recordMap);
     }
-
-    userdb_.close();
+    HIPSSource.finish();
 }
 
 
@@ -715,60 +745,34 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 
 void KSUserDB::AddDSLRInfo(const QMap<QString,QVariant> &oneInfo)
 {
-    userdb_.open();
-    QSqlTableModel DSLRInfo(nullptr, userdb_);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.select();
-
-    QSqlRecord record = DSLRInfo.record();
-
-    for (QMap<QString,QVariant>::const_iterator iter = oneInfo.begin(); iter != oneInfo.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    DSLRInfo.insertRecord(-1, record);
-
-    DSLRInfo.submitAll();
-
-    userdb_.close();
+    Enqueue([oneInfo](KSUserDBWriter &writer) { return insertRecord(writer, "dslr", oneInfo); });
 }
 
-bool KSUserDB::DeleteDSLRInfo(const QString &model)
+void KSUserDB::DeleteDSLRInfo(const QString &model)
 {
-    userdb_.open();
-    QSqlTableModel DSLRInfo(nullptr, userdb_);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.setFilter("model = \'" + model + "\'");
-
-    DSLRInfo.select();
-
-    DSLRInfo.removeRows(0, 1);
-    DSLRInfo.submitAll();
-
-    userdb_.close();
-
-    return true;
+    Enqueue([model](KSUserDBWriter &writer)
+                   { return execute(writer.query("DELETE FROM dslr WHERE model = ?"), QVariantList() << model); });
 }
 
 void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 {
     DSLRInfos.clear();
 
-    userdb_.open();
-    QSqlTableModel DSLRInfo(nullptr, userdb_);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.select();
+    Flush();
+    QSqlQuery &DSLRInfo = Prepared("SELECT * FROM dslr");
+    if (!DSLRInfo.exec())
+        qCWarning(KSTARS) << DSLRInfo.lastError();
 
-    for (int i = 0; i < DSLRInfo.rowCount(); ++i)
+    while (DSLRInfo.next())
     {
         QMap<QString,QVariant> recordMap;
-        QSqlRecord record = DSLRInfo.record(i);
+        QSqlRecord record = DSLRInfo.record();
         for (int j = 1; j < record.count(); j++)
             recordMap[record.fieldName(j)] = record.value(j);
 
         DSLRInfos.append(recordMap);
     }
-
-    userdb_.close();
+    DSLRInfo.finish();
 }
 
 /*
@@ -777,71 +781,48 @@ void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 
 void KSUserDB::DeleteAllFlags()
 {
-    userdb_.open();
-    QSqlTableModel flags(nullptr, userdb_);
-    flags.setEditStrategy(QSqlTableModel::OnManualSubmit);
-    flags.setTable("flags");
-    flags.select();
-
-    flags.removeRows(0, flags.rowCount());
-    flags.submitAll();
-
-    flags.clear();
-    userdb_.close();
+    Enqueue([](KSUserDBWriter &writer) { return execute(writer.query("DELETE FROM flags"), QVariantList()); });
 }
 
 void KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epoch, const QString &image_name,
                        const QString &label, const QString &labelColor)
 {
-    userdb_.open();
-    QSqlTableModel flags(nullptr, userdb_);
-    flags.setTable("flags");
+    QVariantList values;
+    values << ra << dec << image_name << label << labelColor << epoch;
 
-    int row = 0;
-    flags.insertRows(row, 1);
-    flags.setData(flags.index(row, 1), ra); // row,0 is autoincerement ID
-    flags.setData(flags.index(row, 2), dec);
-    flags.setData(flags.index(row, 3), image_name);
-    flags.setData(flags.index(row, 4), label);
-    flags.setData(flags.index(row, 5), labelColor);
-    flags.setData(flags.index(row, 6), epoch);
-    flags.submitAll();
-
-    flags.clear();
-    userdb_.close();
+    Enqueue([values](KSUserDBWriter &writer)
+            {
+                return execute(
+                    writer.query("INSERT INTO flags (RA, Dec, Icon, Label, Color, Epoch) VALUES (?, ?, ?, ?, ?, ?)"),
+                    values);
+            });
 }
 
 QList<QStringList> KSUserDB::GetAllFlags()
 {
     QList<QStringList> flagList;
 
-    userdb_.open();
-    QSqlTableModel flags(nullptr, userdb_);
-    flags.setTable("flags");
-    flags.select();
+    Flush();
+    /* flagEntry order description
+     * The variation in the order is due to variation
+     * in flag entry description order and flag database
+     * description order.
+     * flag (database): ra, dec, icon, label, color, epoch
+     * flag (object):  ra, dec, epoch, icon, label, color
+    */
+    QSqlQuery &flags = Prepared("SELECT RA, Dec, Epoch, Icon, Label, Color FROM flags ORDER BY id");
+    if (!flags.exec())
+        qCWarning(KSTARS) << flags.lastError();
 
-    for (int i = 0; i < flags.rowCount(); ++i)
+    while (flags.next())
     {
         QStringList flagEntry;
-        QSqlRecord record = flags.record(i);
-        /* flagEntry order description
-         * The variation in the order is due to variation
-         * in flag entry description order and flag database
-         * description order.
-         * flag (database): ra, dec, icon, label, color, epoch
-         * flag (object):  ra, dec, epoch, icon, label, color
-        */
-        flagEntry.append(record.value(1).toString());
-        flagEntry.append(record.value(2).toString());
-        flagEntry.append(record.value(6).toString());
-        flagEntry.append(record.value(3).toString());
-        flagEntry.append(record.value(4).toString());
-        flagEntry.append(record.value(5).toString());
+        for (int i = 0; i < 6; ++i)
+            flagEntry.append(flags.value(i).toString());
         flagList.append(flagEntry);
     }
+    flags.finish();
 
-    flags.clear();
-    userdb_.close();
     return flagList;
 }
 
@@ -850,7 +831,7 @@ QList<QStringList> KSUserDB::GetAllFlags()
  */
 void KSUserDB::DeleteEquipment(const QString &type, const int &id)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable(type);
     equip.setFilter("id = " + QString::number(id));
@@ -860,12 +841,11 @@ void KSUserDB::DeleteEquipment(const QString &type, const int &id)
     equip.submitAll();
 
     equip.clear();
-    userdb_.close();
 }
 
 void KSUserDB::DeleteAllEquipment(const QString &type)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setEditStrategy(QSqlTableModel::OnManualSubmit);
     equip.setTable(type);
@@ -875,7 +855,6 @@ void KSUserDB::DeleteAllEquipment(const QString &type)
     equip.submitAll();
 
     equip.clear();
-    userdb_.close();
 }
 
 /*
@@ -884,7 +863,7 @@ void KSUserDB::DeleteAllEquipment(const QString &type)
 void KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &driver, const QString &type,
                         const double &focalLength, const double &aperture)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("telescope");
 
@@ -899,13 +878,12 @@ void KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
     equip.submitAll();
 
     equip.clear(); //DB will not close if linked object not cleared
-    userdb_.close();
 }
 
 void KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &driver, const QString &type,
                         const double &focalLength, const double &aperture, const QString &id)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("telescope");
     equip.setFilter("id = " + id);
@@ -923,15 +901,13 @@ void KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    userdb_.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 {
     scope_list.clear();
 
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("telescope");
     equip.select();
@@ -952,7 +928,6 @@ void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
     }
 
     equip.clear();
-    userdb_.close();
 }
 #endif
 /*
@@ -961,7 +936,7 @@ void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("eyepiece");
 
@@ -975,13 +950,12 @@ void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
     equip.submitAll();
 
     equip.clear();
-    userdb_.close();
 }
 
 void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit, const QString &id)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("eyepiece");
     equip.setFilter("id = " + id);
@@ -998,15 +972,13 @@ void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    userdb_.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
 {
     eyepiece_list.clear();
 
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("eyepiece");
     equip.select();
@@ -1026,7 +998,6 @@ void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
     }
 
     equip.clear();
-    userdb_.close();
 }
 #endif
 /*
@@ -1034,7 +1005,7 @@ void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
  */
 void KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("lens");
 
@@ -1046,12 +1017,11 @@ void KSUserDB::AddLens(const QString &vendor, const QString &model, const double
     equip.submitAll();
 
     equip.clear();
-    userdb_.close();
 }
 
 void KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor, const QString &id)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("lens");
     equip.setFilter("id = " + id);
@@ -1065,15 +1035,13 @@ void KSUserDB::AddLens(const QString &vendor, const QString &model, const double
         record.setValue(3, factor);
         equip.submitAll();
     }
-
-    userdb_.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 {
     lens_list.clear();
 
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("lens");
     equip.select();
@@ -1090,7 +1058,6 @@ void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
     }
 
     equip.clear();
-    userdb_.close();
 }
 #endif
 /*
@@ -1099,7 +1066,7 @@ void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QString &type, const QString &color,
                          int offset, double exposure, bool useAutoFocus, const QString &lockedFilter)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("filter");
 
@@ -1132,13 +1099,12 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
         qCritical() << "AddFilter:" << equip.lastError();
 
     equip.clear();
-    userdb_.close();
 }
 
 void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QString &type, const QString &color,
                          int offset, double exposure, bool useAutoFocus, const QString &lockedFilter, const QString &id)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("filter");
     equip.setFilter("id = " + id);
@@ -1159,13 +1125,11 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
         if (equip.submitAll() == false)
             qCritical() << "AddFilter:" << equip.lastError();
     }
-
-    userdb_.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
 {
-    userdb_.open();
+    Flush();
     filter_list.clear();
     QSqlTableModel equip(nullptr, userdb_);
     equip.setTable("filter");
@@ -1188,7 +1152,6 @@ void KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
     }
 
     equip.clear();
-    userdb_.close();
     return;
 }
 #endif
@@ -1589,7 +1552,7 @@ QList<ArtificialHorizonEntity *> KSUserDB::GetAllHorizons()
 {
     QList<ArtificialHorizonEntity *> horizonList;
 
-    userdb_.open();
+    Flush();
     QSqlTableModel regions(nullptr, userdb_);
     regions.setTable("horizons");
     regions.select();
@@ -1631,13 +1594,12 @@ QList<ArtificialHorizonEntity *> KSUserDB::GetAllHorizons()
     }
 
     regions.clear();
-    userdb_.close();
     return horizonList;
 }
 
 void KSUserDB::DeleteAllHorizons()
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel regions(nullptr, userdb_);
     regions.setEditStrategy(QSqlTableModel::OnManualSubmit);
     regions.setTable("horizons");
@@ -1657,12 +1619,11 @@ void KSUserDB::DeleteAllHorizons()
     regions.submitAll();
 
     regions.clear();
-    userdb_.close();
 }
 
 void KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel regions(nullptr, userdb_);
     regions.setTable("horizons");
 
@@ -1697,13 +1658,11 @@ void KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
 
     points.submitAll();
     points.clear();
-
-    userdb_.close();
 }
 
 int KSUserDB::AddProfile(const QString &name)
 {
-    userdb_.open();
+    Flush();
     int id = -1;
 
     QSqlQuery query(userdb_);
@@ -1714,14 +1673,12 @@ int KSUserDB::AddProfile(const QString &name)
     else
         id = query.lastInsertId().toInt();
 
-    userdb_.close();
-
     return id;
 }
 
 bool KSUserDB::DeleteProfile(ProfileInfo *pi)
 {
-    userdb_.open();
+    Flush();
 
     QSqlQuery query(userdb_);
     bool rc;
@@ -1731,8 +1688,6 @@ bool KSUserDB::DeleteProfile(ProfileInfo *pi)
     if (rc == false)
         qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
-    userdb_.close();
-
     return rc;
 }
 
@@ -1741,7 +1696,7 @@ void KSUserDB::SaveProfile(ProfileInfo *pi)
     // Remove all drivers
     DeleteProfileDrivers(pi);
 
-    userdb_.open();
+    Flush();
     QSqlQuery query(userdb_);
 
     // Clear data
@@ -1820,12 +1775,11 @@ void KSUserDB::SaveProfile(ProfileInfo *pi)
     /*if (pi->customDrivers.isEmpty() == false && !query.exec(QString("INSERT INTO custom_driver (drivers, profile) VALUES('%1',%2)").arg(pi->customDrivers).arg(pi->id)))
         qDebug()  << query.lastQuery() << query.lastError().text();*/
 
-    userdb_.close();
 }
 
 void KSUserDB::GetAllProfiles(QList<std::shared_ptr<ProfileInfo>> &profiles)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel profile(nullptr, userdb_);
     profile.setTable("profile");
     profile.select();
@@ -1867,12 +1821,11 @@ void KSUserDB::GetAllProfiles(QList<std::shared_ptr<ProfileInfo>> &profiles)
     }
 
     profile.clear();
-    userdb_.close();
 }
 
 void KSUserDB::GetProfileDrivers(ProfileInfo *pi)
 {
-    userdb_.open();
+    Flush();
 
     QSqlTableModel driver(nullptr, userdb_);
     driver.setTable("driver");
@@ -1890,12 +1843,11 @@ void KSUserDB::GetProfileDrivers(ProfileInfo *pi)
     }
 
     driver.clear();
-    userdb_.close();
 }
 
 /*void KSUserDB::GetProfileCustomDrivers(ProfileInfo* pi)
 {
-    userdb_.open();
+    Flush();
     QSqlTableModel custom_driver(0, userdb_);
     custom_driver.setTable("driver");
     custom_driver.setFilter("profile=" + QString::number(pi->id));
@@ -1906,12 +1858,11 @@ void KSUserDB::GetProfileDrivers(ProfileInfo *pi)
     pi->customDrivers   = record.value("drivers").toString();
 
     custom_driver.clear();
-    userdb_.close();
 }*/
 
 void KSUserDB::DeleteProfileDrivers(ProfileInfo *pi)
 {
-    userdb_.open();
+    Flush();
 
     QSqlQuery query(userdb_);
 
@@ -1920,6 +1871,4 @@ void KSUserDB::DeleteProfileDrivers(ProfileInfo *pi)
 
     if (!query.exec("DELETE FROM driver WHERE profile=" + QString::number(pi->id)))
         qCWarning(KSTARS) << query.executedQuery() << query.lastError().text();
-
-    userdb_.close();
 }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "auxiliary/profileinfo.h"
+#include "auxiliary/ksuserdbwriter.h"
 #ifndef KSTARS_LITE
 #include "oal/oal.h"
 #endif
@@ -38,6 +39,12 @@ class ArtificialHorizonEntity;
 /**
  * @brief Single class to delegate all User database I/O
  *
+ * The "userdb" connection stays open from Initialize() on, in WAL mode.  Reads run
+ * on it with statements prepared once.  The frequent writes, e.g. of the dark library
+ * and the flags, are queued to a KSUserDBWriter and committed in batches by its worker
+ * thread; every other accessor waits for the queued writes first.  The worker thread
+ * logs the queued writes which failed.
+ *
  * usage: Call QSqlDatabase::removeDatabase("userdb"); after the object
  * of this class is deallocated
  * @author Rishab Arora
@@ -56,6 +63,7 @@ class KSUserDB
      */
     bool Initialize();
 
+    /** @return the open connection, once the queued writes are committed */
     QSqlDatabase GetDatabase();
 
     /************************************************************************
@@ -79,7 +87,7 @@ class KSUserDB
      ************************************************************************/
 
     void AddDarkFrame(const QVariantMap &oneFrame);
-    bool DeleteDarkFrame(const QString &filename);
+    void DeleteDarkFrame(const QString &filename);
     void GetAllDarkFrames(QList<QVariantMap> &darkFrames);
 
     /************************************************************************
@@ -87,7 +95,7 @@ class KSUserDB
      ************************************************************************/
 
     void AddHIPSSource(const QMap<QString, QString> &oneSource);
-    bool DeleteHIPSSource(const QString &ID);
+    void DeleteHIPSSource(const QString &ID);
     void GetAllHIPSSources(QList<QMap<QString,QString>> &HIPSSources);
 
     /************************************************************************
@@ -95,7 +103,7 @@ class KSUserDB
      ************************************************************************/
 
     void AddDSLRInfo(const QMap<QString, QVariant> &oneInfo);
-    bool DeleteDSLRInfo(const QString &model);
+    void DeleteDSLRInfo(const QString &model);
     void GetAllDSLRInfos(QList<QMap<QString,QVariant>> &DSLRInfos);
 
     /************************************************************************
@@ -355,8 +363,21 @@ class KSUserDB
      **/
     inline QSqlError LastError();
 
+    /** @brief Wait until the writes queued to writer_ are committed **/
+    void Flush();
+
+    /** @brief Queue a write to the worker thread, which logs it if it fails **/
+    void Enqueue(const KSUserDBWriter::Task &task);
+
+    /** @brief Returns the statement prepared once on userdb_ **/
+    QSqlQuery &Prepared(const QString &statement);
+
     /** Linked to the user database _once_. **/
     QSqlDatabase userdb_;
+    /** Statements of Prepared(), by SQL text **/
+    QHash<QString, QSqlQuery> statements_;
+    /** Worker thread of the queued writes **/
+    std::unique_ptr<KSUserDBWriter> writer_;
     /** XML reader for importing old formats **/
     QXmlStreamReader *reader_ { nullptr };
 };
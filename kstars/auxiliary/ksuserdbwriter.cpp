@@ -0,0 +1,122 @@
+/*  Background writes of the user database
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "ksuserdbwriter.h"
+
+#include <QSqlError>
+
+#include <kstars_debug.h>
+
+namespace
+{
+const char *CONNECTION_NAME = "userdb_writer";
+}
+
+KSUserDBWriter::KSUserDBWriter(const QString &filename) : m_Filename(filename)
+{
+}
+
+KSUserDBWriter::~KSUserDBWriter()
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Stopping = true;
+        m_Queued.wakeAll();
+    }
+    wait();
+
+    // Only left if the thread never ran
+    if (!m_Tasks.isEmpty())
+        qCWarning(KSTARS) << m_Tasks.size() << "user database writes dropped.";
+}
+
+void KSUserDBWriter::enqueue(const Task &task)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Tasks.append(task);
+    m_Queued.wakeAll();
+}
+
+void KSUserDBWriter::flush()
+{
+    QMutexLocker locker(&m_Mutex);
+    if (!isRunning())
+        return;
+    while (!m_Tasks.isEmpty() || m_Writing)
+        m_Written.wait(&m_Mutex);
+}
+
+QSqlQuery &KSUserDBWriter::query(const QString &statement)
+{
+    auto query = m_Statements.find(statement);
+    if (query == m_Statements.end())
+    {
+        query = m_Statements.insert(statement, QSqlQuery(m_Database));
+        if (!query->prepare(statement))
+            qCWarning(KSTARS) << query->lastError();
+    }
+    return *query;
+}
+
+void KSUserDBWriter::run()
+{
+    {
+        m_Database = QSqlDatabase::addDatabase("QSQLITE", CONNECTION_NAME);
+        m_Database.setDatabaseName(m_Filename);
+        if (m_Database.open())
+        {
+            // Commits in WAL mode only append to the log, which is checkpointed past 1000 pages
+            QSqlQuery pragma(m_Database);
+            if (!pragma.exec("PRAGMA synchronous=NORMAL"))
+                qCWarning(KSTARS) << pragma.lastError();
+        }
+        else
+        {
+            qCWarning(KSTARS) << "Unable to open user database file for writing." << m_Database.lastError();
+        }
+
+        QMutexLocker locker(&m_Mutex);
+        forever
+        {
+            while (m_Tasks.isEmpty() && !m_Stopping)
+                m_Queued.wait(&m_Mutex);
+            if (m_Tasks.isEmpty())
+                break;
+
+            QList<Task> tasks;
+            tasks.swap(m_Tasks);
+            m_Writing = true;
+            locker.unlock();
+
+            // The tasks log their own errors, the count tells which batch they belong to
+            int failed = 0;
+            m_Database.transaction();
+            for (const Task &task : tasks)
+            {
+                if (!task(*this))
+                    ++failed;
+            }
+            if (failed > 0)
+                qCWarning(KSTARS) << failed << "of" << tasks.size() << "user database writes failed.";
+            if (!m_Database.commit())
+                qCWarning(KSTARS) << "Unable to commit" << tasks.size() << "user database writes."
+                                  << m_Database.lastError();
+
+            locker.relock();
+            m_Writing = false;
+            m_Written.wakeAll();
+        }
+
+        m_Statements.clear();
+        m_Database.close();
+        m_Database = QSqlDatabase();
+    }
+    QSqlDatabase::removeDatabase(CONNECTION_NAME);
+}
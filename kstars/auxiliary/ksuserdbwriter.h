@@ -0,0 +1,74 @@
+/*  Background writes of the user database
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <functional>
+
+/**
+ * @class KSUserDBWriter
+ * @short Applies the writes of KSUserDB in a worker thread, so that the GUI never waits for the disk.
+ *
+ * Each write is a task run in the worker thread on a connection of its own.  The tasks
+ * queued while the previous ones were written are run together in a single transaction,
+ * so e.g. saving all flags is one commit.  The database is in WAL mode, so the readers
+ * on the GUI connection are not blocked meanwhile; KSUserDB calls flush() before reading
+ * for the reads to see the writes queued before them.
+ *
+ * The caller cannot know whether a task succeeded when queueing it, so the failed tasks
+ * are logged by the worker thread.
+ */
+class KSUserDBWriter : public QThread
+{
+  public:
+    /** @short A write, run in the worker thread, returning false if it failed */
+    typedef std::function<bool(KSUserDBWriter &writer)> Task;
+
+    /** @param filename the database file, already created */
+    explicit KSUserDBWriter(const QString &filename);
+
+    /** @short Writes the pending tasks and stops the thread */
+    ~KSUserDBWriter() override;
+
+    /** @short Queue task, it runs after all tasks queued before */
+    void enqueue(const Task &task);
+
+    /** @short Wait until all queued tasks are committed */
+    void flush();
+
+    /** @return the connection of the worker thread, for the tasks only */
+    QSqlDatabase &database() { return m_Database; }
+
+    /** @return statement prepared once on the connection of the worker thread, for the tasks only */
+    QSqlQuery &query(const QString &statement);
+
+  protected:
+    void run() override;
+
+  private:
+    QString m_Filename;
+    QSqlDatabase m_Database;
+    QHash<QString, QSqlQuery> m_Statements;
+
+    QList<Task> m_Tasks;
+    bool m_Writing { false };
+    bool m_Stopping { false };
+    QMutex m_Mutex;
+    QWaitCondition m_Queued;
+    QWaitCondition m_Written;
+};
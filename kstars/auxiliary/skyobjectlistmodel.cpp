@@ -79,3 +79,13 @@ void SkyObjectListModel::setSkyObjectsList(QVector<QPair<QString, const SkyObjec
     skyObjects = sObjects;
     endResetModel();
 }
+
+void SkyObjectListModel::appendSkyObjects(const QVector<QPair<QString, const SkyObject *>> &sObjects)
+{
+    if (sObjects.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), skyObjects.size(), skyObjects.size() + sObjects.size() - 1);
+    skyObjects += sObjects;
+    endInsertRows();
+}
@@ -61,6 +61,9 @@ class SkyObjectListModel : public QAbstractListModel
 
     void setSkyObjectsList(QVector<QPair<QString, const SkyObject *>> sObjects);
 
+    /** @short Add objects at the end of the list, used to show search results as they arrive */
+    void appendSkyObjects(const QVector<QPair<QString, const SkyObject *>> &sObjects);
+
   private:
     QVector<QPair<QString, const SkyObject *>> skyObjects;
 };
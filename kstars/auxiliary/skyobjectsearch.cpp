@@ -0,0 +1,287 @@
+/*  Name search engine for the Find dialog
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "skyobjectsearch.h"
+
+#include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+/// Number of results delivered at once by resultsReady()
+const int BATCH_SIZE = 2000;
+
+/// How often a search checks whether it was cancelled
+const int CANCEL_CHECK_MASK = 0xfff;
+
+quint64 trigram(const QString &key, int i)
+{
+    return (quint64(key.at(i).unicode()) << 32) | (quint64(key.at(i + 1).unicode()) << 16) | key.at(i + 2).unicode();
+}
+
+/**
+ * @return the sorted positions of the keys containing all trigrams of key, a superset
+ * of the keys containing key itself
+ */
+QVector<int> trigramCandidates(const QHash<quint64, QVector<int>> &grams, const QString &key)
+{
+    QVector<const QVector<int> *> lists;
+    for (int i = 0; i + 3 <= key.size(); ++i)
+    {
+        QHash<quint64, QVector<int>>::const_iterator it = grams.constFind(trigram(key, i));
+        if (it == grams.constEnd())
+            return QVector<int>();
+        lists.append(&it.value());
+    }
+
+    // Intersect starting from the shortest list
+    std::sort(lists.begin(), lists.end(),
+              [](const QVector<int> *a, const QVector<int> *b) { return a->size() < b->size(); });
+
+    QVector<int> result = *lists.first();
+    for (int i = 1; i < lists.size() && !result.isEmpty(); ++i)
+    {
+        QVector<int> next;
+        std::set_intersection(result.constBegin(), result.constEnd(), lists.at(i)->constBegin(),
+                              lists.at(i)->constEnd(), std::back_inserter(next));
+        result = next;
+    }
+    return result;
+}
+}
+
+struct SkyObjectSearch::Index
+{
+    /// The objects, in the order given to setObjects()
+    Results objects;
+    /// Normalized names, sorted
+    QVector<QString> keys;
+    /// Index in objects of each key
+    QVector<int> order;
+    /// Positions in keys of the names containing each trigram, sorted
+    QHash<quint64, QVector<int>> grams;
+};
+
+SkyObjectSearch::SkyObjectSearch(QObject *parent) : QObject(parent)
+{
+    qRegisterMetaType<SkyObjectSearch::Results>("SkyObjectSearch::Results");
+
+    m_Pool.setMaxThreadCount(1);
+}
+
+SkyObjectSearch::~SkyObjectSearch()
+{
+    cancel();
+    m_Pool.clear();
+    m_Pool.waitForDone();
+}
+
+void SkyObjectSearch::setObjects(const Results &objects)
+{
+    cancel();
+    m_Index = QtConcurrent::run(&m_Pool, &SkyObjectSearch::buildIndex, objects);
+}
+
+int SkyObjectSearch::search(const QString &text)
+{
+    int query = m_Query.fetchAndAddOrdered(1) + 1;
+
+    // 0 is reserved for find()
+    if (query == 0)
+        query = m_Query.fetchAndAddOrdered(1) + 1;
+
+    QtConcurrent::run(&m_Pool, this, &SkyObjectSearch::run, query, text, m_Index);
+    return query;
+}
+
+void SkyObjectSearch::cancel()
+{
+    m_Query.fetchAndAddOrdered(1);
+}
+
+SkyObjectSearch::Results SkyObjectSearch::find(const QString &text, int limit) const
+{
+    Results results;
+
+    QFuture<IndexPtr> index = m_Index;
+    index.waitForFinished();
+    if (index.resultCount() == 0)
+        return results;
+
+    lookup(*index.result(), text, limit, 0, [&results](const Results &batch) { results += batch; });
+    return results;
+}
+
+QString SkyObjectSearch::normalize(const QString &name)
+{
+    QString key;
+    key.reserve(name.size());
+    for (const QChar &c : name)
+    {
+        if (!c.isSpace())
+            key.append(c);
+    }
+    key = key.toCaseFolded();
+
+    // Catalog numbers like NGC0224: remove the zeros between the catalog and the number
+    int letters = 0;
+    while (letters < key.size() && key.at(letters).isLetter())
+        ++letters;
+    if (letters > 0)
+    {
+        int zeros = letters;
+        while (zeros < key.size() && key.at(zeros) == '0')
+            ++zeros;
+        if (zeros > letters && zeros < key.size() && key.at(zeros).isDigit())
+            key.remove(letters, zeros - letters);
+    }
+    return key;
+}
+
+SkyObjectSearch::IndexPtr SkyObjectSearch::buildIndex(const Results &objects)
+{
+    QSharedPointer<Index> index(new Index);
+    index->objects = objects;
+
+    QVector<QPair<QString, int>> entries;
+    entries.reserve(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+        entries.append(qMakePair(normalize(objects.at(i).first), i));
+
+    std::sort(entries.begin(), entries.end(),
+              [&objects](const QPair<QString, int> &a, const QPair<QString, int> &b)
+              {
+                  int order = QString::compare(a.first, b.first);
+                  if (order != 0)
+                      return order < 0;
+                  return objects.at(a.second).first < objects.at(b.second).first;
+              });
+
+    index->keys.reserve(entries.size());
+    index->order.reserve(entries.size());
+    for (int pos = 0; pos < entries.size(); ++pos)
+    {
+        const QString &key = entries.at(pos).first;
+
+        index->keys.append(key);
+        index->order.append(entries.at(pos).second);
+
+        for (int i = 0; i + 3 <= key.size(); ++i)
+        {
+            QVector<int> &positions = index->grams[trigram(key, i)];
+            if (positions.isEmpty() || positions.last() != pos)
+                positions.append(pos);
+        }
+    }
+    return index;
+}
+
+bool SkyObjectSearch::lookup(const Index &index, const QString &text, int limit, int query, const Sink &sink) const
+{
+    const QString key            = normalize(text);
+    const QVector<QString> &keys = index.keys;
+
+    Results batch;
+    int count = 0;
+
+    // Returns false once the limit is reached
+    auto add = [&](int pos)
+    {
+        batch.append(index.objects.at(index.order.at(pos)));
+        if (batch.size() >= BATCH_SIZE)
+        {
+            sink(batch);
+            batch.clear();
+        }
+        return limit < 0 || ++count < limit;
+    };
+
+    // Exact and prefix matches form a range of the sorted keys, exact ones first
+    const int first  = std::lower_bound(keys.constBegin(), keys.constEnd(), key) - keys.constBegin();
+    const bool exact = !key.isEmpty() && first < keys.size() && keys.at(first) == key;
+
+    int last = first;
+    for (; last < keys.size() && keys.at(last).startsWith(key); ++last)
+    {
+        if ((last & CANCEL_CHECK_MASK) == 0 && cancelled(query))
+            return exact;
+        if (!add(last))
+        {
+            if (!batch.isEmpty())
+                sink(batch);
+            return exact;
+        }
+    }
+
+    // Deliver the best matches right away
+    if (!batch.isEmpty())
+    {
+        sink(batch);
+        batch.clear();
+    }
+
+    if (key.isEmpty())
+        return exact;
+
+    // Substring matches
+    if (key.size() < 3)
+    {
+        for (int pos = 0; pos < keys.size(); ++pos)
+        {
+            if ((pos & CANCEL_CHECK_MASK) == 0 && cancelled(query))
+                return exact;
+            if ((pos < first || pos >= last) && keys.at(pos).contains(key) && !add(pos))
+                break;
+        }
+    }
+    else
+    {
+        const QVector<int> candidates = trigramCandidates(index.grams, key);
+        for (int i = 0; i < candidates.size(); ++i)
+        {
+            const int pos = candidates.at(i);
+
+            if ((i & CANCEL_CHECK_MASK) == 0 && cancelled(query))
+                return exact;
+            if ((pos < first || pos >= last) && keys.at(pos).contains(key) && !add(pos))
+                break;
+        }
+    }
+
+    if (!batch.isEmpty())
+        sink(batch);
+    return exact;
+}
+
+void SkyObjectSearch::run(int query, const QString &text, const QFuture<IndexPtr> &index)
+{
+    if (cancelled(query))
+        return;
+
+    // Searches run in the same pool after the index build, so the index is ready
+    if (index.resultCount() == 0)
+    {
+        emit searchFinished(query, false);
+        return;
+    }
+
+    bool exact = lookup(*index.result(), text, -1, query,
+                        [this, query](const Results &batch)
+                        {
+                            if (!cancelled(query))
+                                emit resultsReady(query, batch);
+                        });
+
+    if (!cancelled(query))
+        emit searchFinished(query, exact);
+}
@@ -0,0 +1,117 @@
+/*  Name search engine for the Find dialog
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QMetaType>
+#include <QObject>
+#include <QPair>
+#include <QSharedPointer>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <functional>
+
+class SkyObject;
+
+/**
+ * @class SkyObjectSearch
+ *
+ * Searches a list of (name, object) pairs as used by SkyObjectListModel.
+ *
+ * The names are normalized (see normalize()) and indexed twice: sorted, for
+ * exact and prefix matches, and by trigram, for matches anywhere in the name.
+ * Results are ranked exact matches first, then prefix matches and finally
+ * substring matches, alphabetically within each group.
+ *
+ * Building the index and searching run in a worker thread. search() returns
+ * at once and the results are delivered in batches through resultsReady() so
+ * that a model can display the best matches before the search is complete.
+ * Starting a new search cancels the previous one.
+ *
+ * @short Off-thread name search used by FindDialog
+ */
+class SkyObjectSearch : public QObject
+{
+    Q_OBJECT
+  public:
+    typedef QVector<QPair<QString, const SkyObject *>> Results;
+
+    explicit SkyObjectSearch(QObject *parent = nullptr);
+    ~SkyObjectSearch() override;
+
+    /**
+     * @short Set the list of objects to search
+     * The index is built in a worker thread, searches started meanwhile wait for it.
+     */
+    void setObjects(const Results &objects);
+
+    /**
+     * @short Search the objects in a worker thread, cancelling any previous search
+     * @param text the name or part of the name to search
+     * @return the identifier of the search, passed to resultsReady() and searchFinished()
+     */
+    int search(const QString &text);
+
+    /** @short Cancel the running search, if any */
+    void cancel();
+
+    /**
+     * @short Search the objects in the calling thread
+     * @param text the name or part of the name to search
+     * @param limit maximum number of results, or -1 for no limit
+     * @return the ranked results
+     */
+    Results find(const QString &text, int limit = -1) const;
+
+    /**
+     * @return the key of a name in the index: case folded, without spaces and,
+     * for catalog numbers, without leading zeros. "M 31", "m31" and "NGC 0224"
+     * become "m31", "m31" and "ngc224".
+     */
+    static QString normalize(const QString &name);
+
+  signals:
+    /** @short Next batch of results of the search, in ranked order */
+    void resultsReady(int query, const SkyObjectSearch::Results &results);
+
+    /**
+     * @short The search is complete, not emitted for cancelled searches
+     * @param exactMatch true if an object name matches the search text exactly
+     */
+    void searchFinished(int query, bool exactMatch);
+
+  private:
+    struct Index;
+    typedef QSharedPointer<const Index> IndexPtr;
+    typedef std::function<void(const Results &)> Sink;
+
+    static IndexPtr buildIndex(const Results &objects);
+
+    /**
+     * @short Pass the results of the search to sink in batches
+     * @return true if an exact match was found
+     */
+    bool lookup(const Index &index, const QString &text, int limit, int query, const Sink &sink) const;
+
+    void run(int query, const QString &text, const QFuture<IndexPtr> &index);
+
+    bool cancelled(int query) const { return query != 0 && m_Query.load() != query; }
+
+    /// Runs the index builds and the searches one after the other
+    QThreadPool m_Pool;
+    QFuture<IndexPtr> m_Index;
+    QAtomicInt m_Query { 0 };
+};
+
+Q_DECLARE_METATYPE(SkyObjectSearch::Results)
@@ -0,0 +1,180 @@
+/*  Dependency graph of the startup tasks
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "startuptaskgraph.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#include "kstars_debug.h"
+
+namespace
+{
+/// Milliseconds between two event processings while the main thread waits for the background tasks
+const unsigned long EVENT_INTERVAL = 50;
+}
+
+void StartupTaskGraph::addTask(const QString &name, const Task &task, const QStringList &dependencies,
+                               Affinity affinity)
+{
+    Node node;
+    node.name         = name;
+    node.task         = task;
+    node.dependencies = dependencies;
+    node.affinity     = affinity;
+    m_Nodes.append(node);
+}
+
+bool StartupTaskGraph::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // The nodes are not added nor moved while running, the worker threads keep pointers to them
+    Node *nodes = m_Nodes.data();
+
+    QMutexLocker locker(&m_Mutex);
+    forever
+    {
+        Node *ready  = nullptr;
+        bool changed = false;
+        int running  = 0;
+
+        // Start all the background tasks which can, before running a main thread task
+        for (int i = 0; i < m_Nodes.size(); ++i)
+        {
+            Node &node = nodes[i];
+            if (node.state == Running)
+            {
+                ++running;
+                continue;
+            }
+            if (node.state != Pending)
+                continue;
+
+            const State dependencies = dependencyState(node);
+            if (dependencies == Failed)
+            {
+                qCWarning(KSTARS) << "Startup task" << node.name << "skipped, one of its dependencies failed";
+                node.state = Failed;
+                changed    = true;
+            }
+            else if (dependencies == Succeeded)
+            {
+                if (node.affinity == Background)
+                {
+                    node.state = Running;
+                    ++running;
+                    QtConcurrent::run([this, &node]() { execute(node); });
+                }
+                else if (ready == nullptr)
+                {
+                    ready = &node;
+                }
+            }
+        }
+
+        if (ready != nullptr)
+        {
+            ready->state = Running;
+            locker.unlock();
+            execute(*ready);
+            locker.relock();
+            continue;
+        }
+        if (changed)
+            continue;
+        if (running == 0)
+            break;
+
+        // Let the events of the background tasks, e.g. their progress texts, reach the GUI while waiting
+        m_Finished.wait(&m_Mutex, EVENT_INTERVAL);
+        if (QCoreApplication::instance() != nullptr)
+        {
+            locker.unlock();
+            QCoreApplication::processEvents();
+            locker.relock();
+        }
+    }
+
+    // Tasks waiting for each other
+    for (int i = 0; i < m_Nodes.size(); ++i)
+    {
+        if (nodes[i].state == Pending)
+        {
+            qCWarning(KSTARS) << "Startup task" << nodes[i].name << "skipped, its dependencies cannot be met";
+            nodes[i].state = Failed;
+        }
+    }
+    locker.unlock();
+
+    qCInfo(KSTARS) << "Startup tasks finished in" << timer.elapsed() << "ms";
+
+    return failedTasks().isEmpty();
+}
+
+QStringList StartupTaskGraph::failedTasks() const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    QStringList names;
+    for (const Node &node : m_Nodes)
+    {
+        if (node.state == Failed)
+            names.append(node.name);
+    }
+    return names;
+}
+
+qint64 StartupTaskGraph::duration(const QString &name) const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    for (const Node &node : m_Nodes)
+    {
+        if (node.name == name)
+            return node.duration;
+    }
+    return -1;
+}
+
+StartupTaskGraph::State StartupTaskGraph::dependencyState(const Node &node) const
+{
+    State result = Succeeded;
+    for (const QString &name : node.dependencies)
+    {
+        auto dependency = std::find_if(m_Nodes.constBegin(), m_Nodes.constEnd(),
+                                       [&](const Node &other) { return other.name == name; });
+        if (dependency == m_Nodes.constEnd() || dependency->state == Failed)
+            return Failed;
+        if (dependency->state != Succeeded)
+            result = Pending;
+    }
+    return result;
+}
+
+void StartupTaskGraph::execute(Node &node)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool succeeded = node.task();
+    const qint64 elapsed = timer.elapsed();
+
+    qCInfo(KSTARS) << "Startup task" << node.name << (succeeded ? "finished" : "failed") << "in" << elapsed << "ms";
+
+    QMutexLocker locker(&m_Mutex);
+    node.state    = succeeded ? Succeeded : Failed;
+    node.duration = elapsed;
+    m_Finished.wakeAll();
+}
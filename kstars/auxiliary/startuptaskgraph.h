@@ -0,0 +1,96 @@
+/*  Dependency graph of the startup tasks
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <functional>
+
+/**
+ * @class StartupTaskGraph
+ * @short Runs the loading tasks of the application as soon as their dependencies are done.
+ *
+ * Each task is a function returning false on failure, with the names of the tasks it
+ * depends on.  Background tasks run in the global thread pool, several at a time, while
+ * main thread tasks run in the thread calling run(), in the order they were added.  So
+ * the tasks touching the widgets, the sky components or the SQL connections used later
+ * by the GUI stay in the main thread, and the tasks only reading data files overlap them.
+ *
+ * A task is skipped when one of its dependencies failed.  The duration of every task is
+ * logged, to find what slows the startup down.
+ */
+class StartupTaskGraph
+{
+  public:
+    enum Affinity
+    {
+        MainThread,
+        Background
+    };
+
+    typedef std::function<bool()> Task;
+
+    /**
+     * @short Add a task to the graph
+     * @param name unique name of the task, used by the dependencies and the log
+     * @param task the function to run, returning false on failure
+     * @param dependencies names of the tasks which must succeed before this one starts
+     * @param affinity whether the task may run in a worker thread
+     */
+    void addTask(const QString &name, const Task &task, const QStringList &dependencies = QStringList(),
+                 Affinity affinity = MainThread);
+
+    /**
+     * @short Run all tasks and wait for them
+     * Pending events are processed while the main thread waits, e.g. for the splash screen.
+     * @return true if all tasks succeeded
+     */
+    bool run();
+
+    /** @return the names of the tasks which failed or were skipped by the last run */
+    QStringList failedTasks() const;
+
+    /** @return the duration of the task in milliseconds, -1 if it did not run */
+    qint64 duration(const QString &name) const;
+
+  private:
+    enum State
+    {
+        Pending,
+        Running,
+        Succeeded,
+        Failed
+    };
+
+    struct Node
+    {
+        QString name;
+        Task task;
+        QStringList dependencies;
+        Affinity affinity { MainThread };
+        State state { Pending };
+        qint64 duration { -1 };
+    };
+
+    /** @return Succeeded if the dependencies of node succeeded, Failed if one failed, Pending otherwise */
+    State dependencyState(const Node &node) const;
+
+    /** @short Run the task of node in the calling thread and record its result */
+    void execute(Node &node);
+
+    QVector<Node> m_Nodes;
+    mutable QMutex m_Mutex;
+    QWaitCondition m_Finished;
+};
@@ -59,6 +59,9 @@ DetailDialog::DetailDialog(SkyObject *o, const KStarsDateTime &ut, GeoLocation *
     titlePalette.setColor(backgroundRole(), palette().color(QPalette::Active, QPalette::Highlight));
     titlePalette.setColor(foregroundRole(), palette().color(QPalette::Active, QPalette::HighlightedText));
 
+    // The object may come from a list of names, without the position of the last update
+    KStarsData::Instance()->skyComposite()->refreshObject(selectedObject);
+
     //Create thumbnail image
     Thumbnail.reset(new QPixmap(200, 200));
 
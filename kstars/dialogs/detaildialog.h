@@ -90,6 +90,9 @@ class DetailDialog : public KPageDialog
     /** @return pointer to the QPixmap of the object's thumbnail image */
     inline QPixmap *thumbnail() { return Thumbnail.get(); }
 
+    /** @return pointer to the object shown in the dialog */
+    inline SkyObject *object() const { return selectedObject; }
+
   public slots:
     /** @short Slot to add this object to the observing list. */
     void addToObservingList();
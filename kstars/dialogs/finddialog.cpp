@@ -26,13 +26,12 @@
 #include "skycomponents/starcomponent.h"
 #include "skycomponents/syncedcatalogcomponent.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/solarsystemcomposite.h"
 #include "tools/nameresolver.h"
 #include "skyobjectlistmodel.h"
 
 #include <KMessageBox>
 
-#include <QSortFilterProxyModel>
-#include <QStringListModel>
 #include <QTimer>
 
 FindDialogUI::FindDialogUI(QWidget *parent) : QFrame(parent)
@@ -87,16 +86,12 @@ FindDialog::FindDialog(QWidget *parent) : QDialog(parent), timer(nullptr), m_tar
 
     ui->FilterType->setCurrentIndex(0); // show all types of objects
 
-    fModel    = new SkyObjectListModel(this);
-    sortModel = new QSortFilterProxyModel(ui->SearchList);
-    sortModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-    sortModel->setSourceModel(fModel);
-    sortModel->setSortRole(Qt::DisplayRole);
-    sortModel->setFilterRole(Qt::DisplayRole);
-    sortModel->setDynamicSortFilter(true);
-    sortModel->sort(0);
+    fModel = new SkyObjectListModel(this);
+    ui->SearchList->setModel(fModel);
 
-    ui->SearchList->setModel(sortModel);
+    m_Search = new SkyObjectSearch(this);
+    connect(m_Search, &SkyObjectSearch::resultsReady, this, &FindDialog::slotResultsReady);
+    connect(m_Search, &SkyObjectSearch::searchFinished, this, &FindDialog::slotSearchFinished);
 
     // Connect signals to slots
     connect(ui->SearchBox, SIGNAL(textChanged(QString)), SLOT(enqueueSearch()));
@@ -119,72 +114,65 @@ FindDialog::~FindDialog()
 
 void FindDialog::init()
 {
+    // List the asteroids and comets too, even if they are still read in the background
+    KStarsData::Instance()->skyComposite()->solarSystemComposite()->finishLoading();
+
     ui->SearchBox->clear();
     filterByType();
-    sortModel->sort(0);
-    initSelection();
+    filterList();
     m_targetObject = nullptr;
 }
 
 void FindDialog::initSelection()
 {
-    if (sortModel->rowCount() <= 0)
+    if (fModel->rowCount(QModelIndex()) <= 0)
     {
         okB->setEnabled(false);
         return;
     }
 
+    //Pre-select the first item, which is the best match of the search text
+    QModelIndex selectItem = fModel->index(0);
     if (ui->SearchBox->text().isEmpty())
     {
-        //Pre-select the first item
-        QModelIndex selectItem = sortModel->index(0, sortModel->filterKeyColumn(), QModelIndex());
+        int row = -1;
         switch (ui->FilterType->currentIndex())
         {
             case 0: //All objects, choose Andromeda galaxy
-            {
-                QModelIndex qmi = fModel->index(fModel->indexOf(i18n("Andromeda Galaxy")));
-                selectItem      = sortModel->mapFromSource(qmi);
+                row = fModel->indexOf(i18n("Andromeda Galaxy"));
                 break;
-            }
             case 1: //Stars, choose Aldebaran
-            {
-                QModelIndex qmi = fModel->index(fModel->indexOf(i18n("Aldebaran")));
-                selectItem      = sortModel->mapFromSource(qmi);
+                row = fModel->indexOf(i18n("Aldebaran"));
                 break;
-            }
             case 2: //Solar system or Asteroids, choose Aaltje
             case 9:
-            {
-                QModelIndex qmi = fModel->index(fModel->indexOf(i18n("Aaltje")));
-                selectItem      = sortModel->mapFromSource(qmi);
+                row = fModel->indexOf(i18n("Aaltje"));
                 break;
-            }
             case 8: //Comets, choose 'Aarseth-Brewington (1989 W1)'
-            {
-                QModelIndex qmi = fModel->index(fModel->indexOf(i18n("Aarseth-Brewington (1989 W1)")));
-                selectItem      = sortModel->mapFromSource(qmi);
+                row = fModel->indexOf(i18n("Aarseth-Brewington (1989 W1)"));
                 break;
-            }
         }
+        if (row >= 0)
+            selectItem = fModel->index(row);
+    }
 
-        if (selectItem.isValid())
-        {
-            ui->SearchList->selectionModel()->select(selectItem, QItemSelectionModel::ClearAndSelect);
-            ui->SearchList->scrollTo(selectItem);
-            ui->SearchList->setCurrentIndex(selectItem);
+    if (selectItem.isValid())
+    {
+        ui->SearchList->selectionModel()->select(selectItem, QItemSelectionModel::ClearAndSelect);
+        ui->SearchList->scrollTo(selectItem);
+        ui->SearchList->setCurrentIndex(selectItem);
 
-            okB->setEnabled(true);
-        }
+        okB->setEnabled(true);
     }
-
-    listFiltered = true;
 }
 
 void FindDialog::filterByType()
 {
     KStarsData *data = KStarsData::Instance();
 
-    switch (ui->FilterType->currentIndex())
+    m_FilterType = ui->FilterType->currentIndex();
+
+    switch (m_FilterType)
     {
         case 0: // All object types
         {
@@ -193,7 +181,7 @@ void FindDialog::filterByType()
             {
                 allObjects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
             }
-            fModel->setSkyObjectsList(allObjects);
+            m_Search->setObjects(allObjects);
             break;
         }
         case 1: //Stars
@@ -201,7 +189,7 @@ void FindDialog::filterByType()
             QVector<QPair<QString, const SkyObject *>> starObjects;
             starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
             starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-            fModel->setSkyObjectsList(starObjects);
+            m_Search->setObjects(starObjects);
             break;
         }
         case 2: //Solar system
@@ -212,38 +200,38 @@ void FindDialog::filterByType()
             ssObjects.append(data->skyComposite()->objectLists(SkyObject::ASTEROID));
             ssObjects.append(data->skyComposite()->objectLists(SkyObject::MOON));
 
-            fModel->setSkyObjectsList(ssObjects);
+            m_Search->setObjects(ssObjects);
             break;
         }
         case 3: //Open Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::OPEN_CLUSTER));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::OPEN_CLUSTER));
             break;
         case 4: //Globular Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GLOBULAR_CLUSTER));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::GLOBULAR_CLUSTER));
             break;
         case 5: //Gaseous nebulae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GASEOUS_NEBULA));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::GASEOUS_NEBULA));
             break;
         case 6: //Planetary nebula
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::PLANETARY_NEBULA));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::PLANETARY_NEBULA));
             break;
         case 7: //Galaxies
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GALAXY));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::GALAXY));
             break;
         case 8: //Comets
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::COMET));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::COMET));
             break;
         case 9: //Asteroids
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::ASTEROID));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::ASTEROID));
             break;
         case 10: //Constellations
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::CONSTELLATION));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::CONSTELLATION));
             break;
         case 11: //Supernovae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SUPERNOVA));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::SUPERNOVA));
             break;
         case 12: //Satellites
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SATELLITE));
+            m_Search->setObjects(data->skyComposite()->objectLists(SkyObject::SATELLITE));
             break;
     }
 }
@@ -251,46 +239,65 @@ void FindDialog::filterByType()
 void FindDialog::filterList()
 {
     QString SearchText = processSearchText();
-    sortModel->setFilterFixedString(SearchText);
     ui->InternetSearchButton->setText(i18n("or search the internet for %1", SearchText));
-    filterByType();
-    initSelection();
+    ui->InternetSearchButton->setEnabled(false);
 
-    //Select the first item in the list that begins with the filter string
-    if (!SearchText.isEmpty())
-    {
-        QStringList mItems = fModel->filter(QRegExp('^' + SearchText, Qt::CaseInsensitive));
-        mItems.sort();
+    if (ui->FilterType->currentIndex() != m_FilterType)
+        filterByType();
 
-        if (mItems.size())
-        {
-            QModelIndex qmi        = fModel->index(fModel->indexOf(mItems[0]));
-            QModelIndex selectItem = sortModel->mapFromSource(qmi);
+    // The current results stay in the list until the first new ones arrive
+    m_Query          = m_Search->search(SearchText);
+    m_ResultsPending = true;
 
-            if (selectItem.isValid())
-            {
-                ui->SearchList->selectionModel()->select(selectItem, QItemSelectionModel::ClearAndSelect);
-                ui->SearchList->scrollTo(selectItem);
-                ui->SearchList->setCurrentIndex(selectItem);
+    listFiltered = true;
+}
 
-                okB->setEnabled(true);
-            }
-        }
-        ui->InternetSearchButton->setEnabled(!mItems.contains(
-            SearchText)); // Disable searching the internet when an exact match for SearchText exists in KStars
+void FindDialog::slotResultsReady(int query, const SkyObjectSearch::Results &results)
+{
+    if (query != m_Query)
+        return;
+
+    if (m_ResultsPending)
+    {
+        m_ResultsPending = false;
+        fModel->setSkyObjectsList(results);
+        initSelection();
     }
     else
-        ui->InternetSearchButton->setEnabled(false);
+    {
+        fModel->appendSkyObjects(results);
+    }
+}
 
-    listFiltered = true;
+void FindDialog::slotSearchFinished(int query, bool exactMatch)
+{
+    if (query != m_Query)
+        return;
+
+    if (m_ResultsPending)
+    {
+        m_ResultsPending = false;
+        fModel->setSkyObjectsList(SkyObjectSearch::Results());
+        initSelection();
+    }
+    else if (ui->SearchBox->text().isEmpty())
+    {
+        // The default selection may have arrived after the first results
+        initSelection();
+    }
+
+    // Disable searching the internet when an exact match for SearchText exists in KStars
+    ui->InternetSearchButton->setEnabled(!ui->SearchBox->text().isEmpty() && !exactMatch);
 }
 
 SkyObject *FindDialog::selectedObject() const
 {
-    QModelIndex i = ui->SearchList->currentIndex();
-    QVariant sObj = sortModel->data(sortModel->index(i.row(), 0), SkyObjectListModel::SkyObjectRole);
+    QVariant sObj = fModel->data(ui->SearchList->currentIndex(), SkyObjectListModel::SkyObjectRole);
+    SkyObject *obj = reinterpret_cast<SkyObject*>(sObj.value<void *>());
 
-    return reinterpret_cast<SkyObject*>(sObj.value<void *>());
+    if (obj)
+        KStarsData::Instance()->skyComposite()->refreshObject(obj);
+    return obj;
 }
 
 void FindDialog::enqueueSearch()
@@ -340,11 +347,20 @@ void FindDialog::slotOk()
 {
     //If no valid object selected, show a sorry-box.  Otherwise, emit accept()
     SkyObject *selObj;
-    if (!listFiltered)
+    if (!listFiltered || m_ResultsPending)
     {
+        // Do not wait for the list, take the best match right away
+        if (timer)
+            timer->stop();
+        SkyObjectSearch::Results results = m_Search->find(processSearchText(), 1);
+        selObj = results.isEmpty() ? nullptr : const_cast<SkyObject *>(results.first().second);
+
         filterList();
     }
-    selObj = selectedObject();
+    else
+    {
+        selObj = selectedObject();
+    }
     finishProcessing(selObj, Options::resolveNamesOnline());
 }
 
@@ -376,7 +392,18 @@ void FindDialog::finishProcessing(SkyObject *selObj, bool resolve)
     }
     else
     {
-        selObj->updateCoordsNow(KStarsData::Instance()->updateNum());
+        KStarsData *data = KStarsData::Instance();
+
+        // Faint or off-screen minor bodies are not kept up to date on the sky map
+        if (selObj->type() == SkyObject::ASTEROID || selObj->type() == SkyObject::COMET)
+        {
+            KSNumbers num(data->ut().djd());
+            selObj->updateCoords(&num, true, data->geo()->lat(), data->lst(), false);
+        }
+        else
+        {
+            selObj->updateCoordsNow(data->updateNum());
+        }
         accept();
     }
 }
@@ -392,7 +419,7 @@ void FindDialog::keyPressEvent(QKeyEvent *e)
             int currentRow = ui->SearchList->currentIndex().row();
             if (currentRow > 0)
             {
-                QModelIndex selectItem = sortModel->index(currentRow - 1, sortModel->filterKeyColumn(), QModelIndex());
+                QModelIndex selectItem = fModel->index(currentRow - 1);
                 ui->SearchList->selectionModel()->setCurrentIndex(selectItem, QItemSelectionModel::SelectCurrent);
             }
             break;
@@ -400,9 +427,9 @@ void FindDialog::keyPressEvent(QKeyEvent *e)
         case Qt::Key_Down:
         {
             int currentRow = ui->SearchList->currentIndex().row();
-            if (currentRow < sortModel->rowCount() - 1)
+            if (currentRow < fModel->rowCount(QModelIndex()) - 1)
             {
-                QModelIndex selectItem = sortModel->index(currentRow + 1, sortModel->filterKeyColumn(), QModelIndex());
+                QModelIndex selectItem = fModel->index(currentRow + 1);
                 ui->SearchList->selectionModel()->setCurrentIndex(selectItem, QItemSelectionModel::SelectCurrent);
             }
             break;
@@ -22,10 +22,9 @@
 #include <QDialog>
 
 #include "ui_finddialog.h"
+#include "skyobjectsearch.h"
 
 class QTimer;
-class QStringListModel;
-class QSortFilterProxyModel;
 class SkyObjectListModel;
 class SkyObject;
 
@@ -65,8 +64,10 @@ class FindDialog : public QDialog
     inline SkyObject *targetObject() { return m_targetObject; }
 
   public slots:
-    /**When Text is entered in the QLineEdit, filter the List of objects
-         * so that only objects which start with the filter text are shown.
+    /**When Text is entered in the QLineEdit, search the objects matching the
+         * filter text.  The search runs in a worker thread; objects whose name is
+         * the filter text come first, then those starting with it and finally
+         * those containing it.
          */
     void filterList();
 
@@ -95,6 +96,12 @@ class FindDialog : public QDialog
 
     void slotDetails();
 
+    /** Show the next batch of results of the running search */
+    void slotResultsReady(int query, const SkyObjectSearch::Results &results);
+
+    /** The running search is complete */
+    void slotSearchFinished(int query, bool exactMatch);
+
   protected:
     /**Process Keystrokes.  The Up and Down arrow keys are used to select the
          * Previous/Next item in the listbox of named objects.  The Esc key closes
@@ -124,9 +131,15 @@ class FindDialog : public QDialog
 
     FindDialogUI *ui;
     SkyObjectListModel *fModel;
-    QSortFilterProxyModel *sortModel;
+    SkyObjectSearch *m_Search;
     QTimer *timer;
     bool listFiltered;
+    /// Object type the search index was built for, -1 if none
+    int m_FilterType { -1 };
+    /// Identifier of the running search
+    int m_Query { 0 };
+    /// True until the first results of the running search are shown
+    bool m_ResultsPending { false };
     QPushButton *okB;
     SkyObject *m_targetObject;
 };
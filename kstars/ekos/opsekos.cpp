@@ -70,12 +70,11 @@ void OpsEkos::clearAll()
     darkDir.removeRecursively();
     darkDir.mkdir(darkFilesPath);
 
-    QSqlDatabase userdb = QSqlDatabase::database("userdb");
-    userdb.open();
+    // Commit the queued writes before editing the table
+    KStarsData::Instance()->userdb()->GetDatabase();
     darkFramesModel->setEditStrategy(QSqlTableModel::OnManualSubmit);
     darkFramesModel->removeRows(0, darkFramesModel->rowCount());
     darkFramesModel->submitAll();
-    userdb.close();
 
     Ekos::DarkLibrary::Instance()->refreshFromDB();
 
@@ -84,11 +83,10 @@ void OpsEkos::clearAll()
 
 void OpsEkos::clearRow()
 {
-    QSqlDatabase userdb = QSqlDatabase::database("userdb");
-    userdb.open();
+    // Commit the queued writes before editing the table
+    KStarsData::Instance()->userdb()->GetDatabase();
     darkFramesModel->removeRow(darkTableView->currentIndex().row());
     darkFramesModel->submitAll();
-    userdb.close();
 
     Ekos::DarkLibrary::Instance()->refreshFromDB();
 
@@ -104,8 +102,7 @@ void OpsEkos::openDarksFolder()
 
 void OpsEkos::refreshDarkData()
 {
-    QSqlDatabase userdb = QSqlDatabase::database("userdb");
-    userdb.open();
+    QSqlDatabase userdb = KStarsData::Instance()->userdb()->GetDatabase();
 
     delete (darkFramesModel);
     darkFramesModel = new QSqlTableModel(this, userdb);
@@ -116,8 +113,6 @@ void OpsEkos::refreshDarkData()
     darkTableView->hideColumn(0);
     // Hide Chip
     darkTableView->hideColumn(2);
-
-    userdb.close();
 }
 
 void OpsEkos::loadDarkFITS(QModelIndex index)
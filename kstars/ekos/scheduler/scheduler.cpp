@@ -21,6 +21,9 @@
 #include "scheduleradaptor.h"
 #include "schedulerjob.h"
 #include "skymapcomposite.h"
+#include "skycomponents/artificialhorizoncomponent.h"
+#include "skycomponents/linelist.h"
+#include "visibilitywindowsolver.h"
 #include "auxiliary/QProgressIndicator.h"
 #include "dialogs/finddialog.h"
 #include "ekos/ekosmanager.h"
@@ -29,6 +32,11 @@
 
 #include <KNotifications/KNotification>
 
+#include <QtConcurrent>
+
+#include <functional>
+#include <memory>
+
 #include <ekos_scheduler_debug.h>
 
 #define BAD_SCORE               -1000
@@ -112,6 +120,7 @@ Scheduler::Scheduler()
 
     connect(&schedulerTimer, SIGNAL(timeout()), this, SLOT(checkStatus()));
     connect(&jobTimer, SIGNAL(timeout()), this, SLOT(checkJobStage()));
+    connect(&visibilityWatcher, SIGNAL(finished()), this, SLOT(applyVisibility()));
 
     pi = new QProgressIndicator(this);
     bottomLayout->addWidget(pi, 0, 0);
@@ -1009,6 +1018,10 @@ void Scheduler::pause()
 
 void Scheduler::evaluateJobs()
 {
+    // The jobs are evaluated again once their windows are computed
+    if (updateVisibility() == false)
+        return;
+
     foreach (SchedulerJob *job, jobs)
     {
         if (job->getState() > SchedulerJob::JOB_SCHEDULED)
@@ -1066,8 +1079,7 @@ void Scheduler::evaluateJobs()
                 if (score < 0)
                 {
                     // If Altitude or Dark score are negative, we try to schedule a better time for altitude and dark sky period.
-                    if (calculateAltitudeTime(job, job->getMinAltitude() > 0 ? job->getMinAltitude() : 0,
-                                              job->getMinMoonSeparation()))
+                    if (calculateAltitudeTime(job))
                     {
                         //appendLogText(i18n("%1 observation job is scheduled at %2", job->getName(), job->getStartupTime().toString()));
                         job->setState(SchedulerJob::JOB_SCHEDULED);
@@ -1490,6 +1502,100 @@ void Scheduler::wakeUpScheduler()
     }
 }
 
+bool Scheduler::updateVisibility()
+{
+    if (visibilityWatcher.isRunning())
+        return false;
+
+    // Windows are computed for two days from the local midnight, enough for any search starting today
+    QDateTime lt(KStarsData::Instance()->lt().date(), QTime());
+    const double midnightJD = geo->LTtoUT(KStarsDateTime(lt)).djd();
+
+    // Snapshot of what the windows depend on besides the jobs, the computation must not use the live objects
+    auto location = std::make_shared<const GeoLocation>(*geo);
+    auto horizon  = std::make_shared<const ArtificialHorizonSnapshot>(
+        KStarsData::Instance()->skyComposite()->artificialHorizon()->snapshot());
+
+    struct Constraints
+    {
+        SkyPoint target;
+        double minAltitude;
+        double minMoonSeparation;
+    };
+
+    QList<Constraints> outdated;
+    visibilityJobs.clear();
+    visibilityKeys.clear();
+    foreach (SchedulerJob *job, jobs)
+    {
+        if (job->getState() > SchedulerJob::JOB_SCHEDULED)
+            continue;
+
+        const SkyPoint &target = job->getTargetCoords();
+        const QString key      = QString("%1 %2 %3 %4 %5 %6 %7 %8")
+                                .arg(target.ra().Degrees(), 0, 'f', 6)
+                                .arg(target.dec().Degrees(), 0, 'f', 6)
+                                .arg(job->getMinAltitude())
+                                .arg(job->getMinMoonSeparation())
+                                .arg(location->lat()->Degrees(), 0, 'f', 6)
+                                .arg(location->lng()->Degrees(), 0, 'f', 6)
+                                .arg(midnightJD, 0, 'f', 6)
+                                .arg(horizon->key());
+
+        if (job->getVisibilityKey() != key)
+        {
+            outdated.append(
+                Constraints { target, job->getMinAltitude() > 0 ? job->getMinAltitude() : 0, job->getMinMoonSeparation() });
+            visibilityJobs.append(job);
+            visibilityKeys.append(key);
+        }
+    }
+
+    if (outdated.isEmpty())
+        return true;
+
+    // The Moon series may only be evaluated here, so the workers interpolate a track of it
+    auto moonTrack = std::make_shared<QVector<VisibilityWindowSolver::MoonSample>>();
+    for (const Constraints &constraints : outdated)
+    {
+        if (constraints.minMoonSeparation > 0)
+        {
+            *moonTrack = VisibilityWindowSolver::sampleMoon(midnightJD, midnightJD + 2);
+            break;
+        }
+    }
+
+    std::function<QVector<VisibilityWindowSolver::Window>(const Constraints &)> solve =
+        [location, horizon, moonTrack, midnightJD](const Constraints &constraints)
+    {
+        VisibilityWindowSolver solver(location.get());
+        solver.setMinAltitude(constraints.minAltitude);
+        solver.setMinMoonSeparation(constraints.minMoonSeparation);
+        solver.setHorizon(horizon.get());
+        solver.setMoonTrack(moonTrack.get());
+        return solver.windows(constraints.target, midnightJD, midnightJD + 2);
+    };
+    visibilityWatcher.setFuture(QtConcurrent::mapped(outdated, solve));
+    return false;
+}
+
+void Scheduler::applyVisibility()
+{
+    const QList<QVector<VisibilityWindowSolver::Window>> windows = visibilityWatcher.future().results();
+
+    // Jobs may have been removed during the computation
+    for (int i = 0; i < visibilityJobs.size() && i < windows.size(); ++i)
+    {
+        if (jobs.contains(visibilityJobs.at(i)))
+            visibilityJobs.at(i)->setVisibilityWindows(windows.at(i), visibilityKeys.at(i));
+    }
+    visibilityJobs.clear();
+    visibilityKeys.clear();
+
+    if (state == SCHEDULER_RUNNIG || jobEvaluationOnly)
+        evaluateJobs();
+}
+
 double Scheduler::findAltitude(const SkyPoint &target, const QDateTime &when)
 {
     // Make a copy
@@ -1512,57 +1618,63 @@ double Scheduler::findAltitude(const SkyPoint &target, const QDateTime &when)
     return p.alt().Degrees();
 }
 
-bool Scheduler::calculateAltitudeTime(SchedulerJob *job, double minAltitude, double minMoonAngle)
+bool Scheduler::calculateAltitudeTime(SchedulerJob *job)
 {
+    const double minAltitude  = job->getMinAltitude() > 0 ? job->getMinAltitude() : 0;
+    const double minMoonAngle = job->getMinMoonSeparation();
+
     // We wouldn't stat observation 30 mins (default) before dawn.
     double earlyDawn = Dawn - Options::preDawnTime() / (60.0 * 24.0);
-    double altitude  = 0;
     QDateTime lt(KStarsData::Instance()->lt().date(), QTime());
     KStarsDateTime ut = geo->LTtoUT(KStarsDateTime(lt));
 
-    SkyPoint target = job->getTargetCoords();
-
     QTime now       = KStarsData::Instance()->lt().time();
     double fraction = now.hour() + now.minute() / 60.0 + now.second() / 3600;
 
-    for (double hour = fraction; hour < (fraction + 24); hour += 1.0 / 60.0)
-    {
-        double rawFrac      = 0;
-        KStarsDateTime myUT = ut.addSecs(hour * 3600.0);
+    // Local midnight and the start of the search in UT
+    const double midnightJD = ut.djd();
+    const double startJD    = midnightJD + fraction / 24.0;
 
-        rawFrac = (hour > 24 ? (hour - 24) : hour) / 24.0;
+    for (VisibilityWindowSolver::Window window : job->getVisibilityWindows())
+    {
+        // Only search the day following now
+        window.start = qMax(window.start, startJD);
+        window.end   = qMin(window.end, startJD + 1);
+        if (window.start >= window.end)
+            continue;
 
-        if (rawFrac < Dawn || rawFrac > Dusk)
+        // Find the first night time in the window, the night being after Dusk and before Dawn of the next day
+        for (int day = -1; day <= 1; ++day)
         {
-            CachingDms LST = geo->GSTtoLST(myUT.gst());
-            target.EquatorialToHorizontal(&LST, geo->lat());
-            altitude = target.alt().Degrees();
+            const double nightStart = qMax(window.start, midnightJD + day + Dusk);
+            const double nightEnd   = qMin(window.end, midnightJD + day + 1 + Dawn);
+            if (nightStart >= nightEnd)
+                continue;
 
-            if (altitude > minAltitude)
-            {
-                QDateTime startTime = geo->UTtoLT(myUT);
+            const double rawFrac = nightStart - midnightJD - std::floor(nightStart - midnightJD);
+            QDateTime startTime  = geo->UTtoLT(KStarsDateTime(nightStart));
 
-                if (rawFrac > earlyDawn && rawFrac < Dawn)
-                {
-                    appendLogText(i18n("%1 reaches an altitude of %2 degrees at %3 but will not be scheduled due to "
-                                       "close proximity to astronomical twilight rise.",
-                                       job->getName(), QString::number(minAltitude, 'g', 3), startTime.toString()));
-                    return false;
-                }
+            if (rawFrac > earlyDawn && rawFrac < Dawn)
+            {
+                appendLogText(i18n("%1 reaches an altitude of %2 degrees at %3 but will not be scheduled due to "
+                                   "close proximity to astronomical twilight rise.",
+                                   job->getName(), QString::number(minAltitude, 'g', 3), startTime.toString()));
+                return false;
+            }
 
-                if (minMoonAngle > 0 && getMoonSeparationScore(job, startTime) < 0)
-                    continue;
+            SkyPoint target = job->getTargetCoords();
+            CachingDms LST  = geo->GSTtoLST(KStarsDateTime(nightStart).gst());
+            target.EquatorialToHorizontal(&LST, geo->lat());
 
-                job->setStartupTime(startTime);
-                job->setStartupCondition(SchedulerJob::START_AT);
-                appendLogText(i18n("%1 is scheduled to start at %2 where its altitude is %3 degrees.", job->getName(),
-                                   startTime.toString(), QString::number(altitude, 'g', 3)));
-                return true;
-            }
+            job->setStartupTime(startTime);
+            job->setStartupCondition(SchedulerJob::START_AT);
+            appendLogText(i18n("%1 is scheduled to start at %2 where its altitude is %3 degrees.", job->getName(),
+                               startTime.toString(), QString::number(target.alt().Degrees(), 'g', 3)));
+            return true;
         }
     }
 
-    if (minMoonAngle == -1)
+    if (minMoonAngle <= 0)
         appendLogText(i18n("No night time found for %1 to rise above minimum altitude of %2 degrees.", job->getName(),
                            QString::number(minAltitude, 'g', 3)));
     else
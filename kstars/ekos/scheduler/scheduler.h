@@ -13,9 +13,11 @@
 
 #include "ui_scheduler.h"
 #include "ekos/align/align.h"
+#include "visibilitywindowsolver.h"
 
 #include <lilxml.h>
 
+#include <QFutureWatcher>
 #include <QProcess>
 #include <QTime>
 #include <QTimer>
@@ -328,6 +330,11 @@ class Scheduler : public QWidget, public Ui::Scheduler
     void runShutdownProcedure();
     void checkShutdownProcedure();
 
+    /**
+         * @brief applyVisibility Store the windows computed by updateVisibility() in their jobs and evaluate the jobs again.
+         */
+    void applyVisibility();
+
   signals:
     void newLog();
     void weatherChanged(IPState state);
@@ -340,6 +347,14 @@ class Scheduler : public QWidget, public Ui::Scheduler
          */
     void evaluateJobs();
 
+    /**
+         * @brief updateVisibility computes in parallel the visibility windows of the jobs to evaluate whose
+         * target, constraints, location or date changed since they were last computed.
+         * @return true if the windows of all jobs are current, false if they are being computed, in which
+         * case applyVisibility() is called when they are ready.
+         */
+    bool updateVisibility();
+
     /**
          * @brief executeJob After the best job is selected, we call this in order to start the process that will execute the job.
          * checkJobStatus slot will be connected in order to figure the exact state of the current job each second
@@ -382,13 +397,13 @@ class Scheduler : public QWidget, public Ui::Scheduler
     int16_t getWeatherScore();
 
     /**
-         * @brief calculateAltitudeTime calculate the altitude time given the minimum altitude given.
+         * @brief calculateAltitudeTime calculate the first time in the night the job satisfies its minimum altitude
+         * and minimum moon separation.
+         * @note The windows of the job computed by updateVisibility() are used.
          * @param job active target
-         * @param minAltitude minimum altitude required
-         * @param minMoonAngle minimum separation from the moon. -1 to ignore.
          * @return True if found a time in the night where the object is at or above the minimum altitude, false otherise.
          */
-    bool calculateAltitudeTime(SchedulerJob *job, double minAltitude, double minMoonAngle = -1);
+    bool calculateAltitudeTime(SchedulerJob *job);
 
     /**
          * @brief calculateCulmination find culmination time adjust for the job offset
@@ -626,6 +641,10 @@ class Scheduler : public QWidget, public Ui::Scheduler
     QTimer schedulerTimer;
     /// To call checkJobStage
     QTimer jobTimer;
+    /// Visibility windows being computed, for visibilityJobs with the keys visibilityKeys
+    QFutureWatcher<QVector<VisibilityWindowSolver::Window>> visibilityWatcher;
+    QList<SchedulerJob *> visibilityJobs;
+    QStringList visibilityKeys;
 
     /// Generic time to track timeout of current operation in progress
     QTime currentOperationTime;
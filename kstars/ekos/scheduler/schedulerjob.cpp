@@ -385,3 +385,19 @@ void SchedulerJob::setTargetCoords(dms& ra, dms& dec)
 
     targetCoords.updateCoordsNow(KStarsData::Instance()->updateNum());
 }
+
+const QVector<VisibilityWindowSolver::Window> &SchedulerJob::getVisibilityWindows() const
+{
+    return visibilityWindows;
+}
+
+QString SchedulerJob::getVisibilityKey() const
+{
+    return visibilityKey;
+}
+
+void SchedulerJob::setVisibilityWindows(const QVector<VisibilityWindowSolver::Window> &windows, const QString &key)
+{
+    visibilityWindows = windows;
+    visibilityKey     = key;
+}
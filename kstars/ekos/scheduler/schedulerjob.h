@@ -10,6 +10,7 @@
 #pragma once
 
 #include "skypoint.h"
+#include "visibilitywindowsolver.h"
 
 #include <QUrl>
 
@@ -144,6 +145,17 @@ class SchedulerJob
     uint16_t getRepeatsRemaining() const;
     void setRepeatsRemaining(const uint16_t &value);
 
+    /**
+     * @return the windows during which the target satisfies its altitude, horizon and Moon constraints,
+     * as last computed by Scheduler::updateVisibility()
+     */
+    const QVector<VisibilityWindowSolver::Window> &getVisibilityWindows() const;
+
+    /** @return the description of the inputs of the visibility windows, empty if never computed */
+    QString getVisibilityKey() const;
+
+    void setVisibilityWindows(const QVector<VisibilityWindowSolver::Window> &windows, const QString &key);
+
   private:
     QString name;
     SkyPoint targetCoords;
@@ -183,4 +195,7 @@ class SchedulerJob
     QString dateTimeDisplayFormat;
 
     bool lightFramesRequired { false };
+
+    QVector<VisibilityWindowSolver::Window> visibilityWindows;
+    QString visibilityKey;
 };
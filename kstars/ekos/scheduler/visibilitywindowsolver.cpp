@@ -0,0 +1,275 @@
+/*  Ekos Scheduler visibility windows
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "visibilitywindowsolver.h"
+
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "ksutils.h"
+#include "kstarsdata.h"
+#include "skycomponents/artificialhorizoncomponent.h"
+#include "skyobjects/ksmoon.h"
+
+#include <ekos_scheduler_debug.h>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/// Longest step sampling the horizon and Moon constraints, in days
+const double SAMPLE_STEP = 5.0 / 1440.0;
+
+/// Precision of the refined crossings, in days, also the shortest sampling step
+const double CROSSING_TOLERANCE = 10.0 / 86400.0;
+
+/// Equatorial radius of the Earth in km, for the parallax of the Moon
+const double EARTH_RADIUS = 6378.14;
+
+/** @return the geometric ecliptic longitude of the Sun in degrees, within 0.01 degree (Meeus, chapter 25) */
+double sunLongitude(double jd)
+{
+    const double T = (jd - J2000) / 36525.0;
+    const double L = 280.46646 + T * (36000.76983 + T * 0.0003032);
+    const double M = (357.52911 + T * (35999.05029 - T * 0.0001537)) * dms::DegToRad;
+    const double C = (1.914602 - T * (0.004817 + T * 0.000014)) * sin(M) + (0.019993 - T * 0.000101) * sin(2 * M) +
+                     0.000289 * sin(3 * M);
+    return L + C;
+}
+}
+
+const double VisibilityWindowSolver::MOON_STEP = 1.0 / 24.0;
+
+VisibilityWindowSolver::VisibilityWindowSolver(const GeoLocation *geo) : m_Geo(geo)
+{
+}
+
+QVector<VisibilityWindowSolver::MoonSample> VisibilityWindowSolver::sampleMoon(double startJD, double endJD)
+{
+    QVector<MoonSample> track;
+    KSMoon moon;
+
+    for (double jd = startJD;; jd += MOON_STEP)
+    {
+        KSNumbers num(jd);
+        if (!moon.findGeocentricPosition(&num, nullptr))
+        {
+            qCWarning(KSTARS_EKOS_SCHEDULER) << "Cannot compute the Moon, its separation is ignored.";
+            return QVector<MoonSample>();
+        }
+
+        MoonSample sample;
+        double sinRa, cosRa, sinDec, cosDec;
+        moon.ra().SinCos(sinRa, cosRa);
+        moon.dec().SinCos(sinDec, cosDec);
+        sample.jd           = jd;
+        sample.x            = cosDec * cosRa;
+        sample.y            = cosDec * sinRa;
+        sample.z            = sinDec;
+        sample.distance     = moon.rearth() * AU_KM;
+        sample.illumination = 0.5 * (1.0 - cos((moon.ecLong().Degrees() - sunLongitude(jd)) * dms::DegToRad));
+        track.append(sample);
+
+        if (jd >= endJD)
+            break;
+    }
+
+    return track;
+}
+
+VisibilityWindowSolver::MoonSample VisibilityWindowSolver::moonAt(const QVector<MoonSample> &track, double jd)
+{
+    const int last = track.size() - 1;
+    const int i    = qBound(0, static_cast<int>(std::floor((jd - track.first().jd) / MOON_STEP)), qMax(0, last - 1));
+    if (last == 0)
+        return track.first();
+
+    const MoonSample &a = track.at(i);
+    const MoonSample &b = track.at(i + 1);
+    const double f      = (jd - a.jd) / (b.jd - a.jd);
+
+    MoonSample sample;
+    sample.jd           = jd;
+    sample.x            = a.x + f * (b.x - a.x);
+    sample.y            = a.y + f * (b.y - a.y);
+    sample.z            = a.z + f * (b.z - a.z);
+    sample.distance     = a.distance + f * (b.distance - a.distance);
+    sample.illumination = a.illumination + f * (b.illumination - a.illumination);
+
+    const double norm = sqrt(sample.x * sample.x + sample.y * sample.y + sample.z * sample.z);
+    sample.x /= norm;
+    sample.y /= norm;
+    sample.z /= norm;
+    return sample;
+}
+
+QVector<VisibilityWindowSolver::Window> VisibilityWindowSolver::windows(const SkyPoint &target, double startJD,
+                                                                        double endJD) const
+{
+    const QVector<Window> above = altitudeWindows(target, startJD, endJD);
+    if (m_Horizon == nullptr && m_MinMoonSeparation <= 0)
+        return above;
+
+    QVector<MoonSample> ownTrack;
+    if (m_MinMoonSeparation > 0 && m_MoonTrack == nullptr)
+        ownTrack = sampleMoon(startJD, endJD);
+    const QVector<MoonSample> &track = m_MoonTrack ? *m_MoonTrack : ownTrack;
+
+    // The target must not move by more than half the narrowest region between two samples
+    const double maxMove = m_Horizon ? 0.5 * m_Horizon->resolution() : std::numeric_limits<double>::infinity();
+    auto moved           = [](const SkyPoint &a, const SkyPoint &b)
+    {
+        return qMax(fabs(KSUtils::reduceAngle(b.az().Degrees() - a.az().Degrees(), -180.0, 180.0)),
+                    fabs(b.alt().Degrees() - a.alt().Degrees()));
+    };
+    auto clear = [&](double jd) { return isClear(horizontal(target, jd), jd, track); };
+
+    QVector<Window> result;
+    for (const Window &window : above)
+    {
+        Window current { window.start, window.end };
+        SkyPoint from = horizontal(target, window.start);
+        bool wasClear = isClear(from, window.start, track);
+
+        for (double jd = window.start; jd < window.end;)
+        {
+            double next = qMin(jd + SAMPLE_STEP, window.end);
+            SkyPoint to = horizontal(target, next);
+            while (next - jd > CROSSING_TOLERANCE && moved(from, to) > maxMove)
+            {
+                next = 0.5 * (jd + next);
+                to   = horizontal(target, next);
+            }
+            const bool nowClear = isClear(to, next, track);
+
+            if (nowClear != wasClear)
+            {
+                // Bisect the crossing between the two samples
+                double a = jd, b = next;
+                while (b - a > CROSSING_TOLERANCE)
+                {
+                    const double m = 0.5 * (a + b);
+                    if (clear(m) == wasClear)
+                        a = m;
+                    else
+                        b = m;
+                }
+
+                if (nowClear)
+                {
+                    current.start = b;
+                }
+                else
+                {
+                    current.end = a;
+                    result.append(current);
+                }
+            }
+
+            jd       = next;
+            from     = to;
+            wasClear = nowClear;
+        }
+
+        if (wasClear)
+        {
+            current.end = window.end;
+            result.append(current);
+        }
+    }
+
+    return result;
+}
+
+QVector<VisibilityWindowSolver::Window> VisibilityWindowSolver::altitudeWindows(const SkyPoint &target, double startJD,
+                                                                                double endJD) const
+{
+    QVector<Window> result;
+
+    double sinLat, cosLat, sinDec, cosDec;
+    m_Geo->lat()->SinCos(sinLat, cosLat);
+    target.dec().SinCos(sinDec, cosDec);
+
+    // Hour angle at which the target crosses the minimum altitude
+    const double cosH0 = (sin(m_MinAltitude * dms::DegToRad) - sinLat * sinDec) / (cosLat * cosDec);
+
+    // Never rises above the minimum altitude
+    if (cosH0 >= 1.0)
+        return result;
+
+    // Never sets below it
+    if (cosH0 <= -1.0)
+    {
+        result.append(Window { startJD, endJD });
+        return result;
+    }
+
+    const double H0 = acos(cosH0) / dms::DegToRad;
+
+    // Hour angle at the start, in ]-180, 180]
+    const CachingDms LST = m_Geo->GSTtoLST(KStarsDateTime(startJD).gst());
+    const double H       = KSUtils::reduceAngle(LST.Degrees() - target.ra().Degrees(), -180.0, 180.0);
+
+    // The target is above the minimum altitude while the hour angle is within [-H0, H0] modulo 360
+    for (int k = 0;; ++k)
+    {
+        const double rise = startJD + (360.0 * k - H0 - H) / dms::SiderealRate;
+        const double set  = startJD + (360.0 * k + H0 - H) / dms::SiderealRate;
+        if (rise >= endJD)
+            break;
+
+        const Window window { qMax(rise, startJD), qMin(set, endJD) };
+        if (window.end > window.start)
+            result.append(window);
+    }
+
+    return result;
+}
+
+SkyPoint VisibilityWindowSolver::horizontal(const SkyPoint &target, double jd) const
+{
+    CachingDms LST = m_Geo->GSTtoLST(KStarsDateTime(jd).gst());
+
+    SkyPoint p = target;
+    p.EquatorialToHorizontal(&LST, m_Geo->lat());
+    return p;
+}
+
+bool VisibilityWindowSolver::isClear(const SkyPoint &p, double jd, const QVector<MoonSample> &track) const
+{
+    if (m_Horizon != nullptr && !m_Horizon->isVisible(p.az().Degrees(), p.alt().Degrees()))
+        return false;
+
+    if (m_MinMoonSeparation > 0 && !track.isEmpty())
+    {
+        const MoonSample sample = moonAt(track, jd);
+
+        SkyPoint moon;
+        moon.setRA(dms(atan2(sample.y, sample.x) / dms::DegToRad).reduce());
+        moon.setDec(dms(asin(qBound(-1.0, sample.z, 1.0)) / dms::DegToRad));
+        CachingDms LST = m_Geo->GSTtoLST(KStarsDateTime(jd).gst());
+        moon.EquatorialToHorizontal(&LST, m_Geo->lat());
+
+        // Topocentric altitude of the Moon, lowered by its parallax
+        const double parallax = asin(EARTH_RADIUS / sample.distance) * cos(moon.alt().radians());
+        const double moonAlt  = moon.alt().radians() - parallax;
+
+        // As for the Moon score of the scheduler, a Moon below the horizon or new does not matter
+        if (moonAlt <= 0 || sample.illumination == 0)
+            return true;
+
+        const double cosSeparation =
+            sin(moonAlt) * sin(p.alt().radians()) +
+            cos(moonAlt) * cos(p.alt().radians()) * cos(moon.az().radians() - p.az().radians());
+        if (acos(qBound(-1.0, cosSeparation, 1.0)) < m_MinMoonSeparation * dms::DegToRad)
+            return false;
+    }
+
+    return true;
+}
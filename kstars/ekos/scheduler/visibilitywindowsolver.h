@@ -0,0 +1,107 @@
+/*  Ekos Scheduler visibility windows
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QVector>
+
+class ArtificialHorizonSnapshot;
+class GeoLocation;
+class SkyPoint;
+
+/**
+ * @class VisibilityWindowSolver
+ * @short Finds the time windows during which a target satisfies the scheduler constraints.
+ *
+ * The intervals above the minimum altitude are found analytically from the hour angle
+ * at which the target crosses that altitude.  The artificial horizon and the Moon
+ * separation, which have no closed form, are then sampled inside those intervals only,
+ * and their crossings refined by bisection.  The samples are close enough for the target
+ * not to jump over the narrowest region of the horizon.  Like the Moon score of the
+ * scheduler, the separation is only required while the Moon is up and lit.
+ *
+ * The target is assumed fixed on the sky during the searched interval, which holds for
+ * the deep sky targets of the scheduler over a day.  The Moon is interpolated from a
+ * track sampled beforehand with sampleMoon(), because its series may only be evaluated
+ * in the main thread.  With a track, windows() does not change any shared object and can
+ * run in any thread.
+ */
+class VisibilityWindowSolver
+{
+  public:
+    /** @short An interval between two Julian Days (UT) */
+    struct Window
+    {
+        double start { 0 };
+        double end { 0 };
+    };
+
+    /** @short Position of the Moon at a date */
+    struct MoonSample
+    {
+        double jd { 0 };
+        /// Geocentric equatorial unit vector of the date
+        double x { 0 }, y { 0 }, z { 0 };
+        /// Distance from the Earth in km
+        double distance { 0 };
+        /// Illuminated fraction
+        double illumination { 0 };
+    };
+
+    explicit VisibilityWindowSolver(const GeoLocation *geo);
+
+    /** @short Set the minimum altitude of the target in degrees */
+    void setMinAltitude(double altitude) { m_MinAltitude = altitude; }
+
+    /** @short Set the minimum separation between the target and the Moon in degrees, none if not positive */
+    void setMinMoonSeparation(double separation) { m_MinMoonSeparation = separation; }
+
+    /** @short Exclude the times the target is behind the regions of horizon, nullptr to ignore it */
+    void setHorizon(const ArtificialHorizonSnapshot *horizon) { m_Horizon = horizon; }
+
+    /**
+     * @short Use the Moon positions of track, which must cover the searched interval
+     * Without a track, windows() samples the Moon itself and must run in the main thread.
+     */
+    void setMoonTrack(const QVector<MoonSample> *track) { m_MoonTrack = track; }
+
+    /**
+     * @short Sample the Moon between two Julian Days (UT), to be called from the main thread
+     * @return samples spaced by MOON_STEP, covering startJD and endJD, or none if the lunar data is missing
+     */
+    static QVector<MoonSample> sampleMoon(double startJD, double endJD);
+
+    /** Interval between the samples of the Moon, in days */
+    static const double MOON_STEP;
+
+    /** @return the windows between startJD and endJD during which target satisfies all constraints, in chronological order */
+    QVector<Window> windows(const SkyPoint &target, double startJD, double endJD) const;
+
+  private:
+    /** @return the windows during which target is above the minimum altitude */
+    QVector<Window> altitudeWindows(const SkyPoint &target, double startJD, double endJD) const;
+
+    /** @return target converted to horizontal coordinates at jd */
+    SkyPoint horizontal(const SkyPoint &target, double jd) const;
+
+    /** @return the Moon at jd, interpolated from track */
+    static MoonSample moonAt(const QVector<MoonSample> &track, double jd);
+
+    /**
+     * @return true if target, at horizontal position p at jd, is clear of the horizon
+     * and far enough from the Moon of track
+     */
+    bool isClear(const SkyPoint &p, double jd, const QVector<MoonSample> &track) const;
+
+    const GeoLocation *m_Geo { nullptr };
+    const ArtificialHorizonSnapshot *m_Horizon { nullptr };
+    const QVector<MoonSample> *m_MoonTrack { nullptr };
+    double m_MinAltitude { 0 };
+    double m_MinMoonSeparation { -1 };
+};
@@ -18,6 +18,7 @@
 
 #include "ksalmanac.h"
 
+#include "altitudecurves.h"
 #include "geolocation.h"
 #include "ksnumbers.h"
 #include "kstarsdata.h"
@@ -96,14 +97,19 @@ void KSAlmanac::findDawnDusk()
 
     m_Sun.updateCoords(&num, true, geo->lat(), &LST, true); // We can abuse our own copy of the sun
     double dawn, da, dusk, du, max_alt, min_alt;
-    double last_h   = -12.0;
-    double last_alt = findAltitude(&m_Sun, last_h);
+
+    // Altitudes of the Sun every 3 minutes from -12h to +12h, computed at once
+    const AltitudeCurves curves(geo, today.addSecs(-12.0 * 3600.0), 0.05, 481);
+    const QVector<double> altitudes = curves.fixedCurve(m_Sun);
+
+    double last_alt = altitudes.first();
     dawn = dusk = -13.0;
     max_alt     = -100.0;
     min_alt     = 100.0;
-    for (double h = -11.95; h <= 12.0; h += 0.05)
+    for (int i = 1; i < altitudes.size(); ++i)
     {
-        double alt = findAltitude(&m_Sun, h);
+        double h   = -12.0 + 0.05 * i;
+        double alt = altitudes.at(i);
         bool asc   = alt - last_alt > 0;
         if (alt > max_alt)
             max_alt = alt;
@@ -115,8 +121,6 @@ void KSAlmanac::findDawnDusk()
         if (!asc && last_alt >= -18.0 && alt <= -18.0)
             dusk = h;
 
-        // Never used
-//        last_h   = h;
         last_alt = alt;
     }
 
@@ -170,8 +174,3 @@ double KSAlmanac::sunZenithAngleToTime(double z)
     double HASunset = acos((-m_Sun.dec().sin() * geo->lat()->sin()) / (m_Sun.dec().cos() * geo->lat()->cos()));
     return SunSet + (HA - HASunset) / 24.0;
 }
-
-double KSAlmanac::findAltitude(const SkyPoint *p, double hour)
-{
-    return SkyPoint::findAltitude(p, dt, geo, hour).Degrees();
-}
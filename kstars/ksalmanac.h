@@ -119,13 +119,6 @@ class KSAlmanac
          */
     void findMoonPhase();
 
-    /**
-         * FIXME: More code duplication!
-         * findAltitude should really be part of KSEngine. Copying from ObservingList.
-         * returns in degrees
-         */
-    double findAltitude(const SkyPoint *p, double hour);
-
     KSSun m_Sun;
     KSMoon m_Moon;
     KStarsDateTime dt;
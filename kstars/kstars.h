@@ -398,6 +398,13 @@ class KStars : public KXmlGuiWindow
          */
     Q_SCRIPTABLE QString getObjectPositionInfo(const QString &objectName);
 
+    /** DBUS interface function.  Return XML listing the passes of satellites over the current location
+         * @param satelliteName name of the satellite, all loaded satellites if empty.
+         * @param hours length of the time window starting at the current simulation time, in hours.
+         * @note If the satellite was not found, the XML is empty.
+         */
+    Q_SCRIPTABLE QString getSatellitePasses(const QString &satelliteName, double hours);
+
     /** DBUS interface function. Render eyepiece view and save it in the file(s) specified
          * @note See EyepieceField::renderEyepieceView() for more info. This is a DBus proxy that calls that method, and then writes the resulting image(s) to file(s).
          * @note Important: If imagePath is empty, but overlay is true, or destPathImage is supplied, this method will make a blocking DSS download.
@@ -21,6 +21,7 @@
 #include "ksutils.h"
 #include "Options.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/startuptaskgraph.h"
 #include "skycomponents/supernovaecomponent.h"
 #include "skycomponents/skymapcomposite.h"
 #ifndef KSTARS_LITE
@@ -137,73 +138,58 @@ KStarsData::~KStarsData()
 
 bool KStarsData::initialize()
 {
-    //Initialize CatalogDB//
-    catalogdb()->Initialize();
+    // The time zone rules and the cities only read data files, so they are loaded in the background
+    // while the main thread builds the sky components, which use the databases of the main thread.
+    StartupTaskGraph tasks;
 
-    //Load Time Zone Rules//
-    emit progressText(i18n("Reading time zone rules"));
-    if (!readTimeZoneRulebook())
+    tasks.addTask("Time zone rules", [this]()
     {
-        fatalErrorMessage("TZrules.dat");
-        return false;
-    }
-
-
-    emit progressText(i18n("Upgrade existing user city db to support geographic elevation."));
-
+        emit progressText(i18n("Reading time zone rules"));
+        return readTimeZoneRulebook();
+    }, QStringList(), StartupTaskGraph::Background);
 
-    QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
-
-    /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
-    /// geographic elevation.
-    if (QFile::exists(dbfile))
+    tasks.addTask("City database", [this]()
     {
-            QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
-
-        fixcitydb.setDatabaseName(dbfile);
-        fixcitydb.open();
+        emit progressText(i18n("Loading city data"));
+        return readCityData();
+    }, QStringList() << "Time zone rules", StartupTaskGraph::Background);
 
-        if (fixcitydb.tables().contains("city",Qt::CaseInsensitive))
-        {
-            QSqlRecord r = fixcitydb.record("city");
-            if (!r.contains("Elevation"))
-            {
-                emit progressText(i18n("Adding \"Elevation\" column to city table."));
+    tasks.addTask("Catalog database", [this]()
+    {
+        catalogdb()->Initialize();
+        return true;
+    });
 
-                QSqlQuery query(fixcitydb);
-                if (query.exec("alter table city add column Elevation real default -10;") == false)
-                {
-                    emit progressText(QString("failed to add Elevation column to city table in mycitydb.sqlite: &1").arg(query.lastError().text()));
-                }
-            }
-            else
-            {
-                emit progressText(i18n("City table already contains \"Elevation\"."));
-            }
-        }
-        else
-        {
-            emit progressText(i18n("City table missing from database."));
-        }
-        fixcitydb.close();
-    }
+    tasks.addTask("User database", [this]()
+    {
+        emit progressText(i18n("Loading User Information"));
+        m_ksuserdb.Initialize();
+        return true;
+    });
 
+    tasks.addTask("Sky objects", [this]()
+    {
+        emit progressText(i18n("Loading sky objects"));
+        m_SkyComposite.reset(new SkyMapComposite());
+        return true;
+    }, QStringList() << "Catalog database" << "User database");
 
-    //Load Cities//
-    emit progressText(i18n("Loading city data"));
-    if (!readCityData())
+    if (!tasks.run())
     {
-        fatalErrorMessage("citydb.sqlite");
+        const QStringList failed = tasks.failedTasks();
+        if (failed.contains("Time zone rules"))
+            fatalErrorMessage("TZrules.dat");
+        else if (failed.contains("City database"))
+            fatalErrorMessage("citydb.sqlite");
         return false;
     }
 
-    //Initialize User Database//
-    emit progressText(i18n("Loading User Information"));
-    m_ksuserdb.Initialize();
+    // The city dialogs add the user cities through this connection, which must belong to the main thread
+    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
+    QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+    if (QFile::exists(dbfile))
+        mycitydb.setDatabaseName(dbfile);
 
-    //Initialize SkyMapComposite//
-    emit progressText(i18n("Loading sky objects"));
-    m_SkyComposite.reset(new SkyMapComposite());
     //Load Image URLs//
     //#ifndef Q_OS_ANDROID
     //On Android these 2 calls produce segfault. WARNING
@@ -420,6 +406,44 @@ SkyObject *KStarsData::objectNamed(const QString &name)
 
 bool KStarsData::readCityData()
 {
+    emit progressText(i18n("Upgrade existing user city db to support geographic elevation."));
+
+    const QString mydbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+
+    /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
+    /// geographic elevation.
+    if (QFile::exists(mydbfile))
+    {
+            QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
+
+        fixcitydb.setDatabaseName(mydbfile);
+        fixcitydb.open();
+
+        if (fixcitydb.tables().contains("city",Qt::CaseInsensitive))
+        {
+            QSqlRecord r = fixcitydb.record("city");
+            if (!r.contains("Elevation"))
+            {
+                emit progressText(i18n("Adding \"Elevation\" column to city table."));
+
+                QSqlQuery query(fixcitydb);
+                if (query.exec("alter table city add column Elevation real default -10;") == false)
+                {
+                    emit progressText(QString("failed to add Elevation column to city table in mycitydb.sqlite: &1").arg(query.lastError().text()));
+                }
+            }
+            else
+            {
+                emit progressText(i18n("City table already contains \"Elevation\"."));
+            }
+        }
+        else
+        {
+            emit progressText(i18n("City table missing from database."));
+        }
+        fixcitydb.close();
+    }
+
     QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb");
     QString dbfile      = KSPaths::locate(QStandardPaths::GenericDataLocation, "citydb.sqlite");
     citydb.setDatabaseName(dbfile);
@@ -458,12 +482,12 @@ bool KStarsData::readCityData()
     citydb.close();
 
     // Reading local database
-    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
-    dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+    // Read from a connection of this thread, "mycitydb" is added by initialize() for the main thread
+    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb_read");
 
-    if (QFile::exists(dbfile))
+    if (QFile::exists(mydbfile))
     {
-        mycitydb.setDatabaseName(dbfile);
+        mycitydb.setDatabaseName(mydbfile);
         if (mycitydb.open())
         {
             QSqlQuery get_query(mycitydb);
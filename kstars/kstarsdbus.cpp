@@ -28,10 +28,14 @@
 #include "Options.h"
 #include "skymap.h"
 #include "skycomponents/constellationboundarylines.h"
+#include "skycomponents/satellitescomponent.h"
 #include "skycomponents/skymapcomposite.h"
 #include "skyobjects/deepskyobject.h"
 #include "skyobjects/ksplanetbase.h"
+#include "skyobjects/satellite.h"
+#include "skyobjects/satellitegroup.h"
 #include "skyobjects/starobject.h"
+#include "tools/satellitepasspredictor.h"
 #include "tools/whatsinteresting/wiview.h"
 
 #ifdef HAVE_CFITSIO
@@ -824,6 +828,54 @@ QString KStars::getObjectPositionInfo(const QString &objectName)
     return output;
 }
 
+QString KStars::getSatellitePasses(const QString &satelliteName, double hours)
+{
+    Q_ASSERT(data());
+    QList<Satellite *> satellites;
+    if (satelliteName.isEmpty())
+    {
+        for (SatelliteGroup *group : data()->skyComposite()->satellites()->groups())
+            satellites += *group;
+    }
+    else if (Satellite *sat = data()->skyComposite()->satellites()->findSatellite(satelliteName))
+    {
+        satellites.append(sat);
+    }
+
+    if (satellites.isEmpty())
+        return QString("<xml></xml>");
+
+    const double startJD = data()->ut().djd();
+    const QVector<SatellitePassPredictor::Pass> passes =
+        SatellitePassPredictor(*data()->geo()).predict(satellites, startJD, startJD + hours / 24.0);
+
+    QString output;
+    QXmlStreamWriter stream(&output);
+    stream.setAutoFormatting(true);
+    stream.writeStartDocument();
+    stream.writeStartElement("passes");
+    for (const SatellitePassPredictor::Pass &pass : passes)
+    {
+        stream.writeStartElement("pass");
+        stream.writeTextElement("Name", pass.name);
+        stream.writeTextElement("Rise_JD", QString::number(pass.aos, 'f', 6));
+        stream.writeTextElement("Rise_Az_Degrees", QString::number(pass.aosAzimuth));
+        stream.writeTextElement("Culmination_JD", QString::number(pass.culmination, 'f', 6));
+        stream.writeTextElement("Culmination_Alt_Degrees", QString::number(pass.maxAltitude));
+        stream.writeTextElement("Set_JD", QString::number(pass.los, 'f', 6));
+        stream.writeTextElement("Set_Az_Degrees", QString::number(pass.losAzimuth));
+        if (pass.isVisible())
+        {
+            stream.writeTextElement("Visible_Start_JD", QString::number(pass.visibleStart, 'f', 6));
+            stream.writeTextElement("Visible_End_JD", QString::number(pass.visibleEnd, 'f', 6));
+        }
+        stream.writeEndElement(); // pass
+    }
+    stream.writeEndElement(); // passes
+    stream.writeEndDocument();
+    return output;
+}
+
 void KStars::renderEyepieceView(const QString &objectName, const QString &destPathChart, const double fovWidth,
                                 const double fovHeight, const double rotation, const double scale, const bool flip,
                                 const bool invert, QString imagePath, const QString &destPathImage, const bool overlay,
@@ -45,6 +45,8 @@
 #include "ksutils.h"
 #include "kstarsdatetime.h"
 #include "simclock.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skycomponents/solarsystemcomposite.h"
 #include "ksnumbers.h"
 #include "version.h"
 #include "Options.h"
@@ -202,6 +204,9 @@ int main(int argc, char *argv[])
         QObject::connect(dat, SIGNAL(progressText(QString)), dat, SLOT(slotConsoleMessage(QString)));
         dat->initialize();
 
+        //The image must show the asteroids and comets, still read in the background
+        dat->skyComposite()->solarSystemComposite()->finishLoading();
+
         //Set Geographic Location
         dat->setLocationFromOptions();
 
@@ -10,6 +10,7 @@
 #include "artificialhorizoncomponent.h"
 
 #include "kstarsdata.h"
+#include "ksutils.h"
 #include "linelist.h"
 #include "Options.h"
 #include "skymap.h"
@@ -17,6 +18,10 @@
 #include "skypainter.h"
 #include "projections/projector.h"
 
+#include <QCryptographicHash>
+
+#include <algorithm>
+
 ArtificialHorizonEntity::ArtificialHorizonEntity()
 {
 }
@@ -177,3 +182,84 @@ void ArtificialHorizonComponent::addRegion(const QString &regionName, bool enabl
 
     appendLine(list);
 }
+
+ArtificialHorizonSnapshot ArtificialHorizonComponent::snapshot()
+{
+    ArtificialHorizonSnapshot snapshot;
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    foreach (ArtificialHorizonEntity *horizon, m_HorizonList)
+    {
+        const bool enabled = horizon->enabled() && horizon->list();
+        hash.addData(enabled ? "1" : "0", 1);
+        if (!enabled)
+            continue;
+
+        const SkyList *points = horizon->list()->points();
+        QVector<double> azimuths(points->size()), altitudes(points->size());
+        for (int i = 0; i < points->size(); ++i)
+        {
+            azimuths[i]  = points->at(i)->az().Degrees();
+            altitudes[i] = points->at(i)->alt().Degrees();
+        }
+        hash.addData(reinterpret_cast<const char *>(azimuths.constData()), azimuths.size() * sizeof(double));
+        hash.addData(reinterpret_cast<const char *>(altitudes.constData()), altitudes.size() * sizeof(double));
+
+        snapshot.addRegion(azimuths, altitudes);
+    }
+
+    snapshot.m_Key = hash.result().toHex();
+    return snapshot;
+}
+
+void ArtificialHorizonSnapshot::addRegion(QVector<double> azimuths, const QVector<double> &altitudes)
+{
+    if (azimuths.isEmpty())
+        return;
+
+    // Consecutive points are joined the short way around, so unwrap the azimuths to make
+    // the edges continuous even when the region crosses the north or spans over 180 degrees
+    for (int i = 1; i < azimuths.size(); ++i)
+        azimuths[i] = KSUtils::reduceAngle(azimuths.at(i), azimuths.at(i - 1) - 180.0, azimuths.at(i - 1) + 180.0);
+
+    const auto azRange  = std::minmax_element(azimuths.constBegin(), azimuths.constEnd());
+    const auto altRange = std::minmax_element(altitudes.constBegin(), altitudes.constEnd());
+    m_MinAzimuths.append(*azRange.first);
+    m_MaxAzimuths.append(*azRange.second);
+    m_Resolution = std::min({ m_Resolution, *azRange.second - *azRange.first, *altRange.second - *altRange.first });
+
+    m_Azimuths.append(azimuths);
+    m_Altitudes.append(altitudes);
+}
+
+bool ArtificialHorizonSnapshot::isVisible(double azimuth, double altitude) const
+{
+    for (int r = 0; r < m_Azimuths.size(); ++r)
+    {
+        // The azimuths of the region are unwrapped, so a region may extend beyond 360 degrees
+        // and the tested azimuth is tried at each turn within its range
+        for (double az = KSUtils::reduceAngle(azimuth, m_MinAzimuths.at(r), m_MinAzimuths.at(r) + 360.0);
+             az <= m_MaxAzimuths.at(r); az += 360.0)
+        {
+            if (isInside(r, az, altitude))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool ArtificialHorizonSnapshot::isInside(int region, double azimuth, double altitude) const
+{
+    // Ray casting towards increasing azimuths
+    const QVector<double> &az  = m_Azimuths.at(region);
+    const QVector<double> &alt = m_Altitudes.at(region);
+    bool inside                = false;
+    for (int i = 0, j = az.size() - 1; i < az.size(); j = i++)
+    {
+        if ((alt.at(i) > altitude) != (alt.at(j) > altitude) &&
+            az.at(i) + (altitude - alt.at(i)) * (az.at(j) - az.at(i)) / (alt.at(j) - alt.at(i)) > azimuth)
+            inside = !inside;
+    }
+    return inside;
+}
@@ -11,6 +11,9 @@
 
 #include "noprecessindex.h"
 
+#include <QString>
+#include <QVector>
+
 #include <memory>
 
 class ArtificialHorizonEntity
@@ -35,6 +38,50 @@ class ArtificialHorizonEntity
     std::shared_ptr<LineList> m_List;
 };
 
+/**
+ * @class ArtificialHorizonSnapshot
+ * @short Copy of the enabled regions of the artificial horizon
+ *
+ * The snapshot does not change when the regions are edited, so it can be read from
+ * several threads while the user works on the horizon.
+ */
+class ArtificialHorizonSnapshot
+{
+  public:
+    /**
+     * @return false if the horizontal position lies inside an enabled region, i.e. is blocked
+     * @param azimuth azimuth in degrees
+     * @param altitude altitude in degrees
+     */
+    bool isVisible(double azimuth, double altitude) const;
+
+    /** @return a digest of the enabled flags and the coordinates of all regions, to detect changes */
+    QString key() const { return m_Key; }
+
+    /**
+     * @short Add a region, as the polygon joining the points in order
+     * @param azimuths azimuths of the points in degrees
+     * @param altitudes altitudes of the points in degrees
+     */
+    void addRegion(QVector<double> azimuths, const QVector<double> &altitudes);
+
+    /** @return the smallest azimuth or altitude extent of the regions in degrees, 360 without regions */
+    double resolution() const { return m_Resolution; }
+
+  private:
+    friend class ArtificialHorizonComponent;
+
+    /** @return true if the point is inside the region, its azimuth taken on the unwrapped azimuths of the region */
+    bool isInside(int region, double azimuth, double altitude) const;
+
+    /// Azimuths and altitudes of the points of each region, in degrees, azimuths unwrapped
+    QVector<QVector<double>> m_Azimuths, m_Altitudes;
+    /// Range of the unwrapped azimuths of each region
+    QVector<double> m_MinAzimuths, m_MaxAzimuths;
+    double m_Resolution { 360.0 };
+    QString m_Key;
+};
+
 /**
  * @class ArtificialHorizon
  * Represents custom area from the horizon upwards which represent blocked views from the vantage point of the user.
@@ -64,6 +111,9 @@ class ArtificialHorizonComponent : public NoPrecessIndex
     void removeRegion(const QString &regionName, bool lineOnly = false);
     inline QList<ArtificialHorizonEntity *> *horizonList() { return &m_HorizonList; }
 
+    /** @return a copy of the regions as they are now, see ArtificialHorizonSnapshot */
+    ArtificialHorizonSnapshot snapshot();
+
     bool load();
     void save();
 
@@ -48,7 +48,13 @@
 
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent) : SolarSystemListComponent(parent)
 {
+#ifdef KSTARS_LITE
+    // The nodes of the objects are created with the sky map
     loadData();
+#else
+    // Not needed to show the sky map, so read in the background
+    loadInBackground(SkyObject::ASTEROID, &AsteroidsComponent::readData);
+#endif
 }
 
 AsteroidsComponent::~AsteroidsComponent()
@@ -91,6 +97,16 @@ bool AsteroidsComponent::selected()
  */
 void AsteroidsComponent::loadData()
 {
+    emitProgressText(i18n("Loading asteroids"));
+
+    // Wait for the objects still read at startup, the new file replaces them
+    finishLoading();
+    setObjects(SkyObject::ASTEROID, readData());
+}
+
+QList<SkyObject *> AsteroidsComponent::readData()
+{
+    QList<SkyObject *> asteroids;
     QString name, full_name, orbit_id, orbit_class, dimensions;
     int mJD;
     double q, a, e, dble_i, dble_w, dble_N, dble_M, H, G, earth_moid;
@@ -98,15 +114,6 @@ void AsteroidsComponent::loadData()
     float diameter, albedo, rot_period, period;
     bool neo;
 
-    emitProgressText(i18n("Loading asteroids"));
-
-    // Clear lists
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
-
-    objectLists(SkyObject::ASTEROID).clear();
-    objectNames(SkyObject::ASTEROID).clear();
-
     QList<QPair<QString, KSParser::DataTypes>> sequence;
     sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
     sequence.append(qMakePair(QString("epoch_mjd"), KSParser::D_INT));
@@ -135,48 +142,74 @@ void AsteroidsComponent::loadData()
     //QString file_name = KSPaths::locate( QStandardPaths::DataLocation,  );
     QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("asteroids.dat"));
     KSParser asteroid_parser(file_name, '#', sequence);
-
-    QHash<QString, QVariant> row_content;
-    while (asteroid_parser.HasNextRow())
+    asteroid_parser.UseSnapshot("asteroids");
+
+    // The list is long, so read it as typed rows, with the columns looked up once
+    const int full_name_column   = asteroid_parser.Column("full name");
+    const int epoch_column       = asteroid_parser.Column("epoch_mjd");
+    const int q_column           = asteroid_parser.Column("q");
+    const int a_column           = asteroid_parser.Column("a");
+    const int e_column           = asteroid_parser.Column("e");
+    const int i_column           = asteroid_parser.Column("i");
+    const int w_column           = asteroid_parser.Column("w");
+    const int om_column          = asteroid_parser.Column("om");
+    const int ma_column          = asteroid_parser.Column("ma");
+    const int orbit_id_column    = asteroid_parser.Column("orbit_id");
+    const int H_column           = asteroid_parser.Column("H");
+    const int G_column           = asteroid_parser.Column("G");
+    const int neo_column         = asteroid_parser.Column("neo");
+    const int diameter_column    = asteroid_parser.Column("diameter");
+    const int extent_column      = asteroid_parser.Column("extent");
+    const int albedo_column      = asteroid_parser.Column("albedo");
+    const int rot_period_column  = asteroid_parser.Column("rot_period");
+    const int period_column      = asteroid_parser.Column("per_y");
+    const int moid_column        = asteroid_parser.Column("moid");
+    const int class_column       = asteroid_parser.Column("class");
+
+    const QString europa   = i18nc("Asteroid name (optional)", "Europa");
+    const QString io       = i18nc("Asteroid name (optional)", "Io");
+    const QString asterope = i18nc("Asteroid name (optional)", "Asterope");
+    const QString pluto    = i18nc("Asteroid name (optional)", "Pluto");
+
+    KSParser::Row row;
+    while (asteroid_parser.ReadNextRow(row))
     {
-        row_content = asteroid_parser.ReadNextRow();
-        full_name   = row_content["full name"].toString();
+        full_name   = row.toString(full_name_column);
         full_name   = full_name.trimmed();
         int catN    = full_name.section(' ', 0, 0).toInt();
 
         name = full_name.section(' ', 1, -1);
 
         //JM temporary hack to avoid Europa,Io, and Asterope duplication
-        if (name == i18nc("Asteroid name (optional)", "Europa") || name == i18nc("Asteroid name (optional)", "Io") ||
-            name == i18nc("Asteroid name (optional)", "Asterope"))
+        if (name == europa || name == io || name == asterope)
             name += i18n(" (Asteroid)");
 
-        mJD         = row_content["epoch_mjd"].toInt();
-        q           = row_content["q"].toDouble();
-        a           = row_content["a"].toDouble();
-        e           = row_content["e"].toDouble();
-        dble_i      = row_content["i"].toDouble();
-        dble_w      = row_content["w"].toDouble();
-        dble_N      = row_content["om"].toDouble();
-        dble_M      = row_content["ma"].toDouble();
-        orbit_id    = row_content["orbit_id"].toString();
-        H           = row_content["H"].toDouble();
-        G           = row_content["G"].toDouble();
-        neo         = row_content["neo"].toString() == "Y";
-        diameter    = row_content["diameter"].toFloat();
-        dimensions  = row_content["extent"].toString();
-        albedo      = row_content["albedo"].toFloat();
-        rot_period  = row_content["rot_period"].toFloat();
-        period      = row_content["per_y"].toFloat();
-        earth_moid  = row_content["moid"].toDouble();
-        orbit_class = row_content["class"].toString();
+        mJD         = row.toInt(epoch_column);
+        q           = row.toDouble(q_column);
+        a           = row.toDouble(a_column);
+        e           = row.toDouble(e_column);
+        dble_i      = row.toDouble(i_column);
+        dble_w      = row.toDouble(w_column);
+        dble_N      = row.toDouble(om_column);
+        dble_M      = row.toDouble(ma_column);
+        orbit_id    = row.toString(orbit_id_column);
+        H           = row.toDouble(H_column);
+        G           = row.toDouble(G_column);
+        neo         = row.equals(neo_column, "Y");
+        diameter    = row.toFloat(diameter_column);
+        dimensions  = row.toString(extent_column);
+        albedo      = row.toFloat(albedo_column);
+        rot_period  = row.toFloat(rot_period_column);
+        period      = row.toFloat(period_column);
+        earth_moid  = row.toDouble(moid_column);
+        orbit_class = row.toString(class_column);
 
         JD = static_cast<double>(mJD) + 2400000.5;
 
         KSAsteroid *new_asteroid = nullptr;
 
         // Diameter is missing from JPL data
-        if (name == i18nc("Asteroid name (optional)", "Pluto"))
+        if (name == pluto)
             diameter = 2390;
 
         new_asteroid = new KSAsteroid(catN, name, QString(), JD, a, e, dms(dble_i), dms(dble_w), dms(dble_N), dms(dble_M), H, G);
@@ -194,11 +227,10 @@ void AsteroidsComponent::loadData()
         new_asteroid->setPhysicalSize(diameter);
         //new_asteroid->setAngularSize(0.005);
 
-        m_ObjectList.append(new_asteroid);
-        // Add name to the list of object names
-        objectNames(SkyObject::ASTEROID).append(name);
-        objectLists(SkyObject::ASTEROID).append(QPair<QString, const SkyObject *>(name, new_asteroid));
+        asteroids.append(new_asteroid);
     }
+
+    return asteroids;
 }
 
 void AsteroidsComponent::draw(SkyPainter *skyp)
@@ -221,10 +253,15 @@ void AsteroidsComponent::draw(SkyPainter *skyp)
 
     skyp->setBrush(QBrush(QColor("gray")));
 
-    foreach (SkyObject *so, m_ObjectList)
+    refreshView();
+
+    for (int k = 0; k < m_ObjectList.size(); ++k)
     {
+        if (!isCurrent(k))
+            continue;
+
         // FIXME: God help us!
-        KSAsteroid *ast = (KSAsteroid *)so;
+        KSAsteroid *ast = (KSAsteroid *)m_ObjectList.at(k);
 
         if (ast->mag() > Options::magLimitAsteroid() || std::isnan(ast->mag()) != 0)
             continue;
@@ -244,25 +281,21 @@ void AsteroidsComponent::draw(SkyPainter *skyp)
 
 SkyObject *AsteroidsComponent::objectNearest(SkyPoint *p, double &maxrad)
 {
-    SkyObject *oBest = nullptr;
-
     if (!selected())
         return nullptr;
 
-    foreach (SkyObject *o, m_ObjectList)
-    {
-        if (o->mag() > Options::magLimitAsteroid())
-            continue;
+    const double magLimit = Options::magLimitAsteroid();
 
-        double r = o->angularDistanceTo(p).Degrees();
-        if (r < maxrad)
-        {
-            oBest  = o;
-            maxrad = r;
-        }
-    }
+    refreshNear(p, maxrad);
 
-    return oBest;
+    m_NearestIndex.update(m_ObjectList);
+    return m_NearestIndex.objectNearest(p, maxrad, [this, magLimit](const SkyObject *o)
+                                        { return isCurrent(o) && !(o->mag() > magLimit); });
+}
+
+double AsteroidsComponent::magnitudeLimit() const
+{
+    return Options::magLimitAsteroid();
 }
 
 void AsteroidsComponent::updateDataFile()
@@ -52,12 +52,18 @@ class AsteroidsComponent : public QObject, public SolarSystemListComponent
 
     QString ans();
 
+  protected:
+    double magnitudeLimit() const override;
+
   protected slots:
     void downloadReady();
     void downloadError(const QString &errorString);
 
   private:
     void loadData();
+
+    /** @short Read the objects of asteroids.dat, may be called from any thread */
+    static QList<SkyObject *> readData();
     FileDownloader *downloadJob;
 };
 
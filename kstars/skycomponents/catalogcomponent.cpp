@@ -19,9 +19,48 @@
 
 #include "catalogdata.h"
 #include "kstarsdata.h"
+#include "kstars_debug.h"
+#include "skymapcomposite.h"
+#include "skymesh.h"
 #include "skypainter.h"
+#include "htmesh/MeshIterator.h"
 #include "skyobjects/starobject.h"
 #include "skyobjects/deepskyobject.h"
+#ifndef KSTARS_LITE
+#include "skymap.h"
+#include "dialogs/detaildialog.h"
+#include "tools/visibilityservice.h"
+
+#include <QApplication>
+#endif
+
+#include <algorithm>
+
+namespace
+{
+/** @return the objects used outside of the catalogs, whose pages must not be deleted */
+QSet<const SkyObject *> heldObjects()
+{
+    QSet<const SkyObject *> held;
+    for (const SkyObject *obj : KStarsData::Instance()->skyComposite()->labelObjects())
+        held.insert(obj);
+#ifndef KSTARS_LITE
+    if (SkyMap::Instance())
+    {
+        held.insert(SkyMap::Instance()->focusObject());
+        held.insert(SkyMap::Instance()->clickedObject());
+    }
+    // The details dialogs are windows, even when they have a parent
+    for (QWidget *widget : QApplication::topLevelWidgets())
+    {
+        if (DetailDialog *detail = qobject_cast<DetailDialog *>(widget))
+            held.insert(detail->object());
+    }
+#endif
+    held.remove(nullptr);
+    return held;
+}
+}
 
 CatalogComponent::CatalogComponent(SkyComposite *parent, const QString &catname, bool showerrs, int index,
                                    bool callLoadData)
@@ -62,6 +101,38 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
     else
         emitProgressText(i18n("Loading internal catalog: %1", m_catName));
 
+    CatalogDB *db = KStarsData::Instance()->catalogdb();
+
+    // The DSO table is indexed by the trixels of the sky map mesh, large catalogs are read from there as needed
+    m_SkyMesh                   = SkyMesh::Instance();
+    m_IncludeCatalogDesignation = includeCatalogDesignation;
+    m_CatalogId                 = db->FindCatalog(m_catName);
+
+    m_Paged = isPageable() && m_SkyMesh != nullptr && m_SkyMesh->level() == CatalogDB::TRIXEL_LEVEL;
+    if (m_Paged)
+        m_Paged = db->GetObjectCount(m_CatalogId) > static_cast<int>(Options::catalogPagingThreshold());
+
+    // The pages only point to objects of the object list, deleted below in both cases
+    m_Pages.clear();
+    if (m_Paged)
+    {
+        qCInfo(KSTARS) << "Catalog" << m_catName << "is loaded by sky region";
+        ListComponent::clear();
+    }
+    else
+    {
+        _loadAllObjects(includeCatalogDesignation);
+    }
+
+    CatalogData loaded_catalog_data;
+    db->GetCatalogData(m_catName, loaded_catalog_data);
+    m_catColor    = loaded_catalog_data.color;
+    m_catFluxFreq = loaded_catalog_data.fluxfreq;
+    m_catFluxUnit = loaded_catalog_data.fluxunit;
+}
+
+void CatalogComponent::_loadAllObjects(bool includeCatalogDesignation)
+{
     QList<QPair<int, QString>> names;
 
     KStarsData::Instance()->catalogdb()->GetAllObjects(m_catName, m_ObjectList, names, this, includeCatalogDesignation);
@@ -97,6 +168,7 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
     {
         SkyObject *obj = m_ObjectList[iter];
         Q_ASSERT(obj);
+        addToNameIndex(obj);
         if (obj->type() <= SkyObject::TYPE_UNKNOWN)
         {
             QVector<QPair<QString, const SkyObject *>> &objects = objectLists(obj->type());
@@ -139,52 +211,53 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
     // Remove Duplicates (see FIXME by AS above)
     for (auto &list : objectNames())
         list.removeDuplicates();
-
-    CatalogData loaded_catalog_data;
-    KStarsData::Instance()->catalogdb()->GetCatalogData(m_catName, loaded_catalog_data);
-    m_catColor    = loaded_catalog_data.color;
-    m_catFluxFreq = loaded_catalog_data.fluxfreq;
-    m_catFluxUnit = loaded_catalog_data.fluxunit;
 }
 
 void CatalogComponent::update(KSNumbers *)
 {
     if (selected())
     {
-        KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *obj, m_ObjectList)
+        // Paged objects are updated when drawn, only the visible ones
+        if (!m_Paged)
+        {
+            foreach (SkyObject *obj, m_ObjectList)
+                updateObject(obj);
+        }
+        this->updateID = KStarsData::Instance()->updateID();
+    }
+}
+
+void CatalogComponent::updateObject(SkyObject *obj)
+{
+    KStarsData *data   = KStarsData::Instance();
+    DeepSkyObject *dso = dynamic_cast<DeepSkyObject *>(obj);
+    StarObject *so     = dynamic_cast<StarObject *>(obj);
+    Q_ASSERT(dso || so); // We either have stars, or deep sky objects
+    if (dso)
+    {
+        // Update the deep sky object if need be
+        if (dso->updateID != data->updateID())
         {
-            DeepSkyObject *dso = dynamic_cast<DeepSkyObject *>(obj);
-            StarObject *so     = dynamic_cast<StarObject *>(obj);
-            Q_ASSERT(dso || so); // We either have stars, or deep sky objects
-            if (dso)
+            dso->updateID = data->updateID();
+            if (dso->updateNumID != data->updateNumID())
             {
-                // Update the deep sky object if need be
-                if (dso->updateID != data->updateID())
-                {
-                    dso->updateID = data->updateID();
-                    if (dso->updateNumID != data->updateNumID())
-                    {
-                        dso->updateCoords(data->updateNum());
-                    }
-                    dso->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-                }
+                dso->updateCoords(data->updateNum());
             }
-            else
+            dso->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+        }
+    }
+    else
+    {
+        // Do exactly the same thing for stars
+        if (so->updateID != data->updateID())
+        {
+            so->updateID = data->updateID();
+            if (so->updateNumID != data->updateNumID())
             {
-                // Do exactly the same thing for stars
-                if (so->updateID != data->updateID())
-                {
-                    so->updateID = data->updateID();
-                    if (so->updateNumID != data->updateNumID())
-                    {
-                        so->updateCoords(data->updateNum());
-                    }
-                    so->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-                }
+                so->updateCoords(data->updateNum());
             }
+            so->EquatorialToHorizontal(data->lst(), data->geo()->lat());
         }
-        this->updateID = data->updateID();
     }
 }
 
@@ -200,30 +273,153 @@ void CatalogComponent::draw(SkyPainter *skyp)
     if (updateID != KStarsData::Instance()->updateID())
         update(nullptr);
 
+    if (m_Paged)
+    {
+        loadVisiblePages();
+
+        MeshIterator region(m_SkyMesh, DRAW_BUF);
+        while (region.hasNext())
+        {
+            auto page = m_Pages.constFind(region.next());
+            if (page == m_Pages.constEnd())
+                continue;
+            for (SkyObject *obj : page->objects)
+            {
+                updateObject(obj);
+                drawObject(skyp, obj);
+            }
+        }
+
+        evictPages();
+        return;
+    }
+
     //Draw Custom Catalog objects
     // FIXME: Improve using HTM!
     foreach (SkyObject *obj, m_ObjectList)
+        drawObject(skyp, obj);
+}
+
+void CatalogComponent::drawObject(SkyPainter *skyp, SkyObject *obj)
+{
+    if (obj->type() == 0)
     {
-        if (obj->type() == 0)
-        {
-            StarObject *starobj = static_cast<StarObject *>(obj);
-            // FIXME SKYPAINTER
-            skyp->drawPointSource(starobj, starobj->mag(), starobj->spchar());
-        }
+        StarObject *starobj = static_cast<StarObject *>(obj);
+        // FIXME SKYPAINTER
+        skyp->drawPointSource(starobj, starobj->mag(), starobj->spchar());
+    }
+    else
+    {
+        // FIXME: this PA calc is totally different from the one that was
+        // in DeepSkyComponent which is now in SkyPainter .... O_o
+        //      --hdevalence
+        // PA for Deep-Sky objects is 90 + PA because major axis is
+        // horizontal at PA=0
+        // double pa = 90. + map->findPA( dso, o.x(), o.y() );
+        //
+        // ^ Not sure if above is still valid -- asimha 2016/08/16
+        DeepSkyObject *dso = static_cast<DeepSkyObject *>(obj);
+        skyp->drawDeepSkyObject(dso, true);
+    }
+}
+
+SkyObject *CatalogComponent::objectNearest(SkyPoint *p, double &maxrad)
+{
+    SkyObject *obj = ListComponent::objectNearest(p, maxrad);
+
+    // The object may become the focus, keep its page as recently used as the visible ones
+    if (obj != nullptr && m_Paged)
+    {
+        auto page = m_Pages.find(m_SkyMesh->index(obj));
+        if (page != m_Pages.end())
+            page->drawID = m_SkyMesh->drawID();
+    }
+
+    return obj;
+}
+
+void CatalogComponent::loadVisiblePages()
+{
+    const DrawID drawID = m_SkyMesh->drawID();
+
+    QVector<Trixel> missing;
+    MeshIterator region(m_SkyMesh, DRAW_BUF);
+    while (region.hasNext())
+    {
+        const Trixel trixel = region.next();
+        auto page           = m_Pages.find(trixel);
+        if (page == m_Pages.end())
+            missing.append(trixel);
         else
-        {
-            // FIXME: this PA calc is totally different from the one that was
-            // in DeepSkyComponent which is now in SkyPainter .... O_o
-            //      --hdevalence
-            // PA for Deep-Sky objects is 90 + PA because major axis is
-            // horizontal at PA=0
-            // double pa = 90. + map->findPA( dso, o.x(), o.y() );
-            //
-            // ^ Not sure if above is still valid -- asimha 2016/08/16
-            DeepSkyObject *dso = static_cast<DeepSkyObject *>(obj);
-            skyp->drawDeepSkyObject(dso, true);
-        }
+            page->drawID = drawID;
+    }
+    if (missing.isEmpty())
+        return;
+
+    // A trixel whose query failed gets an empty page, so that it is not read again at every frame
+    QHash<Trixel, QList<SkyObject *>> objects;
+    KStarsData::Instance()->catalogdb()->GetObjectsInTrixels(m_CatalogId, missing, objects, this,
+                                                            m_IncludeCatalogDesignation);
+    for (Trixel trixel : missing)
+    {
+        Page &page   = m_Pages[trixel];
+        page.objects = objects.value(trixel);
+        page.drawID  = drawID;
+    }
+
+    syncObjectList();
+}
+
+void CatalogComponent::evictPages()
+{
+    const int capacity = static_cast<int>(Options::catalogPageCacheSize());
+    int count          = m_ObjectList.size();
+    if (count <= capacity)
+        return;
+
+    // The pages visible in this draw cycle are kept even beyond the capacity
+    const DrawID drawID = m_SkyMesh->drawID();
+    QVector<QPair<DrawID, Trixel>> candidates;
+    for (auto page = m_Pages.constBegin(); page != m_Pages.constEnd(); ++page)
+    {
+        if (page->drawID != drawID)
+            candidates.append(qMakePair(page->drawID, page.key()));
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    // So are the pages of the objects still in use, which would be left dangling
+    const QSet<const SkyObject *> held = heldObjects();
+    auto isHeld = [&held](const SkyObject *obj) { return held.contains(obj); };
+
+    bool evicted = false;
+    for (const auto &candidate : candidates)
+    {
+        if (count <= capacity)
+            break;
+
+        auto page = m_Pages.find(candidate.second);
+        if (std::any_of(page->objects.cbegin(), page->objects.cend(), isHeld))
+            continue;
+
+        count -= page->objects.size();
+#ifndef KSTARS_LITE
+        VisibilityService::Instance()->forget(page->objects);
+#endif
+        qDeleteAll(page->objects);
+        m_Pages.erase(page);
+        evicted = true;
     }
+
+    if (evicted)
+        syncObjectList();
+}
+
+void CatalogComponent::syncObjectList()
+{
+    m_ObjectList.clear();
+    for (const Page &page : m_Pages)
+        m_ObjectList.append(page.objects);
+    m_NearestIndex.invalidate();
 }
 
 bool CatalogComponent::getVisibility()
@@ -20,13 +20,23 @@
 #include "listcomponent.h"
 #include "Options.h"
 
+#include <QHash>
+
 struct stat;
+class SkyMesh;
 
 /**
  * @class CatalogComponent
  * Represents a custom user-defined catalog.
  * Code adapted from CustomCatalogComponent.cpp originally authored by Thomas Kabelmann --spacetime
  *
+ * Catalogs with more objects than Options::catalogPagingThreshold() are paged: like the
+ * StarBlocks of the deep star catalogs, only the objects of the visible trixels are read
+ * from the database, one page per trixel, and the least recently drawn pages are deleted
+ * beyond Options::catalogPageCacheSize() objects.  The pages holding an object shown by the
+ * sky map, a label or a details dialog are kept until it is released.  objectList() then
+ * only holds the pages in memory, and the objects are not in the name index.
+ *
  * @author Thomas Kabelmann
  *         Rishab Arora (spacetime)
  * @version 0.2
@@ -53,6 +63,8 @@ class CatalogComponent : public ListComponent
 
     void update(KSNumbers *num) override;
 
+    SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
+
     /** @return the name of the catalog */
     inline QString name() const { return m_catName; }
 
@@ -84,6 +96,9 @@ class CatalogComponent : public ListComponent
      **/
     bool selected() override;
 
+    /** @return true if the objects of the catalog are loaded by sky region */
+    bool isPaged() const { return m_Paged; }
+
   protected:
     /** @short Load data into custom catalog */
     virtual void loadData() { _loadData(true); }
@@ -91,10 +106,46 @@ class CatalogComponent : public ListComponent
     /** @short Load data into custom catalog */
     virtual void _loadData(bool includeCatalogDesignation);
 
+    /** @short Load all objects of the catalog and add their names to the name index */
+    void _loadAllObjects(bool includeCatalogDesignation);
+
+    /** @return false if the catalog must stay in memory even when large */
+    virtual bool isPageable() const { return true; }
+
     // FIXME: There seems to be no way to remove catalogs from the program. -- asimha
 
     QString m_catName, m_catColor, m_catFluxFreq, m_catFluxUnit;
     bool m_Showerrs { false };
     int m_ccIndex { 0 };
     quint32 updateID { 0 };
+
+  private:
+    /** @short The objects of a paged catalog lying in one trixel */
+    struct Page
+    {
+        QList<SkyObject *> objects;
+        /// Last draw cycle in which the trixel was visible
+        DrawID drawID { 0 };
+    };
+
+    /** @short Recompute the horizontal coordinates of obj if they are out of date */
+    void updateObject(SkyObject *obj);
+
+    /** @short Draw a star or a deep sky object of the catalog */
+    void drawObject(SkyPainter *skyp, SkyObject *obj);
+
+    /** @short Read the pages of the visible trixels which are not in memory */
+    void loadVisiblePages();
+
+    /** @short Delete the least recently drawn pages beyond the cache size, except the held ones */
+    void evictPages();
+
+    /** @short Rebuild the object list from the pages after they changed */
+    void syncObjectList();
+
+    bool m_Paged { false };
+    bool m_IncludeCatalogDesignation { true };
+    int m_CatalogId { -1 };
+    SkyMesh *m_SkyMesh { nullptr };
+    QHash<Trixel, Page> m_Pages;
 };
@@ -48,7 +48,13 @@
 
 CometsComponent::CometsComponent(SolarSystemComposite *parent) : SolarSystemListComponent(parent)
 {
+#ifdef KSTARS_LITE
+    // The nodes of the objects are created with the sky map
     loadData();
+#else
+    // Not needed to show the sky map, so read in the background
+    loadInBackground(SkyObject::COMET, &CometsComponent::readData);
+#endif
 }
 
 CometsComponent::~CometsComponent()
@@ -91,6 +97,16 @@ bool CometsComponent::selected()
  */
 void CometsComponent::loadData()
 {
+    emitProgressText(i18n("Loading comets"));
+
+    // Wait for the objects still read at startup, the new file replaces them
+    finishLoading();
+    setObjects(SkyObject::COMET, readData());
+}
+
+QList<SkyObject *> CometsComponent::readData()
+{
+    QList<SkyObject *> comets;
     QString name, orbit_id, orbit_class, dimensions;
     bool neo;
     int mJD;
@@ -98,14 +114,6 @@ void CometsComponent::loadData()
     long double JD;
     float M1, M2, K1, K2, diameter, albedo, rot_period, period;
 
-    emitProgressText(i18n("Loading comets"));
-
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
-
-    objectNames(SkyObject::COMET).clear();
-    objectLists(SkyObject::COMET).clear();
-
     QList<QPair<QString, KSParser::DataTypes>> sequence;
     sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
     sequence.append(qMakePair(QString("epoch_mjd"), KSParser::D_INT));
@@ -131,43 +139,65 @@ void CometsComponent::loadData()
 
     QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("comets.dat"));
     KSParser cometParser(file_name, '#', sequence);
-
-    QHash<QString, QVariant> row_content;
-    while (cometParser.HasNextRow())
+    cometParser.UseSnapshot("comets");
+
+    // Read typed rows, with the columns looked up once
+    const int full_name_column  = cometParser.Column("full name");
+    const int epoch_column      = cometParser.Column("epoch_mjd");
+    const int q_column          = cometParser.Column("q");
+    const int e_column          = cometParser.Column("e");
+    const int i_column          = cometParser.Column("i");
+    const int w_column          = cometParser.Column("w");
+    const int om_column         = cometParser.Column("om");
+    const int tp_column         = cometParser.Column("tp_calc");
+    const int orbit_id_column   = cometParser.Column("orbit_id");
+    const int neo_column        = cometParser.Column("neo");
+    const int M1_column         = cometParser.Column("M1");
+    const int M2_column         = cometParser.Column("M2");
+    const int diameter_column   = cometParser.Column("diameter");
+    const int extent_column     = cometParser.Column("extent");
+    const int albedo_column     = cometParser.Column("albedo");
+    const int rot_period_column = cometParser.Column("rot_period");
+    const int period_column     = cometParser.Column("per_y");
+    const int moid_column       = cometParser.Column("moid");
+    const int class_column      = cometParser.Column("class");
+
+    KSParser::Row row;
+    while (cometParser.ReadNextRow(row))
     {
         KSComet *com = nullptr;
-        row_content  = cometParser.ReadNextRow();
-        name         = row_content["full name"].toString();
+        name         = row.toString(full_name_column);
         name         = name.trimmed();
-        mJD          = row_content["epoch_mjd"].toInt();
-        q            = row_content["q"].toDouble();
-        e            = row_content["e"].toDouble();
-        dble_i       = row_content["i"].toDouble();
-        dble_w       = row_content["w"].toDouble();
-        dble_N       = row_content["om"].toDouble();
-        Tp           = row_content["tp_calc"].toDouble();
-        orbit_id     = row_content["orbit_id"].toString();
-        neo          = row_content["neo"] == "Y";
-
-        if (row_content["M1"].toFloat() == 0.0)
+        mJD          = row.toInt(epoch_column);
+        q            = row.toDouble(q_column);
+        e            = row.toDouble(e_column);
+        dble_i       = row.toDouble(i_column);
+        dble_w       = row.toDouble(w_column);
+        dble_N       = row.toDouble(om_column);
+        Tp           = row.toDouble(tp_column);
+        orbit_id     = row.toString(orbit_id_column);
+        neo          = row.equals(neo_column, "Y");
+
+        if (row.toFloat(M1_column) == 0.0)
             M1 = 101.0;
         else
-            M1 = row_content["M1"].toFloat();
+            M1 = row.toFloat(M1_column);
 
-        if (row_content["M2"].toFloat() == 0.0)
+        if (row.toFloat(M2_column) == 0.0)
             M2 = 101.0;
         else
-            M2 = row_content["M2"].toFloat();
-
-        diameter    = row_content["diameter"].toFloat();
-        dimensions  = row_content["extent"].toString();
-        albedo      = row_content["albedo"].toFloat();
-        rot_period  = row_content["rot_period"].toFloat();
-        period      = row_content["per_y"].toFloat();
-        earth_moid  = row_content["moid"].toDouble();
-        orbit_class = row_content["class"].toString();
-        K1          = row_content["H"].toFloat();
-        K2          = row_content["G"].toFloat();
+            M2 = row.toFloat(M2_column);
+
+        diameter    = row.toFloat(diameter_column);
+        dimensions  = row.toString(extent_column);
+        albedo      = row.toFloat(albedo_column);
+        rot_period  = row.toFloat(rot_period_column);
+        period      = row.toFloat(period_column);
+        earth_moid  = row.toDouble(moid_column);
+        orbit_class = row.toString(class_column);
+        // The slope parameters "H" and "G" are skipped in the sequence
+        K1          = 0.0;
+        K2          = 0.0;
 
         JD = static_cast<double>(mJD) + 2400000.5;
 
@@ -182,12 +212,10 @@ void CometsComponent::loadData()
         com->setEarthMOID(earth_moid);
         com->setOrbitClass(orbit_class);
         com->setAngularSize(0.005);
-        m_ObjectList.append(com);
-
-        // Add *short* name to the list of object names
-        objectNames(SkyObject::COMET).append(com->name());
-        objectLists(SkyObject::COMET).append(QPair<QString, const SkyObject *>(com->name(), com));
+        comets.append(com);
     }
+
+    return comets;
 }
 
 void CometsComponent::draw(SkyPainter *skyp)
@@ -204,9 +232,14 @@ void CometsComponent::draw(SkyPainter *skyp)
     skyp->setPen(QPen(QColor("transparent")));
     skyp->setBrush(QBrush(QColor("white")));
 
-    foreach (SkyObject *so, m_ObjectList)
+    refreshView();
+
+    for (int k = 0; k < m_ObjectList.size(); ++k)
     {
-        KSComet *com = (KSComet *)so;
+        if (!isCurrent(k))
+            continue;
+
+        KSComet *com = (KSComet *)m_ObjectList.at(k);
         double mag   = com->mag();
         if (std::isnan(mag) == 0)
         {
@@ -53,6 +53,9 @@ class CometsComponent : public QObject, public SolarSystemListComponent
 
   private:
     void loadData();
+
+    /** @short Read the objects of comets.dat, may be called from any thread */
+    static QList<SkyObject *> readData();
     FileDownloader *downloadJob;
 };
 
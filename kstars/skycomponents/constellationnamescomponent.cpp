@@ -101,6 +101,7 @@ void ConstellationNamesComponent::loadData(CultureList *cultures)
             //Add name to the list of object names
             objectNames(SkyObject::CONSTELLATION).append(name);
             objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject *>(name, o));
+            addToNameIndex(o);
         }
     }
 }
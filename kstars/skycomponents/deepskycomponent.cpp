@@ -33,13 +33,14 @@
 
 #include "kstars_debug.h"
 
-DeepSkyComponent::DeepSkyComponent(SkyComposite *parent) : SkyComponent(parent)
+DeepSkyComponent::DeepSkyComponent(SkyComposite *parent, const QList<CatalogEntry> &entries)
+    : SkyComponent(parent)
 {
     m_skyMesh = SkyMesh::Instance();
     // Add labels
     for (int i = 0; i <= MAX_LINENUMBER_MAG; i++)
         m_labelList[i] = new LabelList;
-    loadData();
+    addObjects(entries);
 }
 
 DeepSkyComponent::~DeepSkyComponent()
@@ -71,9 +72,10 @@ void DeepSkyComponent::update(KSNumbers *)
 {
 }
 
-void DeepSkyComponent::loadData()
+QList<DeepSkyComponent::CatalogEntry> DeepSkyComponent::readData()
 {
-    KStarsData *data = KStarsData::Instance();
+    QList<CatalogEntry> entries;
+
     //Check whether we need to concatenate a split NGC/IC catalog
     //(i.e., if user has downloaded the Steinicke catalog)
     mergeSplitFiles();
@@ -148,18 +150,37 @@ void DeepSkyComponent::loadData()
 
     QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("ngcic.dat"));
     KSParser deep_sky_parser(file_name, '#', sequence, widths);
+    deep_sky_parser.UseSnapshot("ngcic");
 
-    deep_sky_parser.SetProgress(i18n("Loading NGC/IC objects"), 13444, 10);
     qCInfo(KSTARS) << "Loading NGC/IC objects";
 
-    QHash<QString, QVariant> row_content;
-    while (deep_sky_parser.HasNextRow())
+    // Read typed rows, with the columns looked up once. Their fields are trimmed.
+    const int flag_column      = deep_sky_parser.Column("Flag");
+    const int id_column        = deep_sky_parser.Column("ID");
+    const int suffix_column    = deep_sky_parser.Column("suffix");
+    const int ra_h_column      = deep_sky_parser.Column("RA_H");
+    const int ra_m_column      = deep_sky_parser.Column("RA_M");
+    const int ra_s_column      = deep_sky_parser.Column("RA_S");
+    const int sign_column      = deep_sky_parser.Column("D_Sign");
+    const int dec_d_column     = deep_sky_parser.Column("Dec_d");
+    const int dec_m_column     = deep_sky_parser.Column("Dec_m");
+    const int dec_s_column     = deep_sky_parser.Column("Dec_s");
+    const int bmag_column      = deep_sky_parser.Column("BMag");
+    const int type_column      = deep_sky_parser.Column("type");
+    const int a_column         = deep_sky_parser.Column("a");
+    const int b_column         = deep_sky_parser.Column("b");
+    const int pa_column        = deep_sky_parser.Column("pa");
+    const int pgc_column       = deep_sky_parser.Column("PGC");
+    const int other_cat_column = deep_sky_parser.Column("other cat");
+    const int other1_column    = deep_sky_parser.Column("other1");
+    const int messr_column     = deep_sky_parser.Column("Messr");
+    const int messr_num_column = deep_sky_parser.Column("MessrNum");
+    const int longname_column  = deep_sky_parser.Column("Longname");
+
+    KSParser::Row row;
+    while (deep_sky_parser.ReadNextRow(row))
     {
-        row_content = deep_sky_parser.ReadNextRow();
-
-        QString iflag;
         QString cat;
-        iflag = row_content["Flag"].toString().mid(0, 1); //check for NGC/IC catalog flag
         /*
         Q_ASSERT(iflag == "I" || iflag == "N" || iflag == " ");
         // (spacetime): ^ Why an assert? Change in implementation of ksparser
@@ -170,31 +191,30 @@ void DeepSkyComponent::loadData()
         float mag(1000.0);
         int type, ingc, imess(-1), pa;
         int pgc, ugc;
-        QString ss, name, name2, longname;
+        QString name, name2, longname;
         QString cat2;
 
         // Designation
-        if (iflag == "I")
+        if (row.equals(flag_column, "I")) //check for NGC/IC catalog flag
             cat = "IC";
-        else if (iflag == "N")
+        else if (row.equals(flag_column, "N"))
             cat = "NGC";
 
-        ingc = row_content["ID"].toInt(); // NGC/IC catalog number
+        ingc = row.toInt(id_column); // NGC/IC catalog number
         if (ingc == 0)
             cat.clear(); //object is not in NGC or IC catalogs
 
-        QString suffix = row_content["suffix"].toString(); // multipliticity suffixes, eg: the 'A' in NGC 4945A
+        QString suffix = row.toString(suffix_column); // multipliticity suffixes, eg: the 'A' in NGC 4945A
 
         //Q_ASSERT(suffix.isEmpty() || (suffix.isEmpty() == false && suffix.at(0) > 0x40 && suffix.at(0) < 0x7B));
 
         //coordinates
-        int rah     = row_content["RA_H"].toInt();
-        int ram     = row_content["RA_M"].toInt();
-        float ras   = row_content["RA_S"].toFloat();
-        QString sgn = row_content["D_Sign"].toString();
-        int dd      = row_content["Dec_d"].toInt();
-        int dm      = row_content["Dec_m"].toInt();
-        int ds      = row_content["Dec_s"].toInt();
+        int rah   = row.toInt(ra_h_column);
+        int ram   = row.toInt(ra_m_column);
+        float ras = row.toFloat(ra_s_column);
+        int dd    = row.toInt(dec_d_column);
+        int dm    = row.toInt(dec_m_column);
+        int ds    = row.toInt(dec_s_column);
 
         if (!((0.0 <= rah && rah < 24.0) || (0.0 <= ram && ram < 60.0) || (0.0 <= ras && ras < 60.0) ||
               (0.0 <= dd && dd <= 90.0) || (0.0 <= dm && dm < 60.0) || (0.0 <= ds && ds < 60.0)))
@@ -209,43 +229,41 @@ void DeepSkyComponent::loadData()
             continue;
 
         //B magnitude
-        ss = row_content["BMag"].toString();
-        if (ss.isEmpty())
+        if (row.equals(bmag_column, ""))
         {
             mag = 99.9f;
         }
         else
         {
-            mag = ss.toFloat();
+            mag = row.toFloat(bmag_column);
         }
 
         //object type
-        type = row_content["type"].toInt();
+        type = row.toInt(type_column);
 
         //major and minor axes
-        float a = row_content["a"].toFloat();
-        float b = row_content["b"].toFloat();
+        float a = row.toFloat(a_column);
+        float b = row.toFloat(b_column);
 
         //position angle.  The catalog PA is zero when the Major axis
         //is horizontal.  But we want the angle measured from North, so
         //we set PA = 90 - pa.
-        ss = row_content["pa"].toString();
-        if (ss.isEmpty())
+        if (row.equals(pa_column, ""))
         {
             pa = 90;
         }
         else
         {
-            pa = 90 - ss.toInt();
+            pa = 90 - row.toInt(pa_column);
         }
 
         //PGC number
-        pgc = row_content["PGC"].toInt();
+        pgc = row.toInt(pgc_column);
 
         //UGC number
-        if (row_content["other cat"].toString().trimmed() == "UGC")
+        if (row.equals(other_cat_column, "UGC"))
         {
-            ugc = row_content["other1"].toString().toInt();
+            ugc = row.toInt(other1_column);
         }
         else
         {
@@ -253,22 +271,22 @@ void DeepSkyComponent::loadData()
         }
 
         //Messier number
-        if (row_content["Messr"].toString().trimmed() == "M")
+        if (row.equals(messr_column, "M"))
         {
             cat2 = cat;
             if (ingc == 0)
                 cat2.clear();
             cat   = 'M';
-            imess = row_content["MessrNum"].toInt();
+            imess = row.toInt(messr_num_column);
         }
 
-        longname = row_content["Longname"].toString();
+        longname = row.toString(longname_column);
 
         dms r;
         r.setH(rah, ram, int(ras));
         dms d(dd, dm, ds);
 
-        if (sgn == "-")
+        if (row.equals(sign_column, "-"))
         {
             d.setD(-1.0 * d.Degrees());
         }
@@ -314,16 +332,42 @@ void DeepSkyComponent::loadData()
         if (type == 0)
             type = 1; //Make sure we use CATALOG_STAR, not STAR
         o = new DeepSkyObject(type, r, d, mag, name, name2, longname, cat, a, b, pa, pgc, ugc);
+
+        CatalogEntry entry;
+        entry.object   = o;
+        entry.name     = name;
+        entry.name2    = name2;
+        entry.longname = longname;
+        entry.hasName  = hasName;
+        entries.append(entry);
+    }
+
+    return entries;
+}
+
+void DeepSkyComponent::addObjects(const QList<CatalogEntry> &entries)
+{
+    KStarsData *data = KStarsData::Instance();
+
+    for (const CatalogEntry &entry : entries)
+    {
+        DeepSkyObject *o        = entry.object;
+        const QString &name     = entry.name;
+        const QString &name2    = entry.name2;
+        const QString &longname = entry.longname;
+        const int type          = o->type();
+
         o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
 
         // Add the name(s) to the nameHash for fast lookup -jbb
-        if (hasName)
+        if (entry.hasName)
         {
             nameHash[name.toLower()] = o;
             if (!longname.isEmpty())
                 nameHash[longname.toLower()] = o;
             if (!name2.isEmpty())
                 nameHash[name2.toLower()] = o;
+            addToNameIndex(o);
         }
 
         Trixel trixel = m_skyMesh->index(o);
@@ -369,8 +413,6 @@ void DeepSkyComponent::loadData()
             objectNames(type).append(longname);
             objectLists(type).append(QPair<QString, SkyObject *>(longname, o));
         }
-
-        deep_sky_parser.ShowProgress();
     }
 
     for (auto &list : objectNames())
@@ -750,6 +792,7 @@ void DeepSkyComponent::clearList(QList<DeepSkyObject *> &list)
     {
         SkyObject *o = list.takeFirst();
         removeFromNames(o);
+        removeFromNameIndex(o);
         delete o;
     }
 }
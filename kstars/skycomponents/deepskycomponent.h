@@ -55,7 +55,19 @@ class DeepSkyComponent : public SkyComponent
 #endif
 
   public:
-    explicit DeepSkyComponent(SkyComposite *);
+    /** @short A deep sky object read from the catalog, with the names it is looked up by */
+    struct CatalogEntry
+    {
+        DeepSkyObject *object { nullptr };
+        QString name, name2, longname;
+        bool hasName { false };
+    };
+
+    /**
+     * @short Create the component with the objects read beforehand by readData()
+     * @p entries the objects of the catalog, whose ownership is taken
+     */
+    DeepSkyComponent(SkyComposite *, const QList<CatalogEntry> &entries);
 
     ~DeepSkyComponent() override;
 
@@ -104,11 +116,11 @@ class DeepSkyComponent : public SkyComponent
 
     bool selected() override;
 
-  private:
     /**
      * @short Read the ngcic.dat deep-sky database.
-     * Parse all lines from the deep-sky object catalog files. Construct a DeepSkyObject
-     * from the data in each line, and add it to the DeepSkyComponent.
+     * Parse all lines from the deep-sky object catalog files and construct a DeepSkyObject
+     * from the data in each line.  No sky component is touched, so this may run in a worker
+     * thread while the other components load.
      *
      * Each line in the file is parsed according to column position:
      * @li 0        IC indicator [char]  If 'I' then IC object; if ' ' then NGC object
@@ -131,13 +143,17 @@ class DeepSkyComponent : public SkyComponent
      * @li 64-69    PGC Catalog number [int] can be blank
      * @li 71-75    UGC Catalog number [int] can be blank
      * @li 77-END   Common name [string] can be blank
-     * @return true if data file is successfully read.
+     * @return the objects read, owned by the caller until passed to the constructor
      */
-    void loadData();
+    static QList<CatalogEntry> readData();
+
+  private:
+    /** @short Add the objects read by readData() to the lists, the sky mesh index and the name tables */
+    void addObjects(const QList<CatalogEntry> &entries);
 
     void clearList(QList<DeepSkyObject *> &list);
 
-    void mergeSplitFiles();
+    static void mergeSplitFiles();
 
     void drawDeepSkyCatalog(SkyPainter *skyp, bool drawObject, DeepSkyIndex *dsIndex, const QString &colorString,
                             bool drawImage = false);
@@ -20,6 +20,7 @@
 #include "kstarsdata.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
+#include "tools/visibilityservice.h"
 #endif
 
 ListComponent::ListComponent(SkyComposite *parent) : SkyComponent(parent)
@@ -28,6 +29,11 @@ ListComponent::ListComponent(SkyComposite *parent) : SkyComponent(parent)
 
 ListComponent::~ListComponent()
 {
+    foreach (SkyObject *o, m_ObjectList)
+        removeFromNameIndex(o);
+#ifndef KSTARS_LITE
+    VisibilityService::Instance()->forget(m_ObjectList);
+#endif
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
     clear();
@@ -35,12 +41,17 @@ ListComponent::~ListComponent()
 
 void ListComponent::clear()
 {
+#ifndef KSTARS_LITE
+    VisibilityService::Instance()->forget(m_ObjectList);
+#endif
     while (!m_ObjectList.isEmpty())
     {
         SkyObject *o = m_ObjectList.takeFirst();
         removeFromNames(o);
+        removeFromNameIndex(o);
         delete o;
     }
+    m_NearestIndex.invalidate();
 }
 
 void ListComponent::update(KSNumbers *num)
@@ -74,15 +85,6 @@ SkyObject *ListComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
-    SkyObject *oBest = nullptr;
-    foreach (SkyObject *o, m_ObjectList)
-    {
-        double r = o->angularDistanceTo(p).Degrees();
-        if (r < maxrad)
-        {
-            oBest  = o;
-            maxrad = r;
-        }
-    }
-    return oBest;
+    m_NearestIndex.update(m_ObjectList);
+    return m_NearestIndex.objectNearest(p, maxrad);
 }
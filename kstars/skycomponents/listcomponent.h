@@ -18,6 +18,7 @@
 #pragma once
 
 #include "skycomponent.h"
+#include "skyobjecttrixelindex.h"
 
 #include <QList>
 
@@ -61,4 +62,6 @@ class ListComponent : public SkyComponent
 
   protected:
     QList<SkyObject *> m_ObjectList;
+    /// Used by objectNearest(), invalidate it when deleting or moving objects
+    SkyObjectTrixelIndex m_NearestIndex;
 };
@@ -38,6 +38,8 @@ SatellitesComponent::SatellitesComponent(SkyComposite *parent) : SkyComponent(pa
 
 SatellitesComponent::~SatellitesComponent()
 {
+    foreach (Satellite *sat, nameHash)
+        removeFromNameIndex(sat);
     qDeleteAll(m_groups);
     m_groups.clear();
 }
@@ -76,9 +78,22 @@ void SatellitesComponent::loadData()
                 objectNames(SkyObject::SATELLITE).append(sat->name());
                 objectLists(SkyObject::SATELLITE).append(QPair<QString, const SkyObject *>(sat->name(), sat));
                 nameHash[sat->name().toLower()] = sat;
+                addToNameIndex(sat);
             }
         }
     }
+    updateSatelliteList();
+}
+
+void SatellitesComponent::updateSatelliteList()
+{
+    m_Satellites.clear();
+    foreach (SatelliteGroup *group, m_groups)
+    {
+        for (int i = 0; i < group->size(); i++)
+            m_Satellites.append(group->at(i));
+    }
+    m_NearestIndex.invalidate();
 }
 
 bool SatellitesComponent::selected()
@@ -92,10 +107,14 @@ void SatellitesComponent::update(KSNumbers *)
     if (!selected())
         return;
 
+    // Satellites below the horizon can be skipped if they are not drawn anyway
+    const Satellite::Context context = Satellite::context(Options::showGround() || Options::showVisibleSatellites());
+
     foreach (SatelliteGroup *group, m_groups)
     {
-        group->updateSatellitesPos();
+        group->updateSatellitesPos(context);
     }
+    m_NearestIndex.invalidate();
 }
 
 void SatellitesComponent::draw(SkyPainter *skyp)
@@ -182,7 +201,8 @@ void SatellitesComponent::updateTLEs()
                 file.write(response->readAll());
                 file.close();
                 group->readTLE();
-                group->updateSatellitesPos();
+                group->updateSatellitesPos(Satellite::context());
+                updateSatelliteList();
                 progressDlg.setValue(++i);
             }
             else
@@ -224,34 +244,10 @@ SkyObject *SatellitesComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
-    //KStarsData* data = KStarsData::Instance();
-
-    SkyObject *oBest = nullptr;
-    double rBest     = maxrad;
-    double r;
-
-    foreach (SatelliteGroup *group, m_groups)
-    {
-        for (int i = 0; i < group->size(); i++)
-        {
-            Satellite *sat = group->at(i);
-            if (!sat->selected())
-                continue;
-
-            r = sat->angularDistanceTo(p).Degrees();
-            //qDebug() << sat->name();
-            //qDebug() << "r = " << r << " - max = " << rBest;
-            //qDebug() << "ra2=" << sat->ra().Degrees() << " - dec2=" << sat->dec().Degrees();
-            if (r < rBest)
-            {
-                rBest = r;
-                oBest = sat;
-            }
-        }
-    }
+    m_NearestIndex.update(m_Satellites);
 
-    maxrad = rBest;
-    return oBest;
+    return m_NearestIndex.objectNearest(p, maxrad,
+                                        [](SkyObject *o) { return static_cast<Satellite *>(o)->selected(); });
 }
 
 SkyObject *SatellitesComponent::findByName(const QString &name)
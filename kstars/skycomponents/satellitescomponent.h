@@ -19,6 +19,7 @@
 
 #include "satellitegroup.h"
 #include "skycomponent.h"
+#include "skyobjecttrixelindex.h"
 
 #include <QList>
 
@@ -107,6 +108,11 @@ class SatellitesComponent : public SkyComponent
     void drawTrails(SkyPainter *skyp) override;
 
   private:
+    /** @short Collect the satellites of all groups for the nearest object index */
+    void updateSatelliteList();
+
     QList<SatelliteGroup *> m_groups; // List of all groups
     QHash<QString, Satellite *> nameHash;
+    QList<SkyObject *> m_Satellites; // All satellites, rebuilt when the groups are read
+    SkyObjectTrixelIndex m_NearestIndex { 0 }; // Rebuilt after each position update
 };
@@ -19,6 +19,7 @@
 
 #include "Options.h"
 #include "skycomposite.h"
+#include "skyobjectnameindex.h"
 #include "skyobjects/skyobject.h"
 
 SkyComponent::SkyComponent(SkyComposite *parent) : m_parent(parent)
@@ -77,6 +78,27 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyComponent::getObjectL
     return parent()->objectLists();
 }
 
+SkyObjectNameIndex *SkyComponent::getNameIndex()
+{
+    if (!parent())
+        return nullptr;
+    return parent()->nameIndex();
+}
+
+void SkyComponent::addToNameIndex(SkyObject *obj)
+{
+    SkyObjectNameIndex *index = getNameIndex();
+    if (index)
+        index->insert(obj);
+}
+
+void SkyComponent::removeFromNameIndex(const SkyObject *obj)
+{
+    SkyObjectNameIndex *index = getNameIndex();
+    if (index)
+        index->remove(obj);
+}
+
 void SkyComponent::removeFromNames(const SkyObject *obj)
 {
     QStringList &names = getObjectNames()[obj->type()];
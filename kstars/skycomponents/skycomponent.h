@@ -23,6 +23,7 @@
 class QString;
 
 class SkyObject;
+class SkyObjectNameIndex;
 class SkyPoint;
 class SkyComposite;
 class SkyPainter;
@@ -196,13 +197,32 @@ class SkyComponent
 
     inline QVector<QPair<QString, const SkyObject *>> &objectLists(int type) { return getObjectLists()[type]; }
 
+    /**
+     * @return the name index of the sky map, or nullptr if this component
+     * is not part of a SkyMapComposite
+     */
+    inline SkyObjectNameIndex *nameIndex() { return getNameIndex(); }
+
   protected:
     void removeFromNames(const SkyObject *obj);
     void removeFromLists(const SkyObject *obj);
 
+    /**
+     * @short Make the object findable by name through SkyMapComposite::findByName()
+     * @see SkyObjectNameIndex
+     */
+    void addToNameIndex(SkyObject *obj);
+
+    /**
+     * @short Remove the object from the name index.
+     * @note This must be called before the object is deleted
+     */
+    void removeFromNameIndex(const SkyObject *obj);
+
   private:
     virtual QHash<int, QStringList> &getObjectNames();
     virtual QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists();
+    virtual SkyObjectNameIndex *getNameIndex();
 
     // Disallow copying and assignment
     SkyComponent(const SkyComponent &);
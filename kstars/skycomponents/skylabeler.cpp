@@ -17,7 +17,10 @@
 
 #include "skylabeler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <limits>
 
 #include <QPainter>
 #include <QPixmap>
@@ -27,17 +30,30 @@
 #include "skymap.h"
 #include "projections/projector.h"
 
-//---------------------------------------------------------------------------//
-// A Little data container class
-//---------------------------------------------------------------------------//
+namespace
+{
+/** Bits lo..hi (inclusive) of a 64-bit word of the virtual screen. */
+inline quint64 cellMask(int lo, int hi)
+{
+    return (~quint64(0) << lo) & (~quint64(0) >> (63 - hi));
+}
+
+/** @return the magnitude used to order the labels, objects of unknown magnitude come last */
+inline float labelMagnitude(const SkyLabel &label)
+{
+    const float mag = label.obj->mag();
+    return std::isnan(mag) ? std::numeric_limits<float>::infinity() : mag;
+}
 
-typedef struct LabelRun
+/** Brighter objects get their labels first. */
+bool brighterLabel(const SkyLabel &a, const SkyLabel &b)
 {
-    LabelRun(int s, int e) : start(s), end(e) {}
-    int start;
-    int end;
+    return labelMagnitude(a) < labelMagnitude(b);
+}
 
-} LabelRun;
+/** Upper bound on the number of widths remembered for each font. */
+const int MAX_CACHED_WIDTHS = 20000;
+}
 
 //----- Now for the main event ----------------------------------------------//
 
@@ -108,15 +124,6 @@ SkyLabeler::SkyLabeler()
 
 SkyLabeler::~SkyLabeler()
 {
-    for (int y = 0; y < screenRows.size(); y++)
-    {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        delete row;
-    }
 }
 
 bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
@@ -177,7 +184,7 @@ bool SkyLabeler::drawNameLabel(SkyObject *obj, const QPointF &_p)
     double offset = obj->labelOffset();
     QPointF p(_p.x() + offset, _p.y() + offset);
 
-    if (!markText(p, sLabel))
+    if (!markRegion(p.x(), p.x() + labelWidth(obj, sLabel), p.y(), p.y() - m_fontMetrics.height()))
     {
         return false;
     }
@@ -201,6 +208,38 @@ void SkyLabeler::setFont(const QFont &font)
     m_drawFont = font;
 #endif
     m_fontMetrics = QFontMetrics(font);
+
+    QString key = font.key();
+    m_widthFont = m_widthFonts.indexOf(key);
+    if (m_widthFont < 0)
+    {
+        m_widthFonts.append(key);
+        m_widthCache.append(LabelWidthCache());
+        m_widthFont = m_widthFonts.size() - 1;
+    }
+}
+
+qreal SkyLabeler::labelWidth(const SkyObject *obj, const QString &text)
+{
+    if (m_widthFont < 0)
+        return m_fontMetrics.width(text);
+
+    LabelWidthCache &cache = m_widthCache[m_widthFont];
+    LabelWidthCache::iterator it = cache.find(obj);
+
+    // The object pointer alone is not enough: deep star blocks recycle their
+    // StarObjects and the star label depends on the name/magnitude options.
+    if (it != cache.end() && it->text == text)
+        return it->width;
+
+    if (cache.size() > MAX_CACHED_WIDTHS)
+        cache.clear();
+
+    CachedLabelWidth entry;
+    entry.text  = text;
+    entry.width = m_fontMetrics.width(text);
+    cache.insert(obj, entry);
+    return entry.width;
 }
 
 void SkyLabeler::setPen(const QPen &pen)
@@ -274,58 +313,51 @@ void SkyLabeler::reset(SkyMap *skyMap)
     setZoomFont();
     m_skyFont     = m_p.font();
     m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
 
     // ----- Set up Zoom Dependent Offset -----
     m_offset = SkyLabeler::ZoomOffset();
 
     // ----- Prepare Virtual Screen -----
-    m_yScale = (m_fontMetrics.height() + 1.0);
-
-    int maxY = int(skyMap->height() / m_yScale);
-    if (maxY < 1)
-        maxY = 1; // prevents a crash below?
-
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
+    resetScreen(skyMap->width(), skyMap->height());
+}
 
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
+void SkyLabeler::resetScreen(int width, int height)
+{
+    m_yScale = (m_fontMetrics.height() + 1.0);
 
-    // Clear all pre-existing rows as needed
+    m_maxY = int(height / m_yScale);
+    if (m_maxY < 1)
+        m_maxY = 1; // prevents a crash below?
 
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
+    m_maxX = int(width / m_xScale);
+    if (m_maxX < 1)
+        m_maxX = 1;
 
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        row->clear();
-    }
+    m_rowWords = (m_maxX >> 6) + 1;
+    m_size     = (m_maxY + 1) * (m_maxX + 1);
 
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
+    // Resizes only if needed and clears the bitmap in the same pass
+    m_screen.fill(0, (m_maxY + 1) * m_rowWords);
 
     // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
+    m_marks = m_hits = m_misses = 0;
 
     //----- Clear out labelList -----
     for (int i = 0; i < labelList.size(); i++)
     {
         labelList[i].clear();
     }
+
+    // Label widths depend on the zoom dependent font size
+    if (Options::zoomFactor() != m_widthZoom)
+    {
+        m_widthZoom = Options::zoomFactor();
+        for (int i = 0; i < m_widthCache.size(); i++)
+        {
+            m_widthCache[i].clear();
+        }
+    }
+    setFont(m_skyFont);
 }
 
 #ifdef KSTARS_LITE
@@ -339,57 +371,12 @@ void SkyLabeler::reset()
     setZoomFont();
     m_skyFont     = m_drawFont;
     m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
+
     // ----- Set up Zoom Dependent Offset -----
     m_offset = ZoomOffset();
 
     // ----- Prepare Virtual Screen -----
-    m_yScale = (m_fontMetrics.height() + 1.0);
-
-    int maxY = int(skyMap->height() / m_yScale);
-    if (maxY < 1)
-        maxY = 1; // prevents a crash below?
-
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
-
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        row->clear();
-    }
-
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
-
-    // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
-
-    //----- Clear out labelList -----
-    for (int i = 0; i < labelList.size(); i++)
-    {
-        labelList[i].clear();
-    }
+    resetScreen(skyMap->width(), skyMap->height());
 }
 #endif
 
@@ -408,10 +395,9 @@ void SkyLabeler::draw(QPainter &p)
     //m_p.begin(&m_picture);
 }
 
-// We use Run Length Encoding to hold the information instead of an array of
-// chars.  This is both faster and smaller but the code is more complicated.
-//
-// This code is easy to break and hard to fix.
+// The virtual screen is a bitmap with one bit per cell.  Each row of cells is
+// m_rowWords 64-bit words long so a label only touches a couple of words per
+// row no matter how crowded the screen already is.
 
 bool SkyLabeler::markText(const QPointF &p, const QString &text)
 {
@@ -422,22 +408,35 @@ bool SkyLabeler::markText(const QPointF &p, const QString &text)
 
 bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
 {
-    if (m_maxY < 1)
+    if (m_screen.isEmpty())
     {
         if (!m_errors++)
             qDebug() << QString("Someone forgot to reset the SkyLabeler!");
         return true;
     }
 
-    // setup x coordinates of rectangular region
-    int minX = int(left);
-    int maxX = int(right);
+    // setup x coordinates of rectangular region, in cells
+    int minX = int(floor(left / m_xScale));
+    int maxX = int(floor(right / m_xScale));
     if (maxX < minX)
     {
-        maxX = minX;
-        minX = int(right);
+        int temp = maxX;
+        maxX     = minX;
+        minX     = temp;
+    }
+
+    // Entirely off the sides of the screen, nothing to collide with
+    if (maxX < 0 || minX > m_maxX)
+    {
+        m_hits++;
+        return true;
     }
 
+    if (minX < 0)
+        minX = 0;
+    if (maxX > m_maxX)
+        maxX = m_maxX;
+
     // setup y coordinates
     int maxY = int(bot / m_yScale);
     int minY = int(top / m_yScale);
@@ -458,114 +457,39 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
         minY     = temp;
     }
 
+    const int firstWord = minX >> 6;
+    const int lastWord  = maxX >> 6;
+
     // check to see if we overlap any existing label
     // We must check all rows before we start marking
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-        int i;
-        for (i = 0; i < row->size(); i++)
+        const quint64 *row = m_screen.constData() + y * m_rowWords;
+        for (int w = firstWord; w <= lastWord; w++)
         {
-            if (row->at(i)->end < minX)
-                continue; // skip past these
-            if (row->at(i)->start > maxX)
-                break;
-            m_misses++;
-            return false;
+            int lo = (w == firstWord) ? (minX & 63) : 0;
+            int hi = (w == lastWord) ? (maxX & 63) : 63;
+            if (row[w] & cellMask(lo, hi))
+            {
+                m_misses++;
+                return false;
+            }
         }
     }
 
     m_hits++;
     m_marks += (maxX - minX + 1) * (maxY - minY + 1);
 
-    // Okay, there was no overlap so let's insert the current rectangle into
-    // screenRows.
-
+    // Okay, there was no overlap so let's mark the current rectangle
+    quint64 *screen = m_screen.data();
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-
-        // Simplest case: an empty row
-        if (row->size() < 1)
+        quint64 *row = screen + y * m_rowWords;
+        for (int w = firstWord; w <= lastWord; w++)
         {
-            row->append(new LabelRun(minX, maxX));
-            m_elements++;
-            continue;
-        }
-
-        // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
-
-        // i now points to first label PAST ours
-
-        // if we are first, append or merge at start of list
-        if (i == 0)
-        {
-            if (row->at(0)->start - maxX < m_minDeltaX)
-            {
-                row->at(0)->start = minX;
-            }
-            else
-            {
-                row->insert(0, new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we are past the last label, merge or append at end
-        else if (i == row->size())
-        {
-            if (minX - row->at(i - 1)->end < m_minDeltaX)
-            {
-                row->at(i - 1)->end = maxX;
-            }
-            else
-            {
-                row->append(new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we got here, we must insert or merge the new label
-        //  between [i-1] and [i]
-
-        bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
-        bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
-
-        // double merge => combine all 3 into one
-        if (mergeHead && mergeTail)
-        {
-            row->at(i - 1)->end = row->at(i)->end;
-            delete row->at(i);
-            row->removeAt(i);
-            m_elements--;
-        }
-
-        // Merge label with [i-1]
-        else if (mergeHead)
-        {
-            row->at(i - 1)->end = maxX;
-        }
-
-        // Merge label with [i]
-        else if (mergeTail)
-        {
-            row->at(i)->start = minX;
-        }
-
-        // insert between the two
-        else
-        {
-            row->insert(i, new LabelRun(minX, maxX));
-            m_elements++;
+            int lo = (w == firstWord) ? (minX & 63) : 0;
+            int hi = (w == lastWord) ? (maxX & 63) : 63;
+            row[w] |= cellMask(lo, hi);
         }
     }
 
@@ -629,7 +553,8 @@ void SkyLabeler::drawQueuedLabels()
 
 void SkyLabeler::drawQueuedLabelsType(SkyLabeler::label_t type)
 {
-    LabelList list = labelList[type];
+    LabelList &list = labelList[type];
+    std::stable_sort(list.begin(), list.end(), brighterLabel);
     for (int i = 0; i < list.size(); i++)
     {
         drawNameLabel(list.at(i).obj, list.at(i).o);
@@ -683,8 +608,8 @@ void SkyLabeler::printInfo()
     printf("  hits=%d  misses=%d  ratio=%.1f%%\n", m_hits, m_misses, hitRatio());
     printf("  yScale=%.1f maxY=%d\n", m_yScale, m_maxY);
 
-    printf("  screenRows=%d elements=%d virtualSize=%.1f Kbytes\n", screenRows.size(), m_elements,
-           float(m_size) / 1024.0);
+    printf("  xScale=%.1f maxX=%d words/row=%d\n", m_xScale, m_maxX, m_rowWords);
+    printf("  cells=%d virtualSize=%.1f Kbytes\n", m_size, float(m_screen.size() * sizeof(quint64)) / 1024.0);
 
     return;
 
@@ -704,28 +629,4 @@ void SkyLabeler::printInfo()
 //        printf("  %20ss: %d\n", labelName[i], labelList[i].size());
 //    }
 //
-//    // Check for errors in the data structure
-//    for (int y = 0; y <= m_maxY; y++)
-//    {
-//        LabelRow *row = screenRows[y];
-//        int size      = row->size();
-//        if (size < 2)
-//            continue;
-//
-//        bool error = false;
-//        for (int i = 1; i < size; i++)
-//        {
-//            if (row->at(i - 1)->end > row->at(i)->start)
-//                error = true;
-//        }
-//        if (!error)
-//            continue;
-//
-//        printf("ERROR: %3d: ", y);
-//        for (int i = 0; i < row->size(); i++)
-//        {
-//            printf("(%d, %d) ", row->at(i)->start, row->at(i)->end);
-//        }
-//        printf("\n");
-//    }
 }
@@ -20,7 +20,9 @@
 #include "skylabel.h"
 
 #include <QFontMetricsF>
+#include <QHash>
 #include <QList>
+#include <QStringList>
 #include <QVector>
 #include <QPainter>
 #include <QPicture>
@@ -30,10 +32,6 @@ class QString;
 class QPointF;
 class SkyMap;
 class Projector;
-struct LabelRun;
-
-typedef QList<LabelRun *> LabelRow;
-typedef QVector<LabelRow *> ScreenRows;
 
 /**
  *@class SkyLabeler
@@ -47,21 +45,18 @@ typedef QVector<LabelRow *> ScreenRows;
  * and return true.
  *
  * Since we need to check for overlap for every label every time it is
- * potentially drawn on the screen, efficiency is essential.  So instead of
- * having a 2-dimensional array of boolean values we use Run Length Encoding
- * and store the virtual array in a QVector of QLists.  Each element of the
- * vector, a LabelRow, corresponds to a horizontal strip of pixels on the actual
- * screen.  How many vertical pixels are in each strip is controlled by
- * m_yDensity.  The higher the density, the fewer vertical pixels per strip and
- * hence a larger number of strips are needed to cover the screen.  As
- * m_yDensity increases so does the density of the strips.
+ * potentially drawn on the screen, efficiency is essential.  The virtual
+ * screen is a fixed grid of cells stored as a bitmap.  Each row of the grid
+ * corresponds to a horizontal strip of pixels on the actual screen whose height
+ * is set by the font height, and each cell in that row covers m_xScale
+ * horizontal pixels.  A row is stored as a small number of 64-bit words so
+ * checking or marking the cells covered by a label takes a couple of mask
+ * operations per strip no matter how many labels are already on the screen.
  *
- * The information in the X-dimension is completed run length encoded. A
- * consecutive run of pixels in one strip that are covered by one or more labels
- * is stored in a LabelRun object that merely stores the start pixel and the end
- * pixel.  A LabelRow is a list of LabelRun's stored in ascending order.  This
- * saves a lot of space over an explicit array and it also makes checking for
- * overlaps faster and even makes inserting new overlaps faster on average.
+ * The width of a name label only changes when its text or the font does, so
+ * drawNameLabel() caches the width per object (and per font) and only calls
+ * QFontMetricsF::width() when the label text changes.  The cache is dropped
+ * whenever the zoom level changes.
  *
  * Synopsis:
  *
@@ -88,7 +83,8 @@ typedef QVector<LabelRow *> ScreenRows;
  * Each type of label has its own buffer which lets us control the font and
  * color as well as the priority.  The priority is now manually set in the
  * draw() routine by adjusting the order in which the various buffers get
- * drawn.
+ * drawn.  Within a buffer the labels are sorted once by magnitude before they
+ * are drawn so the brightest objects win any collision.
  *
  * Finally, even though this code was written to be very efficient, we might
  * want to take some care in how many labels we throw at it.  Sending it
@@ -271,7 +267,8 @@ class SkyLabeler
 
     /**
          * @short a convenience routine that draws all the labels from a single
-         * buffer. Currently this is only called from within draw() above.
+         * buffer, brightest objects first. Currently this is only called from
+         * within draw() above.
          */
     void drawQueuedLabelsType(SkyLabeler::label_t type);
 
@@ -332,17 +329,37 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
-    ScreenRows screenRows;
+    /**
+         * @short resizes and clears the virtual screen to cover a window of
+         * the given size in pixels.  Called from reset().
+         */
+    void resetScreen(int width, int height);
+
+    /**
+         * @short returns the width of the label text of obj in the current
+         * font, using the cached value if the text has not changed.
+         */
+    qreal labelWidth(const SkyObject *obj, const QString &text);
+
+    struct CachedLabelWidth
+    {
+        QString text;
+        qreal width;
+    };
+    typedef QHash<const SkyObject *, CachedLabelWidth> LabelWidthCache;
+
+    /// Occupancy bitmap of the virtual screen, m_rowWords words per row
+    QVector<quint64> m_screen;
+    int m_rowWords { 0 };
     int m_maxX { 0 };
     int m_maxY { 0 };
     int m_size { 0 };
-    /// When to merge two adjacent regions
-    int m_minDeltaX { 30 };
     int m_marks { 0 };
     int m_hits { 0 };
     int m_misses { 0 };
-    int m_elements { 0 };
     int m_errors { 0 };
+    /// Width in pixels of one cell of the virtual screen
+    qreal m_xScale { 4 };
     qreal m_yScale { 0 };
     double m_offset { 0 };
     QFont m_stdFont, m_skyFont;
@@ -354,6 +371,11 @@ class SkyLabeler
     QPainter m_p;
     QPicture m_picture;
     QVector<LabelList> labelList;
+    /// Label widths, one cache per font in m_widthFonts
+    QVector<LabelWidthCache> m_widthCache;
+    QStringList m_widthFonts;
+    int m_widthFont { -1 };
+    double m_widthZoom { 0 };
     const Projector *m_proj { nullptr };
     static SkyLabeler *pinstance;
 };
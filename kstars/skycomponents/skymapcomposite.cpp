@@ -18,7 +18,9 @@
 #include "skymapcomposite.h"
 
 #include "artificialhorizoncomponent.h"
+#include "asteroidscomponent.h"
 #include "catalogcomponent.h"
+#include "cometscomponent.h"
 #include "constellationartcomponent.h"
 #include "constellationboundarylines.h"
 #include "constellationlines.h"
@@ -47,6 +49,7 @@
 #include "supernovaecomponent.h"
 #include "syncedcatalogcomponent.h"
 #include "targetlistcomponent.h"
+#include "auxiliary/startuptaskgraph.h"
 #include "projections/projector.h"
 #include "skyobjects/deepskyobject.h"
 #include "skyobjects/ksplanet.h"
@@ -91,7 +94,7 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m
     addComponent(m_Equator = new Equator(this), 95);
     addComponent(m_Ecliptic = new Ecliptic(this), 95);
     addComponent(m_Horizon = new HorizonComponent(this), 100);
-    addComponent(m_DeepSky = new DeepSkyComponent(this), 5);
+    addComponent(m_DeepSky = new DeepSkyComponent(this, DeepSkyComponent::readData()), 5);
     addComponent(m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
 
     addComponent(m_ArtificialHorizon = new ArtificialHorizonComponent(this), 110);
@@ -131,22 +134,61 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
     SkyMapLite::Instance()->loadingFinished();
 #else
-    addComponent(m_MilkyWay = new MilkyWay(this), 50);
-    addComponent(m_Stars = StarComponent::Create(this), 10);
-    addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
-    addComponent(m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this));
-    addComponent(m_LocalMeridianComponent = new LocalMeridianComponent(this));
+    // The star and deep sky catalogs are read in worker threads while the main thread builds the
+    // other components.  Adding their objects to the sky mesh and the name tables, which are not
+    // thread safe, is left to the main thread, like the components reading them.
+    StarComponent::StaticData namedStars;
+    QList<DeepSkyComponent::CatalogEntry> deepSkyEntries;
+    StartupTaskGraph tasks;
+
+    tasks.addTask("Star catalog", [&]()
+    {
+        namedStars = StarComponent::readStaticData();
+        return true;
+    }, QStringList(), StartupTaskGraph::Background);
 
-    // Do add to components.
-    addComponent(m_CBoundLines = new ConstellationBoundaryLines(this), 80);
-    m_Cultures.reset(new CultureList());
-    addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()), 85);
-    addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()), 90);
-    addComponent(m_Equator = new Equator(this), 95);
-    addComponent(m_Ecliptic = new Ecliptic(this), 95);
-    addComponent(m_Horizon = new HorizonComponent(this), 100);
-    addComponent(m_DeepSky = new DeepSkyComponent(this), 5);
-    addComponent(m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
+    tasks.addTask("Deep sky catalog", [&]()
+    {
+        deepSkyEntries = DeepSkyComponent::readData();
+        return true;
+    }, QStringList(), StartupTaskGraph::Background);
+
+    tasks.addTask("Reference lines", [&]()
+    {
+        addComponent(m_MilkyWay = new MilkyWay(this), 50);
+        addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
+        addComponent(m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this));
+        addComponent(m_LocalMeridianComponent = new LocalMeridianComponent(this));
+        addComponent(m_CBoundLines = new ConstellationBoundaryLines(this), 80);
+        addComponent(m_Equator = new Equator(this), 95);
+        addComponent(m_Ecliptic = new Ecliptic(this), 95);
+        addComponent(m_Horizon = new HorizonComponent(this), 100);
+        return true;
+    });
+
+    tasks.addTask("Stars", [&]()
+    {
+        addComponent(m_Stars = StarComponent::Create(this, namedStars), 10);
+        return true;
+    }, QStringList() << "Star catalog");
+
+    //Stars must come before constellation lines
+    tasks.addTask("Constellations", [&]()
+    {
+        m_Cultures.reset(new CultureList());
+        addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()), 85);
+        addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()), 90);
+        addComponent(m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
+        return true;
+    }, QStringList() << "Stars");
+
+    tasks.addTask("Deep sky objects", [&]()
+    {
+        addComponent(m_DeepSky = new DeepSkyComponent(this, deepSkyEntries), 5);
+        return true;
+    }, QStringList() << "Deep sky catalog");
+
+    tasks.run();
 
     // Hips
     addComponent(m_HiPS = new HIPSComponent(this));
@@ -579,6 +621,11 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyMapComposite::getObje
     return m_ObjectLists;
 }
 
+SkyObjectNameIndex *SkyMapComposite::getNameIndex()
+{
+    return &m_NameIndex;
+}
+
 QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1, const SkyPoint &p2)
 {
     const SkyRegion &region = m_skyMesh->skyRegion(p1, p2);
@@ -599,40 +646,33 @@ SkyObject *SkyMapComposite::findByName(const QString &name)
         return nullptr;
 #endif
 
-    //We search the children in an "intelligent" order (most-used
-    //object types first), in order to avoid wasting too much time
-    //looking for a match.  The most important part of this ordering
-    //is that stars should be last (because the stars list is so long)
-    SkyObject *o = nullptr;
-    o            = m_SolarSystem->findByName(name);
-    if (o)
-        return o;
-    o = m_DeepSky->findByName(name);
-    if (o)
-        return o;
-    o = m_CustomCatalogs->findByName(name);
-    if (o)
-        return o;
-    o = m_internetResolvedComponent->findByName(name);
-    if (o)
-        return o;
-    o = m_manualAdditionsComponent->findByName(name);
-    if (o)
-        return o;
-    o = m_CNames->findByName(name);
-    if (o)
-        return o;
-    o = m_Stars->findByName(name);
-    if (o)
-        return o;
-    o = m_Supernovae->findByName(name);
-    if (o)
-        return o;
-    o = m_Satellites->findByName(name);
+    // The asteroids and comets may still be read in the background
+    m_SolarSystem->finishLoading();
+
+    // All named objects are registered in the name index by their components,
+    // which resolves duplicate names in the order the components used to be
+    // searched: solar system, deep sky, custom catalogs, constellations, stars,
+    // supernovae and satellites.
+    SkyObject *o = m_NameIndex.find(name);
+
+    // Not every solar system body is registered (e.g. the moons of the planets),
+    // so search the solar system the old way before giving up
+    if (!o)
+        o = m_SolarSystem->findByName(name);
+
     if (o)
-        return o;
+        refreshObject(o);
 
-    return nullptr;
+    return o;
+}
+
+void SkyMapComposite::refreshObject(const SkyObject *o)
+{
+    // Faint or off-screen minor bodies may have been skipped by the last update
+    if (o->type() == SkyObject::ASTEROID)
+        m_SolarSystem->asteroidsComponent()->refreshObject(o);
+    else if (o->type() == SkyObject::COMET)
+        m_SolarSystem->cometsComponent()->refreshObject(o);
 }
 
 SkyObject *SkyMapComposite::findStarByGenetiveName(const QString name)
@@ -668,7 +708,8 @@ KSPlanetBase *SkyMapComposite::planet(int n)
 void SkyMapComposite::addCustomCatalog(const QString &filename, int index)
 {
     CatalogComponent *cc = new CatalogComponent(this, filename, false, index);
-    if (cc->objectList().size())
+    // A paged catalog reads its objects only when drawn
+    if (cc->isPaged() || cc->objectList().size())
     {
         m_CustomCatalogs->addComponent(cc);
     }
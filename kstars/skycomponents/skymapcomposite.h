@@ -20,6 +20,7 @@
 #include "skycomposite.h"
 #include "ksnumbers.h"
 #include "skyobject.h"
+#include "skyobjectnameindex.h"
 
 #include <QList>
 
@@ -153,6 +154,14 @@ class SkyMapComposite : public QObject, public SkyComposite
      */
     SkyObject *findByName(const QString &name) override;
 
+    /**
+     * @short Bring o up to date if the last update skipped it
+     * Minor bodies may be skipped while they are too faint or far from the screen,
+     * see SolarSystemListComponent::updateSolarSystemBodies(). Objects handed out
+     * from the name lists must be refreshed before their position is used.
+     */
+    void refreshObject(const SkyObject *o);
+
     /**
      * @return the list of objects in the region defined by skypoints
      * @param p1 first sky point (top-left vertex of rectangular region)
@@ -238,7 +247,11 @@ class SkyMapComposite : public QObject, public SkyComposite
   private:
     QHash<int, QStringList> &getObjectNames() override;
     QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists() override;
+    SkyObjectNameIndex *getNameIndex() override;
 
+    // Destroyed before ~SkyComposite() deletes the components. getNameIndex() then no longer
+    // resolves to this class, so the objects they remove skip the index
+    SkyObjectNameIndex m_NameIndex;
     std::unique_ptr<CultureList> m_Cultures;
     ConstellationBoundaryLines *m_CBoundLines { nullptr };
     ConstellationNamesComponent *m_CNames { nullptr };
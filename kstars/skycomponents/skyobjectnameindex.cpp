@@ -0,0 +1,113 @@
+/*  Name index for the sky objects loaded in KStars
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "skyobjectnameindex.h"
+
+#include "skyobjects/skyobject.h"
+#include "skyobjects/starobject.h"
+
+#include <QMutexLocker>
+
+int SkyObjectNameIndex::priority(const SkyObject *obj)
+{
+    switch (obj->type())
+    {
+        case SkyObject::PLANET:
+        case SkyObject::MOON:
+        case SkyObject::ASTEROID:
+        case SkyObject::COMET:
+            return 0;
+        case SkyObject::CONSTELLATION:
+            return 2;
+        case SkyObject::STAR:
+            return 3;
+        case SkyObject::SUPERNOVA:
+            return 4;
+        case SkyObject::SATELLITE:
+            return 5;
+        default:
+            // Deep-sky objects and anything from custom catalogs
+            return 1;
+    }
+}
+
+void SkyObjectNameIndex::insert(SkyObject *obj)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    insertLocked(obj->name(), obj);
+    insertLocked(obj->longname(), obj);
+    insertLocked(obj->name2(), obj);
+    if (obj->type() == SkyObject::STAR)
+        insertLocked(static_cast<StarObject *>(obj)->gname(false), obj);
+}
+
+void SkyObjectNameIndex::insertLocked(const QString &name, SkyObject *obj)
+{
+    if (name.isEmpty())
+        return;
+
+    QString key       = foldName(name);
+    QStringList &keys = m_Keys[obj];
+    if (keys.contains(key))
+        return;
+    keys.append(key);
+
+    Entry entry;
+    entry.name     = name;
+    entry.object   = obj;
+    entry.priority = priority(obj);
+
+    // Keep the entries sorted by priority, first come first served within a priority
+    QVector<Entry> &entries = m_Entries[key];
+    int i                   = entries.size();
+    while (i > 0 && entries.at(i - 1).priority > entry.priority)
+        --i;
+    entries.insert(i, entry);
+}
+
+void SkyObjectNameIndex::remove(const SkyObject *obj)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    QHash<const SkyObject *, QStringList>::iterator it = m_Keys.find(obj);
+    if (it == m_Keys.end())
+        return;
+
+    for (const QString &key : it.value())
+    {
+        QHash<QString, QVector<Entry>>::iterator eit = m_Entries.find(key);
+        if (eit == m_Entries.end())
+            continue;
+
+        QVector<Entry> &entries = eit.value();
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            if (entries.at(i).object == obj)
+            {
+                entries.remove(i);
+                break;
+            }
+        }
+        if (entries.isEmpty())
+            m_Entries.erase(eit);
+    }
+    m_Keys.erase(it);
+}
+
+SkyObject *SkyObjectNameIndex::find(const QString &name) const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    QHash<QString, QVector<Entry>>::const_iterator it = m_Entries.constFind(foldName(name));
+    if (it == m_Entries.constEnd() || it.value().isEmpty())
+        return nullptr;
+    return it.value().first().object;
+}
@@ -0,0 +1,78 @@
+/*  Name index for the sky objects loaded in KStars
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class SkyObject;
+
+/**
+ * @class SkyObjectNameIndex
+ *
+ * A case-folded hash of the names of all named objects in the sky map, used by
+ * SkyMapComposite::findByName() so that looking up a name does not depend on the
+ * number of objects loaded.
+ *
+ * Components register their objects with SkyComponent::addToNameIndex() when they
+ * load them and must call SkyComponent::removeFromNameIndex() before deleting them.
+ * An object is indexed under its name, long name, secondary name and, for stars,
+ * its genetive name.
+ *
+ * Several objects may share a name. Lookups return the object of the highest
+ * priority type, in the order SkyMapComposite used to search its components:
+ * solar system bodies, deep-sky and catalog objects, constellations, stars,
+ * supernovae and finally satellites.
+ *
+ * All methods are thread-safe; some components load their objects in a worker thread.
+ */
+class SkyObjectNameIndex
+{
+  public:
+    SkyObjectNameIndex() = default;
+
+    /** @short Index the object under all of its names */
+    void insert(SkyObject *obj);
+
+    /** @short Remove all names of the object from the index */
+    void remove(const SkyObject *obj);
+
+    /**
+     * @short Find an object by name
+     * @param name the name, case does not matter
+     * @return the matching object with the highest priority, or nullptr
+     */
+    SkyObject *find(const QString &name) const;
+
+    /** @return the key used for the name in the index */
+    static QString foldName(const QString &name) { return name.toCaseFolded(); }
+
+  private:
+    struct Entry
+    {
+        QString name;
+        SkyObject *object;
+        int priority;
+    };
+
+    static int priority(const SkyObject *obj);
+
+    void insertLocked(const QString &name, SkyObject *obj);
+
+    /// Entries per folded name, sorted by priority
+    QHash<QString, QVector<Entry>> m_Entries;
+    /// Folded names of every object, needed to remove them again
+    QHash<const SkyObject *, QStringList> m_Keys;
+    mutable QMutex m_Mutex;
+};
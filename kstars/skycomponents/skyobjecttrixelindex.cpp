@@ -0,0 +1,134 @@
+/*  Trixel index of sky objects for proximity queries
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "skyobjecttrixelindex.h"
+
+#include "kstarsdata.h"
+#include "skymesh.h"
+#include "htmesh/MeshIterator.h"
+#include "skyobjects/skyobject.h"
+
+#include <cmath>
+
+namespace
+{
+/// Degrees added to the query radius to cover the drift of the objects since the index was built
+const double INDEX_MARGIN = 1.0;
+}
+
+SkyObjectTrixelIndex::SkyObjectTrixelIndex(double maxAge) : m_MaxAge(maxAge)
+{
+}
+
+void SkyObjectTrixelIndex::update(const QList<SkyObject *> &objects)
+{
+    const long double jd = KStarsData::Instance()->updateNum()->julianDay();
+
+    if (m_Valid && m_Count == objects.size() && (m_MaxAge <= 0 || std::fabs(jd - m_BuildJD) < m_MaxAge))
+        return;
+
+    m_Trixels.clear();
+    m_Unindexed.clear();
+
+    m_Mesh = SkyMesh::Instance();
+    if (m_Mesh)
+    {
+        foreach (SkyObject *o, objects)
+            m_Trixels[m_Mesh->HTMesh::index(o->ra().Degrees(), o->dec().Degrees())].append(o);
+    }
+    else
+    {
+        m_Unindexed = objects;
+    }
+
+    m_BuildJD = jd;
+    m_Count   = objects.size();
+    m_Valid   = true;
+}
+
+bool SkyObjectTrixelIndex::aperture(SkyPoint *p, double radius) const
+{
+    if (!m_Mesh)
+        return false;
+
+    m_Mesh->intersect(p->ra().Degrees(), p->dec().Degrees(), radius + INDEX_MARGIN, (BufNum)OBJ_INDEX_BUF);
+    return true;
+}
+
+SkyObject *SkyObjectTrixelIndex::objectNearest(SkyPoint *p, double &maxrad, const Filter &filter) const
+{
+    SkyObject *oBest = nullptr;
+    double rBest     = maxrad;
+
+    auto test = [&](SkyObject *o)
+    {
+        if (filter && !filter(o))
+            return;
+
+        double r = o->angularDistanceTo(p).Degrees();
+        if (r < rBest)
+        {
+            rBest = r;
+            oBest = o;
+        }
+    };
+
+    if (aperture(p, maxrad))
+    {
+        MeshIterator region(m_Mesh, OBJ_INDEX_BUF);
+        while (region.hasNext())
+        {
+            QHash<Trixel, QVector<SkyObject *>>::const_iterator it = m_Trixels.constFind(region.next());
+            if (it == m_Trixels.constEnd())
+                continue;
+            for (SkyObject *o : it.value())
+                test(o);
+        }
+    }
+    else
+    {
+        foreach (SkyObject *o, m_Unindexed)
+            test(o);
+    }
+
+    maxrad = rBest;
+    return oBest;
+}
+
+QList<SkyObject *> SkyObjectTrixelIndex::objectsNear(SkyPoint *p, double radius, const Filter &filter) const
+{
+    QList<SkyObject *> result;
+
+    auto test = [&](SkyObject *o)
+    {
+        if ((!filter || filter(o)) && o->angularDistanceTo(p).Degrees() < radius)
+            result.append(o);
+    };
+
+    if (aperture(p, radius))
+    {
+        MeshIterator region(m_Mesh, OBJ_INDEX_BUF);
+        while (region.hasNext())
+        {
+            QHash<Trixel, QVector<SkyObject *>>::const_iterator it = m_Trixels.constFind(region.next());
+            if (it == m_Trixels.constEnd())
+                continue;
+            for (SkyObject *o : it.value())
+                test(o);
+        }
+    }
+    else
+    {
+        foreach (SkyObject *o, m_Unindexed)
+            test(o);
+    }
+
+    return result;
+}
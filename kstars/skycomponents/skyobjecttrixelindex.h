@@ -0,0 +1,88 @@
+/*  Trixel index of sky objects for proximity queries
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "typedef.h"
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include <functional>
+
+class SkyMesh;
+class SkyObject;
+class SkyPoint;
+
+/**
+ * @class SkyObjectTrixelIndex
+ *
+ * Buckets the objects of a component by the SkyMesh trixel containing their
+ * current position so that objectNearest() and objectsNear() only look at the
+ * objects around the query point instead of the whole list.
+ *
+ * The index is a cache over a list owned by the component.  Call update() with
+ * the list before querying: it rebuilds the index when it was invalidated, when
+ * the number of objects changed or when the simulation time moved too far from
+ * the one the index was built at.  Components must call invalidate() whenever
+ * they delete objects or move them by more than a fraction of a degree, e.g.
+ * when recomputing solar system positions.
+ *
+ * Unlike the indexes of DeepSkyComponent and StarComponent, objects are indexed
+ * by their current coordinates and the queries are not precessed to J2000.  The
+ * drift due to precession until the index expires is covered by a safety margin
+ * added to the query radius.
+ */
+class SkyObjectTrixelIndex
+{
+  public:
+    typedef std::function<bool(SkyObject *)> Filter;
+
+    /**
+     * @param maxAge number of days of simulation time after which the index is rebuilt,
+     * 0 for an index that is only rebuilt when invalidated or when the list size changes
+     */
+    explicit SkyObjectTrixelIndex(double maxAge = 3650.0);
+
+    /** @short Force a rebuild of the index on the next update() */
+    void invalidate() { m_Valid = false; }
+
+    /** @short Rebuild the index from objects if it is out of date */
+    void update(const QList<SkyObject *> &objects);
+
+    /**
+     * @short Find the object nearest to p among the objects accepted by filter
+     * @param p the query point
+     * @param maxrad on input the search radius in degrees, on output the distance
+     * to the object found, unchanged if none was found
+     * @param filter optional predicate, objects for which it returns false are skipped
+     * @return the nearest object or nullptr
+     */
+    SkyObject *objectNearest(SkyPoint *p, double &maxrad, const Filter &filter = Filter()) const;
+
+    /**
+     * @return the objects accepted by filter less than radius degrees away from p
+     */
+    QList<SkyObject *> objectsNear(SkyPoint *p, double radius, const Filter &filter = Filter()) const;
+
+  private:
+    /** @short Intersect the mesh with the query aperture, false if there is no mesh */
+    bool aperture(SkyPoint *p, double radius) const;
+
+    QHash<Trixel, QVector<SkyObject *>> m_Trixels;
+    /// Objects without a mesh to index them, searched linearly
+    QList<SkyObject *> m_Unindexed;
+    SkyMesh *m_Mesh { nullptr };
+    double m_MaxAge { 0 };
+    long double m_BuildJD { 0 };
+    int m_Count { -1 };
+    bool m_Valid { false };
+};
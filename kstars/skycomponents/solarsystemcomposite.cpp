@@ -156,11 +156,16 @@ void SolarSystemComposite::drawTrails(SkyPainter *skyp)
 
 const QList<SkyObject *> &SolarSystemComposite::asteroids() const
 {
+    // Tools walking the whole list expect every body to be there and current
+    m_AsteroidsComponent->finishLoading();
+    m_AsteroidsComponent->refreshAll();
     return m_AsteroidsComponent->objectList();
 }
 
 const QList<SkyObject *> &SolarSystemComposite::comets() const
 {
+    m_CometsComponent->finishLoading();
+    m_CometsComponent->refreshAll();
     return m_CometsComponent->objectList();
 }
 
@@ -184,6 +189,12 @@ AsteroidsComponent *SolarSystemComposite::asteroidsComponent()
     return m_AsteroidsComponent;
 }
 
+void SolarSystemComposite::finishLoading()
+{
+    m_AsteroidsComponent->finishLoading();
+    m_CometsComponent->finishLoading();
+}
+
 const QList<SolarSystemSingleComponent *> &SolarSystemComposite::planets() const
 {
     return m_planets;
@@ -48,7 +48,9 @@ class SolarSystemComposite : public SkyComposite
 
     KSSun *sun() { return m_Sun; }
 
+    /** @return all asteroids, with the ones skipped by the last update brought up to date */
     const QList<SkyObject *> &asteroids() const;
+    /** @return all comets, with the ones skipped by the last update brought up to date */
     const QList<SkyObject *> &comets() const;
     const QList<SkyObject *> &planetObjects() const;
     const QList<SkyObject *> &moons() const;
@@ -67,6 +69,9 @@ class SolarSystemComposite : public SkyComposite
 
     AsteroidsComponent *asteroidsComponent();
 
+    /** @short Wait for the asteroids and comets still read in the background and add them */
+    void finishLoading();
+
     QList<PlanetMoonsComponent *> planetMoonsComponent() const;
 
     const QList<SolarSystemSingleComponent *> &planets() const;
@@ -25,17 +25,120 @@
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/ksplanetbase.h"
 #include "kstarsdata.h"
+#include "ksnumbers.h"
+#include "kstars_debug.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
+#include "tools/visibilityservice.h"
 #endif
 
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/// Number of bodies finished by one thread at a time
+const int BODIES_PER_TASK = 256;
+
+/// Degrees added around the screen or a query point for the errors of the estimated directions
+const double DIRECTION_MARGIN = 2.0;
+
+/// Mean obliquity of the ecliptic at J2000, in degrees
+const double OBLIQUITY_J2000 = 23.4392911;
+
+/// Gaussian gravitational constant
+const double GAUSS_K = 0.01720209895;
+
+/// Upper bound of the orbital speed of the Earth, in AU per day
+const double EARTH_SPEED = 0.0176;
+
+/// Maximum number of days a body stays skipped for being too faint
+const double MAX_FAINT_WINDOW = 30.0;
+
+/**
+ * @return the number of days over which a body with a magnitude of H + 5 log10(r delta), excess
+ * magnitudes over the limit, cannot reach the limit
+ */
+double faintWindow(double excess, double r, double delta)
+{
+    // The magnitude drops by excess when r * delta shrinks by s^2, which needs r or delta to shrink by s
+    const double s = pow(10.0, -excess / 10.0);
+    // Parabolic speed at the smallest distance from the Sun, an upper bound of the speed of the body
+    const double v = GAUSS_K * sqrt(2.0 / (r * s));
+    return std::min(std::min(r * (1.0 - s) / v, delta * (1.0 - s) / (v + EARTH_SPEED)), MAX_FAINT_WINDOW);
+}
+}
+
 SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p) : ListComponent(p), m_Earth(p->earth())
 {
+    QObject::connect(&m_Loader, &QFutureWatcher<QList<SkyObject *>>::finished, [this]() { finishLoading(); });
 }
 
 SolarSystemListComponent::~SolarSystemListComponent()
 {
     //Object deletes handled by parent class (ListComponent)
+    if (m_Loading)
+    {
+        m_Loader.waitForFinished();
+        qDeleteAll(m_Loader.result());
+    }
+}
+
+void SolarSystemListComponent::loadInBackground(int type, const Reader &reader)
+{
+    finishLoading();
+
+    m_LoaderType = type;
+    m_Loading    = true;
+    m_Loader.setFuture(QtConcurrent::run([reader]()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        const QList<SkyObject *> objects = reader();
+        qCInfo(KSTARS) << "Read" << objects.size() << "solar system bodies in" << timer.elapsed() << "ms";
+        return objects;
+    }));
+}
+
+void SolarSystemListComponent::finishLoading()
+{
+    // Also called by the finished signal after the objects were added
+    if (!m_Loading)
+        return;
+    m_Loading = false;
+
+    m_Loader.waitForFinished();
+    setObjects(m_LoaderType, m_Loader.result());
+
+    // Position the new bodies at the next update
+    KStarsData::Instance()->setFullTimeUpdate();
+}
+
+void SolarSystemListComponent::setObjects(int type, const QList<SkyObject *> &objects)
+{
+    foreach (SkyObject *o, m_ObjectList)
+        removeFromNameIndex(o);
+#ifndef KSTARS_LITE
+    VisibilityService::Instance()->forget(m_ObjectList);
+#endif
+    qDeleteAll(m_ObjectList);
+    m_ObjectList.clear();
+    m_NearestIndex.invalidate();
+    clearOrbits();
+
+    objectNames(type).clear();
+    objectLists(type).clear();
+
+    for (SkyObject *o : objects)
+    {
+        m_ObjectList.append(o);
+        objectNames(type).append(o->name());
+        objectLists(type).append(QPair<QString, const SkyObject *>(o->name(), o));
+        addToNameIndex(o);
+    }
 }
 
 void SolarSystemListComponent::update(KSNumbers *)
@@ -43,10 +146,13 @@ void SolarSystemListComponent::update(KSNumbers *)
     if (selected())
     {
         KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *o, m_ObjectList)
+        for (int k = 0; k < m_ObjectList.size(); ++k)
         {
+            if (!isCurrent(k))
+                continue;
+
             // FIXME: get rid of cast.
-            KSPlanetBase *p = (KSPlanetBase *)o;
+            KSPlanetBase *p = (KSPlanetBase *)m_ObjectList.at(k);
             p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
         }
     }
@@ -57,18 +163,387 @@ void SolarSystemListComponent::updateSolarSystemBodies(KSNumbers *num)
     if (selected())
     {
         KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *o, m_ObjectList)
+        const CachingDms *lat = data->geo()->lat();
+        const CachingDms *lst = data->lst();
+
+        if (!m_OrbitsValid || m_Orbits.size() != m_ObjectList.size())
+            m_HasOrbits = buildOrbits();
+
+        if (!m_HasOrbits)
         {
-            KSPlanetBase *p = (KSPlanetBase *)o;
-            p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
-            p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+            foreach (SkyObject *o, m_ObjectList)
+            {
+                KSPlanetBase *p = (KSPlanetBase *)o;
+                p->findPosition(num, lat, lst, m_Earth);
+                p->EquatorialToHorizontal(lst, lat);
 
+                if (p->hasTrail())
+                    p->updateTrail(lst, lat);
+            }
+            m_NearestIndex.invalidate();
+            return;
+        }
+
+        const long double jd = num->julianDay();
+        const double t       = double(jd - J2000);
+        const double limit   = magnitudeLimit();
+
+        if (limit != m_FaintLimit && !(std::isnan(limit) && std::isnan(m_FaintLimit)))
+        {
+            m_FaintUntil.fill(-std::numeric_limits<double>::infinity());
+            m_FaintLimit = limit;
+        }
+
+        m_UpdateNum.reset(new KSNumbers(*num));
+        m_Deferred.clear();
+
+        // Objects the user is looking at are always updated
+        const SkyObject *focus   = nullptr;
+        const SkyObject *clicked = nullptr;
+#ifndef KSTARS_LITE
+        if (SkyMap::Instance())
+        {
+            focus   = SkyMap::Instance()->focusObject();
+            clicked = SkyMap::Instance()->clickedObject();
+        }
+#endif
+        auto pinned = [&](const KSPlanetBase *p) { return p == focus || p == clicked || p->hasTrail(); };
+
+        // Bodies without orbital elements are computed one by one, and always
+        for (int k : m_Unbatched)
+        {
+            KSPlanetBase *p = (KSPlanetBase *)m_ObjectList.at(k);
+            p->findPosition(num, lat, lst, m_Earth);
+            p->EquatorialToHorizontal(lst, lat);
             if (p->hasTrail())
-                p->updateTrail(data->lst(), data->geo()->lat());
+                p->updateTrail(lst, lat);
+            m_State[k] = Current;
+        }
+
+        // First pass: skip the bodies still known to be too faint
+        QVector<int> active;
+        for (int k = 0, u = 0; k < m_ObjectList.size(); ++k)
+        {
+            if (u < m_Unbatched.size() && m_Unbatched.at(u) == k)
+            {
+                ++u;
+                continue;
+            }
+            if (t >= m_FaintFrom.at(k) && t <= m_FaintUntil.at(k) && !pinned((KSPlanetBase *)m_ObjectList.at(k)))
+                m_State[k] = Culled;
+            else
+                active.append(k);
+        }
+
+        m_Orbits.propagate(jd, active, m_Positions);
+
+        // Second pass: estimate the magnitude and direction of the others from their heliocentric position
+        double cosBe, sinBe, cosLe, sinLe;
+        m_Earth->ecLong().SinCos(sinLe, cosLe);
+        m_Earth->ecLat().SinCos(sinBe, cosBe);
+        const double xe = m_Earth->rsun() * cosBe * cosLe;
+        const double ye = m_Earth->rsun() * cosBe * sinLe;
+        const double ze = m_Earth->rsun() * sinBe;
+
+        double sinEps, cosEps;
+        dms(OBLIQUITY_J2000).SinCos(sinEps, cosEps);
+
+        double vx = 0, vy = 0, vz = 0, cosView = -2.0;
+        const bool hasView = viewCone(jd, vx, vy, vz, cosView);
+
+        QVector<int> finish;
+        for (int k : active)
+        {
+            KSPlanetBase *p = (KSPlanetBase *)m_ObjectList.at(k);
+
+            const double r     = m_Positions.r.at(k);
+            const double dx    = m_Positions.x.at(k) - xe;
+            const double dy    = m_Positions.y.at(k) - ye;
+            const double dz    = m_Positions.z.at(k) - ze;
+            const double delta = sqrt(dx * dx + dy * dy + dz * dz);
+
+            if (!std::isnan(limit) && !pinned(p))
+            {
+                const double brightest = p->brightestMagnitude(r, delta);
+                if (brightest > limit)
+                {
+                    const double window = faintWindow(brightest - limit, r, delta);
+                    m_FaintFrom[k]      = t - window;
+                    m_FaintUntil[k]     = t + window;
+                    m_State[k]          = Culled;
+                    continue;
+                }
+            }
+
+            m_DirX[k] = dx / delta;
+            m_DirY[k] = (dy * cosEps - dz * sinEps) / delta;
+            m_DirZ[k] = (dy * sinEps + dz * cosEps) / delta;
+
+            if (!hasView || pinned(p) || m_DirX.at(k) * vx + m_DirY.at(k) * vy + m_DirZ.at(k) * vz >= cosView)
+            {
+                finish.append(k);
+            }
+            else
+            {
+                m_State[k] = Deferred;
+                m_Deferred.append(k);
+            }
         }
+
+        finishBodies(finish, num);
+        m_Stale = finish.size() + m_Unbatched.size() < m_ObjectList.size();
+        m_NearestIndex.invalidate();
     }
 }
 
+void SolarSystemListComponent::finishBodies(const QVector<int> &indexes, const KSNumbers *num)
+{
+    KStarsData *data      = KStarsData::Instance();
+    const CachingDms *lat = data->geo()->lat();
+    const CachingDms *lst = data->lst();
+    quint8 *state         = m_State.data();
+
+    // Bodies with trails share the list of trail objects, they are done below
+    auto finish = [&](int k)
+    {
+        KSPlanetBase *p = (KSPlanetBase *)m_ObjectList.at(k);
+        p->findPosition(num, lat, lst, m_Earth, m_Positions.x.at(k), m_Positions.y.at(k), m_Positions.z.at(k),
+                        m_Positions.r.at(k));
+        p->EquatorialToHorizontal(lst, lat);
+        state[k] = Current;
+    };
+
+    QVector<int> tasks;
+    for (int begin = 0; begin < indexes.size(); begin += BODIES_PER_TASK)
+        tasks.append(begin);
+
+    // The workers get the Earth explicitly and must only read the Sun used to bend the light
+    SkyPoint::findSun();
+
+    QtConcurrent::blockingMap(tasks, [&](const int &begin)
+    {
+        const int end = qMin(begin + BODIES_PER_TASK, indexes.size());
+        for (int i = begin; i < end; ++i)
+        {
+            if (!((KSPlanetBase *)m_ObjectList.at(indexes.at(i)))->hasTrail())
+                finish(indexes.at(i));
+        }
+    });
+
+    for (int k : indexes)
+    {
+        KSPlanetBase *p = (KSPlanetBase *)m_ObjectList.at(k);
+        if (p->hasTrail())
+        {
+            finish(k);
+            p->updateTrail(lst, lat);
+        }
+    }
+}
+
+bool SolarSystemListComponent::viewCone(long double jd, double &x, double &y, double &z, double &cosRadius) const
+{
+#ifndef KSTARS_LITE
+    SkyMap *map = SkyMap::Instance();
+    if (map == nullptr)
+        return false;
+
+    const double radius = map->fov() + DIRECTION_MARGIN;
+    if (radius >= 180.0)
+        return false;
+
+    // Same as SkyMesh::aperture()
+    SkyPoint center(map->focus()->ra(), map->focus()->dec());
+    center.apparentCoord(jd, J2000);
+
+    double sinRa, cosRa, sinDec, cosDec;
+    center.ra().SinCos(sinRa, cosRa);
+    center.dec().SinCos(sinDec, cosDec);
+    x         = cosDec * cosRa;
+    y         = cosDec * sinRa;
+    z         = sinDec;
+    cosRadius = cos(radius * dms::DegToRad);
+    return true;
+#else
+    Q_UNUSED(jd);
+    Q_UNUSED(x);
+    Q_UNUSED(y);
+    Q_UNUSED(z);
+    Q_UNUSED(cosRadius);
+    return false;
+#endif
+}
+
+void SolarSystemListComponent::refreshView()
+{
+    if (m_Deferred.isEmpty())
+        return;
+
+    double x, y, z, cosRadius;
+    if (viewCone(m_UpdateNum->julianDay(), x, y, z, cosRadius))
+        refreshCone(x, y, z, cosRadius);
+    else
+        refreshCone(1.0, 0.0, 0.0, -2.0);
+}
+
+void SolarSystemListComponent::refreshNear(SkyPoint *p, double radius)
+{
+    if (m_Deferred.isEmpty())
+        return;
+
+    SkyPoint center(p->ra(), p->dec());
+    center.apparentCoord(m_UpdateNum->julianDay(), J2000);
+
+    double sinRa, cosRa, sinDec, cosDec;
+    center.ra().SinCos(sinRa, cosRa);
+    center.dec().SinCos(sinDec, cosDec);
+
+    radius += DIRECTION_MARGIN;
+    refreshCone(cosDec * cosRa, cosDec * sinRa, sinDec, radius >= 180.0 ? -2.0 : cos(radius * dms::DegToRad));
+}
+
+void SolarSystemListComponent::refreshCone(double x, double y, double z, double cosRadius)
+{
+    QVector<int> finish, deferred;
+    for (int k : m_Deferred)
+    {
+        if (m_DirX.at(k) * x + m_DirY.at(k) * y + m_DirZ.at(k) * z >= cosRadius)
+            finish.append(k);
+        else
+            deferred.append(k);
+    }
+
+    if (finish.isEmpty())
+        return;
+
+    finishBodies(finish, m_UpdateNum.get());
+    m_Deferred = deferred;
+    m_NearestIndex.invalidate();
+}
+
+void SolarSystemListComponent::refreshObject(const SkyObject *o)
+{
+    if (!m_HasOrbits || !m_UpdateNum)
+        return;
+
+    QHash<const SkyObject *, int>::const_iterator it = m_Indexes.constFind(o);
+    if (it == m_Indexes.constEnd() || m_State.at(it.value()) == Current)
+        return;
+
+    const int k = it.value();
+    if (m_State.at(k) == Culled)
+        m_Orbits.propagate(k, m_UpdateNum->julianDay(), m_Positions.x[k], m_Positions.y[k], m_Positions.z[k],
+                           m_Positions.r[k]);
+
+    m_Deferred.removeOne(k);
+    finishBodies(QVector<int>() << k, m_UpdateNum.get());
+    m_NearestIndex.invalidate();
+}
+
+void SolarSystemListComponent::refreshAll()
+{
+    if (!m_HasOrbits || !m_UpdateNum || !m_Stale)
+        return;
+
+    QVector<int> culled, finish;
+    for (int k = 0; k < m_ObjectList.size(); ++k)
+    {
+        if (m_State.at(k) == Current)
+            continue;
+        if (m_State.at(k) == Culled)
+            culled.append(k);
+        finish.append(k);
+    }
+
+    m_Orbits.propagate(m_UpdateNum->julianDay(), culled, m_Positions);
+    finishBodies(finish, m_UpdateNum.get());
+    m_Deferred.clear();
+    m_Stale = false;
+    m_NearestIndex.invalidate();
+}
+
+bool SolarSystemListComponent::isCurrent(const SkyObject *o) const
+{
+    if (!m_HasOrbits)
+        return true;
+
+    QHash<const SkyObject *, int>::const_iterator it = m_Indexes.constFind(o);
+    return it == m_Indexes.constEnd() || m_State.at(it.value()) == Current;
+}
+
+double SolarSystemListComponent::magnitudeLimit() const
+{
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+SkyObject *SolarSystemListComponent::objectNearest(SkyPoint *p, double &maxrad)
+{
+    if (!selected())
+        return nullptr;
+
+    refreshNear(p, maxrad);
+
+    m_NearestIndex.update(m_ObjectList);
+    return m_NearestIndex.objectNearest(p, maxrad, [this](const SkyObject *o) { return isCurrent(o); });
+}
+
+bool SolarSystemListComponent::buildOrbits()
+{
+    clearOrbits();
+    m_OrbitsValid = true;
+
+    const int count = m_ObjectList.size();
+    m_State.fill(Culled, count);
+    m_FaintFrom.fill(std::numeric_limits<double>::infinity(), count);
+    m_FaintUntil.fill(-std::numeric_limits<double>::infinity(), count);
+    m_DirX.fill(0, count);
+    m_DirY.fill(0, count);
+    m_DirZ.fill(0, count);
+
+    m_Unbatched.clear();
+
+    // Bodies without elements keep a placeholder orbit so that the indexes match m_ObjectList
+    KeplerOrbits::Elements placeholder;
+    placeholder.a      = 1.0;
+    placeholder.period = 365.25;
+
+    KeplerOrbits::Elements elements;
+    for (int k = 0; k < count; ++k)
+    {
+        SkyObject *o = m_ObjectList.at(k);
+        if (((KSPlanetBase *)o)->orbitalElements(elements))
+        {
+            m_Orbits.add(elements);
+        }
+        else
+        {
+            m_Orbits.add(placeholder);
+            m_Unbatched.append(k);
+        }
+        m_Indexes.insert(o, k);
+    }
+
+    if (m_Unbatched.size() == count)
+    {
+        m_Orbits.clear();
+        m_Indexes.clear();
+        m_Unbatched.clear();
+        return false;
+    }
+    return true;
+}
+
+void SolarSystemListComponent::clearOrbits()
+{
+    m_Orbits.clear();
+    m_Indexes.clear();
+    m_Unbatched.clear();
+    m_Deferred.clear();
+    m_OrbitsValid = false;
+    m_HasOrbits   = false;
+    m_Stale       = false;
+}
+
 void SolarSystemListComponent::drawTrails(SkyPainter *skyp)
 {
     //FIXME: here for all objects trails are drawn this could be source of inefficiency
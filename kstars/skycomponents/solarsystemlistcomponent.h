@@ -19,7 +19,15 @@
 #define SOLARSYSTEMLISTCOMPONENT_H
 
 #include "listcomponent.h"
+#include "skyobjects/keplerorbits.h"
 
+#include <QFutureWatcher>
+#include <QHash>
+
+#include <functional>
+#include <memory>
+
+class KSNumbers;
 class KSPlanet;
 class SolarSystemComposite;
 
@@ -41,16 +49,126 @@ class SolarSystemListComponent : public ListComponent
     /** @short Update the coordinates of the solar system bodies in this component.
          *
          * This function updates the position of the moving solar system bodies.
+         * When all of them have fixed orbital elements, their orbits are propagated
+         * together by KeplerOrbits and the positions are finished in parallel.
+         *
+         * Only the bodies which may be seen are fully updated.  Bodies which cannot be
+         * brighter than magnitudeLimit() are skipped until their orbital motion could
+         * bring them over the limit, and bodies far from the screen are postponed until
+         * refreshView() or refreshNear() reach them.  Bodies with a trail and the focused
+         * or clicked object are always updated.  The others keep the coordinates of their
+         * last update, see isCurrent(), refreshObject() and refreshAll().
          * @p data Pointer to the KStarsData object
          * @p num Pointer to the KSNumbers object
          */
     void updateSolarSystemBodies(KSNumbers *num) override;
 
+    SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
+
+    /** @short Wait for the objects still read in the background and add them now */
+    void finishLoading();
+
+    /**
+     * @short Bring o up to the date of the last update if that update skipped or postponed it
+     * SkyMapComposite::findByName() calls it, so that the objects looked up by name have
+     * current coordinates.
+     */
+    void refreshObject(const SkyObject *o);
+
+    /**
+     * @short Bring every object skipped or postponed by the last update up to date
+     * Called before the whole list is handed out to tools, see SolarSystemComposite::asteroids().
+     */
+    void refreshAll();
+
   protected:
+    /** @short Reads the objects of the component from its data file, from any thread */
+    typedef std::function<QList<SkyObject *>()> Reader;
+
     void drawTrails(SkyPainter *skyp) override;
 
+    /**
+     * @short Read the objects in a worker thread and add them from the main thread once read
+     *
+     * The sky map does not wait for the objects, so it can be shown before they are read.
+     * Call finishLoading() when they are needed at once.
+     * @p type the type of the objects, for the lists of names
+     * @p reader reads the objects, it must not touch the sky components
+     */
+    void loadInBackground(int type, const Reader &reader);
+
+    /** @short Replace the objects of the component by objects of the given type, taking their ownership */
+    void setObjects(int type, const QList<SkyObject *> &objects);
+
+    /** @short Must be called when the objects are replaced, to rebuild the orbits */
+    void clearOrbits();
+
+    /**
+     * @return the faintest magnitude drawn by this component, NaN if the bodies are
+     * drawn whatever their magnitude
+     */
+    virtual double magnitudeLimit() const;
+
+    /** @short Finish the postponed bodies which may be within radius degrees of p */
+    void refreshNear(SkyPoint *p, double radius);
+
+    /** @short Finish the postponed bodies which may be on screen, to be called before drawing */
+    void refreshView();
+
+    /** @return false if the last update skipped or postponed the object */
+    bool isCurrent(const SkyObject *o) const;
+
+    /** @return false if the last update skipped or postponed the object at index in m_ObjectList */
+    bool isCurrent(int index) const { return !m_HasOrbits || m_State.at(index) == Current; }
+
   private:
+    enum BodyState : quint8
+    {
+        Culled,   ///< Not updated, known to be too faint
+        Deferred, ///< Propagated but not finished, too far from the screen
+        Current   ///< Up to date
+    };
+
+    /** @short Collect the orbital elements of the objects, false if none has any */
+    bool buildOrbits();
+
+    /** @short Finish the propagated positions of the bodies at indexes */
+    void finishBodies(const QVector<int> &indexes, const KSNumbers *num);
+
+    /** @short Finish the postponed bodies within the given cone around a J2000 unit vector */
+    void refreshCone(double x, double y, double z, double cosRadius);
+
+    /** @short Get the J2000 unit vector of the screen center and the cosine of the screen radius */
+    bool viewCone(long double jd, double &x, double &y, double &z, double &cosRadius) const;
+
     KSPlanet *m_Earth;
+    KeplerOrbits m_Orbits;
+    KeplerOrbits::Positions m_Positions;
+    bool m_OrbitsValid { false };
+    bool m_HasOrbits { false };
+
+    /// State of each body after the last update
+    QVector<quint8> m_State;
+    /// Days after J2000 between which each body is known to be fainter than m_FaintLimit
+    QVector<double> m_FaintFrom, m_FaintUntil;
+    double m_FaintLimit { 0 };
+    /// Estimated J2000 equatorial unit vector of each body
+    QVector<float> m_DirX, m_DirY, m_DirZ;
+    /// Deferred bodies of the last update
+    QVector<int> m_Deferred;
+    /// Bodies without orbital elements, in increasing order, updated one by one
+    QVector<int> m_Unbatched;
+    /// True if the last update skipped or postponed some bodies not refreshed since
+    bool m_Stale { false };
+    /// Index of each body in m_ObjectList
+    QHash<const SkyObject *, int> m_Indexes;
+    /// Date of the last update, to finish the deferred bodies
+    std::unique_ptr<KSNumbers> m_UpdateNum;
+
+    /// Objects being read in the background
+    QFutureWatcher<QList<SkyObject *>> m_Loader;
+    int m_LoaderType { 0 };
+    bool m_Loading { false };
 };
 
 #endif
@@ -51,12 +51,14 @@ SolarSystemSingleComponent::SolarSystemSingleComponent(SolarSystemComposite *par
         objectNames(m_Planet->type()).append(m_Planet->longname());
         objectLists(m_Planet->type()).append(QPair<QString, const SkyObject *>(m_Planet->longname(), m_Planet));
     }
+    addToNameIndex(m_Planet);
 }
 
 SolarSystemSingleComponent::~SolarSystemSingleComponent()
 {
     removeFromNames(m_Planet);
     removeFromLists(m_Planet);
+    removeFromNameIndex(m_Planet);
     delete m_Planet;
 }
 
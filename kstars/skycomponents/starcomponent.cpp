@@ -37,6 +37,8 @@
 
 #include <qplatformdefs.h>
 
+#include <cstring>
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -51,7 +53,7 @@
 
 StarComponent *StarComponent::pinstance = nullptr;
 
-StarComponent::StarComponent(SkyComposite *parent)
+StarComponent::StarComponent(SkyComposite *parent, const StaticData &data)
     : ListComponent(parent), m_reindexNum(J2000)
 {
     m_skyMesh          = SkyMesh::Instance();
@@ -70,7 +72,7 @@ StarComponent::StarComponent(SkyComposite *parent)
     // Actually load data
     emitProgressText(i18n("Loading stars"));
 
-    loadStaticData();
+    loadStaticData(data);
     // Load any deep star catalogs that are available
     loadDeepStarCatalogs();
 
@@ -96,9 +98,14 @@ StarComponent::~StarComponent()
 }
 
 StarComponent *StarComponent::Create(SkyComposite *parent)
+{
+    return Create(parent, readStaticData());
+}
+
+StarComponent *StarComponent::Create(SkyComposite *parent, const StaticData &data)
 {
     delete pinstance;
-    pinstance = new StarComponent(parent);
+    pinstance = new StarComponent(parent, data);
     return pinstance;
 }
 
@@ -394,84 +401,66 @@ void StarComponent::drawLabels()
     }
 }
 
-bool StarComponent::loadStaticData()
+StarComponent::StaticData StarComponent::readStaticData()
 {
     // We break from Qt / KDE API and use traditional file handling here, to obtain speed.
     // We also avoid C++ constructors for the same reason.
+    StaticData data;
     FILE *dataFile, *nameFile;
-    bool swapBytes = false, named = false, gnamed = false;
     BinFileHelper dataReader, nameReader;
-    QString name, gname, visibleName;
-    StarObject *star;
-
-    if (starsLoaded)
-        return true;
-
-    // prepare to index stars to this date
-    m_skyMesh->setKSNumbers(&m_reindexNum);
 
     /* Open the data files */
     // TODO: Maybe we don't want to hardcode the filename?
     if ((dataFile = dataReader.openFile("namedstars.dat")) == nullptr)
     {
         qDebug() << "Could not open data file namedstars.dat" << endl;
-        return false;
+        return data;
     }
 
     if (!(nameFile = nameReader.openFile("starnames.dat")))
     {
         qDebug() << "Could not open data file starnames.dat" << endl;
-        return false;
+        return data;
     }
 
     if (!dataReader.readHeader())
     {
         qDebug() << "Error reading namedstars.dat header : " << dataReader.getErrorNumber() << " : "
                  << dataReader.getError() << endl;
-        return false;
+        return data;
     }
 
     if (!nameReader.readHeader())
     {
         qDebug() << "Error reading starnames.dat header : " << nameReader.getErrorNumber() << " : "
                  << nameReader.getError() << endl;
-        return false;
+        return data;
     }
     //KDE_fseek(nameFile, nameReader.getDataOffset(), SEEK_SET);
     QT_FSEEK(nameFile, nameReader.getDataOffset(), SEEK_SET);
-    swapBytes = dataReader.getByteSwap();
-
-    long int nstars = 0;
+    const bool swapBytes = dataReader.getByteSwap();
 
     //KDE_fseek(dataFile, dataReader.getDataOffset(), SEEK_SET);
     QT_FSEEK(dataFile, dataReader.getDataOffset(), SEEK_SET);
 
-    qint16 faintmag;
-    quint8 htm_level;
     quint16 t_MSpT;
     int ret = 0;
 
-    ret = fread(&faintmag, 2, 1, dataFile);
+    ret = fread(&data.faintMag, 2, 1, dataFile);
     if (swapBytes)
-        faintmag = bswap_16(faintmag);
-    ret = fread(&htm_level, 1, 1, dataFile);
+        data.faintMag = bswap_16(data.faintMag);
+    ret = fread(&data.htmLevel, 1, 1, dataFile);
     ret = fread(&t_MSpT, 2, 1, dataFile); // Unused
-    if (swapBytes)
-        faintmag = bswap_16(faintmag);
-
-    if (faintmag / 100.0 > m_FaintMagnitude)
-        m_FaintMagnitude = faintmag / 100.0;
 
-    if (htm_level != m_skyMesh->level())
-        qDebug()
-            << "WARNING: HTM Level in shallow star data file and HTM Level in m_skyMesh do not match. EXPECT TROUBLE"
-            << endl;
-
-    for (int i = 0; i < m_skyMesh->size(); ++i)
+    // The file is indexed by the trixels of its own level
+    data.stars.resize(8 << (2 * data.htmLevel));
+    for (int trixel = 0; trixel < data.stars.size(); ++trixel)
     {
-        Trixel trixel = i; // = ( ( i >= 256 ) ? ( i - 256 ) : ( i + 256 ) );
-        for (unsigned long j = 0; j < (unsigned long)dataReader.getRecordCount(i); ++j)
+        QVector<StarData> &stars = data.stars[trixel];
+        stars.resize(dataReader.getRecordCount(trixel));
+        for (int j = 0; j < stars.size(); ++j)
         {
+            StarData &stardata = stars[j];
             if (!fread(&stardata, sizeof(StarData), 1, dataFile))
             {
                 qDebug() << "FILE FORMAT ERROR: Could not read StarData structure for star #" << j << " under trixel #"
@@ -482,6 +471,58 @@ bool StarComponent::loadStaticData()
             if (swapBytes)
                 byteSwap(&stardata);
 
+            /* Named Star - Read the nameFile */
+            if (stardata.flags & 0x01)
+            {
+                starName starname;
+                if (!fread(&starname, sizeof(starName), 1, nameFile))
+                {
+                    qDebug() << "ERROR: fread() call on nameFile failed in trixel " << trixel << " star " << j << endl;
+                    memset(&starname, 0, sizeof(starName));
+                }
+                data.names.append(starname);
+            }
+        }
+    }
+    Q_UNUSED(ret);
+
+    dataReader.closeFile();
+    nameReader.closeFile();
+
+    data.valid = true;
+    return data;
+}
+
+bool StarComponent::loadStaticData(const StaticData &data)
+{
+    bool named = false, gnamed = false;
+    QString name, gname, visibleName;
+    StarObject *star;
+
+    if (starsLoaded)
+        return true;
+    if (!data.valid)
+        return false;
+
+    // prepare to index stars to this date
+    m_skyMesh->setKSNumbers(&m_reindexNum);
+
+    long int nstars = 0;
+
+    if (data.faintMag / 100.0 > m_FaintMagnitude)
+        m_FaintMagnitude = data.faintMag / 100.0;
+
+    if (data.htmLevel != m_skyMesh->level())
+        qDebug()
+            << "WARNING: HTM Level in shallow star data file and HTM Level in m_skyMesh do not match. EXPECT TROUBLE"
+            << endl;
+
+    auto starname = data.names.constBegin();
+    for (int i = 0; i < m_skyMesh->size() && i < data.stars.size(); ++i)
+    {
+        Trixel trixel = i; // = ( ( i >= 256 ) ? ( i - 256 ) : ( i + 256 ) );
+        for (const StarData &stardata : data.stars.at(i))
+        {
             named  = false;
             gnamed = false;
 
@@ -489,16 +530,14 @@ bool StarComponent::loadStaticData()
             if (stardata.flags & 0x01)
             {
                 visibleName = "";
-                if (!fread(&starname, sizeof(starName), 1, nameFile))
-                    qDebug() << "ERROR: fread() call on nameFile failed in trixel " << trixel << " star " << j << endl;
 
-                name  = QByteArray(starname.longName, 32);
+                name  = QByteArray(starname->longName, 32);
                 named = !name.isEmpty();
 
-                gname  = QByteArray(starname.bayerName, 8);
+                gname  = QByteArray(starname->bayerName, 8);
                 gnamed = !gname.isEmpty();
 
-                if (gnamed && starname.bayerName[0] != '.')
+                if (gnamed && starname->bayerName[0] != '.')
                     visibleName = gname;
 
                 if (named)
@@ -510,6 +549,7 @@ bool StarComponent::loadStaticData()
                 {
                     name = i18n("star");
                 }
+                ++starname;
             }
             else
                 qDebug() << "ERROR: Named star file contains unnamed stars! Expect trouble." << endl;
@@ -549,6 +589,9 @@ bool StarComponent::loadStaticData()
                 objectLists(SkyObject::STAR).append(QPair<QString, const SkyObject *>(gName, star));
             }
 
+            if (named || !visibleName.isEmpty())
+                addToNameIndex(star);
+
             m_ObjectList.append(star);
 
             m_starIndex->at(trixel)->append(star);
@@ -562,9 +605,6 @@ bool StarComponent::loadStaticData()
         }
     }
 
-    dataReader.closeFile();
-    nameReader.closeFile();
-
     starsLoaded = true;
     return true;
 }
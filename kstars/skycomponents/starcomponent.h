@@ -23,6 +23,8 @@
 #include "stardata.h"
 #include "skyobjects/starobject.h"
 
+#include <QVector>
+
 #include <memory>
 
 #ifdef KSTARS_LITE
@@ -61,8 +63,35 @@ class StarComponent : public ListComponent
     friend class StarItem; //Needs access to faintMagnitude() and reindex()
 #endif
 
+  public:
+    /**
+     * Structure that holds star name information, to be read as-is from the
+     * corresponding binary data file
+     */
+    typedef struct starName
+    {
+        char bayerName[8];
+        char longName[32];
+    } starName;
+
+    /**
+     * @short The records of the named stars, as read from namedstars.dat and starnames.dat
+     * Reading them does not touch any sky component, so it can be done in a worker thread
+     * while the other components load, see readStaticData().
+     */
+    struct StaticData
+    {
+        bool valid { false };
+        qint16 faintMag { 0 };
+        quint8 htmLevel { 0 };
+        /// Records of the stars in each trixel, in the order of the file
+        QVector<QVector<StarData>> stars;
+        /// Names of the stars flagged as named, in the order of the file
+        QVector<starName> names;
+    };
+
   protected:
-    StarComponent(SkyComposite *);
+    StarComponent(SkyComposite *, const StaticData &data);
 
   public:
     ~StarComponent() override;
@@ -71,6 +100,15 @@ class StarComponent : public ListComponent
     /** @short Create an instance of StarComponent */
     static StarComponent *Create(SkyComposite *);
 
+    /** @short Create an instance of StarComponent with the named stars read beforehand by readStaticData() */
+    static StarComponent *Create(SkyComposite *, const StaticData &data);
+
+    /**
+     * @short Read the named stars from their data files, from any thread
+     * @return the records, not valid if the files cannot be read
+     */
+    static StaticData readStaticData();
+
     /** @return the instance of StarComponent if already created, nullptr otherwise */
     static StarComponent *Instance() { return pinstance; }
 
@@ -142,15 +180,15 @@ class StarComponent : public ListComponent
 
   private:
     /**
-     * @short Read data for stars which will remain static in the memory
+     * @short Add the stars which will remain static in the memory
      *
-     * This method reads data for named stars (stars having names, which are stored by
-     * default in "namedstars.dat") into memory. These stars are always kept in memory,
+     * This method adds the named stars (stars having names, which are stored by
+     * default in "namedstars.dat") read by readStaticData(). These stars are always kept in memory,
      * as against 'deep' stars which are mostly loaded dynamically (KStars treats all
      * unnamed stars as 'deep' stars) into memory when required, depending on region
      * and magnitude limit. Once loading is successful, this method sets the starsLoaded flag to true
      */
-    bool loadStaticData();
+    bool loadStaticData(const StaticData &data);
 
     /** @return the magnitude of the faintest star */
     float faintMagnitude() const;
@@ -197,18 +235,7 @@ class StarComponent : public ListComponent
     QHash<int, StarObject *> m_HDHash;
     QVector<DeepStarComponent *> m_DeepStarComponents;
 
-    /**
-     * Structure that holds star name information, to be read as-is from the
-     * corresponding binary data file
-     */
-    typedef struct starName
-    {
-        char bayerName[8];
-        char longName[32];
-    } starName;
-
     StarData stardata;
-    starName starname;
 
     static StarComponent *pinstance;
 };
@@ -67,8 +67,11 @@ bool SupernovaeComponent::selected()
 
 void SupernovaeComponent::loadData()
 {
+    foreach (SkyObject *o, m_ObjectList)
+        removeFromNameIndex(o);
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
+    m_NearestIndex.invalidate();
 
     objectNames(SkyObject::SUPERNOVA).clear();
     objectLists(SkyObject::SUPERNOVA).clear();
@@ -142,6 +145,7 @@ void SupernovaeComponent::loadData()
 
         m_ObjectList.append(sup);
         objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject *>(name, sup));
+        addToNameIndex(sup);
     }
 }
 
@@ -161,21 +165,8 @@ SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
-    SkyObject *oBest = nullptr;
-    double rBest     = maxrad;
-
-    foreach (SkyObject *so, m_ObjectList)
-    {
-        double r = so->angularDistanceTo(p).Degrees();
-        //qDebug()<<r;
-        if (r < rBest)
-        {
-            oBest = so;
-            rBest = r;
-        }
-    }
-    maxrad = rBest;
-    return oBest;
+    m_NearestIndex.update(m_ObjectList);
+    return m_NearestIndex.objectNearest(p, maxrad);
 }
 
 float SupernovaeComponent::zoomMagnitudeLimit()
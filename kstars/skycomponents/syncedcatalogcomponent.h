@@ -57,6 +57,10 @@ class SyncedCatalogComponent : public CatalogComponent
 
     void loadData() override { _loadData(false); }
 
+  protected:
+    /** Objects are added at run time, so the whole catalog stays in memory */
+    bool isPageable() const override { return false; }
+
     //    virtual bool selected();
 
   private:
@@ -0,0 +1,195 @@
+/*  Chebyshev cache of the planetary and lunar series
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "ephemeriscache.h"
+
+#include "dms.h"
+#include "kstarsdatetime.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/// Number of times a segment can be cut in halves before the series is used directly
+const int MAX_DEPTH = 3;
+
+/// Number of segments kept per body, the least recently used ones are dropped beyond
+const int MAX_SEGMENTS = 4096;
+
+/// Number of segments dropped at once when a body has too many
+const int EVICTED_SEGMENTS = MAX_SEGMENTS / 4;
+}
+
+const double EphemerisCache::TOLERANCE = 1e-8;
+
+EphemerisCache *EphemerisCache::Instance()
+{
+    static EphemerisCache cache;
+    return &cache;
+}
+
+void EphemerisCache::position(const QString &key, double days, double jd, const Series &series, double xyz[3])
+{
+    const qint64 index = static_cast<qint64>(std::floor((jd - J2000) / days));
+
+    auto lookup = [&](const Segment &segment)
+    {
+        if (segment.isEmpty())
+        {
+            series(jd, xyz);
+            return;
+        }
+        for (const Piece &piece : segment)
+        {
+            if (jd < piece.end)
+            {
+                evaluate(piece, jd, xyz);
+                return;
+            }
+        }
+        evaluate(segment.last(), jd, xyz);
+    };
+
+    {
+        QReadLocker locker(&m_Lock);
+        auto body = m_Segments.constFind(key);
+        if (body != m_Segments.constEnd())
+        {
+            auto segment = body->constFind(index);
+            if (segment != body->constEnd())
+            {
+                segment->used.store(m_Clock.fetchAndAddRelaxed(1));
+                lookup(segment->segment);
+                return;
+            }
+        }
+    }
+
+    // Fill the segment without holding the lock, another thread may do the same meanwhile
+    Segment segment;
+    const double begin = J2000 + index * days;
+    if (!fit(series, begin, begin + days, 0, segment))
+        segment.clear();
+
+    {
+        QWriteLocker locker(&m_Lock);
+        QHash<qint64, CachedSegment> &body = m_Segments[key];
+        if (body.size() >= MAX_SEGMENTS && !body.contains(index))
+            evict(body);
+        CachedSegment &cached = body[index];
+        cached.segment        = segment;
+        cached.used.store(m_Clock.fetchAndAddRelaxed(1));
+    }
+
+    lookup(segment);
+}
+
+void EphemerisCache::evict(QHash<qint64, CachedSegment> &body)
+{
+    QVector<qint64> used;
+    used.reserve(body.size());
+    for (const CachedSegment &cached : body)
+        used.append(cached.used.load());
+
+    // Segments used before the threshold are dropped
+    std::nth_element(used.begin(), used.begin() + EVICTED_SEGMENTS, used.end());
+    const qint64 threshold = used.at(EVICTED_SEGMENTS);
+
+    for (auto it = body.begin(); it != body.end();)
+    {
+        if (it->used.load() < threshold)
+            it = body.erase(it);
+        else
+            ++it;
+    }
+}
+
+void EphemerisCache::clear()
+{
+    QWriteLocker locker(&m_Lock);
+    m_Segments.clear();
+}
+
+bool EphemerisCache::fit(const Series &series, double begin, double end, int depth, Segment &segment)
+{
+    const double middle = 0.5 * (begin + end);
+    const double half   = 0.5 * (end - begin);
+
+    Piece piece;
+    piece.begin = begin;
+    piece.end   = end;
+
+    // Sample the series at the Chebyshev nodes
+    double samples[ORDER][3];
+    for (int k = 0; k < ORDER; ++k)
+        series(middle + half * cos(dms::PI * (k + 0.5) / ORDER), samples[k]);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < ORDER; ++j)
+        {
+            double sum = 0;
+            for (int k = 0; k < ORDER; ++k)
+                sum += samples[k][i] * cos(dms::PI * j * (k + 0.5) / ORDER);
+            piece.coefficients[i][j] = 2.0 * sum / ORDER;
+        }
+    }
+
+    // Check the fit where it is the least constrained: at the ends, midway between the nodes
+    // and halfway between those points and the nodes. The nodes are at k = 2 (mod 4).
+    bool accurate = true;
+    for (int k = 0; k <= 4 * ORDER && accurate; ++k)
+    {
+        if (k % 4 == 2)
+            continue;
+
+        const double jd = middle + half * cos(dms::PI * k / (4 * ORDER));
+        double exact[3], cached[3];
+        series(jd, exact);
+        evaluate(piece, jd, cached);
+
+        double error = 0, distance = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            error += (cached[i] - exact[i]) * (cached[i] - exact[i]);
+            distance += exact[i] * exact[i];
+        }
+        accurate = sqrt(error) <= TOLERANCE * sqrt(distance);
+    }
+
+    if (accurate)
+    {
+        segment.append(piece);
+        return true;
+    }
+    if (depth == MAX_DEPTH)
+        return false;
+    return fit(series, begin, middle, depth + 1, segment) && fit(series, middle, end, depth + 1, segment);
+}
+
+void EphemerisCache::evaluate(const Piece &piece, double jd, double xyz[3])
+{
+    const double x = (2.0 * jd - piece.begin - piece.end) / (piece.end - piece.begin);
+
+    // Clenshaw recurrence
+    for (int i = 0; i < 3; ++i)
+    {
+        const double *c = piece.coefficients[i];
+        double b1 = 0, b2 = 0;
+        for (int j = ORDER - 1; j >= 1; --j)
+        {
+            const double b0 = 2.0 * x * b1 - b2 + c[j];
+            b2              = b1;
+            b1              = b0;
+        }
+        xyz[i] = x * b1 - b2 + 0.5 * c[0];
+    }
+}
@@ -0,0 +1,99 @@
+/*  Chebyshev cache of the planetary and lunar series
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QAtomicInteger>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @class EphemerisCache
+ *
+ * Process-wide cache of the positions of the major bodies, used instead of evaluating
+ * their full series (VSOP87 for the planets, Meeus for the Moon) at every epoch.
+ *
+ * The time line of each body is cut in segments of fixed length aligned on J2000.  The
+ * first time an epoch is requested in a segment, the series is sampled at the Chebyshev
+ * nodes of the segment and fitted by one polynomial per rectangular coordinate.  The
+ * fit is then compared to the series at the ends of the segment, midway between the
+ * nodes and halfway between those points and the nodes;
+ * if the difference exceeds TOLERANCE times the distance of the body, the segment is cut
+ * in halves fitted separately, and after a few cuts the series is used directly for
+ * that segment.  So every cached position is within the tolerance of the series on the
+ * tested epochs, and evaluating one is a few dozen multiplications.
+ *
+ * Tools evaluating the same bodies at thousands of epochs (conjunctions, altitude
+ * curves, calendars, the scheduler) share the segments with the sky map.  Beyond a
+ * fixed number of segments per body, the least recently used ones are dropped.  The
+ * cache can be used from any thread.
+ */
+class EphemerisCache
+{
+  public:
+    /** @short Direct evaluation of the series of a body at a Julian Day, to rectangular coordinates */
+    typedef std::function<void(double jd, double xyz[3])> Series;
+
+    /** Maximum error of the cached positions relative to the distance, about 2 milliarcseconds */
+    static const double TOLERANCE;
+
+    static EphemerisCache *Instance();
+
+    /**
+     * @short Find the position of a body from the cache, filling the cache from series if needed
+     * @param key identifies the body and its series, e.g. its untranslated name
+     * @param days length of the segments of this body, a small fraction of its shortest period
+     * @param jd the Julian Day, in the time scale of the series
+     * @param series evaluates the body directly, only called to fill the cache
+     * @param xyz the rectangular coordinates are returned through this array
+     */
+    void position(const QString &key, double days, double jd, const Series &series, double xyz[3]);
+
+    /** @short Forget all segments, e.g. when the series data change */
+    void clear();
+
+  private:
+    EphemerisCache() = default;
+
+    /// Number of coefficients of each polynomial
+    static const int ORDER = 14;
+
+    struct Piece
+    {
+        double begin { 0 };
+        double end { 0 };
+        double coefficients[3][ORDER];
+    };
+
+    /// A segment is covered by pieces in chronological order, none if the series must be used
+    typedef QVector<Piece> Segment;
+
+    struct CachedSegment
+    {
+        Segment segment;
+        /// Value of m_Clock at the last lookup, updated under the read lock
+        mutable QAtomicInteger<qint64> used;
+    };
+
+    static bool fit(const Series &series, double begin, double end, int depth, Segment &segment);
+    static void evaluate(const Piece &piece, double jd, double xyz[3]);
+
+    /** @short Drop the least recently used segments of a body, the write lock must be held */
+    static void evict(QHash<qint64, CachedSegment> &body);
+
+    QReadWriteLock m_Lock;
+    QHash<QString, QHash<qint64, CachedSegment>> m_Segments;
+    /// Incremented at each lookup to order the segments by use
+    QAtomicInteger<qint64> m_Clock { 0 };
+};
@@ -0,0 +1,254 @@
+/*  Batch propagation of Keplerian orbits
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "keplerorbits.h"
+
+#include "dms.h"
+#include "kstarsdatetime.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/// Number of orbits propagated by one thread at a time
+const int BLOCK_SIZE = 1024;
+
+/// Newton iterations applied to every orbit, enough for all but the most eccentric ones
+const int NEWTON_ITERATIONS = 6;
+
+/// Tolerance on Kepler's equation in radians, about 0.02 arcsecond
+const double KEPLER_TOLERANCE = 1e-7;
+
+/// Gaussian gravitational constant
+const double GAUSS_K = 0.01720209895;
+}
+
+int KeplerOrbits::add(const Elements &elements)
+{
+    double sinw, cosw, sinN, cosN, sini, cosi;
+    dms(elements.w).SinCos(sinw, cosw);
+    dms(elements.N).SinCos(sinN, cosN);
+    dms(elements.i).SinCos(sini, cosi);
+
+    const double e = elements.e;
+
+    m_epoch.append(double(elements.epoch - J2000));
+    m_M0.append(elements.meanAnomaly * dms::DegToRad);
+    m_n.append(elements.period > 0 ? 2.0 * dms::PI / elements.period : 0.0);
+    m_a.append(elements.a);
+    m_q.append(elements.q);
+    m_e.append(e);
+    m_b.append(e < 1.0 ? elements.a * sqrt(1.0 - e * e) : 0.0);
+
+    m_Px.append(cosw * cosN - sinw * sinN * cosi);
+    m_Py.append(cosw * sinN + sinw * cosN * cosi);
+    m_Pz.append(sinw * sini);
+    m_Qx.append(-sinw * cosN - cosw * sinN * cosi);
+    m_Qy.append(-sinw * sinN + cosw * cosN * cosi);
+    m_Qz.append(cosw * sini);
+
+    if (elements.nearParabolic)
+        m_nearParabolic.append(m_e.size() - 1);
+
+    return m_e.size() - 1;
+}
+
+void KeplerOrbits::clear()
+{
+    m_epoch.clear();
+    m_M0.clear();
+    m_n.clear();
+    m_a.clear();
+    m_q.clear();
+    m_e.clear();
+    m_b.clear();
+    m_Px.clear();
+    m_Py.clear();
+    m_Pz.clear();
+    m_Qx.clear();
+    m_Qy.clear();
+    m_Qz.clear();
+    m_nearParabolic.clear();
+}
+
+void KeplerOrbits::propagate(long double jd, Positions &positions) const
+{
+    const int count = size();
+    const double t  = double(jd - J2000);
+
+    positions.x.resize(count);
+    positions.y.resize(count);
+    positions.z.resize(count);
+    positions.r.resize(count);
+
+    // Detach the vectors here, the blocks write to disjoint parts of them
+    double *x = positions.x.data();
+    double *y = positions.y.data();
+    double *z = positions.z.data();
+    double *r = positions.r.data();
+
+    if (count <= BLOCK_SIZE)
+    {
+        propagate(t, 0, count, x, y, z, r);
+        return;
+    }
+
+    QVector<int> blocks;
+    for (int begin = 0; begin < count; begin += BLOCK_SIZE)
+        blocks.append(begin);
+
+    QtConcurrent::blockingMap(blocks, [&](const int &begin)
+                              {
+                                  const int end = qMin(begin + BLOCK_SIZE, count);
+                                  propagate(t, begin, end, x + begin, y + begin, z + begin, r + begin);
+                              });
+}
+
+void KeplerOrbits::propagate(long double jd, const QVector<int> &indexes, Positions &positions) const
+{
+    const int count = size();
+    if (indexes.size() == count)
+    {
+        propagate(jd, positions);
+        return;
+    }
+
+    const double t = double(jd - J2000);
+
+    positions.x.resize(count);
+    positions.y.resize(count);
+    positions.z.resize(count);
+    positions.r.resize(count);
+
+    double *x = positions.x.data();
+    double *y = positions.y.data();
+    double *z = positions.z.data();
+    double *r = positions.r.data();
+
+    // Split the indexes in runs of consecutive orbits, no longer than a block
+    QVector<QPair<int, int>> runs;
+    for (int i = 0; i < indexes.size();)
+    {
+        const int begin = indexes.at(i);
+        int end         = begin + 1;
+        for (++i; i < indexes.size() && indexes.at(i) == end && end - begin < BLOCK_SIZE; ++i)
+            ++end;
+        runs.append(qMakePair(begin, end));
+    }
+
+    if (indexes.size() <= BLOCK_SIZE)
+    {
+        for (const QPair<int, int> &run : runs)
+            propagate(t, run.first, run.second, x + run.first, y + run.first, z + run.first, r + run.first);
+        return;
+    }
+
+    QtConcurrent::blockingMap(runs, [&](const QPair<int, int> &run)
+                              {
+                                  const int k = run.first;
+                                  propagate(t, run.first, run.second, x + k, y + k, z + k, r + k);
+                              });
+}
+
+void KeplerOrbits::propagate(int index, long double jd, double &x, double &y, double &z, double &r) const
+{
+    propagate(double(jd - J2000), index, index + 1, &x, &y, &z, &r);
+}
+
+void KeplerOrbits::propagate(double t, int begin, int end, double *x, double *y, double *z, double *r) const
+{
+    const int count    = end - begin;
+    const double *e    = m_e.constData() + begin;
+    const double *a    = m_a.constData() + begin;
+    const double *b    = m_b.constData() + begin;
+    const double *n    = m_n.constData() + begin;
+    const double *M0   = m_M0.constData() + begin;
+    const double *T0   = m_epoch.constData() + begin;
+    const double *Px   = m_Px.constData() + begin;
+    const double *Py   = m_Py.constData() + begin;
+    const double *Pz   = m_Pz.constData() + begin;
+    const double *Qx   = m_Qx.constData() + begin;
+    const double *Qy   = m_Qy.constData() + begin;
+    const double *Qz   = m_Qz.constData() + begin;
+
+    QVector<double> meanAnomaly(count), eccentricAnomaly(count);
+    double *M = meanAnomaly.data();
+    double *E = eccentricAnomaly.data();
+
+    // Mean anomaly in [-pi, pi] and the usual starting value of the eccentric anomaly
+    for (int k = 0; k < count; ++k)
+    {
+        M[k] = std::remainder(M0[k] + n[k] * (t - T0[k]), 2.0 * dms::PI);
+        E[k] = M[k] + e[k] * sin(M[k]) * (1.0 + e[k] * cos(M[k]));
+    }
+
+    // Fixed number of Newton steps on all orbits, without branches
+    for (int iter = 0; iter < NEWTON_ITERATIONS; ++iter)
+    {
+        for (int k = 0; k < count; ++k)
+            E[k] -= (E[k] - e[k] * sin(E[k]) - M[k]) / (1.0 - e[k] * cos(E[k]));
+    }
+
+    // Finish the few orbits that have not converged yet
+    for (int k = 0; k < count; ++k)
+    {
+        if (e[k] >= 1.0)
+            continue;
+        for (int iter = 0; iter < 1000 && fabs(E[k] - e[k] * sin(E[k]) - M[k]) > KEPLER_TOLERANCE; ++iter)
+            E[k] -= (E[k] - e[k] * sin(E[k]) - M[k]) / (1.0 - e[k] * cos(E[k]));
+    }
+
+    for (int k = 0; k < count; ++k)
+    {
+        const double sinE = sin(E[k]);
+        const double cosE = cos(E[k]);
+        const double xv   = a[k] * (cosE - e[k]);
+        const double yv   = b[k] * sinE;
+
+        x[k] = xv * Px[k] + yv * Qx[k];
+        y[k] = xv * Py[k] + yv * Qy[k];
+        z[k] = xv * Pz[k] + yv * Qz[k];
+        r[k] = a[k] * (1.0 - e[k] * cosE);
+    }
+
+    // Near-parabolic orbits overwrite the values computed above, see KSComet::findGeocentricPosition()
+    QVector<int>::const_iterator it = std::lower_bound(m_nearParabolic.constBegin(), m_nearParabolic.constEnd(), begin);
+    for (; it != m_nearParabolic.constEnd() && *it < end; ++it)
+    {
+        const int index = *it;
+        const int k     = index - begin;
+        const double ek = e[k];
+        const double q  = m_q.at(index);
+
+        const double A  = 0.75 * (t - T0[k]) * GAUSS_K * sqrt((1 + ek) / (q * q * q));
+        const double B  = sqrt(1.0 + A * A);
+        const double W  = pow((B + A), 1.0 / 3.0) - pow((B - A), 1.0 / 3.0);
+        const double c  = 1.0 + 1.0 / (W * W);
+        const double f  = (1.0 - ek) / (1.0 + ek);
+        const double g  = f / (c * c);
+        const double a1 = (2.0 / 3.0) + (2.0 * W * W / 5.0);
+        const double a2 = (7.0 / 5.0) + (33.0 * W * W / 35.0) + (37.0 * W * W * W * W / 175.0);
+        const double a3 = W * W * ((432.0 / 175.0) + (956.0 * W * W / 1125.0) + (84.0 * W * W * W * W / 1575.0));
+        const double wv = W * (1.0 + g * c * (a1 + a2 * g + a3 * g * g));
+
+        const double v  = 2.0 * atan(wv);
+        const double rv = q * (1.0 + wv * wv) / (1.0 + wv * wv * f);
+        const double xv = rv * cos(v);
+        const double yv = rv * sin(v);
+
+        x[k] = xv * Px[k] + yv * Qx[k];
+        y[k] = xv * Py[k] + yv * Qy[k];
+        z[k] = xv * Pz[k] + yv * Qz[k];
+        r[k] = rv;
+    }
+}
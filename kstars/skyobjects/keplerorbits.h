@@ -0,0 +1,116 @@
+/*  Batch propagation of Keplerian orbits
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QVector>
+
+/**
+ * @class KeplerOrbits
+ *
+ * Propagates a set of two-body heliocentric orbits, such as all the asteroids or
+ * comets, to a given date in one call.
+ *
+ * The elements are stored as one array per quantity so that the loops solving
+ * Kepler's equation run over contiguous memory and can be vectorized by the
+ * compiler.  The orientation of each orbit is reduced to its two Gaussian
+ * vectors when the orbit is added, so propagating only needs the trigonometry
+ * of the anomaly.  Large sets are split in blocks propagated in parallel.
+ *
+ * The results are heliocentric ecliptic cartesian coordinates referred to the
+ * J2000 equinox, in AU, as expected by KSPlanetBase::findPosition().
+ *
+ * A KeplerOrbits can be propagated to any number of dates, e.g. by tools that
+ * evaluate many epochs; it holds no state besides the elements.
+ */
+class KeplerOrbits
+{
+  public:
+    /** @short Orbital elements of one body, angles in degrees */
+    struct Elements
+    {
+        /// Julian Day at which the mean anomaly is meanAnomaly, the perihelion date for comets
+        long double epoch { 0 };
+        /// Mean anomaly at epoch
+        double meanAnomaly { 0 };
+        /// Orbital period in days
+        double period { 0 };
+        /// Semi-major axis in AU
+        double a { 0 };
+        /// Perihelion distance in AU, only used for near-parabolic orbits
+        double q { 0 };
+        /// Eccentricity
+        double e { 0 };
+        /// Inclination
+        double i { 0 };
+        /// Argument of perihelion
+        double w { 0 };
+        /// Longitude of the ascending node
+        double N { 0 };
+        /// Use the near-parabolic approximation instead of the ellipse
+        bool nearParabolic { false };
+    };
+
+    /** @short Heliocentric positions, one entry per orbit */
+    struct Positions
+    {
+        QVector<double> x, y, z;
+        /// Distance from the Sun
+        QVector<double> r;
+    };
+
+    /**
+     * @short Add an orbit
+     * @return the index of the orbit in the results
+     */
+    int add(const Elements &elements);
+
+    /** @short Remove all orbits */
+    void clear();
+
+    /** @return the number of orbits */
+    int size() const { return m_e.size(); }
+
+    /**
+     * @short Propagate all orbits to the given date
+     * @param jd the Julian Day
+     * @param positions the results, resized to size()
+     */
+    void propagate(long double jd, Positions &positions) const;
+
+    /**
+     * @short Propagate some of the orbits to the given date
+     * @param jd the Julian Day
+     * @param indexes the orbits to propagate, in increasing order
+     * @param positions the results, resized to size(), only the entries of indexes are set
+     */
+    void propagate(long double jd, const QVector<int> &indexes, Positions &positions) const;
+
+    /** @short Propagate a single orbit to the given date */
+    void propagate(int index, long double jd, double &x, double &y, double &z, double &r) const;
+
+  private:
+    /** @short Propagate the orbits [begin, end) to t days after J2000, the results start at x, y, z and r */
+    void propagate(double t, int begin, int end, double *x, double *y, double *z, double *r) const;
+
+    /// Epoch in days after J2000
+    QVector<double> m_epoch;
+    /// Mean anomaly at epoch in radians
+    QVector<double> m_M0;
+    /// Mean motion in radians per day
+    QVector<double> m_n;
+    QVector<double> m_a, m_q, m_e;
+    /// Semi-minor axis
+    QVector<double> m_b;
+    /// Gaussian vectors: unit vectors towards the perihelion (P) and 90° ahead in the orbit (Q)
+    QVector<double> m_Px, m_Py, m_Pz, m_Qx, m_Qy, m_Qz;
+    /// Indexes of the near-parabolic orbits, propagated separately
+    QVector<int> m_nearParabolic;
+};
@@ -95,56 +95,30 @@ bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase
     double yh = r * (sinN * cosvw + cosN * sinvw * cosi);
     double zh = r * (sinvw * sini);
 
-    //the spherical ecliptic coordinates:
-    double ELongRad = atan2(yh, xh);
-    double ELatRad  = atan2(zh, r);
+    setHeliocentricPosition(num, Earth, xh, yh, zh, r);
 
-    helEcPos.longitude.setRadians(ELongRad);
-    helEcPos.longitude.reduceToRange(dms::ZERO_TO_2PI);
-    helEcPos.latitude.setRadians(ELatRad);
-    setRsun(r);
-
-    if (Earth)
-    {
-        //xe, ye, ze are the Earth's heliocentric cartesian coords
-        double cosBe, sinBe, cosLe, sinLe;
-        Earth->ecLong().SinCos(sinLe, cosLe);
-        Earth->ecLat().SinCos(sinBe, cosBe);
-
-        double xe = Earth->rsun() * cosBe * cosLe;
-        double ye = Earth->rsun() * cosBe * sinLe;
-        double ze = Earth->rsun() * sinBe;
-
-        //convert to geocentric ecliptic coordinates by subtracting Earth's coords:
-        xh -= xe;
-        yh -= ye;
-        zh -= ze;
-    }
-
-    //the spherical geocentricecliptic coordinates:
-    ELongRad  = atan2(yh, xh);
-    double rr = sqrt(xh * xh + yh * yh);
-    ELatRad   = atan2(zh, rr);
-
-    ep.longitude.setRadians(ELongRad);
-    ep.longitude.reduceToRange(dms::ZERO_TO_2PI);
-    ep.latitude.setRadians(ELatRad);
-    if (Earth)
-        setRearth(Earth);
-
-    EclipticToEquatorial(num->obliquity());
-
-    // JM 2017-09-10: The calculations above produce J2000 RESULTS
-    // So we have to precess as well
-    setRA0(ra());
-    setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
-    //nutate(num);
-    //aberrate(num);
+    return true;
+}
 
+bool KSAsteroid::orbitalElements(KeplerOrbits::Elements &elements) const
+{
+    elements.epoch       = JD;
+    elements.meanAnomaly = M.Degrees();
+    elements.period      = P;
+    elements.a           = a;
+    elements.q           = q;
+    elements.e           = e;
+    elements.i           = i.Degrees();
+    elements.w           = w.Degrees();
+    elements.N           = N.Degrees();
     return true;
 }
 
+double KSAsteroid::brightestMagnitude(double r, double delta) const
+{
+    return H + 5 * log10(r * delta);
+}
+
 void KSAsteroid::findMagnitude(const KSNumbers *)
 {
     double param     = 5 * log10(rsun() * rearth());
@@ -184,6 +184,11 @@ class KSAsteroid : public KSPlanetBase
          */
     inline float getPeriod() const { return Period; }
 
+    bool orbitalElements(KeplerOrbits::Elements &elements) const override;
+
+    /** @return the magnitude without the phase function, which only makes the asteroid fainter */
+    double brightestMagnitude(double r, double delta) const override;
+
   protected:
     /** Calculate the geocentric RA, Dec coordinates of the Asteroid.
         	*@note reimplemented from KSPlanetBase
@@ -255,53 +255,31 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     double yh = r * (sinN * cosvw + cosN * sinvw * cosi);
     double zh = r * (sinvw * sini);
 
-    //the spherical ecliptic coordinates:
-    double ELongRad = atan2(yh, xh);
-    double ELatRad  = atan2(zh, r);
-
-    helEcPos.longitude.setRadians(ELongRad);
-    helEcPos.longitude.reduceToRange(dms::ZERO_TO_2PI);
-    helEcPos.latitude.setRadians(ELatRad);
-    setRsun(r);
-
-    //xe, ye, ze are the Earth's heliocentric cartesian coords
-    double cosBe, sinBe, cosLe, sinLe;
-    Earth->ecLong().SinCos(sinLe, cosLe);
-    Earth->ecLat().SinCos(sinBe, cosBe);
-
-    double xe = Earth->rsun() * cosBe * cosLe;
-    double ye = Earth->rsun() * cosBe * sinLe;
-    double ze = Earth->rsun() * sinBe;
-
-    //convert to geocentric ecliptic coordinates by subtracting Earth's coords:
-    xh -= xe;
-    yh -= ye;
-    zh -= ze;
-
-    //Finally, the spherical ecliptic coordinates:
-    ELongRad  = atan2(yh, xh);
-    double rr = sqrt(xh * xh + yh * yh);
-    ELatRad   = atan2(zh, rr);
-
-    ep.longitude.setRadians(ELongRad);
-    ep.longitude.reduceToRange(dms::ZERO_TO_2PI);
-    ep.latitude.setRadians(ELatRad);
-    setRearth(Earth);
-
-    // Now convert to geocentric equatorial coords
-    EclipticToEquatorial(num->obliquity());
-
-    // JM 2017-09-10: The calculations above produce J2000 RESULTS
-    // So we have to precess as well
-    setRA0(ra());
-    setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
-
-    //nutate(num);
-    //aberrate(num);
+    setHeliocentricPosition(num, Earth, xh, yh, zh, r);
 
+    return true;
+}
+
+void KSComet::setHeliocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth, double xh, double yh, double zh,
+                                      double r)
+{
+    KSPlanetBase::setHeliocentricPosition(num, Earth, xh, yh, zh, r);
     findPhysicalParameters();
+}
 
+bool KSComet::orbitalElements(KeplerOrbits::Elements &elements) const
+{
+    // The mean anomaly is zero at perihelion
+    elements.epoch         = JDp;
+    elements.meanAnomaly   = 0;
+    elements.period        = P;
+    elements.a             = a;
+    elements.q             = q;
+    elements.e             = e;
+    elements.i             = i.Degrees();
+    elements.w             = w.Degrees();
+    elements.N             = N.Degrees();
+    elements.nearParabolic = e > 0.98;
     return true;
 }
 
@@ -177,6 +177,8 @@ class KSComet : public KSPlanetBase
     /** @return the comet's period */
     inline float getPeriod() { return Period; }
 
+    bool orbitalElements(KeplerOrbits::Elements &elements) const override;
+
   protected:
     /**
      * Calculate the geocentric RA, Dec coordinates of the Comet.
@@ -187,6 +189,10 @@ class KSComet : public KSPlanetBase
      */
     bool findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth = nullptr) override;
 
+    /** Also estimates the physical parameters, which depend on the distance from the Sun */
+    void setHeliocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth, double xh, double yh, double zh,
+                                 double r) override;
+
     /**
      * @short Estimate physical parameters of the comet such as coma size, tail length and size of the nucleus
      * @note invoked from findGeocentricPosition in order
@@ -28,10 +28,12 @@
 #include <QFile>
 #include <QTextStream>
 
+#include "ephemeriscache.h"
 #include "ksnumbers.h"
 #include "ksutils.h"
 #include "kssun.h"
 #include "kstarsdata.h"
+#include "kstarsdatetime.h"
 #ifndef KSTARS_LITE
 #include "kspopupmenu.h"
 #endif
@@ -87,8 +89,7 @@ KSMoon *KSMoon::clone() const
 
 KSMoon::~KSMoon()
 {
-    instance_count--;
-    if (instance_count <= 0)
+    if (--instance_count <= 0)
     {
         LRData.clear();
         BData.clear();
@@ -97,7 +98,7 @@ KSMoon::~KSMoon()
 }
 
 bool KSMoon::data_loaded   = false;
-int KSMoon::instance_count = 0;
+std::atomic<int> KSMoon::instance_count { 0 };
 QList<KSMoon::MoonLRData> KSMoon::LRData;
 QList<KSMoon::MoonBData> KSMoon::BData;
 
@@ -157,17 +158,52 @@ bool KSMoon::loadData()
 }
 
 bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
+{
+    if (!loadData())
+        return false;
+
+    // The geocentric rectangular coordinates are cached, they are smooth unlike the longitude
+    double xyz[3];
+    EphemerisCache::Instance()->position("Moon", 4, J2000 + num->julianCenturies() * 36525.0,
+                                         [this](double jd, double pos[3])
+                                         {
+                                             EclipticPosition ep;
+                                             calcEclipticSeries((jd - J2000) / 36525.0, ep);
+
+                                             double sinL, cosL, sinB, cosB;
+                                             ep.longitude.SinCos(sinL, cosL);
+                                             ep.latitude.SinCos(sinB, cosB);
+                                             pos[0] = ep.radius * cosB * cosL;
+                                             pos[1] = ep.radius * cosB * sinL;
+                                             pos[2] = ep.radius * sinB;
+                                         },
+                                         xyz);
+
+    //Geocentric coordinates
+    const double rxy = sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1]);
+    dms longitude;
+    longitude.setRadians(atan2(xyz[1], xyz[0]));
+    setEcLong(longitude.reduce());
+    setEcLat(dms(atan2(xyz[2], rxy) * 180.0 / dms::PI));
+    Rearth = sqrt(rxy * rxy + xyz[2] * xyz[2]); //distance from Earth, in AU
+
+    EclipticToEquatorial(num->obliquity());
+
+    //Determine position angle
+    findPA(num);
+
+    return true;
+}
+
+void KSMoon::calcEclipticSeries(double T, EclipticPosition &ep) const
 {
     //Algorithms in this subroutine are taken from Chapter 45 of "Astronomical Algorithms"
     //by Jean Meeus (1991, Willmann-Bell, Inc. ISBN 0-943396-35-2.  http://www.willbell.com/math/mc1.htm)
     //updated to Jean Messus (1998, Willmann-Bell, http://www.naughter.com/aa.html )
 
-    double T, L, D, M, M1, F, A1, A2, A3;
+    double L, D, M, M1, F, A1, A2, A3;
     double sumL, sumR, sumB;
 
-    //Julian centuries since J2000
-    T = num->julianCenturies();
-
     double Et = 1.0 - 0.002516 * T - 0.0000074 * T * T;
 
     //Moon's mean longitude
@@ -194,9 +230,6 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
     sumL = 0.0;
     sumR = 0.0;
 
-    if (!loadData())
-        return false;
-
     for (int i = 0; i < LRData.size(); ++i)
     {
         const MoonLRData &mlrd = LRData[i];
@@ -233,16 +266,9 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
              115.0 * sin(L + M1));
 
     //Geocentric coordinates
-    setEcLong(dms(sumL / 1000000.0 + L * 180.0 / dms::PI)); //convert radians to degrees
-    setEcLat(dms(sumB / 1000000.0));
-    Rearth = (385000.56 + sumR / 1000.0) / AU_KM; //distance from Earth, in AU
-
-    EclipticToEquatorial(num->obliquity());
-
-    //Determine position angle
-    findPA(num);
-
-    return true;
+    ep.longitude = dms(sumL / 1000000.0 + L * 180.0 / dms::PI); //convert radians to degrees
+    ep.latitude  = dms(sumB / 1000000.0);
+    ep.radius    = (385000.56 + sumR / 1000.0) / AU_KM; //distance from Earth, in AU
 }
 
 void KSMoon::findMagnitude(const KSNumbers *)
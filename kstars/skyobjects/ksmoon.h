@@ -20,6 +20,8 @@
 #include "ksplanetbase.h"
 #include "dms.h"
 
+#include <atomic>
+
 class KSSun;
 
 /**
@@ -95,8 +97,17 @@ class KSMoon : public KSPlanetBase
   private:
     void findMagnitude(const KSNumbers *) override;
 
+    /**
+     * Evaluate the series giving the geocentric ecliptic coordinates of the Moon,
+     * findGeocentricPosition() interpolates them from the EphemerisCache.
+     * @param T Julian centuries since J2000
+     * @param ep the coordinates are returned through this argument, the radius in AU
+     */
+    void calcEclipticSeries(double T, EclipticPosition &ep) const;
+
     static bool data_loaded;
-    static int instance_count;
+    /// Moons are also created by tools working in other threads
+    static std::atomic<int> instance_count;
 
     /**
      * @class MoonLRData
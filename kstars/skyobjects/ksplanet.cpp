@@ -17,7 +17,9 @@
 
 #include "ksplanet.h"
 
+#include "ephemeriscache.h"
 #include "ksnumbers.h"
+#include "kstarsdatetime.h"
 #include "ksutils.h"
 #include "ksfilereader.h"
 
@@ -192,6 +194,40 @@ bool KSPlanet::loadData()
 }
 
 void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+{
+    // Segments of a small fraction of the period, Mercury moving the fastest
+    const QString key = untranslatedName();
+    double days       = 16;
+    if (key == "Mercury")
+        days = 8;
+    else if (key == "Jupiter" || key == "Saturn" || key == "Uranus" || key == "Neptune")
+        days = 32;
+
+    // The heliocentric rectangular coordinates are cached, they are smooth unlike the longitude
+    double xyz[3];
+    EphemerisCache::Instance()->position(key, days, J2000 + Tau * 365250.0,
+                                         [this](double jd, double pos[3])
+                                         {
+                                             EclipticPosition ep;
+                                             calcEclipticSeries((jd - J2000) / 365250.0, ep);
+
+                                             double sinL, cosL, sinB, cosB;
+                                             ep.longitude.SinCos(sinL, cosL);
+                                             ep.latitude.SinCos(sinB, cosB);
+                                             pos[0] = ep.radius * cosB * cosL;
+                                             pos[1] = ep.radius * cosB * sinL;
+                                             pos[2] = ep.radius * sinB;
+                                         },
+                                         xyz);
+
+    const double rxy = sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1]);
+    epret.longitude.setRadians(atan2(xyz[1], xyz[0]));
+    epret.longitude.setD(epret.longitude.reduce().Degrees());
+    epret.latitude.setRadians(atan2(xyz[2], rxy));
+    epret.radius = sqrt(rxy * rxy + xyz[2] * xyz[2]);
+}
+
+void KSPlanet::calcEclipticSeries(double Tau, EclipticPosition &epret) const
 {
     double sum[6];
     OrbitDataColl odc;
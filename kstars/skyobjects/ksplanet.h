@@ -79,11 +79,19 @@ class KSPlanet : public KSPlanetBase
      * Calculate the ecliptic longitude and latitude of the planet for
      * the given date (expressed in Julian Millenia since J2000).  A reference
      * to the ecliptic coordinates is returned as the second object.
+     * @note The position is interpolated from the EphemerisCache, see calcEclipticSeries()
      * @param jm Julian Millenia (=jd/1000)
      * @param ret The ecliptic coordinates are returned by reference through this argument.
      */
     virtual void calcEcliptic(double jm, EclipticPosition &ret) const;
 
+    /**
+     * Same as calcEcliptic(), but evaluates the full VSOP series.
+     * @param jm Julian Millenia (=jd/1000)
+     * @param ret The ecliptic coordinates are returned by reference through this argument.
+     */
+    void calcEclipticSeries(double jm, EclipticPosition &ret) const;
+
   protected:
     /**
      * Calculate the geocentric RA, Dec coordinates of the Planet.
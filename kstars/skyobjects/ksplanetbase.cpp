@@ -127,7 +127,78 @@ void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, con
     lastPrecessJD = num->julianDay();
 
     findGeocentricPosition(num, Earth); //private function, reimplemented in each subclass
-    findPhase();
+    finishPosition(num, lat, LST, Earth);
+}
+
+void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                                const KSPlanetBase *Earth, double xh, double yh, double zh, double r)
+{
+    lastPrecessJD = num->julianDay();
+
+    setHeliocentricPosition(num, Earth, xh, yh, zh, r);
+    finishPosition(num, lat, LST, Earth);
+}
+
+void KSPlanetBase::findGeocentricCoords(const KSNumbers *num, const KSPlanetBase *Earth)
+{
+    lastPrecessJD = num->julianDay();
+
+    findGeocentricPosition(num, Earth);
+}
+
+void KSPlanetBase::setHeliocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth, double xh, double yh,
+                                           double zh, double r)
+{
+    //the spherical ecliptic coordinates:
+    double ELongRad = atan2(yh, xh);
+    double ELatRad  = atan2(zh, r);
+
+    helEcPos.longitude.setRadians(ELongRad);
+    helEcPos.longitude.reduceToRange(dms::ZERO_TO_2PI);
+    helEcPos.latitude.setRadians(ELatRad);
+    setRsun(r);
+
+    if (Earth)
+    {
+        //xe, ye, ze are the Earth's heliocentric cartesian coords
+        double cosBe, sinBe, cosLe, sinLe;
+        Earth->ecLong().SinCos(sinLe, cosLe);
+        Earth->ecLat().SinCos(sinBe, cosBe);
+
+        double xe = Earth->rsun() * cosBe * cosLe;
+        double ye = Earth->rsun() * cosBe * sinLe;
+        double ze = Earth->rsun() * sinBe;
+
+        //convert to geocentric ecliptic coordinates by subtracting Earth's coords:
+        xh -= xe;
+        yh -= ye;
+        zh -= ze;
+    }
+
+    //the spherical geocentric ecliptic coordinates:
+    ELongRad  = atan2(yh, xh);
+    double rr = sqrt(xh * xh + yh * yh);
+    ELatRad   = atan2(zh, rr);
+
+    ep.longitude.setRadians(ELongRad);
+    ep.longitude.reduceToRange(dms::ZERO_TO_2PI);
+    ep.latitude.setRadians(ELatRad);
+    if (Earth)
+        setRearth(Earth);
+
+    EclipticToEquatorial(num->obliquity());
+
+    // JM 2017-09-10: The calculations above produce J2000 RESULTS
+    // So we have to precess as well
+    setRA0(ra());
+    setDec0(dec());
+    apparentCoord(J2000, lastPrecessJD);
+}
+
+void KSPlanetBase::finishPosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                                  const KSPlanetBase *Earth)
+{
+    computePhase(Earth);
     setAngularSize(asin(physicalSize() / Rearth / AU_KM) * 60. * 180. / dms::PI); //angular size in arcmin
 
     if (lat && LST)
@@ -294,14 +365,22 @@ double KSPlanetBase::labelOffset() const
 }
 
 void KSPlanetBase::findPhase()
+{
+    computePhase(nullptr);
+}
+
+void KSPlanetBase::computePhase(const KSPlanetBase *Earth)
 {
     if (2*rsun()*rearth() == 0)
     {
         Phase = std::numeric_limits<double>::quiet_NaN();
         return;
     }
+    if (Earth == nullptr)
+        Earth = KStarsData::Instance()->skyComposite()->earth();
+
     /* Compute the phase of the planet in degrees */
-    double earthSun = KStarsData::Instance()->skyComposite()->earth()->rsun();
+    double earthSun = Earth->rsun();
     double cosPhase = (rsun() * rsun() + rearth() * rearth() - earthSun * earthSun) / (2 * rsun() * rearth());
 
     Phase           = acos(cosPhase) * 180.0 / dms::PI;
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "keplerorbits.h"
 #include "trailobject.h"
 
 #include <QColor>
@@ -24,6 +25,8 @@
 #include <QImage>
 #include <QList>
 
+#include <limits>
+
 class KSNumbers;
 
 /**
@@ -179,6 +182,54 @@ class KSPlanetBase : public TrailObject
     void findPosition(const KSNumbers *num, const CachingDms *lat = nullptr, const CachingDms *LST = nullptr,
                       const KSPlanetBase *Earth = nullptr);
 
+    /**
+     * @short Find position from a heliocentric position computed elsewhere, usually by KeplerOrbits.
+     * Same as findPosition() above, but skips findGeocentricPosition().
+     * @param num KSNumbers pointer for the target date/time
+     * @param lat pointer to the geographic latitude; if nullptr, we skip localizeCoords()
+     * @param LST pointer to the local sidereal time; if nullptr, we skip localizeCoords()
+     * @param Earth pointer to the Earth
+     * @param xh heliocentric ecliptic x coordinate referred to J2000, in AU
+     * @param yh heliocentric ecliptic y coordinate referred to J2000, in AU
+     * @param zh heliocentric ecliptic z coordinate referred to J2000, in AU
+     * @param r distance from the Sun, in AU
+     * @note Safe to call for different objects in parallel, unless the object has a trail.
+     */
+    void findPosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST, const KSPlanetBase *Earth,
+                      double xh, double yh, double zh, double r);
+
+    /**
+     * @short Find the geocentric position only, without the phase, magnitude and trail of findPosition()
+     * Unlike findPosition(), it does not read the sky map state, so it can be called on a private
+     * copy from another thread once loadData() was called.
+     * @param num KSNumbers pointer for the target date/time
+     * @param Earth pointer to the Earth, at the date of num
+     */
+    void findGeocentricCoords(const KSNumbers *num, const KSPlanetBase *Earth);
+
+    /**
+     * @short Get the osculating orbital elements of the object, for batch propagation with KeplerOrbits
+     * @return false if the position is not computed from fixed Keplerian elements
+     */
+    virtual bool orbitalElements(KeplerOrbits::Elements &elements) const
+    {
+        Q_UNUSED(elements);
+        return false;
+    }
+
+    /**
+     * @short Get a cheap lower bound of the magnitude of the object at the given distances
+     * @param r distance from the Sun, in AU
+     * @param delta distance from the Earth, in AU
+     * @return the lower bound, NaN if it cannot be estimated
+     */
+    virtual double brightestMagnitude(double r, double delta) const
+    {
+        Q_UNUSED(r);
+        Q_UNUSED(delta);
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
     /** @return the Planet's position angle. */
     double pa() const override { return PositionAngle; }
 
@@ -241,6 +292,19 @@ class KSPlanetBase : public TrailObject
      */
     virtual bool findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth = nullptr) = 0;
 
+    /**
+     * @short Set the ecliptic and equatorial coordinates from a heliocentric position
+     * Used by the bodies with Keplerian orbits to finish findGeocentricPosition().
+     * @param num pointer to current KSNumbers object
+     * @param Earth pointer to planet Earth; if nullptr, the coordinates stay heliocentric
+     * @param xh heliocentric ecliptic x coordinate referred to J2000, in AU
+     * @param yh heliocentric ecliptic y coordinate referred to J2000, in AU
+     * @param zh heliocentric ecliptic z coordinate referred to J2000, in AU
+     * @param r distance from the Sun, in AU
+     */
+    virtual void setHeliocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth, double xh, double yh,
+                                         double zh, double r);
+
     /**
      * @short Computes the visual magnitude for the major planets.
      * @param num pointer to a ksnumbers object. Needed for the saturn rings contribution to
@@ -279,6 +343,17 @@ class KSPlanetBase : public TrailObject
      */
     void localizeCoords(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST);
 
+    /**
+     * @short The part of findPosition() that follows findGeocentricPosition()
+     * The phase is computed from Earth when it is given, so that bodies can be finished from
+     * worker threads without reaching KStarsData.
+     */
+    void finishPosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                        const KSPlanetBase *Earth);
+
+    /** @short Determine the phase of the planet, from the Earth of KStarsData if Earth is null */
+    void computePhase(const KSPlanetBase *Earth);
+
     double PositionAngle, AngularSize, PhysicalSize;
     QColor m_Color;
 };
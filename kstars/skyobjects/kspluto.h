@@ -53,6 +53,9 @@ class KSPluto : public KSAsteroid
 
     KSPluto *clone() const override;
 
+    /** The elements of Pluto change with time, so they cannot be propagated by KeplerOrbits */
+    bool orbitalElements(KeplerOrbits::Elements &) const override { return false; }
+
     /**Destructor (empty) */
     ~KSPluto() override;
 
@@ -0,0 +1,189 @@
+/*  Batch rise, transit and set times
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "risesetsolver.h"
+
+#include "geolocation.h"
+#include "kstarsdatetime.h"
+#include "ksutils.h"
+#include "skyobject.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/// Number of positions solved by one thread at a time
+const int BLOCK_SIZE = 2048;
+
+const double NO_EVENT = std::numeric_limits<double>::quiet_NaN();
+
+/// An event of a moving object is iterated until it changes by less than this, in days
+const double CONVERGENCE = 1.0 / 86400.0;
+
+/// Iterations of an event of a moving object, the Moon needs about three
+const int MAX_ITERATIONS = 8;
+}
+
+RiseSetSolver::RiseSetSolver(const GeoLocation *geo)
+    : m_Longitude(geo->lng()->Degrees()), m_Latitude(geo->lat()->Degrees())
+{
+    geo->lat()->SinCos(m_SinLatitude, m_CosLatitude);
+}
+
+int RiseSetSolver::add(double ra, double dec, double horizon)
+{
+    m_ra.append(ra);
+    m_dec.append(dec);
+    m_horizon.append(horizon);
+    return m_ra.size() - 1;
+}
+
+int RiseSetSolver::add(const SkyObject *object)
+{
+    return add(object->ra().Degrees(), object->dec().Degrees(), object->elevationCorrection().Degrees());
+}
+
+void RiseSetSolver::clear()
+{
+    m_ra.clear();
+    m_dec.clear();
+    m_horizon.clear();
+}
+
+void RiseSetSolver::solve(double jd, QVector<Events> &events) const
+{
+    const int count = size();
+    events.resize(count);
+    if (count == 0)
+        return;
+
+    const double lst = KStarsDateTime(jd).gst().Degrees() + m_Longitude;
+    Events *results  = events.data();
+
+    if (count <= BLOCK_SIZE)
+    {
+        solve(jd, lst, 0, count, results);
+        return;
+    }
+
+    QVector<int> blocks;
+    for (int begin = 0; begin < count; begin += BLOCK_SIZE)
+        blocks.append(begin);
+
+    QtConcurrent::blockingMap(blocks, [&](const int &begin)
+                              {
+                                  const int end = qMin(begin + BLOCK_SIZE, count);
+                                  solve(jd, lst, begin, end, results + begin);
+                              });
+}
+
+void RiseSetSolver::solve(double jd, double lst, int begin, int end, Events *events) const
+{
+    const double *ra      = m_ra.constData();
+    const double *dec     = m_dec.constData();
+    const double *horizon = m_horizon.constData();
+
+    for (int i = begin; i < end; ++i)
+        events[i - begin] = solvePosition(lst - ra[i], dec[i], horizon[i], jd);
+}
+
+RiseSetSolver::Events RiseSetSolver::solve(const Motion &motion, double horizon, double jd) const
+{
+    double ra, dec;
+    motion(jd, ra, dec);
+    Events events = solvePosition(hourAngle(jd, ra), dec, horizon, jd);
+
+    // The transit from the position at the transit
+    for (int i = 0; i < MAX_ITERATIONS; ++i)
+    {
+        const double transit = events.transit;
+        motion(transit, ra, dec);
+        events = solvePosition(hourAngle(transit, ra), dec, horizon, transit);
+        if (fabs(events.transit - transit) < CONVERGENCE)
+            break;
+    }
+
+    events.rise = iterateHorizon(motion, horizon, events, true);
+    events.set  = iterateHorizon(motion, horizon, events, false);
+    return events;
+}
+
+double RiseSetSolver::iterateHorizon(const Motion &motion, double horizon, const Events &events, bool rise) const
+{
+    double jd = rise ? events.rise : events.set;
+    for (int i = 0; i < MAX_ITERATIONS && !std::isnan(jd); ++i)
+    {
+        // The hour angle of the horizon from the position at the last estimate, around the same transit
+        double ra, dec;
+        motion(jd, ra, dec);
+        const Events e    = solvePosition(hourAngle(events.transit, ra), dec, horizon, events.transit);
+        const double next = rise ? e.rise : e.set;
+        if (std::isnan(next) || fabs(next - jd) < CONVERGENCE)
+            return next;
+        jd = next;
+    }
+    return jd;
+}
+
+double RiseSetSolver::hourAngle(double jd, double ra) const
+{
+    return KStarsDateTime(jd).gst().Degrees() + m_Longitude - ra;
+}
+
+RiseSetSolver::Events RiseSetSolver::solvePosition(double hourAngle, double dec, double horizon, double jd) const
+{
+    Events events;
+
+    // Transit closest to jd, and the highest altitude
+    events.transit         = jd - KSUtils::reduceAngle(hourAngle, -180.0, 180.0) / dms::SiderealRate;
+    events.transitAltitude = 90.0 - fabs(m_Latitude - dec);
+
+    riseAndSet(dec, horizon, events);
+    return events;
+}
+
+void RiseSetSolver::riseAndSet(double dec, double horizon, Events &events) const
+{
+    events.rise        = NO_EVENT;
+    events.set         = NO_EVENT;
+    events.circumpolar = false;
+    events.neverRises  = false;
+
+    const double sinDec = sin(dec * dms::DegToRad), cosDec = cos(dec * dms::DegToRad);
+
+    const double numerator   = sin(horizon * dms::DegToRad) - m_SinLatitude * sinDec;
+    const double denominator = m_CosLatitude * cosDec;
+    if (fabs(denominator) < 1e-12)
+    {
+        // At the poles, the altitude does not change
+        events.circumpolar = numerator < 0;
+        events.neverRises  = !events.circumpolar;
+        return;
+    }
+
+    const double cosH0 = numerator / denominator;
+    if (cosH0 >= 1.0)
+    {
+        events.neverRises = true;
+        return;
+    }
+    if (cosH0 <= -1.0)
+    {
+        events.circumpolar = true;
+        return;
+    }
+
+    const double H0 = acos(cosH0) / dms::DegToRad;
+    events.rise     = events.transit - H0 / dms::SiderealRate;
+    events.set      = events.transit + H0 / dms::SiderealRate;
+}
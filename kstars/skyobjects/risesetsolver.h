@@ -0,0 +1,118 @@
+/*  Batch rise, transit and set times
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QVector>
+
+#include <functional>
+
+class GeoLocation;
+class SkyObject;
+
+/**
+ * @class RiseSetSolver
+ *
+ * Finds when objects rise, transit and set as seen from a location, many objects in one call.
+ *
+ * The positions of the objects are added to the solver, stored as one array per quantity,
+ * and their events are solved in closed form from the hour angle.  Large sets are split in
+ * blocks solved in parallel.  The added positions are fixed on the sky.  The events of a
+ * moving object are rather iterated one object at a time by solve() with its Motion, each
+ * from the position at its previous estimate, as VisibilityService does for the solar
+ * system objects.
+ *
+ * The solver copies the coordinates of the location and reads no global state, so it can
+ * be used from any thread.  The positions are apparent coordinates of date, e.g. the ra()
+ * and dec() of the objects updated by the sky map.
+ */
+class RiseSetSolver
+{
+  public:
+    /** @short The events of an object around a time, in Julian Days (UT) */
+    struct Events
+    {
+        /// The transit closest to the time of the solution
+        double transit { 0 };
+        /// The rise before the transit and the set after it, NaN if the object does not cross its horizon
+        double rise { 0 };
+        double set { 0 };
+        /// Altitude at the transit, in degrees
+        double transitAltitude { 0 };
+        /// The object stays above its horizon all day
+        bool circumpolar { false };
+        /// The object stays below its horizon all day
+        bool neverRises { false };
+    };
+
+    /// The position of a moving object at a Julian Day (UT): right ascension and declination in degrees
+    typedef std::function<void(double jd, double &ra, double &dec)> Motion;
+
+    explicit RiseSetSolver(const GeoLocation *geo);
+
+    /**
+     * @short Add a position fixed on the sky
+     * @param ra right ascension in degrees
+     * @param dec declination in degrees
+     * @param horizon altitude of the rise and the set in degrees, see SkyObject::elevationCorrection()
+     * @return the index of the position in the results
+     */
+    int add(double ra, double dec, double horizon);
+
+    /** @short Add object at its current position */
+    int add(const SkyObject *object);
+
+    /** @short Remove all positions */
+    void clear();
+
+    /** @return the number of positions */
+    int size() const { return m_ra.size(); }
+
+    /**
+     * @short Solve all positions around a time
+     * @param jd the Julian Day (UT) the transits are closest to
+     * @param events the results, resized to size()
+     */
+    void solve(double jd, QVector<Events> &events) const;
+
+    /**
+     * @short Solve a moving object around a time, without adding it
+     * The transit, then the rise and the set are each iterated with the position at their last
+     * estimate, until they change by less than a second.  The other fields are those of the
+     * position at the transit.
+     * @param motion the position of the object at any time, called a few times per event
+     * @param horizon altitude of the rise and the set in degrees
+     * @param jd the Julian Day (UT) the transit is closest to
+     */
+    Events solve(const Motion &motion, double horizon, double jd) const;
+
+  private:
+    /** @short Solve the positions [begin, end), the hour angle at jd being lst minus their right ascension */
+    void solve(double jd, double lst, int begin, int end, Events *events) const;
+
+    /** @short Solve a single position from its hour angle at jd */
+    Events solvePosition(double hourAngle, double dec, double horizon, double jd) const;
+
+    /** @short Iterate the rise or the set of a moving object from the events of its transit, NaN if not crossed */
+    double iterateHorizon(const Motion &motion, double horizon, const Events &events, bool rise) const;
+
+    /** @return the hour angle at jd of right ascension ra, in degrees */
+    double hourAngle(double jd, double ra) const;
+
+    /** @short Fill the rise and the set of events from their hour angle, or the circumpolar flags */
+    void riseAndSet(double dec, double horizon, Events &events) const;
+
+    double m_Longitude { 0 };
+    double m_Latitude { 0 };
+    double m_SinLatitude { 0 };
+    double m_CosLatitude { 0 };
+
+    QVector<double> m_ra, m_dec, m_horizon;
+};
@@ -56,6 +56,10 @@
 #define F       3.35281066474748e-3      // Flattening factor
 #define MFACTOR 7.292115e-5
 
+// Culling of the satellites below the horizon
+#define HIDDEN_MARGIN      2.0   // Degrees added to the horizon for the perturbations of the orbit (deg)
+#define MAX_HIDDEN_MINUTES 360.0 // Longest time a satellite is skipped (min)
+
 Satellite::Satellite(const QString &name, const QString &line1, const QString &line2)
 {
     //m_name          = name;
@@ -717,16 +721,121 @@ void Satellite::init()
     }
 }
 
-int Satellite::updatePos()
+Satellite::Context Satellite::context(bool cull)
 {
     KStarsData *data = KStarsData::Instance();
-    return sgp4((data->clock()->utc().djd() - m_tle_jd) * MINPD);
+    Context context  = Satellite::context(*data->geo(), data->clock()->utc().djd(), cull);
+
+    // Use the same sidereal time and Sun as the rest of the sky map
+    context.lst     = *data->lst();
+    KSSun *sun      = (KSSun *)data->skyComposite()->findByName("Sun");
+    context.sunDown = sun->alt().Degrees() <= -12.0;
+
+    return context;
 }
 
-int Satellite::sgp4(double tsince)
+Satellite::Context Satellite::context(const GeoLocation &geo, double jd, bool cull)
 {
-    KStarsData *data = KStarsData::Instance();
+    Context context;
+
+    context.jd        = jd;
+    context.lat       = *geo.lat();
+    context.longitude = geo.lng()->Degrees();
+    context.cull      = cull;
+
+    // Observer ECI position
+    context.sinlat        = sin(geo.lat()->radians());
+    context.coslat        = cos(geo.lat()->radians());
+    const double thetageo = geo.LMST(context.jd);
+    context.lst.setRadians(thetageo);
+    context.sintheta      = sin(thetageo);
+    context.costheta      = cos(thetageo);
+
+    const double c     = 1.0 / sqrt(1.0 + F * (F - 2.0) * context.sinlat * context.sinlat);
+    const double sq    = (1.0 - F) * (1.0 - F) * c;
+    const double achcp = (RADIUSEARTHKM * c + MEANALT) * context.coslat;
+    context.obs_posx   = achcp * context.costheta;
+    context.obs_posy   = achcp * context.sintheta;
+    context.obs_posz   = (RADIUSEARTHKM * sq + MEANALT) * context.sinlat;
+
+    // Find ECI coordinates of the sun
+    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
+
+    mjd  = context.jd - 2415020.0;
+    year = 1900.0 + mjd / 365.25;
+    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
+    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
+    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
+    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
+    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
+                   0.000293 * sin(3 * M));
+    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
+    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
+    nu   = Modulus(M + C, TWOPI);
+    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
+    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
+    R    = AU * R;
+
+    context.sun_posx = R * cos(Lsa);
+    context.sun_posy = R * sin(Lsa) * cos(eps);
+    context.sun_posz = R * sin(Lsa) * sin(eps);
+    context.sun_posw = R;
+
+    // Elevation of the sun, the observer being much closer to the center of the Earth
+    const double top_z = context.coslat * context.costheta * context.sun_posx +
+                         context.coslat * context.sintheta * context.sun_posy + context.sinlat * context.sun_posz;
+    context.sunDown = arcSin(top_z / R) <= -12.0 * DEG2RAD;
+
+    return context;
+}
+
+int Satellite::updatePos()
+{
+    return updatePos(context());
+}
 
+int Satellite::updatePos(const Context &context)
+{
+    // Skip the satellite while it cannot rise above the horizon
+    if (context.cull && context.jd >= m_hidden_from && context.jd < m_hidden_until &&
+        context.lat.Degrees() == m_hidden_lat && context.longitude == m_hidden_lng)
+        return 0;
+
+    return sgp4((context.jd - m_tle_jd) * MINPD, context);
+}
+
+void Satellite::setHidden(const Context &context, double sat_posx, double sat_posy, double sat_posz, double sat_posw)
+{
+    // Angle at the center of the Earth between the observer and the satellite
+    const double obs_posw = sqrt(context.obs_posx * context.obs_posx + context.obs_posy * context.obs_posy +
+                                 context.obs_posz * context.obs_posz);
+    const double cospsi =
+        (context.obs_posx * sat_posx + context.obs_posy * sat_posy + context.obs_posz * sat_posz) / (obs_posw * sat_posw);
+    const double psi = acos(qBound(-1.0, cospsi, 1.0));
+
+    // Largest such angle for which the satellite can be above the horizon, reached at apogee
+    const double a      = pow(XKE / m_mean_motion, X2O3);
+    const double apogee = a * (1.0 + m_eccentricity);
+    if (apogee <= 1.0)
+        return;
+    const double horizon = acos(1.0 / apogee) + HIDDEN_MARGIN * DEG2RAD;
+
+    // Upper bound of the angular speed of the satellite relative to the observer, at perigee
+    const double e2      = 1.0 - m_eccentricity * m_eccentricity;
+    const double rate    = m_mean_motion * (1.0 + m_eccentricity) * (1.0 + m_eccentricity) / (e2 * sqrt(e2)) +
+                        MFACTOR * 60.0;
+    const double minutes = qMin((psi - horizon) / rate, MAX_HIDDEN_MINUTES);
+    if (minutes <= 0)
+        return;
+
+    m_hidden_from  = context.jd - minutes / MINPD;
+    m_hidden_until = context.jd + minutes / MINPD;
+    m_hidden_lat   = context.lat.Degrees();
+    m_hidden_lng   = context.longitude;
+}
+
+int Satellite::sgp4(double tsince, const Context &context)
+{
     int ktr;
     double am, axnl, aynl, betal, cosim, cnod, cos2u, coseo1 = 0, cosi, cosip, cosisq, cossu, cosu, delm, delomg, em,
         ecose, el2, eo1, ep, esine, argpm, argpp, argpdf, pl,
@@ -734,13 +843,11 @@ int Satellite::sgp4(double tsince)
         t3, t4, tem5, temp, temp1, temp2, tempa, tempe, templ, u, ux, uy, uz, vx, vy, vz, inclm, mm, nm, nodem, xinc,
         xincp, xl, xlm, mp, xmdf, xmx, xmy, nodedf, xnode, nodep, tc, sat_posx, sat_posy, sat_posz, sat_posw, sat_velx,
         sat_vely, sat_velz, sinlat, obs_posx, obs_posy, obs_posz, obs_posw, /*obs_velx, obs_vely, obs_velz,*/
-        coslat, thetageo, sintheta, costheta, c, sq, achcp, vkmpersec;
+        coslat, sintheta, costheta, vkmpersec;
 //    double emsq;
 
     const double temp4 = 1.5e-12;
 
-    double jul_utc = data->clock()->utc().djd();
-
     vkmpersec = RADIUSEARTHKM * XKE / 60.0;
 
     // Update for secular gravity and atmospheric drag
@@ -1150,17 +1257,13 @@ int Satellite::sgp4(double tsince)
     }
 
     // Observer ECI position and velocity
-    sinlat   = sin(data->geo()->lat()->radians());
-    coslat   = cos(data->geo()->lat()->radians());
-    thetageo = data->geo()->LMST(jul_utc);
-    sintheta = sin(thetageo);
-    costheta = cos(thetageo);
-    c        = 1.0 / sqrt(1.0 + F * (F - 2.0) * sinlat * sinlat);
-    sq       = (1.0 - F) * (1.0 - F) * c;
-    achcp    = (RADIUSEARTHKM * c + MEANALT) * coslat;
-    obs_posx = achcp * costheta;
-    obs_posy = achcp * sintheta;
-    obs_posz = (RADIUSEARTHKM * sq + MEANALT) * sinlat;
+    sinlat   = context.sinlat;
+    coslat   = context.coslat;
+    sintheta = context.sintheta;
+    costheta = context.costheta;
+    obs_posx = context.obs_posx;
+    obs_posy = context.obs_posy;
+    obs_posz = context.obs_posz;
     obs_posw = sqrt(obs_posx * obs_posx + obs_posy * sat_posy + obs_posz * obs_posz);
     /*obs_velx = -MFACTOR * obs_posy;
     obs_vely = MFACTOR * obs_posx;
@@ -1193,31 +1296,16 @@ int Satellite::sgp4(double tsince)
 
     setAz(azimut / DEG2RAD);
     setAlt(elevation / DEG2RAD);
-    HorizontalToEquatorial(data->lst(), data->geo()->lat());
+    HorizontalToEquatorial(&context.lst, &context.lat);
 
-    // is the satellite visible ?
-    // Find ECI coordinates of the sun
-    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
-
-    mjd  = jul_utc - 2415020.0;
-    year = 1900.0 + mjd / 365.25;
-    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
-    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
-    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
-    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
-    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
-                   0.000293 * sin(3 * M));
-    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
-    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
-    nu   = Modulus(M + C, TWOPI);
-    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
-    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
-    R    = AU * R;
+    if (context.cull && elevation < 0.0)
+        setHidden(context, sat_posx, sat_posy, sat_posz, sat_posw);
 
-    double sun_posx = R * cos(Lsa);
-    double sun_posy = R * sin(Lsa) * cos(eps);
-    double sun_posz = R * sin(Lsa) * sin(eps);
-    double sun_posw = R;
+    // is the satellite visible ?
+    double sun_posx = context.sun_posx;
+    double sun_posy = context.sun_posy;
+    double sun_posz = context.sun_posz;
+    double sun_posw = context.sun_posw;
 
     // Calculates satellite's eclipse status and depth
     double sd_sun, sd_earth, delta, depth;
@@ -1235,10 +1323,9 @@ int Satellite::sgp4(double tsince)
     double earth_w = sat_posw;
     delta      = PIO2 - arcSin((sun_posx * earth_x + sun_posy * earth_y + sun_posz * earth_z) / (sun_posw * earth_w));
     depth      = sd_earth - sd_sun - delta;
-    KSSun *sun = (KSSun *)data->skyComposite()->findByName("Sun");
 
     m_is_eclipsed = sd_earth >= sd_sun && depth >= 0;
-    m_is_visible  = !m_is_eclipsed && sun->alt().Degrees() <= -12.0 && elevation >= 0.0;
+    m_is_visible  = !m_is_eclipsed && context.sunDown && elevation >= 0.0;
 
     return (0);
 }
@@ -1348,3 +1435,8 @@ QString Satellite::id()
 {
     return m_id;
 }
+
+double Satellite::period() const
+{
+    return TWOPI / m_mean_motion;
+}
@@ -21,6 +21,7 @@
 
 #include <QString>
 
+class GeoLocation;
 class KSPopupMenu;
 
 /**
@@ -33,6 +34,32 @@ class KSPopupMenu;
 class Satellite : public SkyObject
 {
   public:
+    /**
+     * @struct Satellite::Context
+     * Time and observer dependent terms shared by all satellites at a given date.
+     * Computed once by context() and passed to updatePos() for each satellite.
+     */
+    struct Context
+    {
+        /// Julian Day (UTC)
+        double jd { 0 };
+        /// Observer latitude and local sidereal time
+        CachingDms lat, lst;
+        /// Observer longitude in degrees
+        double longitude { 0 };
+        double sinlat { 0 }, coslat { 0 };
+        /// Sine and cosine of the observer local mean sidereal time
+        double sintheta { 0 }, costheta { 0 };
+        /// Observer ECI position (km)
+        double obs_posx { 0 }, obs_posy { 0 }, obs_posz { 0 };
+        /// Sun ECI position (km)
+        double sun_posx { 0 }, sun_posy { 0 }, sun_posz { 0 }, sun_posw { 0 };
+        /// True if the sun is at least 12° under horizon
+        bool sunDown { false };
+        /// True to skip the satellites known to stay below the horizon
+        bool cull { false };
+    };
+
     /** @short Constructor */
     Satellite(const QString &name, const QString &line1, const QString &line2);
 
@@ -45,9 +72,31 @@ class Satellite : public SkyObject
     /** @short Destructor */
     ~Satellite() override;
 
+    /**
+     * @short Compute the terms shared by all satellites for the current date and location
+     * @param cull true to let updatePos() skip the satellites below the horizon until they
+     * can rise again, their position is then left unchanged
+     */
+    static Context context(bool cull = false);
+
+    /**
+     * @short Compute the terms shared by all satellites for any date and location
+     * Does not use KStarsData, so it can be called from any thread.
+     * @param geo the observer location
+     * @param jd the Julian Day (UTC)
+     * @param cull see context(bool)
+     */
+    static Context context(const GeoLocation &geo, double jd, bool cull = false);
+
     /** @short Update satellite position */
     int updatePos();
 
+    /**
+     * @short Update satellite position with precomputed shared terms
+     * @note Safe to call for different satellites in parallel
+     */
+    int updatePos(const Context &context);
+
     /**
      * @return True if the satellite is visible (above horizon, in the sunlight and sun at least 12° under horizon)
      */
@@ -71,6 +120,15 @@ class Satellite : public SkyObject
     /** @return Satellite international designator */
     QString id();
 
+    /** @return Orbital period in minutes */
+    double period() const;
+
+    /**
+     * @return Julian Day until which the satellite cannot rise, as found by the last
+     * updatePos() with a culling context, in the past if unknown
+     */
+    double hiddenUntil() const { return m_hidden_until; }
+
     /**
      * @brief sgp4ErrorString Get error string associated with sgp4 calculation failure
      * @param code error code as returned from sgp4() function
@@ -85,10 +143,17 @@ class Satellite : public SkyObject
     void init();
 
     /** @short Compute satellite position */
-    int sgp4(double tsince);
+    int sgp4(double tsince, const Context &context);
+
+    /**
+     * @short Compute how long the satellite, currently below the horizon, cannot rise
+     * Uses the angle at the center of the Earth between the observer and the satellite,
+     * compared to the largest angle at which the satellite can be seen.
+     */
+    void setHidden(const Context &context, double sat_posx, double sat_posy, double sat_posz, double sat_posw);
 
     /** @return Arcsine of the argument */
-    double arcSin(double arg);
+    static double arcSin(double arg);
 
     /**
      * Provides the difference between UT (approximately the same as UTC)
@@ -96,10 +161,10 @@ class Satellite : public SkyObject
      * This function is based on a least squares fit of data from 1950
      * to 1991 and will need to be updated periodically.
      */
-    double deltaET(double year);
+    static double deltaET(double year);
 
     /** @return arg1 mod arg2 */
-    double Modulus(double arg1, double arg2);
+    static double Modulus(double arg1, double arg2);
 
     // TLE
     /// Satellite Number
@@ -152,6 +217,11 @@ class Satellite : public SkyObject
     double m_altitude { 0 };
     /// Satellite range from observer in km
     double m_range { 0 };
+    /// Julian Days between which the satellite stays below the horizon of the observer below
+    double m_hidden_from { 0 };
+    double m_hidden_until { -1 };
+    double m_hidden_lat { 0 };
+    double m_hidden_lng { 0 };
 
     // Near Earth
     bool isimp { false };
@@ -22,6 +22,13 @@
 #include "skyobjects/satellite.h"
 
 #include <QTextStream>
+#include <QtConcurrent>
+
+namespace
+{
+/// Number of satellites propagated by one thread at a time
+const int SATELLITES_PER_TASK = 64;
+}
 
 SatelliteGroup::SatelliteGroup(const QString& name, const QString& tle_filename, const QUrl& update_url)
 {
@@ -63,21 +70,34 @@ void SatelliteGroup::readTLE()
     }
 }
 
-void SatelliteGroup::updateSatellitesPos()
+void SatelliteGroup::updateSatellitesPos(const Satellite::Context &context)
 {
-    QMutableListIterator<Satellite *> sats(*this);
+    QVector<Satellite *> selected;
+    for (Satellite *sat : *this)
+    {
+        if (sat->selected())
+            selected.append(sat);
+    }
 
-    while (sats.hasNext())
+    QVector<int> codes(selected.size());
+    int *code = codes.data();
+
+    QVector<int> tasks;
+    for (int begin = 0; begin < selected.size(); begin += SATELLITES_PER_TASK)
+        tasks.append(begin);
+
+    QtConcurrent::blockingMap(tasks, [&](const int &begin)
     {
-        Satellite *sat = sats.next();
+        const int end = qMin(begin + SATELLITES_PER_TASK, selected.size());
+        for (int i = begin; i < end; ++i)
+            code[i] = selected.at(i)->updatePos(context);
+    });
 
-        if (sat->selected())
-        {
-            int rc = sat->updatePos();
-            // If position cannot be calculated, remove it from list
-            if (rc != 0)
-                sats.remove();
-        }
+    // If position cannot be calculated, remove it from list
+    for (int i = 0; i < selected.size(); ++i)
+    {
+        if (codes.at(i) != 0)
+            removeOne(selected.at(i));
     }
 }
 
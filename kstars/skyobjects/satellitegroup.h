@@ -17,11 +17,11 @@
 
 #pragma once
 
+#include "satellite.h"
+
 #include <QString>
 #include <QUrl>
 
-class Satellite;
-
 /**
  * @class SatelliteGroup
  * Represents a group of artificial satellites.
@@ -47,9 +47,10 @@ class SatelliteGroup : public QList<Satellite *>
     void readTLE();
 
     /**
-     * Compute current position of the each satellites in the group.
+     * Compute current position of the each satellites in the group, in parallel.
+     * @param context terms shared by all satellites, see Satellite::context()
      */
-    void updateSatellitesPos();
+    void updateSatellitesPos(const Satellite::Context &context);
 
     /**
      * @return TLE filename
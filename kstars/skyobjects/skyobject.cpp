@@ -133,7 +133,8 @@ QTime SkyObject::riseSetTime(const KStarsDateTime &dt, const GeoLocation *geo, b
     // compute the _closest_ rise time and the _closest_ set time to
     // the current time.
 
-    QTime rstUt = riseSetTimeUT(dt2, geo, rst, exact);
+    // The position of a fixed object computed above is used for the whole day
+    QTime rstUt = isSolarSystem() ? riseSetTimeUT(dt2, geo, rst, exact) : fixedRiseSetTimeUT(dt2, geo, p, rst);
     if (!rstUt.isValid())
         return QTime();
 
@@ -142,8 +143,14 @@ QTime SkyObject::riseSetTime(const KStarsDateTime &dt, const GeoLocation *geo, b
 
 QTime SkyObject::riseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo, bool riseT, bool exact) const
 {
+    // Objects fixed on the sky do not move during the day, their position at dt is enough
+    if (!isSolarSystem())
+        return fixedRiseSetTimeUT(dt, geo, recomputeCoords(dt, geo), riseT);
+
+    const dms h0 = elevationCorrection();
+
     // First trial to calculate UT
-    QTime UT = auxRiseSetTimeUT(dt, geo, &ra(), &dec(), riseT);
+    QTime UT = auxRiseSetTimeUT(dt, geo, &ra(), &dec(), h0, riseT);
 
     // We iterate once more using the calculated UT to compute again
     // the ra and dec for that time and hence the rise/set time.
@@ -168,7 +175,7 @@ QTime SkyObject::riseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo,
     }
 
     SkyPoint sp = recomputeCoords(dt0, geo);
-    UT          = auxRiseSetTimeUT(dt0, geo, &sp.ra(), &sp.dec(), riseT);
+    UT          = auxRiseSetTimeUT(dt0, geo, &sp.ra(), &sp.dec(), h0, riseT);
 
     if (exact)
     {
@@ -176,22 +183,42 @@ QTime SkyObject::riseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo,
         // aprox. 1.5 arcmin the coordinates).
         dt0.setTime(UT);
         sp = recomputeCoords(dt0, geo);
-        UT = auxRiseSetTimeUT(dt0, geo, &sp.ra(), &sp.dec(), riseT);
+        UT = auxRiseSetTimeUT(dt0, geo, &sp.ra(), &sp.dec(), h0, riseT);
     }
 
     return UT;
 }
 
+QTime SkyObject::fixedRiseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo, const SkyPoint &p,
+                                    bool riseT) const
+{
+    const dms h0 = elevationCorrection();
+    QTime UT     = auxRiseSetTimeUT(dt, geo, &p.ra(), &p.dec(), h0, riseT);
+
+    // Same choice of the day as riseSetTimeUT()
+    KStarsDateTime dt0 = dt;
+    dt0.setTime(UT);
+    if (riseT && dt0 > dt)
+    {
+        dt0 = dt0.addDays(-1);
+    }
+    else if (!riseT && dt0 < dt)
+    {
+        dt0 = dt0.addDays(1);
+    }
+
+    return auxRiseSetTimeUT(dt0, geo, &p.ra(), &p.dec(), h0, riseT);
+}
+
 QTime SkyObject::auxRiseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo, const dms *righta, const dms *decl,
-                                  bool riseT) const
+                                  const dms &h0, bool riseT) const
 {
-    dms LST = auxRiseSetTimeLST(geo->lat(), righta, decl, riseT);
+    dms LST = auxRiseSetTimeLST(geo->lat(), righta, decl, h0, riseT);
     return dt.GSTtoUT(geo->LSTtoGST(LST));
 }
 
-dms SkyObject::auxRiseSetTimeLST(const dms *gLat, const dms *righta, const dms *decl, bool riseT) const
+dms SkyObject::auxRiseSetTimeLST(const dms *gLat, const dms *righta, const dms *decl, const dms &h0, bool riseT) const
 {
-    dms h0   = elevationCorrection();
     double H = approxHourAngle(&h0, gLat, decl);
     dms LST;
 
@@ -215,7 +242,7 @@ dms SkyObject::riseSetTimeAz(const KStarsDateTime &dt, const GeoLocation *geo, b
     dt0.setTime(UT);
     SkyPoint sp = recomputeCoords(dt0, geo);
 
-    dms LST       = auxRiseSetTimeLST(geo->lat(), &sp.ra0(), &sp.dec0(), riseT);
+    dms LST       = auxRiseSetTimeLST(geo->lat(), &sp.ra0(), &sp.dec0(), elevationCorrection(), riseT);
     dms HourAngle = dms(LST.Degrees() - sp.ra0().Degrees());
 
     geo->lat()->SinCos(sinlat, coslat);
@@ -238,6 +265,14 @@ QTime SkyObject::transitTimeUT(const KStarsDateTime &dt, const GeoLocation *geo)
 {
     dms LST = geo->GSTtoLST(dt.gst());
 
+    // Objects fixed on the sky only need their position at dt
+    if (!isSolarSystem())
+    {
+        SkyPoint sp   = recomputeCoords(dt, geo);
+        dms HourAngle = dms(LST.Degrees() - sp.ra().Degrees());
+        return dt.addSecs(int(-3600. * HourAngle.Hours())).time();
+    }
+
     //dSec is the number of seconds until the object transits.
     dms HourAngle = dms(LST.Degrees() - ra().Degrees());
     int dSec      = int(-3600. * HourAngle.Hours());
@@ -262,8 +297,10 @@ QTime SkyObject::transitTime(const KStarsDateTime &dt, const GeoLocation *geo) c
 
 dms SkyObject::transitAltitude(const KStarsDateTime &dt, const GeoLocation *geo) const
 {
+    // The declination of objects fixed on the sky does not change during the day
     KStarsDateTime dt0 = dt;
-    dt0.setTime(transitTimeUT(dt, geo));
+    if (isSolarSystem())
+        dt0.setTime(transitTimeUT(dt, geo));
     SkyPoint sp = recomputeCoords(dt0, geo);
 
     double delta = 90 - geo->lat()->Degrees() + sp.dec().Degrees();
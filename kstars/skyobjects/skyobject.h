@@ -369,6 +369,22 @@ class SkyObject : public SkyPoint
      */
     virtual UID getUID() const;
 
+    /**
+     * Correct for the geometric altitude of the center of the body at the
+     * time of rising or setting. This is due to refraction at the horizon
+     * and to the size of the body. The moon correction has also to take into
+     * account parallax. The value we use here is a rough approximation
+     * suggested by J. Meeus.
+     *
+     * Weather status (temperature and pressure basically) is not taken
+     * into account although change of conditions between summer and
+     * winter could shift the times of sunrise and sunset by 20 seconds.
+     *
+     * This function is used by the rise and set times and by RiseSetSolver.
+     * @return dms object with the correction.
+     */
+    dms elevationCorrection(void) const;
+
   private:
     /**
      * Compute the UT time when the object will rise or set. It is an auxiliary
@@ -379,12 +395,24 @@ class SkyObject : public SkyPoint
      * @param geo    pointer to Geographic location
      * @param righta pointer to Right ascention of the object
      * @param decl   pointer to Declination of the object
+     * @param h0     altitude of the rise or the set, see elevationCorrection()
      * @param rst    Boolean. If true will compute rise time. If false
      * will compute set time.
      * @return the time at which the given position will rise or set.
      */
     QTime auxRiseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo, const dms *righta, const dms *decl,
-                           bool riseT) const;
+                           const dms &h0, bool riseT) const;
+
+    /**
+     * Compute the UT time when an object fixed on the sky will rise or set, from its
+     * position p on the day of dt.  It replaces the iterations of riseSetTimeUT(),
+     * which only matter for the solar system objects.
+     * @param dt  target date/time
+     * @param geo pointer to Geographic location
+     * @param p   position of the object at dt
+     * @param riseT If true will compute rise time. If false will compute set time.
+     */
+    QTime fixedRiseSetTimeUT(const KStarsDateTime &dt, const GeoLocation *geo, const SkyPoint &p, bool riseT) const;
 
     /**
      * Compute the LST time when the object will rise or set. It is an auxiliary
@@ -394,10 +422,11 @@ class SkyObject : public SkyPoint
      * @param gLt Geographic latitude
      * @param rga Right ascention of the object
      * @param decl Declination of the object
+     * @param h0 altitude of the rise or the set, see elevationCorrection()
      * @param rst Boolean. If true will compute rise time. If false
      * will compute set time.
      */
-    dms auxRiseSetTimeLST(const dms *gLt, const dms *rga, const dms *decl, bool rst) const;
+    dms auxRiseSetTimeLST(const dms *gLt, const dms *rga, const dms *decl, const dms &h0, bool rst) const;
 
     /**
      * Compute the approximate hour angle that an object with declination d will have
@@ -410,22 +439,6 @@ class SkyObject : public SkyPoint
      */
     double approxHourAngle(const dms *h, const dms *gLat, const dms *d) const;
 
-    /**
-     * Correct for the geometric altitude of the center of the body at the
-     * time of rising or setting. This is due to refraction at the horizon
-     * and to the size of the body. The moon correction has also to take into
-     * account parallax. The value we use here is a rough approximation
-     * suggested by J. Meeus.
-     *
-     * Weather status (temperature and pressure basically) is not taken
-     * into account although change of conditions between summer and
-     * winter could shift the times of sunrise and sunset by 20 seconds.
-     *
-     * This function is only used by auxRiseSetTimeLST().
-     * @return dms object with the correction.
-     */
-    dms elevationCorrection(void) const;
-
     /**
      * @short Return a pointer to the AuxInfo object associated with this SkyObject.
      * @note  This method creates the AuxInfo object if it is non-existent
@@ -332,6 +332,16 @@ bool SkyPoint::checkBendLight()
     // 0.06".  Assuming min. sun-earth distance is 200 solar radii.
     static const dms maxAngle(1.75 * (30.0 / 200.0) / dms::DegToRad);
 
+    if (!findSun())
+        return false;
+
+    // TODO: This can be optimized further. We only need a ballpark estimate of the distance to the sun to start with.
+    return (fabs(angularDistanceTo(static_cast<const SkyPoint *>(m_Sun)).Degrees()) <=
+            maxAngle.Degrees()); // NOTE: dynamic_cast is slow and not important here.
+}
+
+bool SkyPoint::findSun()
+{
     if (!m_Sun)
     {
         SkyComposite *skycomopsite = KStarsData::Instance()->skyComposite();
@@ -340,14 +350,9 @@ bool SkyPoint::checkBendLight()
             return false;
 
         m_Sun = (KSSun *)skycomopsite->findByName("Sun");
-
-        if (m_Sun == nullptr)
-            return false;
     }
 
-    // TODO: This can be optimized further. We only need a ballpark estimate of the distance to the sun to start with.
-    return (fabs(angularDistanceTo(static_cast<const SkyPoint *>(m_Sun)).Degrees()) <=
-            maxAngle.Degrees()); // NOTE: dynamic_cast is slow and not important here.
+    return m_Sun != nullptr;
 }
 
 bool SkyPoint::bendlight()
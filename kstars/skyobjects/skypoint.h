@@ -287,6 +287,14 @@ class SkyPoint
          */
     bool checkBendLight();
 
+    /**
+         *@short Look up the Sun used by checkBendLight()
+         * checkBendLight() does it on first use. Call this before updating points
+         * from several threads, so that they only read it.
+         *@return false if the Sun is not available yet
+         */
+    static bool findSun();
+
     /** Correct for the effect of "bending" of light around the sun for
          * positions near the sun.
          *
@@ -44,6 +44,12 @@
 
 #include "kstars_debug.h"
 
+namespace
+{
+/// Number of points of a curve, one every 15 minutes over 24 hours
+const int CURVE_POINTS = 97;
+}
+
 AltVsTimeUI::AltVsTimeUI(QWidget *p) : QFrame(p)
 {
     setupUi(this);
@@ -367,108 +373,140 @@ void AltVsTime::slotBrowseObject()
 
 void AltVsTime::processObject(SkyObject *o, bool forceAdd)
 {
-    if (!o)
-        return;
-
-    KSNumbers *num    = new KSNumbers(getDate().djd());
-    KSNumbers *oldNum = nullptr;
+    processObjects(QList<SkyObject *>() << o, forceAdd);
+}
 
-    //If the object is in the solar system, recompute its position for the given epochLabel
+void AltVsTime::processObjects(const QList<SkyObject *> &objects, bool forceAdd)
+{
+    KSNumbers *num   = new KSNumbers(getDate().djd());
     KStarsData *data = KStarsData::Instance();
-    if (o->isSolarSystem())
-    {
-        oldNum = new KSNumbers(data->ut().djd());
-        o->updateCoords(num, true, geo->lat(), data->lst(), true);
-    }
+    QList<SkyObject *> added;
 
-    //precess coords to target epoch
-    o->updateCoordsNow(num);
+    foreach (SkyObject *o, objects)
+    {
+        if (!o)
+            continue;
 
-    // vector used for computing the points needed for drawing the graph
-    QVector<double> y(100), t(100);
+        KSNumbers *oldNum = nullptr;
 
-    //If this point is not in list already, add it to list
-    bool found(false);
-    foreach (SkyObject *p, pList)
-    {
-        if (o->ra().Degrees() == p->ra().Degrees() && o->dec().Degrees() == p->dec().Degrees())
+        //If the object is in the solar system, recompute its position for the given epochLabel
+        if (o->isSolarSystem())
         {
-            found = true;
-            break;
+            oldNum = new KSNumbers(data->ut().djd());
+            o->updateCoords(num, true, geo->lat(), data->lst(), true);
         }
-    }
-    if (found && !forceAdd)
-    {
-        qCWarning(KSTARS) << "This point is already displayed; It will not be duplicated.";
-    }
-    else
-    {
-        pList.append(o);
 
-        // make sure existing curves are thin and red:
+        //precess coords to target epoch
+        o->updateCoordsNow(num);
 
-        for (int i = 0; i < avtUI->View->graphCount(); i++)
+        //If this point is not in list already, add it to list
+        bool found(false);
+        foreach (SkyObject *p, pList)
         {
-            if (avtUI->View->graph(i)->pen().color() == Qt::white)
+            if (o->ra().Degrees() == p->ra().Degrees() && o->dec().Degrees() == p->dec().Degrees())
             {
-                avtUI->View->graph(i)->setPen(QPen(Qt::red, 2));
+                found = true;
+                break;
             }
         }
+        if (found && !forceAdd)
+        {
+            qCWarning(KSTARS) << "This point is already displayed; It will not be duplicated.";
+        }
+        else
+        {
+            pList.append(o);
+            added.append(o);
+
+            avtUI->raBox->showInHours(o->ra());
+            avtUI->decBox->showInDegrees(o->dec());
+            avtUI->nameBox->setText(getObjectName(o));
+        }
+
+        //restore original position
+        if (o->isSolarSystem())
+        {
+            o->updateCoords(oldNum, true, data->geo()->lat(), data->lst(), true);
+            delete oldNum;
+        }
+        o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
+    delete num;
+
+    if (added.isEmpty())
+        return;
+
+    // make sure existing curves are thin and red:
+    for (int i = 0; i < avtUI->View->graphCount(); i++)
+    {
+        if (avtUI->View->graph(i)->pen().color() == Qt::white)
+        {
+            avtUI->View->graph(i)->setPen(QPen(Qt::red, 2));
+        }
+    }
 
+    // compute the new graphs together, time range: 24h
+    const QVector<QVector<double>> altitudes = altitudeCurves().curves(added);
+    const QVector<double> times              = curveTimes();
+
+    for (int k = 0; k < added.size(); ++k)
+    {
         // SET up the curve's name
-        avtUI->View->addGraph()->setName(o->name());
+        QCPGraph *graph = avtUI->View->addGraph();
+        graph->setName(added.at(k)->name());
+        graph->setData(times, altitudes.at(k));
 
-        // compute the current graph:
-        // time range: 24h
+        // only the last added curve is highlighted
+        graph->setPen(k == added.size() - 1 ? QPen(Qt::white, 3) : QPen(Qt::red, 2));
 
-        int offset = 3;
-        for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
+        for (double altitude : altitudes.at(k))
         {
-            y[i] = findAltitude(o, h);
-            if (y[i] > maxAlt)
-                maxAlt = y[i];
-            if (y[i] < minAlt)
-                minAlt = y[i];
-            t[i] = i * 900 + 43200;
-            avtUI->View->graph(avtUI->View->graphCount() - 1)->addData(t[i], y[i]);
+            if (altitude > maxAlt)
+                maxAlt = altitude;
+            if (altitude < minAlt)
+                minAlt = altitude;
         }
-        avtUI->View->graph(avtUI->View->graphCount() - 1)->setPen(QPen(Qt::white, 3));
 
-        // Go into initial state: without Zoom/Pan
-        avtUI->View->xAxis->setRange(43200, 129600);
-        avtUI->View->xAxis2->setRange(61200, 147600);
-        if (abs(minAlt) > maxAlt)
-            maxAlt = abs(minAlt);
-        else
-            minAlt = -maxAlt;
+        avtUI->PlotList->addItem(getObjectName(added.at(k)));
+    }
 
-        avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
+    // Go into initial state: without Zoom/Pan
+    int offset = 3;
+    avtUI->View->xAxis->setRange(43200, 129600);
+    avtUI->View->xAxis2->setRange(61200, 147600);
+    if (abs(minAlt) > maxAlt)
+        maxAlt = abs(minAlt);
+    else
+        minAlt = -maxAlt;
 
-        // Update background coordonates:
-        background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-        background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+    avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
 
-        avtUI->View->replot();
+    // Update background coordonates:
+    background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
+    background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
 
-        avtUI->PlotList->addItem(getObjectName(o));
-        avtUI->PlotList->setCurrentRow(avtUI->PlotList->count() - 1);
-        avtUI->raBox->showInHours(o->ra());
-        avtUI->decBox->showInDegrees(o->dec());
-        avtUI->nameBox->setText(getObjectName(o));
+    avtUI->View->replot();
 
-        //Set epochName to epoch shown in date tab
-        avtUI->epochName->setText(QString().setNum(getDate().epoch()));
-    }
+    avtUI->PlotList->setCurrentRow(avtUI->PlotList->count() - 1);
+
+    //Set epochName to epoch shown in date tab
+    avtUI->epochName->setText(QString().setNum(getDate().epoch()));
     //qCDebug() << "Currently, there are " << avtUI->View->graphCount() << " objects displayed.";
+}
 
-    //restore original position
-    if (o->isSolarSystem())
-    {
-        o->updateCoords(oldNum, true, data->geo()->lat(), data->lst(), true);
-        delete oldNum;
-    }
-    o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-    delete num;
+AltitudeCurves AltVsTime::altitudeCurves()
+{
+    //getDate converts the user-entered local time to UT, the curves span 24h around it
+    KStarsDateTime start = getDate().addSecs((24.0 * DayOffset - 12.0) * 3600.0);
+    return AltitudeCurves(geo, start, 0.25, CURVE_POINTS);
+}
+
+QVector<double> AltVsTime::curveTimes()
+{
+    QVector<double> times(CURVE_POINTS);
+    for (int i = 0; i < CURVE_POINTS; ++i)
+        times[i] = i * 900 + 43200;
+    return times;
 }
 
 double AltVsTime::findAltitude(SkyPoint *p, double hour)
@@ -994,8 +1032,6 @@ void AltVsTime::slotUpdateDateLoc()
     KStarsData *data     = KStarsData::Instance();
     KStarsDateTime today = getDate();
     KSNumbers *num       = new KSNumbers(today.djd());
-    KSNumbers *oldNum    = nullptr;
-    CachingDms LST       = geo->GSTtoLST(today.gst());
 
     //First determine time of sunset and sunrise
     computeSunRiseSetTimes();
@@ -1005,112 +1041,52 @@ void AltVsTime::slotUpdateDateLoc()
     for (int i = 0; i < pList.count(); ++i)
     {
         SkyObject *o = pList.at(i);
-        if (o)
-        {
-            //If the object is in the solar system, recompute its position for the given date
-            if (o->isSolarSystem())
-            {
-                oldNum = new KSNumbers(data->ut().djd());
-                o->updateCoords(num, true, geo->lat(), &LST, true);
-            }
 
-            //precess coords to target epoch
+        //precess coords to target epoch, the solar system objects are moved along the curves
+        if (!o->isSolarSystem())
             o->updateCoordsNow(num);
+    }
 
-            //update pList entry
-            pList.replace(i, o);
-
-            // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
-            // compute the new graph values:
-            // time range: 24h
-            int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
-            {
-                point_altitudeValue = findAltitude(o, h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
-            }
-
-            // Replace graph data set:
-            avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
-
-            // Go into initial state: without Zoom/Pan
-            avtUI->View->xAxis->setRange(43200, 129600);
-            avtUI->View->xAxis2->setRange(61200, 147600);
-
-            // Center the altitude axis in 0 value:
-            if (abs(minAlt) > maxAlt)
-                maxAlt = abs(minAlt);
-            else
-                minAlt = -maxAlt;
-            avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
-
-            // Update background coordonates:
-            background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-            background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+    // compute the new graph values together, time range: 24h
+    const QVector<QVector<double>> altitudes = altitudeCurves().curves(pList);
+    const QVector<double> times              = curveTimes();
 
-            // Redraw the plot:
-            avtUI->View->replot();
+    for (int i = 0; i < pList.count(); ++i)
+    {
+        // Replace graph data set:
+        avtUI->View->graph(i)->setData(times, altitudes.at(i));
 
-            //restore original position
-            if (o->isSolarSystem())
-            {
-                o->updateCoords(oldNum, true, data->geo()->lat(), data->lst());
-                delete oldNum;
-                oldNum = nullptr;
-            }
-            o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-        }
-        else //assume unfound object is a custom object
+        for (double altitude : altitudes.at(i))
         {
-            pList.at(i)->updateCoordsNow(num); //precess to desired epoch
-
-            // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
-            // compute the new graph values:
-            // time range: 24h
-            int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
-            {
-                point_altitudeValue = findAltitude(pList.at(i), h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
-            }
+            if (altitude > maxAlt)
+                maxAlt = altitude;
+            if (altitude < minAlt)
+                minAlt = altitude;
+        }
 
-            // Replace graph data set:
-            avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
+        pList.at(i)->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
 
-            // Go into initial state: without Zoom/Pan
-            avtUI->View->xAxis->setRange(43200, 129600);
-            avtUI->View->xAxis2->setRange(61200, 147600);
+    if (!pList.isEmpty())
+    {
+        // Go into initial state: without Zoom/Pan
+        int offset = 3;
+        avtUI->View->xAxis->setRange(43200, 129600);
+        avtUI->View->xAxis2->setRange(61200, 147600);
 
-            // Center the altitude axis in 0 value:
-            if (abs(minAlt) > maxAlt)
-                maxAlt = abs(minAlt);
-            else
-                minAlt = -maxAlt;
-            avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
+        // Center the altitude axis in 0 value:
+        if (abs(minAlt) > maxAlt)
+            maxAlt = abs(minAlt);
+        else
+            minAlt = -maxAlt;
+        avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
 
-            // Update background coordonates:
-            background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-            background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+        // Update background coordonates:
+        background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
+        background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
 
-            // Redraw the plot:
-            avtUI->View->replot();
-        }
+        // Redraw the plot:
+        avtUI->View->replot();
     }
 
     if (getDate().time().hour() > 12)
@@ -20,6 +20,7 @@
 #include <QList>
 #include <QDialog>
 
+#include "altitudecurves.h"
 #include "ui_altvstime.h"
 
 class QCPAbstractPlottable;
@@ -105,6 +106,15 @@ class AltVsTime : public QDialog
      */
     void processObject(SkyObject *o, bool forceAdd = false);
 
+    /**
+     * @short Add several SkyObjects to the display at once.
+     * The curves are computed together and the plot redrawn once.
+     * @param objects the SkyObjects to be added
+     * @param forceAdd if true, then the objects will be added, even if there
+     * are already curves for the same coordinates.
+     */
+    void processObjects(const QList<SkyObject *> &objects, bool forceAdd = false);
+
     /**
      * @short Determine the altitude coordinate of a SkyPoint,
      * given an hour of the day.
@@ -193,6 +203,12 @@ class AltVsTime : public QDialog
     void slotPrint();
 
   private:
+    /** @return the grid of the displayed day, every 15 minutes from noon to noon */
+    AltitudeCurves altitudeCurves();
+
+    /** @return the plot times of the points of the curves, in seconds */
+    QVector<double> curveTimes();
+
     /** @short find start of dawn, end of dusk, maximum and minimum elevation of the sun */
     void setDawnDusk();
 
@@ -30,6 +30,7 @@
 #include "modcalcvizequinox.h"
 #include "modcalcvlsr.h"
 #include "conjunctions.h"
+#include "satellitepasses.h"
 
 #include <QDialogButtonBox>
 #include <QSplitter>
@@ -173,6 +174,7 @@ AstroCalc::AstroCalc(QWidget *parent) : QDialog(parent)
     //solarItem->setIcon(0,solarIcon);
     addTreeItem<modCalcPlanets>(solarItem, i18n("Planets Coordinates"));
     addTreeItem<ConjunctionsTool>(solarItem, i18n("Conjunctions"));
+    addTreeItem<SatellitePassesTool>(solarItem, i18n("Satellite Passes"));
 
     acStack->setCurrentWidget(splashScreen);
     connect(navigationPanel, SIGNAL(itemClicked(QTreeWidgetItem*,int)), this,
@@ -18,7 +18,7 @@
 #include "calendarwidget.h"
 
 #include "ksalmanac.h"
-#include "kssun.h"
+#include "ksplanetbase.h"
 #include "kstarsdata.h"
 #include "skycalendar.h"
 
@@ -28,6 +28,8 @@
 #include <QPainter>
 #include <QDebug>
 
+#include <cmath>
+
 #define BIGTICKSIZE   10
 #define SMALLTICKSIZE 4
 
@@ -71,9 +73,8 @@ void CalendarWidget::paintEvent(QPaintEvent *e)
 
 void CalendarWidget::setHorizon()
 {
-    KSSun thesun;
     SkyCalendar *skycal = (SkyCalendar *)topLevelWidget();
-    KStarsDateTime kdt(QDate(skycal->year(), 1, 1), QTime(12, 0, 0));
+    const SkyCalendarEvents::Events &sun = skycal->events().events(KSPlanetBase::SUN);
 
     maxRTime = 0.0;
     minSTime = 0.0;
@@ -86,54 +87,24 @@ void CalendarWidget::setHorizon()
     float rTime, sTime;
 
     // Get rise and set time every 7 days for 1 year
-    while (skycal->year() == kdt.date().year())
+    for (QDate date(skycal->year(), 1, 1); date.year() == skycal->year();
+         date = date.addDays(skycal->scUI->spinBox_Interval->value()))
     {
-        QTime tmp_rTime = thesun.riseSetTime(KStarsDateTime(kdt.djd() + 1.0), skycal->get_geo(), true, true);
-        QTime tmp_sTime = thesun.riseSetTime(KStarsDateTime(kdt.djd()), skycal->get_geo(), false, true);
-
-        /* riseSetTime seems buggy since it sometimes returns the same time for rise and set (01:00:00).
-         * In this case, we just reset tmp_rTime and tmp_sTime so they will be considered invalid
-         * in the following lines.
-         * NOTE: riseSetTime should be fix now, this test is no longer necessary*/
-        if (tmp_rTime == tmp_sTime)
-        {
-            tmp_rTime = QTime();
-            tmp_sTime = QTime();
-        }
+        // The tables hold the sunset starting each night and the sunrise ending it
+        rTime = sun.rise.at(date.dayOfYear() - 1);
+        sTime = sun.set.at(date.dayOfYear() - 1);
 
-        // If rise and set times are valid, the sun rise and set...
-        if (tmp_rTime.isValid() && tmp_sTime.isValid())
+        /* If the sun does not rise and/or does not set, the tables tell whether it stays
+         * above the horizon, then there is no night, or below it, then there is no day. */
+        if (rTime == -24.0)
         {
-            // Compute X-coordinate value for rise and set time
-            QTime midday(12, 0, 0);
-            rTime = tmp_rTime.secsTo(midday) * 24.0 / 86400.0;
-            sTime = tmp_sTime.secsTo(midday) * 24.0 / 86400.0;
-
-            if (tmp_rTime <= midday)
-                rTime = 12.0 - rTime;
-            else
-                rTime = -12.0 - rTime;
-
-            if (tmp_sTime <= midday)
-                sTime = 12.0 - sTime;
-            else
-                sTime = -12.0 - sTime;
+            rTime = -4.0;
+            sTime = 4.0;
         }
-        /* else, the sun don't rise and/or don't set.
-         * we look at the altitude of the sun at transit time, if it is above the horizon,
-         * there is no night, else there is no day. */
-        else
+        else if (std::isnan(rTime) || std::isnan(sTime) || rTime == 24.0)
         {
-            if (thesun.transitAltitude(KStarsDateTime(kdt.djd()), skycal->get_geo()).degree() > 0)
-            {
-                rTime = -4.0;
-                sTime = 4.0;
-            }
-            else
-            {
-                rTime = 12.0;
-                sTime = -12.0;
-            }
+            rTime = 12.0;
+            sTime = -12.0;
         }
 
         // Get max rise time and min set time
@@ -143,12 +114,9 @@ void CalendarWidget::setHorizon()
             minSTime = sTime;
 
         // Keep the day, rise time and set time in lists
-        dateList.append(kdt.date());
+        dateList.append(date);
         riseTimeList.append(rTime);
         setTimeList.append(sTime);
-
-        // Next week
-        kdt = kdt.addDays(skycal->scUI->spinBox_Interval->value());
     }
 
     // Set widget limits
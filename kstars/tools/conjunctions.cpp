@@ -24,8 +24,8 @@
 
 #include "conjunctions.h"
 
+#include "conjunctionsearch.h"
 #include "geolocation.h"
-#include "ksconjunct.h"
 #include "kstars.h"
 #include "kstarsdata.h"
 #include "skymap.h"
@@ -36,9 +36,7 @@
 #include "skyobjects/kspluto.h"
 
 #include <QFileDialog>
-#include <QProgressDialog>
 #include <QStandardItemModel>
-#include <QtConcurrent>
 
 ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
 {
@@ -112,11 +110,8 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     // signals and slots connections
     connect(LocationButton, SIGNAL(clicked()), this, SLOT(slotLocation()));
     connect(Obj1FindButton, SIGNAL(clicked()), this, SLOT(slotFindObject()));
-    //connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
-    connect(ComputeButton, &QPushButton::clicked, [this]()
-    {
-       QtConcurrent::run(this, &ConjunctionsTool::slotCompute);
-    });
+    connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
+    connect(CancelButton, SIGNAL(clicked()), this, SLOT(slotCancel()));
     connect(FilterTypeComboBox, SIGNAL(currentIndexChanged(int)), SLOT(slotFilterType(int)));
     connect(ClearButton, SIGNAL(clicked()), this, SLOT(slotClear()));
     connect(ExportButton, SIGNAL(clicked()), this, SLOT(slotExport()));
@@ -124,6 +119,11 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     connect(ClearFilterButton, SIGNAL(clicked()), FilterEdit, SLOT(clear()));
     connect(FilterEdit, SIGNAL(textChanged(QString)), this, SLOT(slotFilterReg(QString)));
 
+    m_Search = new ConjunctionSearch(this);
+    connect(m_Search, &ConjunctionSearch::conjunctionFound, this, &ConjunctionsTool::slotConjunctionFound);
+    connect(m_Search, &ConjunctionSearch::progress, this, &ConjunctionsTool::showProgress);
+    connect(m_Search, &ConjunctionSearch::finished, this, &ConjunctionsTool::slotSearchFinished);
+
     show();
 }
 
@@ -234,7 +234,6 @@ void ConjunctionsTool::slotCompute(void)
         opposition = true;
     QStringList objects; // List of sky object used as Object1
     KStarsData *data = KStarsData::Instance();
-    int progress     = 0;
 
     // Check if we have a valid angle in maxSeparationBox
     dms maxSeparation(0.0);
@@ -263,11 +262,6 @@ void ConjunctionsTool::slotCompute(void)
         return;
     }
 
-    // Init KSConjunct object
-    KSConjunct ksc;
-    connect(&ksc, SIGNAL(madeProgress(int)), this, SLOT(showProgress(int)));
-    ksc.setGeoLocation(geoPlace);
-
     switch (FilterTypeComboBox->currentIndex())
     {
         case 1: // All object types
@@ -334,81 +328,70 @@ void ConjunctionsTool::slotCompute(void)
         objects.removeAll("Iapetus");
     }
 
+    QList<SkyObject *> candidates;
     if (FilterTypeComboBox->currentIndex() != 0)
     {
-        // Show a progress dialog while processing
-        QProgressDialog progressDlg(i18n("Compute conjunction..."), i18n("Abort"), 0, objects.count(), this);
-        progressDlg.setWindowTitle(i18n("Conjunction"));
-        progressDlg.setWindowModality(Qt::WindowModal);
-        progressDlg.setValue(0);
-
         for (auto &object : objects)
         {
-            // If the user click on the 'cancel' button
-            if (progressDlg.wasCanceled())
-                break;
-
-            // Update progress dialog
-            ++progress;
-            progressDlg.setValue(progress);
-            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), object));
-
-            // Compute conjuction
-            Object1 = data->skyComposite()->findByName(object);
-            showConjunctions(ksc.findClosestApproach(*Object1, *Object2, startJD, stopJD, maxSeparation, opposition),
-                             object, Object2->name());
+            SkyObject *o = data->skyComposite()->findByName(object);
+            if (o != nullptr && o->name() != Object2->name())
+                candidates.append(o);
         }
-
-        progressDlg.setValue(objects.count());
     }
     else
     {
-        // Change cursor while we search for conjunction
-        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+        candidates.append(Object1);
+    }
 
-        ComputeStack->setCurrentIndex(1);
-        showConjunctions(ksc.findClosestApproach(*Object1, *Object2, startJD, stopJD, maxSeparation, opposition),
-                         Object1->name(), Object2->name());
-        ComputeStack->setCurrentIndex(0);
+    // The positions of the major bodies are computed before the search goes to the background
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    m_Search->start(candidates, *Object2, geoPlace, startJD, stopJD, maxSeparation, opposition);
+    QApplication::restoreOverrideCursor();
 
-        // Restore cursor
-        QApplication::restoreOverrideCursor();
-    }
+    progress->setValue(0);
+    ComputeStack->setCurrentIndex(1);
 
     Object2.reset();
 }
 
+void ConjunctionsTool::slotCancel()
+{
+    m_Search->cancel();
+    ComputeStack->setCurrentIndex(0);
+}
+
+void ConjunctionsTool::slotSearchFinished()
+{
+    ComputeStack->setCurrentIndex(0);
+}
+
 void ConjunctionsTool::showProgress(int n)
 {
     progress->setValue(n);
 }
 
-void ConjunctionsTool::showConjunctions(const QMap<long double, dms> &conjunctionlist, const QString &object1,
-                                        const QString &object2)
+void ConjunctionsTool::slotConjunctionFound(const QString &object1, const QString &object2, long double jd,
+                                            const dms &separation)
 {
     KStarsDateTime dt;
     QList<QStandardItem *> itemList;
 
-    for (auto it = conjunctionlist.constBegin(); it != conjunctionlist.constEnd(); ++it)
-    {
-        dt.setDJD(it.key());
-        QStandardItem *typeItem;
-
-        if (!Opposition->currentIndex())
-            typeItem = new QStandardItem(i18n("Conjunction"));
-        else
-            typeItem = new QStandardItem(i18n("Opposition"));
-
-        itemList << typeItem
-                 //FIXME TODO is this ISO date? is there a ready format to use?
-                 //<< new QStandardItem( QLocale().toString( dt.dateTime(), "YYYY-MM-DDTHH:mm:SS" ) )
-                 //<< new QStandardItem( QLocale().toString( dt, Qt::ISODate) )
-                 << new QStandardItem(dt.toString(Qt::ISODate)) << new QStandardItem(object1)
-                 << new QStandardItem(object2) << new QStandardItem(it.value().toDMSString());
-        m_Model->appendRow(itemList);
-        itemList.clear();
-
-        outputJDList.insert(m_index, it.key());
-        ++m_index;
-    }
+    dt.setDJD(jd);
+    QStandardItem *typeItem;
+
+    if (!Opposition->currentIndex())
+        typeItem = new QStandardItem(i18n("Conjunction"));
+    else
+        typeItem = new QStandardItem(i18n("Opposition"));
+
+    itemList << typeItem
+             //FIXME TODO is this ISO date? is there a ready format to use?
+             //<< new QStandardItem( QLocale().toString( dt.dateTime(), "YYYY-MM-DDTHH:mm:SS" ) )
+             //<< new QStandardItem( QLocale().toString( dt, Qt::ISODate) )
+             << new QStandardItem(dt.toString(Qt::ISODate)) << new QStandardItem(object1)
+             << new QStandardItem(object2) << new QStandardItem(separation.toDMSString());
+    m_Model->appendRow(itemList);
+
+    outputJDList.insert(m_index, jd);
+    ++m_index;
 }
@@ -36,12 +36,13 @@
 class QSortFilterProxyModel;
 class QStandardItemModel;
 
+class ConjunctionSearch;
 class GeoLocation;
 class KSPlanetBase;
 class SkyObject;
 
 /**
-  * @short Predicts conjunctions using KSConjunct in the background
+  * @short Predicts conjunctions using ConjunctionSearch in the background
   */
 class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
 {
@@ -62,10 +63,13 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
     void slotClear();
     void slotExport();
     void slotFilterReg(const QString &);
+    void slotCancel();
+
+  private slots:
+    void slotConjunctionFound(const QString &object1, const QString &object2, long double jd, const dms &separation);
+    void slotSearchFinished();
 
   private:
-    void showConjunctions(const QMap<long double, dms> &conjunctionlist, const QString &object1,
-                          const QString &object2);
 
     SkyObject* Object1 = nullptr;
     std::unique_ptr<KSPlanetBase> Object2; // Second object is always a planet.
@@ -76,5 +80,6 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
     GeoLocation *geoPlace { nullptr };
     QStandardItemModel *m_Model { nullptr };
     QSortFilterProxyModel *m_SortModel { nullptr };
+    ConjunctionSearch *m_Search { nullptr };
     int m_index { 0 };
 };
@@ -0,0 +1,488 @@
+/*  Parallel search of conjunctions and oppositions
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "conjunctionsearch.h"
+
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "kstarsdatetime.h"
+#include "Options.h"
+#include "skyobjects/keplerorbits.h"
+#include "skyobjects/ksasteroid.h"
+#include "skyobjects/ksmoon.h"
+#include "skyobjects/ksplanet.h"
+
+#include <KLocalizedString>
+
+#include <QtConcurrent>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+/// Interval between the samples of the coarse pass, in days
+const double SAMPLE_STEP = 0.5;
+
+/// Interval between the samples when the Moon is involved, in days
+const double MOON_SAMPLE_STEP = 0.125;
+
+/// Number of samples of one object scanned by a task, to split long intervals across threads
+const int SAMPLES_PER_TASK = 4096;
+
+/// Number of objects scanned by a task
+const int OBJECTS_PER_TASK = 32;
+
+/// Number of tasks per thread between two reports of the brackets found
+const int TASKS_PER_THREAD = 4;
+
+/// Margin on the coarse separations for the frames of the bodies, simplified by the coarse pass, in degrees
+const double FRAME_MARGIN = 0.1;
+
+/// Margin on the coarse separations for the parallax of the Moon, which the coarse pass ignores, in degrees
+const double MOON_PARALLAX_MARGIN = 1.0;
+
+/// Precision of the refined times, in days
+const double REFINE_TOLERANCE = 1.0 / 1440.0;
+
+/// Ratio of the golden section search
+const double GOLDEN_RATIO = 0.6180339887498949;
+
+/// Where the coarse pass takes the positions of an object from
+enum Source
+{
+    Fixed,
+    Orbit,
+    Track
+};
+
+void toVector(const dms &ra, const dms &dec, double *v)
+{
+    double sinRA, cosRA, sinDec, cosDec;
+    ra.SinCos(sinRA, cosRA);
+    dec.SinCos(sinDec, cosDec);
+    v[0] = cosDec * cosRA;
+    v[1] = cosDec * sinRA;
+    v[2] = sinDec;
+}
+
+void normalize(double *v)
+{
+    const double norm = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    v[0] /= norm;
+    v[1] /= norm;
+    v[2] /= norm;
+}
+
+/** @short A range of samples [begin, end) of a range of objects [firstObject, lastObject) */
+struct Task
+{
+    int firstObject { 0 };
+    int lastObject { 0 };
+    int begin { 0 };
+    int end { 0 };
+    /// Minima found: object, first and last Julian Day of the bracket
+    QVector<int> objects;
+    QVector<double> brackets;
+};
+}
+
+/**
+ * The samples are filled by computeSamples() in the thread pool, the rest is set by start()
+ * and only read afterwards.
+ */
+struct ConjunctionSearch::Job
+{
+    std::shared_ptr<const GeoLocation> geo;
+    double maxSeparation { 0 };
+    double threshold { 0 };
+    bool opposition { false };
+
+    double startJD { 0 };
+    double sampleStep { 0 };
+    int samples { 0 };
+
+    /// Per sample, the J2000 to epoch precession matrix, p2 of KSNumbers, row-major
+    QVector<double> precession;
+    /// Per sample, cos and sin of the obliquity
+    QVector<double> obliquity;
+    /// Per sample, heliocentric ecliptic coordinates of the Earth
+    QVector<double> earth;
+
+    /// Per sample, unit vector towards the target
+    QVector<double> target;
+
+    /// Per object, where its positions come from and the index in fixed, orbits or tracks
+    QVector<int> source;
+    QVector<int> index;
+    /// J2000 unit vectors of the fixed objects
+    QVector<double> fixed;
+    KeplerOrbits orbits;
+    /// Per sample, unit vectors of the major bodies
+    QVector<QVector<double>> tracks;
+
+    /// Private copies of the Earth, the target and the major bodies, moved by computeSamples()
+    std::unique_ptr<KSPlanetBase> earthCopy;
+    std::unique_ptr<KSPlanetBase> targetCopy;
+    std::vector<std::unique_ptr<KSPlanetBase>> bodyCopies;
+
+    int objects() const { return source.size(); }
+
+    double time(int sample) const { return startJD + sample * sampleStep; }
+
+    /** @short The unit vector of object at sample, precessed to the epoch of the sample */
+    void vector(int object, int sample, double *v) const
+    {
+        const double *p = precession.constData() + 9 * sample;
+        double s[3];
+
+        switch (source.at(object))
+        {
+            case Track:
+            {
+                const double *t = tracks.at(index.at(object)).constData() + 3 * sample;
+                v[0]            = t[0];
+                v[1]            = t[1];
+                v[2]            = t[2];
+                return;
+            }
+            case Fixed:
+            {
+                const double *f = fixed.constData() + 3 * index.at(object);
+                s[0]            = f[0];
+                s[1]            = f[1];
+                s[2]            = f[2];
+                break;
+            }
+            case Orbit:
+            {
+                // Same reduction as KSPlanetBase::setHeliocentricPosition(), without light time
+                double x, y, z, r;
+                orbits.propagate(index.at(object), time(sample), x, y, z, r);
+                x -= earth.at(3 * sample);
+                y -= earth.at(3 * sample + 1);
+                z -= earth.at(3 * sample + 2);
+
+                const double cosEps = obliquity.at(2 * sample), sinEps = obliquity.at(2 * sample + 1);
+                s[0]                = x;
+                s[1]                = y * cosEps - z * sinEps;
+                s[2]                = y * sinEps + z * cosEps;
+                normalize(s);
+                break;
+            }
+        }
+
+        for (int i = 0; i < 3; ++i)
+            v[i] = p[i] * s[0] + p[3 + i] * s[1] + p[6 + i] * s[2];
+    }
+
+    /** @short Compute the quantities shared by all objects and the major bodies at each sample, false if cancelled */
+    bool computeSamples(const QAtomicInt &search, int id)
+    {
+        tracks.resize(int(bodyCopies.size()));
+
+        for (int j = 0; j < samples; ++j)
+        {
+            if (search.load() != id)
+                return false;
+
+            KSNumbers num(time(j));
+            earthCopy->findGeocentricCoords(&num, nullptr);
+
+            for (int i = 0; i < 3; ++i)
+                for (int k = 0; k < 3; ++k)
+                    precession.append(num.p2(i, k));
+
+            double sinEps, cosEps;
+            num.obliquity()->SinCos(sinEps, cosEps);
+            obliquity.append(cosEps);
+            obliquity.append(sinEps);
+
+            double e[3];
+            toVector(earthCopy->ecLong(), earthCopy->ecLat(), e);
+            for (int i = 0; i < 3; ++i)
+                earth.append(e[i] * earthCopy->rsun());
+
+            double v[3];
+            targetCopy->findGeocentricCoords(&num, earthCopy.get());
+            toVector(targetCopy->ra(), targetCopy->dec(), v);
+            target.append(v[0]);
+            target.append(v[1]);
+            target.append(v[2]);
+
+            for (int b = 0; b < int(bodyCopies.size()); ++b)
+            {
+                bodyCopies[b]->findGeocentricCoords(&num, earthCopy.get());
+                toVector(bodyCopies[b]->ra(), bodyCopies[b]->dec(), v);
+                tracks[b].append(v[0]);
+                tracks[b].append(v[1]);
+                tracks[b].append(v[2]);
+            }
+        }
+        return true;
+    }
+
+    /** @short Scan the samples of task for minima of the separation below the threshold */
+    void scan(Task &task, const QAtomicInt &search, int id) const
+    {
+        // The samples around the range are needed to detect minima at its ends
+        const int first = qMax(0, task.begin - 1);
+        const int last  = qMin(samples - 1, task.end);
+
+        for (int object = task.firstObject; object < task.lastObject; ++object)
+        {
+            if (search.load() != id)
+                return;
+
+            double before = 0, middle = 0;
+            for (int j = first; j <= last; ++j)
+            {
+                double v[3];
+                vector(object, j, v);
+
+                const double *t = target.constData() + 3 * j;
+                double distance = acos(qBound(-1.0, v[0] * t[0] + v[1] * t[1] + v[2] * t[2], 1.0)) / dms::DegToRad;
+                if (opposition)
+                    distance = 180.0 - distance;
+
+                // Minimum at the previous sample
+                if (j >= first + 2 && j - 1 >= task.begin && middle < before && middle <= distance &&
+                    middle < threshold)
+                {
+                    task.objects.append(object);
+                    task.brackets.append(time(j - 2));
+                    task.brackets.append(time(j));
+                }
+
+                before = middle;
+                middle = distance;
+            }
+        }
+    }
+};
+
+ConjunctionSearch::ConjunctionSearch(QObject *parent) : QObject(parent)
+{
+    m_Pool.setMaxThreadCount(1);
+}
+
+ConjunctionSearch::~ConjunctionSearch()
+{
+    cancel();
+    m_Pool.clear();
+    m_Pool.waitForDone();
+}
+
+void ConjunctionSearch::start(const QList<SkyObject *> &objects, const KSPlanetBase &target, const GeoLocation *geo,
+                              long double startJD, long double stopJD, const dms &maxSeparation, bool opposition)
+{
+    const int search = m_Search.fetchAndAddOrdered(1) + 1;
+
+    // The coarse pass and the refinement move their own copies of the bodies
+    QSharedPointer<Job> job(new Job);
+    job->geo           = std::make_shared<const GeoLocation>(*geo);
+    job->maxSeparation = maxSeparation.Degrees();
+    job->opposition    = opposition;
+    job->targetCopy.reset(dynamic_cast<KSPlanetBase *>(target.clone()));
+    job->earthCopy.reset(new KSPlanet(I18N_NOOP("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/));
+
+    m_Target.reset(dynamic_cast<KSPlanetBase *>(target.clone()));
+    m_Earth.reset(new KSPlanet(I18N_NOOP("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/));
+    m_Orbit.reset(
+        new KSAsteroid(0, QString(), QString(), J2000, 1.0, 0.0, dms(0.0), dms(0.0), dms(0.0), dms(0.0), 0, 0));
+    m_Names.clear();
+    m_Objects.clear();
+
+    bool moon = dynamic_cast<KSMoon *>(m_Target.get()) != nullptr;
+
+    // Sort the objects by how their positions are found, the orbits are refined from the elements of the job
+    for (SkyObject *object : objects)
+    {
+        KSPlanetBase *planet = dynamic_cast<KSPlanetBase *>(object);
+        KeplerOrbits::Elements elements;
+        m_Names.append(object->name());
+
+        if (planet == nullptr)
+        {
+            double v[3];
+            toVector(object->ra0(), object->dec0(), v);
+            job->source.append(Fixed);
+            job->index.append(job->fixed.size() / 3);
+            job->fixed.append(v[0]);
+            job->fixed.append(v[1]);
+            job->fixed.append(v[2]);
+            m_Objects.emplace_back(object->clone());
+        }
+        else if (planet->orbitalElements(elements))
+        {
+            job->source.append(Orbit);
+            job->index.append(job->orbits.add(elements));
+            m_Objects.emplace_back();
+        }
+        else
+        {
+            moon = moon || dynamic_cast<KSMoon *>(planet) != nullptr;
+            job->source.append(Track);
+            job->index.append(int(job->bodyCopies.size()));
+            job->bodyCopies.emplace_back(dynamic_cast<KSPlanetBase *>(planet->clone()));
+            m_Objects.emplace_back(planet->clone());
+        }
+    }
+
+    job->startJD    = startJD;
+    job->sampleStep = moon ? MOON_SAMPLE_STEP : SAMPLE_STEP;
+    job->samples    = qMax(3, int(std::ceil((stopJD - startJD) / job->sampleStep)) + 1);
+    job->threshold  = job->maxSeparation + FRAME_MARGIN + (moon ? MOON_PARALLAX_MARGIN : 0);
+
+    // The series and the Sun bending the light are looked up here, the thread pool only reads them
+    job->earthCopy->loadData();
+    job->targetCopy->loadData();
+    for (const auto &body : job->bodyCopies)
+        body->loadData();
+    if (Options::useRelativistic())
+        SkyPoint::findSun();
+
+    m_Job     = job;
+    m_Running = true;
+    QtConcurrent::run(&m_Pool, this, &ConjunctionSearch::run, search, m_Job);
+}
+
+void ConjunctionSearch::cancel()
+{
+    m_Search.fetchAndAddOrdered(1);
+    m_Running = false;
+}
+
+void ConjunctionSearch::run(int search, JobPtr job)
+{
+    if (!job->computeSamples(m_Search, search))
+        return;
+
+    QVector<Task> tasks;
+    for (int begin = 0; begin < job->samples; begin += SAMPLES_PER_TASK)
+    {
+        for (int first = 0; first < job->objects(); first += OBJECTS_PER_TASK)
+        {
+            Task task;
+            task.firstObject = first;
+            task.lastObject  = qMin(first + OBJECTS_PER_TASK, job->objects());
+            task.begin       = begin;
+            task.end         = qMin(begin + SAMPLES_PER_TASK, job->samples);
+            tasks.append(task);
+        }
+    }
+
+    const int batch = qMax(1, QThread::idealThreadCount()) * TASKS_PER_THREAD;
+    for (int first = 0; first < tasks.size(); first += batch)
+    {
+        if (cancelled(search))
+            return;
+
+        QVector<Task> current = tasks.mid(first, batch);
+        QtConcurrent::blockingMap(current, [&](Task &task) { job->scan(task, m_Search, search); });
+
+        for (const Task &task : current)
+        {
+            for (int i = 0; i < task.objects.size(); ++i)
+                QMetaObject::invokeMethod(this, "slotBracket", Qt::QueuedConnection, Q_ARG(int, search),
+                                          Q_ARG(int, task.objects.at(i)), Q_ARG(double, task.brackets.at(2 * i)),
+                                          Q_ARG(double, task.brackets.at(2 * i + 1)));
+        }
+        QMetaObject::invokeMethod(this, "slotProgress", Qt::QueuedConnection, Q_ARG(int, search),
+                                  Q_ARG(int, 100 * (first + current.size()) / tasks.size()));
+    }
+
+    QMetaObject::invokeMethod(this, "slotDone", Qt::QueuedConnection, Q_ARG(int, search));
+}
+
+void ConjunctionSearch::slotBracket(int search, int object, double begin, double end)
+{
+    if (cancelled(search))
+        return;
+
+    auto distance = [&](double jd) { return separation(jd, object); };
+
+    // Golden section search of the minimum in the bracket
+    double a = begin, b = end;
+    double c = b - GOLDEN_RATIO * (b - a), d = a + GOLDEN_RATIO * (b - a);
+    double fc = distance(c), fd = distance(d);
+    while (b - a > REFINE_TOLERANCE)
+    {
+        if (fc < fd)
+        {
+            b  = d;
+            d  = c;
+            fd = fc;
+            c  = b - GOLDEN_RATIO * (b - a);
+            fc = distance(c);
+        }
+        else
+        {
+            a  = c;
+            c  = d;
+            fc = fd;
+            d  = a + GOLDEN_RATIO * (b - a);
+            fd = distance(d);
+        }
+    }
+
+    const double jd      = 0.5 * (a + b);
+    const double closest = distance(jd);
+    if (closest < m_Job->maxSeparation)
+        emit conjunctionFound(m_Names.at(object), m_Target->name(), jd, dms(closest));
+}
+
+void ConjunctionSearch::slotProgress(int search, int percent)
+{
+    if (!cancelled(search))
+        emit progress(percent);
+}
+
+void ConjunctionSearch::slotDone(int search)
+{
+    if (cancelled(search))
+        return;
+
+    m_Running = false;
+    emit finished();
+}
+
+double ConjunctionSearch::separation(double jd, int object) const
+{
+    const GeoLocation *geo = m_Job->geo.get();
+    KStarsDateTime t(jd);
+    KSNumbers num(jd);
+
+    m_Earth->findGeocentricCoords(&num, nullptr);
+    CachingDms LST(geo->GSTtoLST(t.gst()));
+
+    SkyObject *copy = m_Objects.at(object).get();
+    if (copy == nullptr)
+    {
+        // The asteroids and comets are reduced from their propagated orbits, like in the sky map
+        double x, y, z, r;
+        m_Job->orbits.propagate(m_Job->index.at(object), jd, x, y, z, r);
+        m_Orbit->findPosition(&num, geo->lat(), &LST, m_Earth.get(), x, y, z, r);
+        copy = m_Orbit.get();
+    }
+    else if (KSPlanetBase *p = dynamic_cast<KSPlanetBase *>(copy))
+    {
+        p->findPosition(&num, geo->lat(), &LST, m_Earth.get());
+    }
+    else
+    {
+        copy->updateCoordsNow(&num);
+    }
+
+    m_Target->findPosition(&num, geo->lat(), &LST, m_Earth.get());
+
+    const double distance = copy->angularDistanceTo(m_Target.get()).Degrees();
+    return m_Job->opposition ? 180.0 - distance : distance;
+}
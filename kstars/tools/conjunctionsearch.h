@@ -0,0 +1,122 @@
+/*  Parallel search of conjunctions and oppositions
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "dms.h"
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+class GeoLocation;
+class KSPlanetBase;
+class SkyObject;
+
+/**
+ * @class ConjunctionSearch
+ * @short Finds the close approaches of many objects to a major body of the solar system
+ *
+ * The search runs in two passes.  The coarse pass samples the separation of every pair
+ * on a regular time grid and brackets its local minima.  The positions of the fixed
+ * objects and of the asteroids and comets, whose orbits are propagated with KeplerOrbits,
+ * are computed by the coarse pass itself, which is split across the time range and the
+ * objects and runs in the global thread pool.  The major bodies are read from the
+ * EphemerisCache on private copies before the coarse pass, in the thread of the search.
+ *
+ * Only the minima bracketed by the coarse pass closer than the maximum separation, with
+ * a margin for the simplified frames and the parallax, are refined.  The refinement uses the
+ * full topocentric positions, like the sky map, and runs in the thread of the search
+ * object as the brackets arrive, so the results are streamed by conjunctionFound().
+ *
+ * start() copies everything the search needs, so the objects may be deleted meanwhile.
+ */
+class ConjunctionSearch : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit ConjunctionSearch(QObject *parent = nullptr);
+    ~ConjunctionSearch() override;
+
+    /**
+     * @short Start a search, cancelling the previous one
+     * @param objects the objects to check, only read by this call
+     * @param target the major body the objects are compared to, copied
+     * @param geo the location of the observer, copied
+     * @param startJD start of the searched interval
+     * @param stopJD end of the searched interval
+     * @param maxSeparation the largest separation reported
+     * @param opposition search for oppositions instead of conjunctions
+     */
+    void start(const QList<SkyObject *> &objects, const KSPlanetBase &target, const GeoLocation *geo,
+               long double startJD, long double stopJD, const dms &maxSeparation, bool opposition = false);
+
+    /** @short Cancel the running search, no more results are reported */
+    void cancel();
+
+    /** @return true while a search is running */
+    bool isRunning() const { return m_Running; }
+
+  signals:
+    /**
+     * @short A conjunction, or opposition, was found
+     * @param object1 the name of the object
+     * @param object2 the name of the major body
+     * @param jd the Julian Day of the closest approach
+     * @param separation the separation, or its difference to 180° for oppositions
+     */
+    void conjunctionFound(const QString &object1, const QString &object2, long double jd, const dms &separation);
+
+    /** @short Percentage of the coarse pass done */
+    void progress(int percent);
+
+    /** @short The search is complete, not emitted for cancelled searches */
+    void finished();
+
+  private slots:
+    void slotBracket(int search, int object, double begin, double end);
+    void slotProgress(int search, int percent);
+    void slotDone(int search);
+
+  private:
+    struct Job;
+    typedef QSharedPointer<Job> JobPtr;
+
+    /** @short The positions at the samples, then the coarse pass, in the thread pool of the search */
+    void run(int search, JobPtr job);
+
+    /** @return the separation between an object and the target at jd, in degrees, as it is refined */
+    double separation(double jd, int object) const;
+
+    bool cancelled(int search) const { return m_Search.load() != search; }
+
+    /// Runs the coarse passes, which spread their work over the global thread pool
+    QThreadPool m_Pool;
+    QAtomicInt m_Search { 0 };
+    bool m_Running { false };
+
+    JobPtr m_Job;
+
+    /// Copies moved by the refinement, in the thread of the search object
+    std::unique_ptr<KSPlanetBase> m_Target;
+    std::unique_ptr<KSPlanetBase> m_Earth;
+    /// Per object, its name and its copy, none for the orbits of the job
+    QStringList m_Names;
+    std::vector<std::unique_ptr<SkyObject>> m_Objects;
+    /// Reduces the positions propagated from the orbits of the job, like the sky map
+    std::unique_ptr<KSPlanetBase> m_Orbit;
+};
@@ -0,0 +1,101 @@
+/*  Bulk observability filter of the observing list wizard
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "observabilityfilter.h"
+
+#include "geolocation.h"
+#include "ksutils.h"
+#include "kstarsdatetime.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+namespace
+{
+/// Number of objects processed by one thread at a time
+const int OBJECTS_PER_TASK = 4096;
+}
+
+ObservabilityFilter::ObservabilityFilter(const GeoLocation *geo, const KStarsDateTime &start,
+                                         const KStarsDateTime &end)
+{
+    geo->lat()->SinCos(m_SinLat, m_CosLat);
+    m_StartLST = geo->GSTtoLST(start.gst()).Degrees();
+    m_Span     = qMax(0.0, (end.djd() - start.djd()) * dms::SiderealRate);
+}
+
+void ObservabilityFilter::setAltitudeRange(double minAltitude, double maxAltitude)
+{
+    m_SinMinAltitude = sin(minAltitude * dms::DegToRad);
+    m_SinMaxAltitude = sin(maxAltitude * dms::DegToRad);
+}
+
+QBitArray ObservabilityFilter::apply(const QVector<SkyObject *> &objects) const
+{
+    const int count = objects.size();
+    QVector<char> observable(count);
+    char *result = observable.data();
+
+    QVector<int> tasks;
+    for (int begin = 0; begin < count; begin += OBJECTS_PER_TASK)
+        tasks.append(begin);
+
+    QtConcurrent::blockingMap(tasks, [&](const int &begin)
+    {
+        const int end = qMin(begin + OBJECTS_PER_TASK, count);
+        for (int i = begin; i < end; ++i)
+            result[i] = isObservable(objects.at(i));
+    });
+
+    QBitArray mask(count);
+    for (int i = 0; i < count; ++i)
+    {
+        if (result[i])
+            mask.setBit(i);
+    }
+    return mask;
+}
+
+bool ObservabilityFilter::isObservable(const SkyObject *object) const
+{
+    double sinDec, cosDec;
+    object->dec().SinCos(sinDec, cosDec);
+
+    // At the poles of the sky or of the Earth, the altitude does not change
+    const double denominator = m_CosLat * cosDec;
+    if (fabs(denominator) < 1e-12)
+    {
+        const double sinAlt = m_SinLat * sinDec;
+        return sinAlt >= m_SinMinAltitude && sinAlt <= m_SinMaxAltitude;
+    }
+
+    // The object is above the minimum altitude while |H| <= outer, and below the maximum while |H| >= inner
+    const double cosOuter = (m_SinMinAltitude - m_SinLat * sinDec) / denominator;
+    const double cosInner = (m_SinMaxAltitude - m_SinLat * sinDec) / denominator;
+    if (cosOuter >= 1.0 || cosInner <= -1.0)
+        return false;
+
+    const double outer = cosOuter <= -1.0 ? 180.0 : acos(cosOuter) / dms::DegToRad;
+    const double inner = cosInner >= 1.0 ? 0.0 : acos(cosInner) / dms::DegToRad;
+    if (inner > outer)
+        return false;
+    if (m_Span >= 360.0)
+        return true;
+
+    // Hour angles swept during the interval, starting in [0, 360[ and ending before 720
+    const double start = KSUtils::reduceAngle(m_StartLST - object->ra().Degrees(), 0.0, 360.0);
+    const double end   = start + m_Span;
+
+    auto meets = [&](double from, double to) { return start <= to && end >= from; };
+    return meets(inner, outer) || meets(360.0 - outer, 360.0 - inner) || meets(360.0 + inner, 360.0 + outer) ||
+           meets(720.0 - outer, 720.0 - inner);
+}
@@ -0,0 +1,60 @@
+/*  Bulk observability filter of the observing list wizard
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QBitArray>
+#include <QVector>
+
+class GeoLocation;
+class KStarsDateTime;
+class SkyObject;
+
+/**
+ * @class ObservabilityFilter
+ * @short Finds which objects rise within an altitude range during a time interval.
+ *
+ * The altitude of a fixed object only depends on its hour angle, so the hour angles at
+ * which it crosses the minimum and maximum altitudes are solved in closed form from its
+ * declination and the latitude.  The object is observable if the hour angles swept
+ * during the interval meet that range, no sampling of the interval is needed.
+ *
+ * Objects are processed in parallel and only read.  Moving objects are taken at their
+ * current position, which is good enough over a night.
+ */
+class ObservabilityFilter
+{
+  public:
+    /**
+     * @param geo the observer location
+     * @param start beginning of the interval
+     * @param end end of the interval
+     */
+    ObservabilityFilter(const GeoLocation *geo, const KStarsDateTime &start, const KStarsDateTime &end);
+
+    /** @short Set the altitude range in degrees, the whole sky above the horizon by default */
+    void setAltitudeRange(double minAltitude, double maxAltitude);
+
+    /** @return a mask with the bits of the observable objects set, in the order of objects */
+    QBitArray apply(const QVector<SkyObject *> &objects) const;
+
+    /** @return true if object reaches the altitude range during the interval */
+    bool isObservable(const SkyObject *object) const;
+
+  private:
+    double m_SinLat { 0 };
+    double m_CosLat { 1 };
+    double m_SinMinAltitude { 0 };
+    double m_SinMaxAltitude { 1 };
+    /// Local sidereal time at the beginning of the interval, in degrees
+    double m_StartLST { 0 };
+    /// Hour angle swept during the interval, in degrees
+    double m_Span { 0 };
+};
@@ -21,6 +21,7 @@
 
 #include "config-kstars.h"
 
+#include "altitudecurves.h"
 #include "constellationboundarylines.h"
 #include "fov.h"
 #include "imageviewer.h"
@@ -791,15 +792,17 @@ void ObservingList::slotAVT()
     if (selectedItems.size())
     {
         QPointer<AltVsTime> avt = new AltVsTime(KStars::Instance());
+        QList<SkyObject *> objects;
         foreach (const QModelIndex &i, selectedItems)
         {
             if (i.column() == 0)
             {
                 SkyObject *o = static_cast<SkyObject *>(i.data(Qt::UserRole + 1).value<void *>());
                 Q_ASSERT(o);
-                avt->processObject(o);
+                objects.append(o);
             }
         }
+        avt->processObjects(objects);
         avt->exec();
         delete avt;
     }
@@ -1133,26 +1136,16 @@ void ObservingList::plot(SkyObject *o)
     ui->avt->setMoonIllum(ksal->getMoonIllum());
     ui->avt->update();
     KPlotObject *po = new KPlotObject(Qt::white, KPlotObject::Lines, 2.0);
-    for (double h = -12.0; h <= 12.0; h += 0.5)
+    const AltitudeCurves curves(geo, ut.addSecs((DayOffset * 24.0 - 12.0) * 3600.0), 0.5, 49);
+    const QVector<double> altitudes = curves.curve(o);
+    for (int i = 0; i < altitudes.size(); ++i)
     {
-        po->addPoint(h, findAltitude(o, (h + DayOffset * 24.0)));
+        po->addPoint(-12.0 + 0.5 * i, altitudes.at(i));
     }
     ui->avt->removeAllPlotObjects();
     ui->avt->addPlotObject(po);
 }
 
-double ObservingList::findAltitude(SkyPoint *p, double hour)
-{
-    // Jasem 2015-09-05 Using correct procedure to find altitude
-    SkyPoint sp                   = *p; // make a copy
-    QDateTime midnight            = QDateTime(dt.date(), QTime());
-    KStarsDateTime ut             = geo->LTtoUT(KStarsDateTime(midnight));
-    KStarsDateTime targetDateTime = ut.addSecs(hour * 3600.0);
-    dms LST                       = geo->GSTtoLST(targetDateTime.gst());
-    sp.EquatorialToHorizontal(&LST, geo->lat());
-    return sp.alt().Degrees();
-}
-
 void ObservingList::slotChangeTab(int index)
 {
     noSelection = true;
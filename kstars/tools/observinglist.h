@@ -119,12 +119,6 @@ class ObservingList : public QDialog
            */
     void plot(SkyObject *o);
 
-    /** @short Return the altitude of the given SkyObject for the given hour.
-            *@p p pointer to the SkyObject
-            *@p hour time at which altitude has to be found
-            */
-    double findAltitude(SkyPoint *p, double hour = 0);
-
     /** @short Sets the image parameters for the current object
             *@p o The passed object for setting the parameters
             */
@@ -18,11 +18,14 @@
 
 #include "geolocation.h"
 #include "kstarsdata.h"
+#include "observabilityfilter.h"
 #include "dialogs/locationdialog.h"
 #include "skycomponents/constellationboundarylines.h"
 #include "skycomponents/skymapcomposite.h"
 #include "skyobjects/deepskyobject.h"
 
+#include <QSet>
+
 ObsListWizardUI::ObsListWizardUI(QWidget *p) : QFrame(p)
 {
     setupUi(this);
@@ -119,34 +122,7 @@ void ObsListWizard::initialize()
     olw->RAMin->setDegType(false);
     olw->RAMax->setDegType(false);
 
-    //Initialize object counts
-    ObjectCount   = 0;                                        //number of objects in observing list
-    StarCount     = data->skyComposite()->stars().size();     //total number of stars
-    PlanetCount   = 10;                                       //Sun, Moon, 8 planets
-    AsteroidCount = data->skyComposite()->asteroids().size(); //total number of asteroids
-    CometCount    = data->skyComposite()->comets().size();    //total number of comets
-    //DeepSkyObjects
-    OpenClusterCount = 0;
-    GlobClusterCount = 0;
-    GasNebCount      = 0;
-    PlanNebCount     = 0;
-    GalaxyCount      = 0;
-
-    foreach (DeepSkyObject *o, data->skyComposite()->deepSkyObjects())
-    {
-        if (o->type() == SkyObject::GALAXY)
-            ++GalaxyCount; //most deepsky obj are galaxies, so check them first
-        else if (o->type() == SkyObject::STAR || o->type() == SkyObject::CATALOG_STAR)
-            ++StarCount;
-        else if (o->type() == SkyObject::OPEN_CLUSTER)
-            ++OpenClusterCount;
-        else if (o->type() == SkyObject::GLOBULAR_CLUSTER)
-            ++GlobClusterCount;
-        else if (o->type() == SkyObject::GASEOUS_NEBULA || o->type() == SkyObject::SUPERNOVA_REMNANT)
-            ++GasNebCount;
-        else if (o->type() == SkyObject::PLANETARY_NEBULA)
-            ++PlanNebCount;
-    }
+    ObjectCount = 0; //number of objects in observing list
 }
 
 bool ObsListWizard::isItemSelected(const QString &name, QListWidget *listWidget, bool *ok)
@@ -393,26 +369,6 @@ void ObsListWizard::slotObjectCountDirty()
 void ObsListWizard::slotUpdateObjectCount()
 {
     QApplication::setOverrideCursor(Qt::WaitCursor);
-    ObjectCount = 0;
-    if (isItemSelected(i18n("Stars"), olw->TypeList))
-        ObjectCount += StarCount;
-    if (isItemSelected(i18n("Sun, moon, planets"), olw->TypeList))
-        ObjectCount += PlanetCount;
-    if (isItemSelected(i18n("Comets"), olw->TypeList))
-        ObjectCount += CometCount;
-    if (isItemSelected(i18n("Asteroids"), olw->TypeList))
-        ObjectCount += AsteroidCount;
-    if (isItemSelected(i18n("Galaxies"), olw->TypeList))
-        ObjectCount += GalaxyCount;
-    if (isItemSelected(i18n("Open clusters"), olw->TypeList))
-        ObjectCount += OpenClusterCount;
-    if (isItemSelected(i18n("Globular clusters"), olw->TypeList))
-        ObjectCount += GlobClusterCount;
-    if (isItemSelected(i18n("Gaseous nebulae"), olw->TypeList))
-        ObjectCount += GasNebCount;
-    if (isItemSelected(i18n("Planetary nebulae"), olw->TypeList))
-        ObjectCount += PlanNebCount;
-
     applyFilters(false); //false = only adjust counts, do not build list
     QApplication::restoreOverrideCursor();
     olw->updateButton->setDisabled(true);
@@ -420,21 +376,43 @@ void ObsListWizard::slotUpdateObjectCount()
 
 void ObsListWizard::applyFilters(bool doBuildList)
 {
-    bool filterPass  = true;
-    KStarsData *data = KStarsData::Instance();
     if (doBuildList)
         obsList().clear();
 
-    //We don't need to call applyRegionFilter() if no region filter is selected, *and*
-    //we are just counting items (i.e., doBuildList is false)
-    bool needRegion = true;
-    if (!doBuildList && isItemSelected(i18n("all over the sky"), olw->RegionList))
-        needRegion = false;
-
     double maglimit = 100.;
     if (olw->SelectByMagnitude->isChecked())
         maglimit = olw->Mag->value();
 
+    //Each filter gives a mask over the candidates, so counting and building the list are the same pass
+    const QVector<SkyObject *> candidates = selectedObjects(maglimit);
+    QBitArray mask(candidates.size(), true);
+    if (olw->SelectByMagnitude->isChecked())
+        mask &= magnitudeMask(candidates, maglimit);
+    if (!isItemSelected(i18n("all over the sky"), olw->RegionList))
+        mask &= regionMask(candidates, mask);
+    if (olw->SelectByDate->isChecked())
+        mask &= observableMask(candidates);
+
+    ObjectCount = mask.count(true);
+    if (doBuildList)
+    {
+        obsList().reserve(ObjectCount);
+        for (int i = 0; i < candidates.size(); ++i)
+        {
+            if (mask.testBit(i))
+                obsList().append(candidates.at(i));
+        }
+    }
+
+    olw->CountLabel->setText(i18np("Your observing list currently has 1 object",
+                                   "Your observing list currently has %1 objects", ObjectCount));
+}
+
+QVector<SkyObject *> ObsListWizard::selectedObjects(double maglimit)
+{
+    KStarsData *data = KStarsData::Instance();
+    QVector<SkyObject *> objects;
+
     //Stars
     if (isItemSelected(i18n("Stars"), olw->TypeList))
     {
@@ -462,262 +440,67 @@ void ObsListWizard::applyFilters(bool doBuildList)
             }
         }
 
-        //DEBUG
-        qDebug() << QString("starIndex for mag %1: %2").arg(maglimit).arg(starIndex) << endl;
-
-        if (!doBuildList)
-        {
-            //reduce StarCount by appropriate amount
-            ObjectCount -= StarCount;
-            ObjectCount += starIndex;
-        }
+        objects.reserve(starIndex);
         for (int i = 0; i < starIndex; ++i)
         {
-            SkyObject *o = (SkyObject *)(starList[i]);
-
             // JM 2012-10-22: Skip unnamed stars
-            if (o->name() == "star")
-            {
-                if (!doBuildList)
-                    --ObjectCount;
-                continue;
-            }
-
-            if (needRegion)
-                filterPass = applyRegionFilter(o, doBuildList, !doBuildList);
-            //Filter objects visible from geo at Date if region filter passes
-            if (olw->SelectByDate->isChecked() && filterPass)
-                applyObservableFilter(o, doBuildList, !doBuildList);
+            if (starList[i]->name() != "star")
+                objects.append(starList[i]);
         }
     }
 
     //Sun, Moon, Planets
     if (isItemSelected(i18n("Sun, moon, planets"), olw->TypeList))
     {
-        if (maglimit < data->skyComposite()->findByName("Sun")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName("Sun"), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName("Sun"), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Moon")->mag())
+        const QStringList names = { "Sun",           "Moon",           i18n("Mercury"), i18n("Venus"),
+                                    i18n("Mars"),    i18n("Jupiter"),  i18n("Saturn"),  i18n("Uranus"),
+                                    i18n("Neptune"), i18nc("Asteroid name (optional)", "Pluto") };
+        for (const QString &name : names)
         {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
+            SkyObject *o = data->skyComposite()->findByName(name);
+            if (o != nullptr)
+                objects.append(o);
         }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName("Moon"), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName("Moon"), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Mercury")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Mercury")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Mercury")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Venus")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Venus")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Venus")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Mars")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Mars")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Mars")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Jupiter")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Jupiter")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Jupiter")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Saturn")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Saturn")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Saturn")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Uranus")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Uranus")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Uranus")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Neptune")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18n("Neptune")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18n("Neptune")), doBuildList);
-
-        if (maglimit < data->skyComposite()->findByName("Pluto")->mag())
-        {
-            if (!doBuildList)
-                --ObjectCount;
-            filterPass = false;
-        }
-        else
-            filterPass = true;
-
-        if (needRegion && filterPass)
-            filterPass = applyRegionFilter(data->skyComposite()->findByName(i18nc("Asteroid name (optional)", "Pluto")), doBuildList);
-        if (olw->SelectByDate->isChecked() && filterPass)
-            applyObservableFilter(data->skyComposite()->findByName(i18nc("Asteroid name (optional)", "Pluto")), doBuildList);
     }
 
     //Deep sky objects
-    bool dso =
-        (isItemSelected(i18n("Open clusters"), olw->TypeList) ||
-         isItemSelected(i18n("Globular clusters"), olw->TypeList) ||
-         isItemSelected(i18n("Gaseous nebulae"), olw->TypeList) ||
-         isItemSelected(i18n("Planetary nebulae"), olw->TypeList) || isItemSelected(i18n("Galaxies"), olw->TypeList));
+    const bool openClusters     = isItemSelected(i18n("Open clusters"), olw->TypeList);
+    const bool globularClusters = isItemSelected(i18n("Globular clusters"), olw->TypeList);
+    const bool gaseousNebulae   = isItemSelected(i18n("Gaseous nebulae"), olw->TypeList);
+    const bool planetaryNebulae = isItemSelected(i18n("Planetary nebulae"), olw->TypeList);
+    const bool galaxies         = isItemSelected(i18n("Galaxies"), olw->TypeList);
 
-    if (dso)
+    if (openClusters || globularClusters || gaseousNebulae || planetaryNebulae || galaxies)
     {
-        //Don't need to do anything if we are just counting objects and not
-        //filtering by region or magnitude
-        if (needRegion || olw->SelectByMagnitude->isChecked() || olw->SelectByDate->isChecked())
+        foreach (DeepSkyObject *o, data->skyComposite()->deepSkyObjects())
         {
-            foreach (DeepSkyObject *o, data->skyComposite()->deepSkyObjects())
+            //Skip unselected object types
+            bool typeSelected = false;
+            switch (o->type())
             {
-                //Skip unselected object types
-                bool typeSelected = false;
-                // if ( (o->type() == SkyObject::STAR || o->type() == SkyObject::CATALOG_STAR) &&
-                //       isItemSelected( i18n( "Stars" ), olw->TypeList ) )
-                // typeSelected = true;
-                switch (o->type())
-                {
-                    case SkyObject::OPEN_CLUSTER:
-                        if (isItemSelected(i18n("Open clusters"), olw->TypeList))
-                            typeSelected = true;
-                        break;
-
-                    case SkyObject::GLOBULAR_CLUSTER:
-                        if (isItemSelected(i18n("Globular clusters"), olw->TypeList))
-                            typeSelected = true;
-                        break;
-
-                    case SkyObject::GASEOUS_NEBULA:
-                    case SkyObject::SUPERNOVA_REMNANT:
-                        if (isItemSelected(i18n("Gaseous nebulae"), olw->TypeList))
-                            typeSelected = true;
-                        break;
-
-                    case SkyObject::PLANETARY_NEBULA:
-                        if (isItemSelected(i18n("Planetary nebulae"), olw->TypeList))
-                            typeSelected = true;
-                        break;
-                    case SkyObject::GALAXY:
-                        if (isItemSelected(i18n("Galaxies"), olw->TypeList))
-                            typeSelected = true;
-                        break;
-                }
+                case SkyObject::OPEN_CLUSTER:
+                    typeSelected = openClusters;
+                    break;
 
-                if (!typeSelected)
-                    continue;
+                case SkyObject::GLOBULAR_CLUSTER:
+                    typeSelected = globularClusters;
+                    break;
 
-                if (olw->SelectByMagnitude->isChecked())
-                {
-                    if (o->mag() > 90.)
-                    {
-                        if (olw->IncludeNoMag->isChecked())
-                        {
-                            if (needRegion)
-                                filterPass = applyRegionFilter(o, doBuildList);
-                            if (olw->SelectByDate->isChecked() && filterPass)
-                                applyObservableFilter(o, doBuildList);
-                        }
-                        else if (!doBuildList)
-                            --ObjectCount;
-                    }
-                    else
-                    {
-                        if (o->mag() <= maglimit)
-                        {
-                            if (needRegion)
-                                filterPass = applyRegionFilter(o, doBuildList);
-                            if (olw->SelectByDate->isChecked() && filterPass)
-                                applyObservableFilter(o, doBuildList);
-                        }
-                        else if (!doBuildList)
-                            --ObjectCount;
-                    }
-                }
-                else
-                {
-                    if (needRegion)
-                        filterPass = applyRegionFilter(o, doBuildList);
-                    if (olw->SelectByDate->isChecked() && filterPass)
-                        applyObservableFilter(o, doBuildList);
-                }
+                case SkyObject::GASEOUS_NEBULA:
+                case SkyObject::SUPERNOVA_REMNANT:
+                    typeSelected = gaseousNebulae;
+                    break;
+
+                case SkyObject::PLANETARY_NEBULA:
+                    typeSelected = planetaryNebulae;
+                    break;
+                case SkyObject::GALAXY:
+                    typeSelected = galaxies;
+                    break;
             }
+
+            if (typeSelected)
+                objects.append(o);
         }
     }
 
@@ -725,149 +508,72 @@ void ObsListWizard::applyFilters(bool doBuildList)
     if (isItemSelected(i18n("Comets"), olw->TypeList))
     {
         foreach (SkyObject *o, data->skyComposite()->comets())
-        {
-            if (olw->SelectByMagnitude->isChecked())
-            {
-                if (o->mag() > 90.)
-                {
-                    if (olw->IncludeNoMag->isChecked())
-                    {
-                        if (needRegion)
-                            filterPass = applyRegionFilter(o, doBuildList);
-                        if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
-                    }
-                    else if (!doBuildList)
-                        --ObjectCount;
-                }
-                else
-                {
-                    if (o->mag() <= maglimit)
-                    {
-                        if (needRegion)
-                            filterPass = applyRegionFilter(o, doBuildList);
-                        if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
-                    }
-                    else if (!doBuildList)
-                        --ObjectCount;
-                }
-            }
-            else
-            {
-                if (needRegion)
-                    filterPass = applyRegionFilter(o, doBuildList);
-                if (olw->SelectByDate->isChecked() && filterPass)
-                    applyObservableFilter(o, doBuildList);
-            }
-        }
+            objects.append(o);
     }
 
     //Asteroids
     if (isItemSelected(i18n("Asteroids"), olw->TypeList))
     {
         foreach (SkyObject *o, data->skyComposite()->asteroids())
-        {
-            if (olw->SelectByMagnitude->isChecked())
-            {
-                if (o->mag() > 90.)
-                {
-                    if (olw->IncludeNoMag->isChecked())
-                    {
-                        if (needRegion)
-                            filterPass = applyRegionFilter(o, doBuildList);
-                        if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
-                    }
-                    else if (!doBuildList)
-                        --ObjectCount;
-                }
-                else
-                {
-                    if (o->mag() <= maglimit)
-                    {
-                        if (needRegion)
-                            filterPass = applyRegionFilter(o, doBuildList);
-                        if (olw->SelectByDate->isChecked() && filterPass)
-                            applyObservableFilter(o, doBuildList);
-                    }
-                    else if (!doBuildList)
-                        --ObjectCount;
-                }
-            }
-            else
-            {
-                if (needRegion)
-                    filterPass = applyRegionFilter(o, doBuildList);
-                if (olw->SelectByDate->isChecked() && filterPass)
-                    applyObservableFilter(o, doBuildList);
-            }
-        }
+            objects.append(o);
     }
 
-    //Update the object count label
-    if (doBuildList)
-        ObjectCount = obsList().size();
+    return objects;
+}
 
-    olw->CountLabel->setText(i18np("Your observing list currently has 1 object",
-                                   "Your observing list currently has %1 objects", ObjectCount));
+QBitArray ObsListWizard::magnitudeMask(const QVector<SkyObject *> &objects, double maglimit)
+{
+    const bool includeNoMag = olw->IncludeNoMag->isChecked();
+
+    QBitArray mask(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        const float mag = objects.at(i)->mag();
+        mask.setBit(i, mag > 90. ? includeNoMag : mag <= maglimit);
+    }
+    return mask;
 }
 
-bool ObsListWizard::applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdjustCount)
+QBitArray ObsListWizard::regionMask(const QVector<SkyObject *> &objects, const QBitArray &candidates)
 {
+    QBitArray mask(objects.size());
+
     //select by constellation
     if (isItemSelected(i18n("by constellation"), olw->RegionList))
     {
-        QString c = KStarsData::Instance()->skyComposite()->constellationBoundary()->constellationName(o);
+        QSet<QString> constellations;
+        foreach (QListWidgetItem *item, olw->ConstellationList->selectedItems())
+            constellations.insert(item->text());
 
-        if (isItemSelected(c, olw->ConstellationList))
+        //The boundary lookup is the slowest filter, skip the objects already rejected
+        ConstellationBoundaryLines *boundaries = KStarsData::Instance()->skyComposite()->constellationBoundary();
+        for (int i = 0; i < objects.size(); ++i)
         {
-            if (doBuildList)
-                obsList().append(o);
-
-            return true;
+            if (candidates.testBit(i))
+                mask.setBit(i, constellations.contains(boundaries->constellationName(objects.at(i))));
         }
-        else if (doAdjustCount)
-        {
-            --ObjectCount;
-            return false;
-        }
-        else
-            return false;
     }
 
     //select by rectangular region
     else if (isItemSelected(i18n("in a rectangular region"), olw->RegionList))
     {
-        double ra      = o->ra().Hours();
-        double dec     = o->dec().Degrees();
-        bool addObject = false;
-        if (dec >= yRect1 && dec <= yRect2)
+        for (int i = 0; i < objects.size(); ++i)
         {
-            if (xRect1 < 0.0)
+            double ra      = objects.at(i)->ra().Hours();
+            double dec     = objects.at(i)->dec().Degrees();
+            bool addObject = false;
+            if (dec >= yRect1 && dec <= yRect2)
             {
-                addObject = ra >= xRect1 + 24.0 || ra <= xRect2;
-            }
-            else
-            {
-                addObject = ra >= xRect1 && ra <= xRect2;
+                if (xRect1 < 0.0)
+                {
+                    addObject = ra >= xRect1 + 24.0 || ra <= xRect2;
+                }
+                else
+                {
+                    addObject = ra >= xRect1 && ra <= xRect2;
+                }
             }
-        }
-
-        if (addObject)
-        {
-            if (doBuildList)
-                obsList().append(o);
-
-            return true;
-        }
-
-        else
-        {
-            if (doAdjustCount)
-                --ObjectCount;
-
-            return false;
+            mask.setBit(i, addObject);
         }
     }
 
@@ -875,37 +581,22 @@ bool ObsListWizard::applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdj
     //make sure circ region data are valid
     else if (isItemSelected(i18n("in a circular region"), olw->RegionList))
     {
-        if (o->angularDistanceTo(&pCirc).Degrees() < rCirc)
-        {
-            if (doBuildList)
-                obsList().append(o);
-
-            return true;
-        }
-        else if (doAdjustCount)
-        {
-            --ObjectCount;
-            return false;
-        }
-        else
-            return false;
+        for (int i = 0; i < objects.size(); ++i)
+            mask.setBit(i, objects.at(i)->angularDistanceTo(&pCirc).Degrees() < rCirc);
     }
 
-    //No region filter, just add the object
-    else if (doBuildList)
+    //No region filter, keep all objects
+    else
     {
-        obsList().append(o);
+        mask.fill(true);
     }
 
-    return true;
+    return mask;
 }
 
-bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount)
+QBitArray ObsListWizard::observableMask(const QVector<SkyObject *> &objects)
 {
-    SkyPoint p = *o;
-
-    //Check altitude of object every hour from 18:00 to midnight
-    //If it's ever above 15 degrees, flag it as visible
+    //Check if the altitude of the object is ever above 15 degrees from 18:00 to midnight
     KStarsDateTime Evening(olw->Date->date(), QTime(18, 0, 0));
     KStarsDateTime Midnight(olw->Date->date().addDays(1), QTime(0, 0, 0));
     double minAlt = 15, maxAlt = 90;
@@ -924,26 +615,7 @@ bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool d
         maxAlt = olw->maxAlt->value();
     }
 
-    bool visible = false;
-    for (KStarsDateTime t = Evening; t < Midnight; t = t.addSecs(3600.0))
-    {
-        dms LST = geo->GSTtoLST(t.gst());
-        p.EquatorialToHorizontal(&LST, geo->lat());
-
-        if (p.alt().Degrees() >= minAlt && p.alt().Degrees() <= maxAlt)
-        {
-            visible = true;
-            break;
-        }
-    }
-
-    if (visible)
-        return true;
-
-    if (doAdjustCount)
-        --ObjectCount;
-    if (doBuildList)
-        obsList().takeAt(obsList().indexOf(o));
-
-    return false;
+    ObservabilityFilter filter(geo, Evening, Midnight);
+    filter.setAltitudeRange(minAlt, maxAlt);
+    return filter.apply(objects);
 }
@@ -19,7 +19,9 @@
 #include "ui_obslistwizard.h"
 #include "skyobjects/skypoint.h"
 
+#include <QBitArray>
 #include <QDialog>
+#include <QVector>
 
 class QListWidget;
 class QPushButton;
@@ -75,9 +77,17 @@ class ObsListWizard : public QDialog
     void initialize();
     void applyFilters(bool doBuildList);
 
-    /** @return true if the object passes the filter region constraints, false otherwise.*/
-    bool applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdjustCount = true);
-    bool applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount = true);
+    /** @return the objects of the selected types, without the unnamed stars and the stars fainter than maglimit */
+    QVector<SkyObject *> selectedObjects(double maglimit);
+    /** @return a mask of the objects passing the magnitude constraints */
+    QBitArray magnitudeMask(const QVector<SkyObject *> &objects, double maglimit);
+    /**
+     * @return a mask of the objects passing the region constraints
+     * @param candidates mask of the objects still selected, the others may be skipped by the slow region filters
+     */
+    QBitArray regionMask(const QVector<SkyObject *> &objects, const QBitArray &candidates);
+    /** @return a mask of the objects observable from geo during the selected times and altitudes */
+    QBitArray observableMask(const QVector<SkyObject *> &objects);
 
     /**
      * Convenience function for safely getting the selected state of a QListWidget item by name.
@@ -101,15 +111,6 @@ class ObsListWizard : public QDialog
     QList<SkyObject *> ObsList;
     ObsListWizardUI *olw { nullptr };
     uint ObjectCount { 0 };
-    uint StarCount { 0 };
-    uint PlanetCount { 0 };
-    uint CometCount { 0 };
-    uint AsteroidCount { 0 };
-    uint GalaxyCount { 0 };
-    uint OpenClusterCount { 0 };
-    uint GlobClusterCount { 0 };
-    uint GasNebCount { 0 };
-    uint PlanNebCount { 0 };
     double xRect1 { 0 };
     double xRect2 { 0 };
     double yRect1 { 0 };
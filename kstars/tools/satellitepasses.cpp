@@ -0,0 +1,212 @@
+/*  Satellite passes tool
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "satellitepasses.h"
+
+#include "kstars.h"
+#include "kstarsdata.h"
+#include "skymap.h"
+#include "dialogs/locationdialog.h"
+#include "skycomponents/satellitescomponent.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skyobjects/satellite.h"
+#include "skyobjects/satellitegroup.h"
+
+#include <KMessageBox>
+
+#include <QFileDialog>
+#include <QSortFilterProxyModel>
+#include <QStandardItemModel>
+#include <QtConcurrent>
+
+SatellitePassesTool::SatellitePassesTool(QWidget *parentSplit) : QFrame(parentSplit)
+{
+    setupUi(this);
+
+    KStarsData *kd = KStarsData::Instance();
+    KStarsDateTime dtStart(KStarsDateTime::currentDateTime());
+    KStarsDateTime dtStop(dtStart.djd() + 7);
+
+    startDate->setDateTime(dtStart);
+    stopDate->setDateTime(dtStop);
+
+    geoPlace = kd->geo();
+    LocationButton->setText(geoPlace->fullName());
+
+    //Set up the Table Views
+    m_Model = new QStandardItemModel(0, 8, this);
+    m_Model->setHorizontalHeaderLabels(QStringList() << i18n("Satellite") << i18n("Rise (UT)") << i18n("Rise Azimuth")
+                                                     << i18n("Culmination (UT)") << i18n("Altitude") << i18n("Set (UT)")
+                                                     << i18n("Set Azimuth") << i18n("Visible (UT)"));
+    m_SortModel = new QSortFilterProxyModel(this);
+    m_SortModel->setSourceModel(m_Model);
+    OutputList->setModel(m_SortModel);
+    OutputList->setSortingEnabled(true);
+    OutputList->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    ClearFilterButton->setIcon(QIcon::fromTheme("edit-clear", QIcon(":/icons/breeze/default/edit-clear.svg")));
+
+    // signals and slots connections
+    connect(LocationButton, SIGNAL(clicked()), this, SLOT(slotLocation()));
+    connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
+    connect(ClearButton, SIGNAL(clicked()), this, SLOT(slotClear()));
+    connect(ExportButton, SIGNAL(clicked()), this, SLOT(slotExport()));
+    connect(OutputList, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(slotGoto()));
+    connect(ClearFilterButton, SIGNAL(clicked()), FilterEdit, SLOT(clear()));
+    connect(FilterEdit, SIGNAL(textChanged(QString)), this, SLOT(slotFilterReg(QString)));
+    connect(&m_Watcher, SIGNAL(finished()), this, SLOT(showPasses()));
+
+    show();
+}
+
+SatellitePassesTool::~SatellitePassesTool()
+{
+    m_Watcher.waitForFinished();
+}
+
+void SatellitePassesTool::slotGoto()
+{
+    int index = m_SortModel->mapToSource(OutputList->currentIndex()).row(); // Get the number of the line
+    KStarsDateTime dt;
+    KStars *ks       = KStars::Instance();
+    KStarsData *data = KStarsData::Instance();
+    SkyMap *map      = ks->map();
+
+    // Show the satellite at its culmination
+    data->setLocation(*geoPlace);
+    dt.setDJD(m_Model->item(index, 3)->data(Qt::UserRole).toDouble());
+    data->changeDateTime(dt);
+    map->setClickedObject(data->skyComposite()->satellites()->findSatellite(m_Model->item(index, 0)->text()));
+    if (map->clickedObject() == nullptr)
+        return;
+    map->setClickedPoint(map->clickedObject());
+    map->slotCenter();
+}
+
+void SatellitePassesTool::slotLocation()
+{
+    QPointer<LocationDialog> ld(new LocationDialog(this));
+    if (ld->exec() == QDialog::Accepted && ld)
+    {
+        geoPlace = ld->selectedCity();
+        LocationButton->setText(geoPlace->fullName());
+    }
+    delete ld;
+}
+
+void SatellitePassesTool::slotClear()
+{
+    m_Model->setRowCount(0);
+}
+
+void SatellitePassesTool::slotExport()
+{
+    QByteArray line;
+
+    QFile file(QFileDialog::getSaveFileName(nullptr, i18n("Save Satellite Passes"), QDir::homePath(), "*|All files"));
+
+    file.open(QIODevice::WriteOnly | QIODevice::Text);
+
+    for (int i = 0; i < m_Model->rowCount(); ++i)
+    {
+        for (int j = 0; j < m_Model->columnCount(); ++j)
+        {
+            line.append(m_Model->data(m_Model->index(i, j)).toByteArray());
+            if (j < m_Model->columnCount() - 1)
+                line.append(";");
+            else
+                line.append("\n");
+        }
+        file.write(line);
+        line.clear();
+    }
+
+    file.close();
+}
+
+void SatellitePassesTool::slotFilterReg(const QString &filter)
+{
+    m_SortModel->setFilterRegExp(QRegExp(filter, Qt::CaseInsensitive, QRegExp::RegExp));
+    m_SortModel->setFilterKeyColumn(-1);
+}
+
+void SatellitePassesTool::slotCompute()
+{
+    if (m_Watcher.isRunning())
+        return;
+
+    const double startJD = KStarsDateTime(startDate->dateTime()).djd();
+    const double stopJD  = KStarsDateTime(stopDate->dateTime()).djd();
+    if (stopJD <= startJD)
+    {
+        KMessageBox::sorry(nullptr, i18n("The ending date must be after the starting date."));
+        return;
+    }
+
+    // The satellites are updated by the sky map meanwhile, the computation uses copies
+    const bool all = SatellitesComboBox->currentIndex() == 1;
+    QList<Satellite *> satellites;
+    for (SatelliteGroup *group : KStarsData::Instance()->skyComposite()->satellites()->groups())
+    {
+        for (Satellite *sat : *group)
+        {
+            if (all || sat->selected())
+                satellites.append(sat->clone());
+        }
+    }
+
+    if (satellites.isEmpty())
+    {
+        KMessageBox::sorry(nullptr, i18n("No satellite is selected. Select satellites in the satellites settings."));
+        return;
+    }
+
+    SatellitePassPredictor predictor(*geoPlace);
+    predictor.setMinAltitude(MinAltitudeSpin->value());
+    predictor.setVisibleOnly(VisibleOnlyCheck->isChecked());
+
+    ComputeButton->setEnabled(false);
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+
+    m_Watcher.setFuture(QtConcurrent::run([predictor, satellites, startJD, stopJD]()
+    {
+        QVector<SatellitePassPredictor::Pass> passes = predictor.predict(satellites, startJD, stopJD);
+        qDeleteAll(satellites);
+        return passes;
+    }));
+}
+
+void SatellitePassesTool::showPasses()
+{
+    QApplication::restoreOverrideCursor();
+    ComputeButton->setEnabled(true);
+
+    // Times are shown in UT like in the other calculator modules
+    auto time = [](double jd)
+    {
+        QStandardItem *item = new QStandardItem(KStarsDateTime(jd).toString(Qt::ISODate));
+        item->setData(jd, Qt::UserRole);
+        return item;
+    };
+    auto angle = [](double degrees) { return new QStandardItem(QString::number(degrees, 'f', 1)); };
+
+    for (const SatellitePassPredictor::Pass &pass : m_Watcher.result())
+    {
+        QString visible = i18n("No");
+        if (pass.isVisible())
+            visible = QString("%1 - %2").arg(KStarsDateTime(pass.visibleStart).time().toString("hh:mm:ss"),
+                                             KStarsDateTime(pass.visibleEnd).time().toString("hh:mm:ss"));
+
+        m_Model->appendRow(QList<QStandardItem *>() << new QStandardItem(pass.name) << time(pass.aos)
+                                                    << angle(pass.aosAzimuth) << time(pass.culmination)
+                                                    << angle(pass.maxAltitude) << time(pass.los)
+                                                    << angle(pass.losAzimuth) << new QStandardItem(visible));
+    }
+}
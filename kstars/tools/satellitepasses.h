@@ -0,0 +1,50 @@
+/*  Satellite passes tool
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "satellitepasspredictor.h"
+#include "ui_satellitepasses.h"
+
+#include <QFrame>
+#include <QFutureWatcher>
+
+class QSortFilterProxyModel;
+class QStandardItemModel;
+
+/**
+  * @short Lists the passes of the loaded satellites computed by SatellitePassPredictor in the background
+  */
+class SatellitePassesTool : public QFrame, public Ui::SatellitePassesDlg
+{
+    Q_OBJECT
+
+  public:
+    explicit SatellitePassesTool(QWidget *p);
+    ~SatellitePassesTool() override;
+
+  public slots:
+
+    void slotLocation();
+    void slotCompute();
+    void slotGoto();
+    void slotClear();
+    void slotExport();
+    void slotFilterReg(const QString &);
+
+  private slots:
+    void showPasses();
+
+  private:
+    GeoLocation *geoPlace { nullptr };
+    QStandardItemModel *m_Model { nullptr };
+    QSortFilterProxyModel *m_SortModel { nullptr };
+    QFutureWatcher<QVector<SatellitePassPredictor::Pass>> m_Watcher;
+};
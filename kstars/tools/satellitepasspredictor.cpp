@@ -0,0 +1,222 @@
+/*  Pass prediction for artificial satellites
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "satellitepasspredictor.h"
+
+#include "skyobjects/satellite.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+/// Precision of the refined times, one second in days
+const double TIME_TOLERANCE = 1.0 / 86400.0;
+
+/// Number of satellites processed by one thread at a time
+const int SATELLITES_PER_TASK = 8;
+
+/// Ratio of the golden section search
+const double GOLDEN = 0.6180339887498949;
+
+/** @return the step of the scan in days, short enough not to miss the short passes */
+double scanStep(const Satellite *satellite)
+{
+    // Half a minute for low orbits, up to ten minutes for high ones
+    return qBound(0.5, satellite->period() / 200.0, 10.0) / 1440.0;
+}
+
+/** @return false if the position of satellite cannot be computed at jd, e.g. it has decayed */
+bool update(Satellite *satellite, const GeoLocation &geo, double jd, bool cull = false)
+{
+    return satellite->updatePos(Satellite::context(geo, jd, cull)) == 0;
+}
+
+/** @return the time in [a, b] at which test changes, test(a) being different from test(b) */
+template <typename Test>
+double bisect(double a, double b, Test test)
+{
+    const bool atStart = test(a);
+    while (b - a > TIME_TOLERANCE)
+    {
+        const double m = 0.5 * (a + b);
+        if (test(m) == atStart)
+            a = m;
+        else
+            b = m;
+    }
+    return 0.5 * (a + b);
+}
+}
+
+SatellitePassPredictor::SatellitePassPredictor(const GeoLocation &geo) : m_Geo(geo)
+{
+}
+
+QVector<SatellitePassPredictor::Pass> SatellitePassPredictor::predict(const Satellite *satellite, double startJD,
+                                                                      double endJD) const
+{
+    QVector<Pass> passes;
+
+    std::unique_ptr<Satellite> sat(satellite->clone());
+    const double step = scanStep(sat.get());
+
+    auto above = [&](double jd) { return update(sat.get(), m_Geo, jd) && sat->alt().Degrees() >= 0.0; };
+
+    double t = startJD;
+    if (!update(sat.get(), m_Geo, t, true))
+        return passes;
+    bool up = sat->alt().Degrees() >= 0.0;
+
+    Pass pass;
+    pass.name = satellite->name();
+    pass.aos  = startJD;
+
+    while (t < endJD)
+    {
+        double next = t + step;
+        // Jump over the time during which the satellite cannot rise
+        if (!up && sat->hiddenUntil() > next)
+            next = sat->hiddenUntil();
+        next = qMin(next, endJD);
+
+        if (!update(sat.get(), m_Geo, next, true))
+            break;
+        const bool nextUp = sat->alt().Degrees() >= 0.0;
+
+        if (nextUp != up)
+        {
+            const double crossing = bisect(t, next, above);
+            if (nextUp)
+            {
+                pass.aos = crossing;
+            }
+            else
+            {
+                pass.los = crossing;
+                if (finishPass(sat.get(), step, pass))
+                    passes.append(pass);
+            }
+        }
+
+        t  = next;
+        up = nextUp;
+    }
+
+    // Pass in progress at the end of the window
+    if (up)
+    {
+        pass.los = t;
+        if (finishPass(sat.get(), step, pass))
+            passes.append(pass);
+    }
+
+    return passes;
+}
+
+QVector<SatellitePassPredictor::Pass> SatellitePassPredictor::predict(const QList<Satellite *> &satellites,
+                                                                      double startJD, double endJD) const
+{
+    QVector<QVector<Pass>> results(satellites.size());
+    QVector<Pass> *result = results.data();
+
+    QVector<int> tasks;
+    for (int begin = 0; begin < satellites.size(); begin += SATELLITES_PER_TASK)
+        tasks.append(begin);
+
+    QtConcurrent::blockingMap(tasks, [&](const int &begin)
+    {
+        const int end = qMin(begin + SATELLITES_PER_TASK, satellites.size());
+        for (int i = begin; i < end; ++i)
+            result[i] = predict(satellites.at(i), startJD, endJD);
+    });
+
+    QVector<Pass> passes;
+    for (const QVector<Pass> &satellitePasses : results)
+        passes += satellitePasses;
+
+    std::sort(passes.begin(), passes.end(), [](const Pass &a, const Pass &b) { return a.aos < b.aos; });
+    return passes;
+}
+
+bool SatellitePassPredictor::finishPass(Satellite *satellite, double step, Pass &pass) const
+{
+    auto altitude = [&](double jd) { return update(satellite, m_Geo, jd) ? satellite->alt().Degrees() : -90.0; };
+
+    // Culmination, the altitude has a single maximum during a pass
+    double a  = pass.aos;
+    double b  = pass.los;
+    double c  = b - GOLDEN * (b - a);
+    double d  = a + GOLDEN * (b - a);
+    double fc = altitude(c);
+    double fd = altitude(d);
+    while (b - a > TIME_TOLERANCE)
+    {
+        if (fc > fd)
+        {
+            b  = d;
+            d  = c;
+            fd = fc;
+            c  = b - GOLDEN * (b - a);
+            fc = altitude(c);
+        }
+        else
+        {
+            a  = c;
+            c  = d;
+            fc = fd;
+            d  = a + GOLDEN * (b - a);
+            fd = altitude(d);
+        }
+    }
+    pass.culmination = 0.5 * (a + b);
+    pass.maxAltitude = altitude(pass.culmination);
+
+    if (pass.maxAltitude < m_MinAltitude)
+        return false;
+
+    update(satellite, m_Geo, pass.aos);
+    pass.aosAzimuth = satellite->az().Degrees();
+    update(satellite, m_Geo, pass.los);
+    pass.losAzimuth = satellite->az().Degrees();
+
+    // Visibility changes when the satellite enters the shadow of the Earth or the sky gets dark
+    auto visible = [&](double jd) { return update(satellite, m_Geo, jd) && satellite->isVisible(); };
+
+    double start    = -1;
+    double end      = -1;
+    double previous = pass.aos;
+    bool wasVisible = visible(previous);
+    if (wasVisible)
+        start = pass.aos;
+
+    while (previous < pass.los)
+    {
+        const double jd        = qMin(previous + step, pass.los);
+        const bool nowVisible  = visible(jd);
+
+        if (nowVisible && !wasVisible && start < 0)
+            start = bisect(previous, jd, visible);
+        else if (!nowVisible && wasVisible)
+            end = bisect(previous, jd, visible);
+
+        previous   = jd;
+        wasVisible = nowVisible;
+    }
+    if (wasVisible)
+        end = pass.los;
+
+    pass.visibleStart = start < 0 ? 0 : start;
+    pass.visibleEnd   = start < 0 ? 0 : end;
+
+    return !m_VisibleOnly || pass.isVisible();
+}
@@ -0,0 +1,81 @@
+/*  Pass prediction for artificial satellites
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "geolocation.h"
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class Satellite;
+
+/**
+ * @class SatellitePassPredictor
+ * @short Finds the passes of artificial satellites over an observer in a time window.
+ *
+ * Each satellite is propagated with its SGP4 model, on a private clone so that the
+ * sky map is not disturbed.  The scan uses coarse steps while the satellite is near or
+ * above the horizon, and jumps over the time during which it is known not to rise while
+ * it is below the horizon (see Satellite::context()).  Horizon crossings, culmination and
+ * the start and end of visibility are then refined by bisection.
+ *
+ * Satellites are processed in parallel.  The given satellites are only read, but they must
+ * not be updated while the prediction runs: pass clones when predicting in the background.
+ */
+class SatellitePassPredictor
+{
+  public:
+    struct Pass
+    {
+        QString name;
+        /// Rise (acquisition of signal), culmination and set (loss of signal), in Julian Days UTC
+        double aos { 0 };
+        double culmination { 0 };
+        double los { 0 };
+        /// Azimuths at rise and set and altitude at culmination, in degrees
+        double aosAzimuth { 0 };
+        double losAzimuth { 0 };
+        double maxAltitude { 0 };
+        /// Part of the pass during which the satellite is sunlit and the sky dark, empty if none
+        double visibleStart { 0 };
+        double visibleEnd { 0 };
+
+        /** @return true if the satellite can be seen during some part of the pass */
+        bool isVisible() const { return visibleEnd > visibleStart; }
+    };
+
+    /** @param geo the observer location */
+    explicit SatellitePassPredictor(const GeoLocation &geo);
+
+    /** @short Only report the passes culminating higher than the given altitude in degrees */
+    void setMinAltitude(double altitude) { m_MinAltitude = altitude; }
+
+    /** @short Only report the passes during which the satellite can be seen */
+    void setVisibleOnly(bool visibleOnly) { m_VisibleOnly = visibleOnly; }
+
+    /**
+     * @return the passes of satellite between startJD and endJD, in chronological order.
+     * A pass in progress at startJD or endJD is cut at the window boundary.
+     */
+    QVector<Pass> predict(const Satellite *satellite, double startJD, double endJD) const;
+
+    /** @return the passes of all satellites between startJD and endJD, sorted by rise time */
+    QVector<Pass> predict(const QList<Satellite *> &satellites, double startJD, double endJD) const;
+
+  private:
+    /** @short Refine the time and azimuths of a pass and check it against the filters */
+    bool finishPass(Satellite *satellite, double step, Pass &pass) const;
+
+    GeoLocation m_Geo;
+    double m_MinAltitude { 0 };
+    bool m_VisibleOnly { false };
+};
@@ -31,7 +31,6 @@
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QPushButton>
-#include <QtConcurrent>
 
 SkyCalendarUI::SkyCalendarUI(QWidget *parent) : QFrame(parent)
 {
@@ -80,7 +79,6 @@ SkyCalendar::SkyCalendar(QWidget *parent) : QDialog(parent)
 
     scUI->CalendarView->setHorizon();
 
-    plotButtonText = scUI->CreateButton->text();
     connect(scUI->CreateButton, SIGNAL(clicked()), this, SLOT(slotFillCalendar()));
     connect(scUI->LocationButton, SIGNAL(clicked()), this, SLOT(slotLocation()));
 }
@@ -96,9 +94,8 @@ int SkyCalendar::year()
 
 void SkyCalendar::slotFillCalendar()
 {
-    calculating = true;
-    scUI->CreateButton->setEnabled(false);
-    QtConcurrent::run(this, &SkyCalendar::slotCalculating);
+    // Only the first drawing of a year and location computes the events, then they are read from the cache
+    QApplication::setOverrideCursor(Qt::WaitCursor);
 
     scUI->CalendarView->resetPlot();
     scUI->CalendarView->setHorizon();
@@ -120,35 +117,15 @@ void SkyCalendar::slotFillCalendar()
     //if ( scUI->checkBox_Pluto->isChecked() )
     //addPlanetEvents( KSPlanetBase::PLUTO );
 
-  {
-    QMutexLocker locker(&calculationMutex);
-
-    calculating = false;
-    scUI->CreateButton->setEnabled(true);
     scUI->CalendarView->update();
-  }
+
+    QApplication::restoreOverrideCursor();
 }
 
-void SkyCalendar::slotCalculating()
+const SkyCalendarEvents &SkyCalendar::events()
 {
-  while (calculating)
-  {
-    QMutexLocker locker(&calculationMutex);
-
-    if (!calculating)
-      continue;
-
-    scUI->CreateButton->setText(i18n("Please Wait")+".  ");
-    scUI->CreateButton->repaint();
-    QThread::msleep(200);
-    scUI->CreateButton->setText(i18n("Please Wait")+".. ");
-    scUI->CreateButton->repaint();
-    QThread::msleep(200);
-    scUI->CreateButton->setText(i18n("Please Wait")+"...");
-    scUI->CreateButton->repaint();
-    QThread::msleep(200);
-  }
-  scUI->CreateButton->setText(plotButtonText);
+    yearEvents.load(year(), geo);
+    return yearEvents;
 }
 
 // FIXME: For the time being, adjust with dirty, cluttering labels that don't align to the line
@@ -181,64 +158,17 @@ void SkyCalendar::addPlanetEvents(int nPlanet)
     QColor pColor     = ksp->color();
     QVector<QPointF> vRise, vSet, vTransit;
 
-    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
-         kdt = kdt.addDays(scUI->spinBox_Interval->value()))
-    {
-        float rTime, sTime, tTime;
-
-        //Compute rise/set/transit times.  If they occur before noon,
-        //recompute for the following day
-        QTime tmp_rTime = ksp->riseSetTime(kdt, geo, true, true);  //rise time, exact
-        QTime tmp_sTime = ksp->riseSetTime(kdt, geo, false, true); //set time, exact
-        QTime tmp_tTime = ksp->transitTime(kdt, geo);
-        QTime midday(12, 0, 0);
-
-        // NOTE: riseSetTime should be fix now, this test is no longer necessary
-        if (tmp_rTime == tmp_sTime)
-        {
-            tmp_rTime = QTime();
-            tmp_sTime = QTime();
-        }
-
-        if (tmp_rTime.isValid() && tmp_sTime.isValid())
-        {
-            rTime = tmp_rTime.secsTo(midday) * 24.0 / 86400.0;
-            sTime = tmp_sTime.secsTo(midday) * 24.0 / 86400.0;
-
-            if (tmp_rTime <= midday)
-                rTime = 12.0 - rTime;
-            else
-                rTime = -12.0 - rTime;
-
-            if (tmp_sTime <= midday)
-                sTime = 12.0 - sTime;
-            else
-                sTime = -12.0 - sTime;
-        }
-        else
-        {
-            if (ksp->transitAltitude(kdt, geo).degree() > 0)
-            {
-                rTime = -24.0;
-                sTime = 24.0;
-            }
-            else
-            {
-                rTime = 24.0;
-                sTime = -24.0;
-            }
-        }
+    const SkyCalendarEvents::Events &table = events().events(nPlanet);
 
-        tTime = tmp_tTime.secsTo(midday) * 24.0 / 86400.0;
-        if (tmp_tTime <= midday)
-            tTime = 12.0 - tTime;
-        else
-            tTime = -12.0 - tTime;
+    for (QDate date(year(), 1, 1); date.year() == year(); date = date.addDays(scUI->spinBox_Interval->value()))
+    {
+        //The tables hold the times of every night, in hours from its midnight
+        const int night = date.dayOfYear() - 1;
 
-        float dy = kdt.date().daysInYear() - kdt.date().dayOfYear();
-        vRise << QPointF(rTime, dy);
-        vSet << QPointF(sTime, dy);
-        vTransit << QPointF(tTime, dy);
+        float dy = date.daysInYear() - date.dayOfYear();
+        vRise << QPointF(table.rise.at(night), dy);
+        vSet << QPointF(table.set.at(night), dy);
+        vTransit << QPointF(table.transit.at(night), dy);
     }
 
     //Now, find continuous segments in each QVector and add each segment
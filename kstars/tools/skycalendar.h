@@ -18,8 +18,8 @@
 #pragma once
 
 #include <QDialog>
-#include <QMutex>
 
+#include "skycalendarevents.h"
 #include "ui_skycalendar.h"
 
 class GeoLocation;
@@ -54,15 +54,15 @@ class SkyCalendar : public QDialog
     void slotFillCalendar();
     void slotPrint();
     void slotLocation();
-    void slotCalculating();
 
   private:
+    /** @return the events of the year and location shown, computed if needed */
+    const SkyCalendarEvents &events();
+
     void addPlanetEvents(int nPlanet);
     void drawEventLabel(float x1, float y1, float x2, float y2, QString LabelText);
 
     SkyCalendarUI *scUI { nullptr };
     GeoLocation *geo { nullptr };
-    QMutex calculationMutex;
-    QString plotButtonText;
-    bool calculating { false };
+    SkyCalendarEvents yearEvents;
 };
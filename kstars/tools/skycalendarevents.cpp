@@ -0,0 +1,378 @@
+/*  Yearly rise, set and transit tables of the Sky Calendar
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "skycalendarevents.h"
+
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "kspaths.h"
+#include "kstarsdatetime.h"
+#include "ksutils.h"
+#include "skyobjects/ksplanet.h"
+
+#include <KLocalizedString>
+
+#include <QDate>
+#include <QDataStream>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "kstars_debug.h"
+
+namespace
+{
+/// Identifies the cache files
+const quint32 CACHE_MAGIC = 0x4B534345;
+
+/// Version of the cache files, to be increased when their format or the computation change
+const quint32 CACHE_VERSION = 2;
+
+/// Steps solving each event, the first one from the position at the start of the night
+const int ITERATIONS = 4;
+
+/// Days computed before and after the year, for the nights at its ends
+const int MARGIN_DAYS = 3;
+
+/// Altitude of the upper limb of the Sun at sunrise and sunset, with the refraction, in degrees
+const double SUN_ALTITUDE = -0.8333;
+
+/// Altitude of the planets at their rise and set, for the refraction, in degrees
+const double PLANET_ALTITUDE = -0.5667;
+
+/// Inverse of the speed of light, in days per AU
+const double LIGHT_TIME = 0.0057755183;
+
+/// The bodies of the tables
+const int BODIES[] = { KSPlanetBase::MERCURY, KSPlanetBase::VENUS,  KSPlanetBase::MARS,    KSPlanetBase::JUPITER,
+                       KSPlanetBase::SATURN,  KSPlanetBase::URANUS, KSPlanetBase::NEPTUNE, KSPlanetBase::SUN };
+
+const float NO_EVENT = std::numeric_limits<float>::quiet_NaN();
+
+enum Event
+{
+    Rise,
+    Set,
+    Transit
+};
+
+/** @short Greenwich mean sidereal time at jd, in degrees */
+double siderealTime(double jd)
+{
+    const double T = (jd - J2000) / 36525.0;
+    return 280.46061837 + dms::SiderealRate * (jd - J2000) + T * T * (0.000387933 - T / 38710000.0);
+}
+
+void toRectangular(const EclipticPosition &ep, double *xyz)
+{
+    double sinL, cosL, sinB, cosB;
+    ep.longitude.SinCos(sinL, cosL);
+    ep.latitude.SinCos(sinB, cosB);
+    xyz[0] = ep.radius * cosB * cosL;
+    xyz[1] = ep.radius * cosB * sinL;
+    xyz[2] = ep.radius * sinB;
+}
+
+/** @short The observer and the nights of the year */
+struct Site
+{
+    double longitude { 0 };
+    double sinLatitude { 0 };
+    double cosLatitude { 0 };
+    /// Julian Day of the noon starting the first night
+    double firstNight { 0 };
+    int nights { 0 };
+};
+
+/** @short A body and its events, solved in a worker thread */
+struct Track
+{
+    int body { 0 };
+    double sinAltitude { 0 };
+    /// The planet, nullptr for the Sun
+    const KSPlanet *planet { nullptr };
+    const KSPlanet *earth { nullptr };
+
+    SkyCalendarEvents::Events events;
+
+    /**
+     * @short Right ascension and declination at jd, in degrees, with the same reductions as KSPlanet and KSSun
+     * The series of the bodies are read from the EphemerisCache.
+     */
+    void position(double jd, double &ra, double &dec) const
+    {
+        const KSNumbers num(jd);
+        const double jm = num.julianMillenia();
+        EclipticPosition ep;
+        double e[3], s[3], xyz[3];
+
+        earth->calcEcliptic(jm, ep);
+        toRectangular(ep, e);
+
+        if (planet == nullptr)
+        {
+            // The Earth seen from the Sun when the light left it
+            const double delay = LIGHT_TIME * sqrt(e[0] * e[0] + e[1] * e[1] + e[2] * e[2]) / 365250.0;
+            earth->calcEcliptic(jm - delay, ep);
+            toRectangular(ep, xyz);
+            s[0] = -xyz[0];
+            s[1] = -xyz[1];
+            s[2] = -xyz[2];
+        }
+        else
+        {
+            double distance = 0, previous = -1000, delay = 0;
+            while (fabs(distance - previous) > .001)
+            {
+                planet->calcEcliptic(jm - delay, ep);
+                toRectangular(ep, xyz);
+                s[0]     = xyz[0] - e[0];
+                s[1]     = xyz[1] - e[1];
+                s[2]     = xyz[2] - e[2];
+                previous = distance;
+                distance = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+                delay    = LIGHT_TIME * distance / 365250.0;
+            }
+        }
+
+        // Ecliptic to equatorial, then precessed to the epoch like the J2000 coordinates
+        double sinEps, cosEps;
+        num.obliquity()->SinCos(sinEps, cosEps);
+        const double q[3] = { s[0], s[1] * cosEps - s[2] * sinEps, s[1] * sinEps + s[2] * cosEps };
+        double v[3];
+        for (int i = 0; i < 3; ++i)
+            v[i] = num.p2(0, i) * q[0] + num.p2(1, i) * q[1] + num.p2(2, i) * q[2];
+
+        ra  = atan2(v[1], v[0]) / dms::DegToRad;
+        dec = atan2(v[2], sqrt(v[0] * v[0] + v[1] * v[1])) / dms::DegToRad;
+    }
+
+    /** @return cos of the hour angle of the rise and set at dec, beyond [-1, 1] if the body does not cross */
+    double cosRiseHourAngle(const Site &site, double dec) const
+    {
+        const double sinDec = sin(dec * dms::DegToRad), cosDec = cos(dec * dms::DegToRad);
+        return (sinAltitude - site.sinLatitude * sinDec) / (site.cosLatitude * cosDec);
+    }
+
+    /** @return the first time of event after jd, NaN if the body stops crossing the altitude */
+    double next(const Site &site, Event event, double jd) const
+    {
+        double t = jd;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            double ra, dec;
+            position(t, ra, dec);
+
+            double target = 0;
+            if (event != Transit)
+            {
+                const double cosH0 = cosRiseHourAngle(site, dec);
+                if (fabs(cosH0) > 1.0)
+                    return std::numeric_limits<double>::quiet_NaN();
+                target = acos(cosH0) / dms::DegToRad;
+                if (event == Rise)
+                    target = -target;
+            }
+
+            // The first step goes forward to the next crossing, the others correct it for the motion of the body
+            const double H = siderealTime(t) + site.longitude - ra;
+            t += (i == 0 ? KSUtils::reduceAngle(target - H, 0.0, 360.0) : KSUtils::reduceAngle(target - H, -180.0, 180.0)) /
+                 dms::SiderealRate;
+        }
+        return t;
+    }
+
+    /** @return the time of event during the night starting at start, in hours from its midnight */
+    float time(const Site &site, Event event, double start) const
+    {
+        double t = next(site, event, start);
+
+        // Corrected to just before the night, the next crossing is about a sidereal day later
+        if (t < start)
+            t = next(site, event, t + 0.5);
+
+        if (std::isnan(t) || t >= start + 1.0)
+            return NO_EVENT;
+        return float((t - start) * 24.0 - 12.0);
+    }
+
+    void solve(const Site &site)
+    {
+        events.rise.resize(site.nights);
+        events.set.resize(site.nights);
+        events.transit.resize(site.nights);
+
+        for (int night = 0; night < site.nights; ++night)
+        {
+            const double start = site.firstNight + night;
+
+            double ra, dec;
+            position(start + 0.5, ra, dec);
+            const double cosH0 = cosRiseHourAngle(site, dec);
+
+            if (cosH0 >= 1.0)
+            {
+                // Stays below the horizon
+                events.rise[night] = 24.0;
+                events.set[night]  = -24.0;
+            }
+            else if (cosH0 <= -1.0)
+            {
+                // Stays above the horizon
+                events.rise[night] = -24.0;
+                events.set[night]  = 24.0;
+            }
+            else
+            {
+                events.rise[night] = time(site, Rise, start);
+                events.set[night]  = time(site, Set, start);
+            }
+            events.transit[night] = time(site, Transit, start);
+        }
+    }
+};
+}
+
+void SkyCalendarEvents::load(int year, const GeoLocation *geo)
+{
+    const double longitude = geo->lng()->Degrees();
+    const double latitude  = geo->lat()->Degrees();
+    const double tz        = geo->TZ();
+
+    if (!m_Events.isEmpty() && year == m_Year && longitude == m_Longitude && latitude == m_Latitude && tz == m_TZ)
+        return;
+
+    m_Year      = year;
+    m_Longitude = longitude;
+    m_Latitude  = latitude;
+    m_TZ        = tz;
+
+    const QString path = KSPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "skycalendar/" +
+                         QString("%1_%2_%3_%4.events")
+                             .arg(year)
+                             .arg(longitude, 0, 'f', 4)
+                             .arg(latitude, 0, 'f', 4)
+                             .arg(tz, 0, 'f', 2);
+    if (read(path))
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+    compute();
+    qCDebug(KSTARS) << "Sky calendar events of" << year << "computed in" << timer.elapsed() << "ms";
+
+    write(path);
+}
+
+void SkyCalendarEvents::compute()
+{
+    Site site;
+    site.longitude   = m_Longitude;
+    site.sinLatitude = sin(m_Latitude * dms::DegToRad);
+    site.cosLatitude = cos(m_Latitude * dms::DegToRad);
+    // The Julian Days of the dates are at noon UT
+    site.firstNight = QDate(m_Year, 1, 1).toJulianDay() - m_TZ / 24.0;
+    site.nights     = QDate(m_Year, 12, 31).dayOfYear();
+
+    // Private bodies, their series are loaded here so that the workers only read them
+    KSPlanet earth(I18N_NOOP("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/);
+    earth.loadData();
+
+    std::vector<std::unique_ptr<KSPlanet>> planets;
+    QVector<Track> tracks;
+    for (int body : BODIES)
+    {
+        Track track;
+        track.body  = body;
+        track.earth = &earth;
+        if (body == KSPlanetBase::SUN)
+        {
+            track.sinAltitude = sin(SUN_ALTITUDE * dms::DegToRad);
+        }
+        else
+        {
+            planets.emplace_back(new KSPlanet(body));
+            planets.back()->loadData();
+            track.planet      = planets.back().get();
+            track.sinAltitude = sin(PLANET_ALTITUDE * dms::DegToRad);
+        }
+        tracks.append(track);
+    }
+
+    // The Earth is needed by all bodies, it fills its segments of the EphemerisCache before the workers start
+    const double firstJD = site.firstNight - MARGIN_DAYS;
+    for (int day = 0; day <= site.nights + 2 * MARGIN_DAYS; ++day)
+    {
+        EclipticPosition ep;
+        earth.calcEcliptic((firstJD + day - J2000) / 365250.0, ep);
+    }
+
+    QtConcurrent::blockingMap(tracks, [&](Track &track) { track.solve(site); });
+
+    m_Events.clear();
+    m_Events.resize(KSPlanetBase::SUN + 1);
+    for (const Track &track : tracks)
+        m_Events[track.body] = track.events;
+}
+
+bool SkyCalendarEvents::read(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0;
+    qint32 year      = 0;
+    double longitude = 0, latitude = 0, tz = 0;
+    in >> magic >> version >> year >> longitude >> latitude >> tz;
+    if (in.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != CACHE_VERSION || year != m_Year ||
+        longitude != m_Longitude || latitude != m_Latitude || tz != m_TZ)
+        return false;
+
+    QVector<Events> events(KSPlanetBase::SUN + 1);
+    for (int body : BODIES)
+        in >> events[body].rise >> events[body].set >> events[body].transit;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    m_Events = events;
+    return true;
+}
+
+void SkyCalendarEvents::write(const QString &path) const
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(KSTARS) << "Unable to write sky calendar events" << path;
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << CACHE_MAGIC << CACHE_VERSION << qint32(m_Year) << m_Longitude << m_Latitude << m_TZ;
+    for (int body : BODIES)
+        out << m_Events.at(body).rise << m_Events.at(body).set << m_Events.at(body).transit;
+
+    if (!file.commit())
+        qCWarning(KSTARS) << "Unable to write sky calendar events" << path;
+}
@@ -0,0 +1,67 @@
+/*  Yearly rise, set and transit tables of the Sky Calendar
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+class GeoLocation;
+
+/**
+ * @class SkyCalendarEvents
+ * @short The rise, set and transit times of the Sun and the planets on every night of a year
+ *
+ * The events of each body are solved from its hour angle in a task of the global thread
+ * pool, its positions being computed at every step from the EphemerisCache.  The tables are saved in the cache directory, so
+ * drawing the calendar again for the same year and location only reads them back.
+ */
+class SkyCalendarEvents
+{
+  public:
+    /**
+     * The local times of the events of a body, in hours from the midnight in the middle of
+     * each night.  Night i runs from noon of day i + 1 of the year to noon of the next day,
+     * so the times are within [-12, 12[.  When the body neither rises nor sets, its rise and
+     * set times are -24 and 24 if it stays up, 24 and -24 if it stays down.  An event which
+     * does not happen during a night is NaN.
+     */
+    struct Events
+    {
+        QVector<float> rise;
+        QVector<float> set;
+        QVector<float> transit;
+    };
+
+    /**
+     * @short Fill the tables of year at geo, unless they are already loaded
+     * The tables are read from the cache directory, or computed and saved there.
+     * @note The time zone offset of geo at the time of the call is used for the whole year.
+     */
+    void load(int year, const GeoLocation *geo);
+
+    /** @return the events of body, from KSPlanetBase::MERCURY to KSPlanetBase::SUN, Pluto excluded */
+    const Events &events(int body) const { return m_Events.at(body); }
+
+  private:
+    /** @short Solve the events of all bodies */
+    void compute();
+
+    /** @return true if the tables of the current key were read from path */
+    bool read(const QString &path);
+    void write(const QString &path) const;
+
+    int m_Year { 0 };
+    double m_Longitude { 0 };
+    double m_Latitude { 0 };
+    double m_TZ { 0 };
+
+    QVector<Events> m_Events;
+};
@@ -24,6 +24,121 @@
 
 #include <kstars_debug.h>
 
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace
+{
+/// Largest ratio between the distance to the destination of an expanded node and the one of the source
+const double MAX_DETOUR = 1.2;
+
+/// Offset making the cell coordinates of the neighbour index positive
+const qint64 CELL_OFFSET = 1 << 20;
+
+void toVector(const SkyPoint &p, double v[3])
+{
+    double sinRA, cosRA, sinDec, cosDec;
+    p.ra().SinCos(sinRA, cosRA);
+    p.dec().SinCos(sinDec, cosDec);
+    v[0] = cosDec * cosRA;
+    v[1] = cosDec * sinRA;
+    v[2] = sinDec;
+}
+}
+
+/**
+ * @short The stars around a star hop, bucketed in a grid of cubic cells over their unit vectors
+ *
+ * Built once per hop from the trixels around the destination, so that finding the
+ * neighbours of a node does not go through the star components again.  The cells are
+ * as wide as the chord of the field of view, so the stars within a field of view of
+ * a node are all in the 27 cells around it.  Node 0 is the source of the hop.
+ */
+class StarHopper::NeighbourIndex
+{
+  public:
+    NeighbourIndex(const SkyPoint &src, const QList<StarObject *> &stars, float maglim, double fov)
+    {
+        m_CellSize = 2 * sin(0.5 * fov * dms::DegToRad);
+
+        m_Stars.reserve(stars.size() + 1);
+        m_Vectors.reserve(3 * (stars.size() + 1));
+        add(src, nullptr);
+        for (StarObject *star : stars)
+        {
+            if (star->mag() <= maglim)
+                add(*star, star);
+        }
+    }
+
+    int size() const { return m_Stars.size(); }
+
+    /** @return the star of node, nullptr for the source */
+    const StarObject *star(int node) const { return m_Stars[node]; }
+
+    /** @return the angular distance in degrees between node and the unit vector v */
+    double distance(int node, const double v[3]) const
+    {
+        const double *u = m_Vectors.constData() + 3 * node;
+        return acos(qBound(-1.0, u[0] * v[0] + u[1] * v[1] + u[2] * v[2], 1.0)) / dms::DegToRad;
+    }
+
+    double distance(int a, int b) const { return distance(a, m_Vectors.constData() + 3 * b); }
+
+    /** @return the star nodes within radius degrees of node, not fainter than maglim. radius is at most the field of view. */
+    QVector<int> within(int node, double radius, float maglim) const
+    {
+        QVector<int> result;
+        const double *u      = m_Vectors.constData() + 3 * node;
+        const double minCos  = cos(radius * dms::DegToRad);
+        const qint64 cell[3] = { coordinate(u[0]), coordinate(u[1]), coordinate(u[2]) };
+
+        for (qint64 x = cell[0] - 1; x <= cell[0] + 1; ++x)
+            for (qint64 y = cell[1] - 1; y <= cell[1] + 1; ++y)
+                for (qint64 z = cell[2] - 1; z <= cell[2] + 1; ++z)
+                {
+                    auto bucket = m_Cells.constFind(key(x, y, z));
+                    if (bucket == m_Cells.constEnd())
+                        continue;
+                    for (int other : *bucket)
+                    {
+                        if (other == 0 || m_Stars[other]->mag() > maglim)
+                            continue;
+                        const double *v = m_Vectors.constData() + 3 * other;
+                        if (u[0] * v[0] + u[1] * v[1] + u[2] * v[2] >= minCos)
+                            result.append(other);
+                    }
+                }
+        return result;
+    }
+
+  private:
+    void add(const SkyPoint &p, const StarObject *star)
+    {
+        double v[3];
+        toVector(p, v);
+        m_Cells[key(coordinate(v[0]), coordinate(v[1]), coordinate(v[2]))].append(m_Stars.size());
+        m_Stars.append(star);
+        m_Vectors.append(v[0]);
+        m_Vectors.append(v[1]);
+        m_Vectors.append(v[2]);
+    }
+
+    qint64 coordinate(double x) const { return static_cast<qint64>(std::floor(x / m_CellSize)); }
+
+    static quint64 key(qint64 x, qint64 y, qint64 z)
+    {
+        return (quint64(x + CELL_OFFSET) << 42) | (quint64(y + CELL_OFFSET) << 21) | quint64(z + CELL_OFFSET);
+    }
+
+    QVector<const StarObject *> m_Stars;
+    QVector<double> m_Vectors;
+    QHash<quint64, QVector<int>> m_Cells;
+    double m_CellSize { 1 };
+};
+
 QList<StarObject *> *StarHopper::computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
                                              QStringList *metadata_)
 {
@@ -44,48 +159,63 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
     start  = &src;
     end    = &dest;
 
-    came_from.clear();
     result_path.clear();
 
-    // Implements the A* search algorithm
-
-    QList<SkyPoint const *> cSet;
-    QList<SkyPoint const *> oSet;
-    QHash<SkyPoint const *, double> g_score;
-    QHash<SkyPoint const *, double> f_score;
-    QHash<SkyPoint const *, double> h_score;
-
     qCDebug(KSTARS) << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString()
              << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString()
              << "; a starhop of " << src.angularDistanceTo(&dest).Degrees() << " degrees!";
 
-    oSet.append(&src);
-    g_score[&src] = 0;
-    h_score[&src] = src.angularDistanceTo(&dest).Degrees() / fov;
-    f_score[&src] = h_score[&src];
+    // Gather the stars once from the trixels around the destination. The nodes expanded by the
+    // search are at most MAX_DETOUR times as far from it as the source, their neighbours one field
+    // of view further, and the stars used by the cost function one more field of view away.
+    // The stars one magnitude fainter than the limit are only used by the cost function.
+    // starsInAperture() needs the J2000 coordinates of the center, which dest may not have.
+    SkyPoint target = dest;
+    const SkyPoint j2000 = target.deprecess(KStarsData::Instance()->updateNum());
+    SkyPoint center(dest.ra(), dest.dec());
+    center.setRA0(j2000.ra());
+    center.setDec0(j2000.dec());
+
+    const double radius = MAX_DETOUR * src.angularDistanceTo(&dest).Degrees() + 2 * fov;
+    QList<StarObject *> stars;
+    StarComponent::Instance()->starsInAperture(stars, center, radius, maglim + 1.0);
+
+    const NeighbourIndex nodes(src, stars, maglim + 1.0, fov);
+    index = &nodes;
+    const int count = nodes.size();
+    qCDebug(KSTARS) << "Searching a path through" << count << "stars";
 
-    while (!oSet.isEmpty())
+    // Implements the A* search algorithm, over the nodes of the index
+
+    double destVector[3];
+    toVector(dest, destVector);
+
+    QVector<double> g_score(count, std::numeric_limits<double>::infinity());
+    QVector<double> h_score(count);
+    QVector<bool> cSet(count, false);
+    for (int i = 0; i < count; ++i)
+        h_score[i] = nodes.distance(i, destVector) / fov;
+
+    came_from.fill(-1, count);
+    node_cost.fill(std::numeric_limits<float>::quiet_NaN(), count);
+
+    // Open set ordered by f_score, a node is pushed again when its score improves and its stale entries are skipped
+    typedef QPair<double, int> OpenNode;
+    std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> oSet;
+
+    g_score[0] = 0;
+    oSet.push(OpenNode(h_score[0], 0));
+
+    while (!oSet.empty())
     {
-        qCDebug(KSTARS) << "Next step";
-        // Find the node with the lowest f_score value
-        SkyPoint const *curr_node = nullptr;
-        double lowfscore          = 1.0e8;
+        const OpenNode lowest = oSet.top();
+        oSet.pop();
 
-        foreach (const SkyPoint *sp, oSet)
-        {
-            if (f_score[sp] < lowfscore)
-            {
-                lowfscore = f_score[sp];
-                curr_node = sp;
-            }
-        }
-        if (curr_node == nullptr)
+        const int curr_node = lowest.second;
+        if (cSet[curr_node] || lowest.first > g_score[curr_node] + h_score[curr_node])
             continue;
 
-        qCDebug(KSTARS) << "Lowest fscore (vertex distance-plus-cost score) is " << lowfscore
-                 << " with coords: " << curr_node->ra().toHMSString() << curr_node->dec().toDMSString()
-                 << ". Considering this node now.";
-        if (curr_node == &dest || (curr_node != &src && h_score[curr_node] < 0.5))
+        if (curr_node != 0 && h_score[curr_node] < 0.5)
         {
             // We are at destination
             reconstructPath(came_from[curr_node]);
@@ -129,104 +259,73 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
             }
             qCDebug(KSTARS) << "  The destination is within a field-of-view";
 
+            index = nullptr;
             return result_path;
         }
 
-        oSet.removeOne(curr_node);
-        cSet.append(curr_node);
+        cSet[curr_node] = true;
 
         // FIXME: Make sense. If current node ---> dest distance is
         // larger than src --> dest distance by more than 20%, don't
         // even bother considering it.
 
-        if (h_score[curr_node] > h_score[&src] * 1.2)
-        {
-            qCDebug(KSTARS) << "Node under consideration has larger distance to destination (h-score) than start node! "
-                        "Ignoring it.";
+        if (h_score[curr_node] > h_score[0] * MAX_DETOUR)
             continue;
-        }
 
         // Get the list of stars that are neighbours of this node
-        QList<StarObject *> neighbors;
-
-        // FIXME: Actually, this should be done in
-        // HorizontalToEquatorial, but we do it here because SkyPoint
-        // needs a lot of fixing to handle unprecessed and precessed,
-        // equatorial and horizontal coordinates nicely
-        SkyPoint *CurrentNode = const_cast<SkyPoint *>(curr_node);
-        CurrentNode->deprecess(KStarsData::Instance()->updateNum());
-        //qCDebug(KSTARS) << "Calling starsInAperture";
-        StarComponent::Instance()->starsInAperture(neighbors, *curr_node, fov, maglim);
-        qCDebug(KSTARS) << "Choosing next node from a set of " << neighbors.count();
+        const QVector<int> neighbors = nodes.within(curr_node, fov, maglim);
+
         // Look for the potential next node
-        double curr_g_score = g_score[curr_node];
+        const double curr_g_score = g_score[curr_node];
 
-        for (auto &nhd_node : neighbors)
+        for (int nhd_node : neighbors)
         {
-            if (cSet.contains(nhd_node))
+            if (cSet[nhd_node])
                 continue;
 
             // Compute the tentative g_score
-            double tentative_g_score = curr_g_score + cost(curr_node, nhd_node);
-            bool tentative_better;
-            if (!oSet.contains(nhd_node))
-            {
-                oSet.append(nhd_node);
-                tentative_better = true;
-            }
-            else if (tentative_g_score < g_score[nhd_node])
-                tentative_better = true;
-            else
-                tentative_better = false;
-
-            if (tentative_better)
+            const double tentative_g_score = curr_g_score + cost(curr_node, nhd_node);
+            if (tentative_g_score < g_score[nhd_node])
             {
                 came_from[nhd_node] = curr_node;
                 g_score[nhd_node]   = tentative_g_score;
-                h_score[nhd_node]   = nhd_node->angularDistanceTo(&dest).Degrees() / fov;
-                f_score[nhd_node]   = g_score[nhd_node] + h_score[nhd_node];
+                oSet.push(OpenNode(tentative_g_score + h_score[nhd_node], nhd_node));
             }
         }
     }
+    index = nullptr;
     qCDebug(KSTARS) << "REGRET! Returning empty list!";
     return QList<StarObject const *>(); // Return an empty QList
 }
 
-void StarHopper::reconstructPath(SkyPoint const *curr_node)
+void StarHopper::reconstructPath(int curr_node)
 {
-    if (curr_node != start)
-    {
-        StarObject const *s = dynamic_cast<StarObject const *>(curr_node);
-        Q_ASSERT(s);
-        result_path.prepend(s);
-        reconstructPath(came_from[s]);
-    }
+    for (int node = curr_node; node > 0; node = came_from[node])
+        result_path.prepend(index->star(node));
 }
 
-float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
+float StarHopper::cost(int curr, int next)
 {
     // This is a very heuristic method, that tries to produce a cost
     // for each hop.
 
-    float netcost = 0;
-
-    // Convert 'next' into a StarObject
-    if (next == start)
-    {
-        // If the next hop is back to square one, junk it
-        return 1e8;
-    }
-    bool isThisTheEnd = (next == end);
+    // Test 4: How far is the hop?
+    double distcost =
+        (index->distance(curr, next) /
+         fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
 
-    float magcost, speccost;
-    magcost = speccost = 0;
+    // Test 5: How effective is the hop? [Might not be required with A*]
+    //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
 
-    if (!isThisTheEnd)
+    // The other tests only depend on the next star
+    if (std::isnan(node_cost[next]))
     {
         // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
+        StarObject const *nextstar = index->star(next);
         Q_ASSERT(nextstar);
 
+        float magcost, speccost;
+
         // Test 1: How bright is the star?
         magcost =
             nextstar->mag() - 7.0 +
@@ -255,47 +354,29 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
         else
         dircost = sqrt( 1 - cosC * cosC ) / cosC; // tan( C )
         */
-    }
 
-    // Test 4: How far is the hop?
-    double distcost =
-        (curr->angularDistanceTo(next).Degrees() /
-         fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
-
-    // Test 5: How effective is the hop? [Might not be required with A*]
-    //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
-
-    // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
-    QList<StarObject *> localNeighbors;
-    StarComponent::Instance()->starsInAperture(localNeighbors, *next, fov / 10, maglim + 1.0);
-    double stardensitycost = 1 - localNeighbors.count(); // -1 "magnitude" for every neighbouring star
+        // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
+        double stardensitycost =
+            1 - index->within(next, fov / 10, maglim + 1.0).count(); // -1 "magnitude" for every neighbouring star
 
 // Test 7: Identify star patterns
 
 #define RIGHT_ANGLE_THRESHOLD 0.05
 #define EQUAL_EDGE_THRESHOLD  0.025
 
-    double patterncost = 0;
-    QString patternName;
-    if (!isThisTheEnd)
-    {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT(nextstar);
+        double patterncost = 0;
+        QString patternName;
+        QVector<int> localNeighbors;
 
         float factor = 1.0;
         while (factor <= 10.0)
         {
             localNeighbors.clear();
-            StarComponent::Instance()->starsInAperture(
-                localNeighbors, *next, fov / factor,
-                nextstar->mag() + 1.0); // Use a larger aperture for pattern identification; max 1.0 mag difference
-            foreach (StarObject *star, localNeighbors)
+            // Use a larger aperture for pattern identification; max 1.0 mag difference
+            for (int node : index->within(next, fov / factor, nextstar->mag() + 1.0))
             {
-                if (star == nextstar)
-                    localNeighbors.removeOne(star);
-                else if (fabs(star->mag() - nextstar->mag()) > 1.0)
-                    localNeighbors.removeOne(star);
+                if (node != next && fabs(index->star(node)->mag() - nextstar->mag()) <= 1.0)
+                    localNeighbors.append(node);
             } // Now, we should have a pruned list
             factor += 1.0;
             if (localNeighbors.size() == 2)
@@ -306,15 +387,15 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
         {
             patternName = i18n("triangle (of similar magnitudes)"); // any three stars form a triangle!
             // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
-            StarObject *star1 = localNeighbors[0];
-            double dRA1       = nextstar->ra().radians() - star1->ra().radians();
-            double dDec1      = nextstar->dec().radians() - star1->dec().radians();
-            double dist1sqr   = dRA1 * dRA1 + dDec1 * dDec1;
+            StarObject const *star1 = index->star(localNeighbors[0]);
+            double dRA1             = nextstar->ra().radians() - star1->ra().radians();
+            double dDec1            = nextstar->dec().radians() - star1->dec().radians();
+            double dist1sqr         = dRA1 * dRA1 + dDec1 * dDec1;
 
-            StarObject *star2 = localNeighbors[1];
-            double dRA2       = nextstar->ra().radians() - star2->ra().radians();
-            double dDec2      = nextstar->dec().radians() - star2->dec().radians();
-            double dist2sqr   = dRA2 * dRA2 + dDec2 * dDec2;
+            StarObject const *star2 = index->star(localNeighbors[1]);
+            double dRA2             = nextstar->ra().radians() - star2->ra().radians();
+            double dDec2            = nextstar->dec().radians() - star2->dec().radians();
+            double dist2sqr         = dRA2 * dRA2 + dDec2 * dDec2;
 
             // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
             if (fabs((dRA1 * dRA2 - dDec1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
@@ -335,7 +416,7 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
                     patternName = i18n("straight line of 3 stars");
                 }
                 // Check for equilateral triangles
-                double dist3    = star1->angularDistanceTo(star2).radians();
+                double dist3    = index->distance(localNeighbors[0], localNeighbors[1]) * dms::DegToRad;
                 double dist3sqr = dist3 * dist3;
                 if (fabs((dist3sqr - dist1sqr) / dist1sqr) < EQUAL_EDGE_THRESHOLD)
                 {
@@ -350,13 +431,14 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
             patternName += i18n(" within %1% of FOV of the marked star", (int)(100.0 / factor));
             patternNames.insert(nextstar, patternName);
         }
+
+        node_cost[next] = magcost + speccost + stardensitycost + patterncost;
+        qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Density cost: " << stardensitycost
+                 << "; Pattern cost: " << patterncost << "; Pattern: " << patternName;
     }
 
-    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
+    float netcost = node_cost[next] + distcost;
     if (netcost < 0)
         netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
-    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost
-             << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost
-             << "; Pattern: " << patternName;
     return netcost;
 }
@@ -19,6 +19,7 @@
 
 #include <QHash>
 #include <QList>
+#include <QVector>
 
 class QStringList;
 
@@ -54,21 +55,21 @@ class StarHopper
                                                 QStringList *metadata = nullptr);
 
   private:
+    class NeighbourIndex;
+
     /**
      * @short The cost function for hopping from current position to the a given star, in view of the final destination
-     * @param curr Source SkyPoint
-     * @param next Next point in the hop.
-     * @note If 'next' is neither the starting point of the hop, nor
-     * the ending point, it _has_ to be a StarObject. A dynamic cast
-     * followed by a Q_ASSERT will ensure this.
+     * @param curr Source node
+     * @param next Next node in the hop, which is always a star
+     * @note The part of the cost depending only on the star is computed once per star and kept in node_cost
      */
-    float cost(const SkyPoint *curr, const SkyPoint *next);
+    float cost(int curr, int next);
 
     /**
      * @short For internal use by the A* Search Algorithm. Completes
      * the star-hop path. See http://en.wikipedia.org/wiki/A*_search_algorithm for details
      */
-    void reconstructPath(SkyPoint const *curr_node);
+    void reconstructPath(int curr_node);
 
     float fov { 0 };
     float maglim { 0 };
@@ -76,7 +77,9 @@ class StarHopper
     // Useful for internal computations
     SkyPoint const *start { nullptr };
     SkyPoint const *end { nullptr };
-    QHash<const SkyPoint *, const SkyPoint *> came_from; // Used by the A* search algorithm
+    const NeighbourIndex *index { nullptr }; // Stars around the hop, only valid during computePath_const()
+    QVector<int> came_from;                  // Used by the A* search algorithm
+    QVector<float> node_cost;                // Cost of hopping to each star regardless of where from, NaN if not computed yet
     QList<StarObject const *> result_path;
     QHash<SkyPoint const *, QString> patternNames; // if patterns were identified, they are added to this hash.
 };
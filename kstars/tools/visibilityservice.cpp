@@ -0,0 +1,247 @@
+/*  Rise, transit and set of many objects during a night
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "visibilityservice.h"
+
+#include "geolocation.h"
+#include "ksutils.h"
+#include "kstarsdatetime.h"
+#include "skyobjects/risesetsolver.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+namespace
+{
+/// Number of intervals kept, all are dropped together beyond
+const int MAX_INTERVALS = 16;
+
+/// Number of positions of the solar system objects kept, all are dropped together beyond
+const int MAX_POSITIONS = 1 << 18;
+
+const double MINUTES_PER_DAY = 1440.0;
+
+/** @return the key of a location in the caches */
+QString locationKey(const GeoLocation *geo)
+{
+    return QString("%1 %2").arg(geo->lng()->Degrees(), 0, 'f', 6).arg(geo->lat()->Degrees(), 0, 'f', 6);
+}
+
+/** @return the key of an interval at a location in the cache */
+QString intervalKey(const GeoLocation *geo, double startJD, double endJD)
+{
+    return QString("%1 %2 %3").arg(locationKey(geo)).arg(startJD, 0, 'f', 6).arg(endJD, 0, 'f', 6);
+}
+}
+
+VisibilityService *VisibilityService::Instance()
+{
+    static VisibilityService service;
+    return &service;
+}
+
+QVector<VisibilityService::Visibility> VisibilityService::visibility(const QVector<const SkyObject *> &objects,
+                                                                     const GeoLocation *geo, double startJD,
+                                                                     double endJD)
+{
+    return solve(prepare(objects, geo, startJD, endJD));
+}
+
+QFuture<QVector<VisibilityService::Visibility>> VisibilityService::visibilityAsync(
+    const QVector<const SkyObject *> &objects, const GeoLocation *geo, double startJD, double endJD)
+{
+    const Request request = prepare(objects, geo, startJD, endJD);
+    return QtConcurrent::run([this, request]() { return solve(request); });
+}
+
+VisibilityService::Request VisibilityService::prepare(const QVector<const SkyObject *> &objects,
+                                                      const GeoLocation *geo, double startJD, double endJD)
+{
+    Request request(geo);
+    request.key     = startJD != endJD ? intervalKey(geo, startJD, endJD) : QString();
+    request.startJD = startJD;
+    request.endJD   = endJD;
+    request.objects = objects;
+    request.result.resize(objects.size());
+    geo->lat()->SinCos(request.sinLat, request.cosLat);
+
+    {
+        QReadLocker locker(&m_Lock);
+        request.generation = m_Generation;
+        const QHash<const SkyObject *, Visibility> cached = m_Intervals.value(request.key);
+        for (int i = 0; i < objects.size(); ++i)
+        {
+            auto visibility = cached.constFind(objects.at(i));
+            if (visibility != cached.constEnd())
+                request.result[i] = *visibility;
+            else
+                request.missing.append(i);
+        }
+    }
+
+    // The solar system objects are moved on clones, so they are solved here; the others are added to the solver
+    for (int index : request.missing)
+    {
+        const SkyObject *o = objects.at(index);
+        if (o->isSolarSystem())
+        {
+            request.result[index] = solveMoving(o, geo, request);
+        }
+        else
+        {
+            request.fixed.append(index);
+            request.solver.add(o);
+            request.declinations.append(o->dec().Degrees());
+        }
+    }
+    return request;
+}
+
+VisibilityService::Visibility VisibilityService::solveMoving(const SkyObject *object, const GeoLocation *geo,
+                                                             const Request &request)
+{
+    const QString location = locationKey(geo);
+    auto motion = [&](double jd, double &ra, double &dec)
+    {
+        const Position p = position(object, geo, location, jd);
+        ra               = p.ra;
+        dec              = p.dec;
+    };
+
+    const RiseSetSolver::Events events = request.solver.solve(motion, object->elevationCorrection().Degrees(),
+                                                              0.5 * (request.startJD + request.endJD));
+
+    // The last iteration of the transit cached this position
+    double ra, dec;
+    motion(events.transit, ra, dec);
+    return toVisibility(events, dec, request);
+}
+
+VisibilityService::Position VisibilityService::position(const SkyObject *object, const GeoLocation *geo,
+                                                        const QString &location, double jd)
+{
+    const qint64 minute = qRound64(jd * MINUTES_PER_DAY);
+    {
+        QReadLocker locker(&m_Lock);
+        const QHash<qint64, Position> positions = m_Positions.value(location).value(object);
+        auto cached = positions.constFind(minute);
+        if (cached != positions.constEnd())
+            return *cached;
+    }
+
+    const SkyPoint p = object->recomputeCoords(KStarsDateTime(minute / MINUTES_PER_DAY), geo);
+    Position result;
+    result.ra  = p.ra().Degrees();
+    result.dec = p.dec().Degrees();
+
+    QWriteLocker locker(&m_Lock);
+    if (m_PositionCount >= MAX_POSITIONS)
+    {
+        m_Positions.clear();
+        m_PositionCount = 0;
+    }
+    m_Positions[location][object].insert(minute, result);
+    ++m_PositionCount;
+    return result;
+}
+
+QVector<VisibilityService::Visibility> VisibilityService::solve(const Request &request)
+{
+    QVector<Visibility> result = request.result;
+    if (request.missing.isEmpty())
+        return result;
+
+    QVector<RiseSetSolver::Events> events;
+    request.solver.solve(0.5 * (request.startJD + request.endJD), events);
+
+    for (int j = 0; j < request.fixed.size(); ++j)
+        result[request.fixed.at(j)] = toVisibility(events.at(j), request.declinations.at(j), request);
+
+    // Objects forgotten meanwhile must not be cached again
+    QWriteLocker locker(&m_Lock);
+    if (request.key.isEmpty() || request.generation != m_Generation)
+        return result;
+
+    if (!m_Intervals.contains(request.key) && m_Intervals.size() >= MAX_INTERVALS)
+        m_Intervals.clear();
+    QHash<const SkyObject *, Visibility> &cached = m_Intervals[request.key];
+    for (int index : request.missing)
+        cached.insert(request.objects.at(index), result.at(index));
+
+    return result;
+}
+
+VisibilityService::Visibility VisibilityService::toVisibility(const RiseSetSolver::Events &events, double dec,
+                                                              const Request &request)
+{
+    Visibility visibility;
+    visibility.transit     = events.transit;
+    visibility.rise        = std::isnan(events.rise) ? 0 : events.rise;
+    visibility.set         = std::isnan(events.set) ? 0 : events.set;
+    visibility.circumpolar = events.circumpolar;
+    visibility.neverRises  = events.neverRises;
+    visibility.maxAltitude =
+        maxAltitude(events, dec, request.sinLat, request.cosLat, request.startJD, request.endJD);
+    return visibility;
+}
+
+VisibilityService::Visibility VisibilityService::visibility(const SkyObject *object, const GeoLocation *geo,
+                                                            double startJD, double endJD)
+{
+    return visibility(QVector<const SkyObject *>() << object, geo, startJD, endJD).first();
+}
+
+void VisibilityService::clear()
+{
+    QWriteLocker locker(&m_Lock);
+    m_Intervals.clear();
+    m_Positions.clear();
+    m_PositionCount = 0;
+    ++m_Generation;
+}
+
+void VisibilityService::forget(const QList<SkyObject *> &objects)
+{
+    QWriteLocker locker(&m_Lock);
+    for (auto &cached : m_Intervals)
+    {
+        for (const SkyObject *object : objects)
+            cached.remove(object);
+    }
+    for (auto &positions : m_Positions)
+    {
+        for (const SkyObject *object : objects)
+            m_PositionCount -= positions.take(object).size();
+    }
+    ++m_Generation;
+}
+
+quint64 VisibilityService::generation()
+{
+    QReadLocker locker(&m_Lock);
+    return m_Generation;
+}
+
+double VisibilityService::maxAltitude(const RiseSetSolver::Events &events, double dec, double sinLat, double cosLat,
+                                      double startJD, double endJD)
+{
+    if (events.transit >= startJD && events.transit <= endJD)
+        return events.transitAltitude;
+
+    // Otherwise the altitude is highest at the end of the interval closest to the transit
+    const double start   = KSUtils::reduceAngle((startJD - events.transit) * dms::SiderealRate, -180.0, 180.0);
+    const double end     = KSUtils::reduceAngle((endJD - events.transit) * dms::SiderealRate, -180.0, 180.0);
+    const double closest = qMin(fabs(start), fabs(end));
+
+    const double sinAlt = sinLat * sin(dec * dms::DegToRad) + cosLat * cos(dec * dms::DegToRad) * cos(closest * dms::DegToRad);
+    return asin(qBound(-1.0, sinAlt, 1.0)) / dms::DegToRad;
+}
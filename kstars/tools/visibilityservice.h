@@ -0,0 +1,149 @@
+/*  Rise, transit and set of many objects during a night
+
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "skyobjects/risesetsolver.h"
+
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+class GeoLocation;
+class SkyObject;
+
+/**
+ * @class VisibilityService
+ * @short Computes when objects rise, transit and set around a night, whole categories at once.
+ *
+ * What's up Tonight and What's Interesting ask for the visibility of every object of a
+ * category.  Their rise, transit and set times are solved by a RiseSetSolver, with their
+ * highest altitude during the interval.  The fixed objects are solved in parallel from their
+ * current position.  The events of the solar system objects are iterated on the calling
+ * thread from their positions at each estimate, which are cached by the minute, as the
+ * iterations of the following nights and categories mostly ask for the same ones.
+ *
+ * The results are cached by object, interval and location, so that switching between the
+ * categories or changing the magnitude limit does not compute them again.  An instant is not
+ * cached, as the callers ask for a new one each time.  The sky components call forget() before
+ * deleting objects, so that a new object at the same address does not get their results.
+ */
+class VisibilityService
+{
+  public:
+    struct Visibility
+    {
+        /// Rise, transit and set closest to the interval, in Julian Days (UT); rise and set are 0 if the object does not cross the horizon
+        double rise { 0 };
+        double transit { 0 };
+        double set { 0 };
+        /// Highest altitude reached during the interval, in degrees
+        double maxAltitude { -90 };
+        /// The object stays above the horizon all day
+        bool circumpolar { false };
+        /// The object stays below the horizon all day
+        bool neverRises { false };
+
+        /** @return true if the object gets higher than altitude in degrees during the interval */
+        bool isAbove(double altitude) const { return !neverRises && maxAltitude > altitude; }
+    };
+
+    static VisibilityService *Instance();
+
+    /**
+     * @short Compute the visibility of objects between startJD and endJD (UT), which may be the same instant
+     * The objects are only read from the calling thread.
+     * @return one result per object, in the same order
+     */
+    QVector<Visibility> visibility(const QVector<const SkyObject *> &objects, const GeoLocation *geo, double startJD,
+                                   double endJD);
+
+    /**
+     * @short Like visibility(), but solves the objects in the thread pool
+     * The positions are read before returning, so the objects are still only read from the calling
+     * thread.  The objects may be forgotten meanwhile, see generation().
+     * @return a future of one result per object, in the same order
+     */
+    QFuture<QVector<Visibility>> visibilityAsync(const QVector<const SkyObject *> &objects, const GeoLocation *geo,
+                                                 double startJD, double endJD);
+
+    /** @short Convenience overload for a single object */
+    Visibility visibility(const SkyObject *object, const GeoLocation *geo, double startJD, double endJD);
+
+    /** @short Forget all results, e.g. when the objects are reloaded */
+    void clear();
+
+    /** @short Forget the results of objects, to be called before they are deleted */
+    void forget(const QList<SkyObject *> &objects);
+
+    /** @return a number changed by clear() and forget(), the objects read before may be deleted if it differs */
+    quint64 generation();
+
+  private:
+    /** @short The positions of the objects missing from the cache, read on the calling thread */
+    struct Request
+    {
+        explicit Request(const GeoLocation *geo) : solver(geo) {}
+
+        /// Key of the interval in the cache, empty for an instant
+        QString key;
+        double startJD { 0 };
+        double endJD { 0 };
+        double sinLat { 0 };
+        double cosLat { 1 };
+        quint64 generation { 0 };
+        QVector<const SkyObject *> objects;
+        /// The results, those of the objects in missing are solved, the moving ones already
+        QVector<Visibility> result;
+        QVector<int> missing;
+        /// The objects added to the solver, and their declinations
+        QVector<int> fixed;
+        QVector<double> declinations;
+        RiseSetSolver solver;
+    };
+
+    /** @short The apparent position of a moving object, in degrees */
+    struct Position
+    {
+        double ra { 0 };
+        double dec { 0 };
+    };
+
+    VisibilityService() = default;
+
+    /** @short Look up the cache and read the positions of the other objects, on the calling thread */
+    Request prepare(const QVector<const SkyObject *> &objects, const GeoLocation *geo, double startJD, double endJD);
+
+    /** @short Solve the missing objects of request and cache them, on any thread */
+    QVector<Visibility> solve(const Request &request);
+
+    /** @short Iterate the events of a solar system object during the interval of request, on the calling thread */
+    Visibility solveMoving(const SkyObject *object, const GeoLocation *geo, const Request &request);
+
+    /** @return the position of a solar system object at the minute closest to jd, from the cache if possible */
+    Position position(const SkyObject *object, const GeoLocation *geo, const QString &location, double jd);
+
+    /** @return the visibility of events during the interval of request, for an object at declination dec */
+    static Visibility toVisibility(const RiseSetSolver::Events &events, double dec, const Request &request);
+
+    /** @return the highest altitude between startJD and endJD of an object at declination dec, in degrees */
+    static double maxAltitude(const RiseSetSolver::Events &events, double dec, double sinLat, double cosLat,
+                              double startJD, double endJD);
+
+    QHash<QString, QHash<const SkyObject *, Visibility>> m_Intervals;
+    /// Positions of the solar system objects by location, object and minute
+    QHash<QString, QHash<const SkyObject *, QHash<qint64, Position>>> m_Positions;
+    int m_PositionCount { 0 };
+    quint64 m_Generation { 0 };
+    QReadWriteLock m_Lock;
+};
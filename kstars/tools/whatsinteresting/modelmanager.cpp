@@ -17,6 +17,7 @@
 
 #include "modelmanager.h"
 
+#include "deepskyobject.h"
 #include "ksfilereader.h"
 #include "kstars.h"
 #include "kstarsdata.h"
@@ -25,9 +26,42 @@
 #include "skyobjitem.h"
 #include "skyobjlistmodel.h"
 #include "starobject.h"
+#include "tools/visibilityservice.h"
 
 #include <QtConcurrent>
 
+namespace
+{
+/// An object is considered visible if it is higher than this altitude, in degrees
+const double MIN_ALTITUDE = 6.0;
+
+/**
+ * @return the deep sky objects named, or also named, "<catalog> <number>", sorted by number
+ * One pass over the deep sky objects, instead of looking every number up by name.
+ */
+QList<SkyObject *> catalogObjects(const QString &catalog)
+{
+    const QString prefix = catalog + ' ';
+    QMap<int, SkyObject *> objects;
+
+    foreach (DeepSkyObject *o, KStarsData::Instance()->skyComposite()->deepSkyObjects())
+    {
+        for (const QString &name : { o->name(), o->name2() })
+        {
+            if (!name.startsWith(prefix))
+                continue;
+
+            bool ok          = false;
+            const int number = name.mid(prefix.size()).toInt(&ok);
+            if (ok && !objects.contains(number))
+                objects.insert(number, o);
+        }
+    }
+
+    return objects.values();
+}
+}
+
 ModelManager::ModelManager(ObsConditions *obs)
 {
     m_ObsConditions = obs;
@@ -152,29 +186,19 @@ void ModelManager::loadLists()
 
     emit loadProgressUpdated(0.90);
 
-    for (int i = 1; i <= 110; i++)
-    {
-        SkyObject *o;
-        if ((o = data->skyComposite()->findByName("M " + QString::number(i))))
-            m_ObjectList[Messier].append(new SkyObjItem(o));
-    }
+    foreach (SkyObject *o, catalogObjects("M"))
+        m_ObjectList[Messier].append(new SkyObjItem(o));
 
     emit loadProgressUpdated(1);
 }
 
 void ModelManager::loadNGCCatalog()
 {
-    KStarsData *data = KStarsData::Instance();
     if (!ngcLoaded)
     {
-        for (int i = 1; i <= 7840; i++)
-        {
-            if (i % 100 == 0)
-                emit loadProgressUpdated((double)i / 7840.0);
-            SkyObject *o;
-            if ((o = data->skyComposite()->findByName("NGC " + QString::number(i))))
-                m_ObjectList[NGC].append(new SkyObjItem(o));
-        }
+        emit loadProgressUpdated(0);
+        foreach (SkyObject *o, catalogObjects("NGC"))
+            m_ObjectList[NGC].append(new SkyObjItem(o));
         updateModel(m_ObsConditions, "ngc");
         emit loadProgressUpdated(1);
     }
@@ -183,17 +207,11 @@ void ModelManager::loadNGCCatalog()
 
 void ModelManager::loadICCatalog()
 {
-    KStarsData *data = KStarsData::Instance();
     if (!icLoaded)
     {
-        for (int i = 1; i <= 3866; i++)
-        {
-            if (i % 100 == 0)
-                emit loadProgressUpdated((double)i / 3866.0);
-            SkyObject *o;
-            if ((o = data->skyComposite()->findByName("IC " + QString::number(i))))
-                m_ObjectList[IC].append(new SkyObjItem(o));
-        }
+        emit loadProgressUpdated(0);
+        foreach (SkyObject *o, catalogObjects("IC"))
+            m_ObjectList[IC].append(new SkyObjItem(o));
         updateModel(m_ObsConditions, "ic");
         emit loadProgressUpdated(1);
     }
@@ -283,14 +301,36 @@ void ModelManager::loadObjectList(QList<SkyObjItem *> &skyObjectList, int type)
 
 void ModelManager::loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList)
 {
-    KStarsData *data = KStarsData::Instance();
+    if (!showOnlyVisible)
+    {
+        foreach (SkyObjItem *soitem, skyObjectList)
+            model.addSkyObject(soitem);
+        return;
+    }
 
+    //Altitudes of the whole list at the time of the sky map, solved in one batch, an instant is not cached
+    KStarsData *data = KStarsData::Instance();
+    QVector<const SkyObject *> objects;
+    objects.reserve(skyObjectList.size());
     foreach (SkyObjItem *soitem, skyObjectList)
+        objects.append(soitem->getSkyObject());
+
+    const double jd = data->ut().djd();
+    const QVector<VisibilityService::Visibility> visibility =
+        VisibilityService::Instance()->visibility(objects, data->geo(), jd, jd);
+    const double magLimit = m_ObsConditions->getTrueMagLim();
+
+    for (int i = 0; i < skyObjectList.size(); ++i)
     {
-        bool isVisible =
-            (showOnlyVisible) ? (m_ObsConditions->isVisible(data->geo(), data->lst(), soitem->getSkyObject())) : true;
+        SkyObject *o = skyObjectList.at(i)->getSkyObject();
+        bool isVisible;
+        if (o->type() == SkyObject::SATELLITE)
+            isVisible = o->alt().Degrees() > MIN_ALTITUDE;
+        else
+            isVisible = visibility.at(i).isAbove(MIN_ALTITUDE) && o->mag() < magLimit;
+
         if (isVisible)
-            model.addSkyObject(soitem);
+            model.addSkyObject(skyObjectList.at(i));
     }
 }
 
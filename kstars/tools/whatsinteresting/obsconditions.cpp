@@ -96,21 +96,6 @@ double ObsConditions::getTrueMagLim()
     return m_LM + 5 * log10(m_Aperture / 7.5);
 }
 
-bool ObsConditions::isVisible(GeoLocation *geo, dms *lst, SkyObject *so)
-{
-    if (so->type() == SkyObject::SATELLITE)
-    {
-        return so->alt().Degrees() > 6.0;
-    }
-    KStarsDateTime ut = geo->LTtoUT(KStarsDateTime(QDateTime::currentDateTime().toLocalTime()));
-    SkyPoint sp       = so->recomputeCoords(ut, geo);
-
-    //check altitude of object at this time.
-    sp.EquatorialToHorizontal(lst, geo->lat());
-
-    return (sp.alt().Degrees() > 6.0 && so->mag() < getTrueMagLim());
-}
-
 void ObsConditions::setObsConditions(int bortle, double aperture, ObsConditions::Equipment equip,
                                      ObsConditions::TelescopeType telType)
 {
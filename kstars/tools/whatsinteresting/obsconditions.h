@@ -100,15 +100,6 @@ class ObsConditions
          */
     double getTrueMagLim();
 
-    /**
-         * \brief Evaluate visibility of sky-object based on current observing conditions.
-         * \return Visibility of sky-object based on current observing conditions as a boolean.
-         * \param geo       Geographic location of user.
-         * \param lst       Local standard time expressed as a dms object.
-         * \param so        SkyObject for which visibility is to be evaluated.
-         */
-    bool isVisible(GeoLocation *geo, dms *lst, SkyObject *so);
-
     /**
          * \brief Create QMap<int, double> to be initialised to static member variable m_LMMap
          * \return QMap<int, double> to be initialised to static member variable m_LMMap
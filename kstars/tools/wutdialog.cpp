@@ -27,6 +27,12 @@
 #include "skycomponents/skymapcomposite.h"
 #include "tools/observinglist.h"
 
+namespace
+{
+/// An object is considered visible if it is higher than this altitude, in degrees, during civil twilight
+const double MIN_ALTITUDE = 6.0;
+}
+
 WUTDialogUI::WUTDialogUI(QWidget *p) : QFrame(p)
 {
     setupUi(this);
@@ -102,6 +108,7 @@ void WUTDialog::makeConnections()
     connect(WUT->ObjectListWidget, SIGNAL(currentTextChanged(QString)), SLOT(slotDisplayObject(QString)));
     connect(WUT->EveningMorningBox, SIGNAL(activated(int)), SLOT(slotEveningMorning(int)));
     connect(WUT->MagnitudeEdit, SIGNAL(valueChanged(double)), SLOT(slotChangeMagnitude()));
+    connect(&m_VisibilityWatcher, SIGNAL(finished()), SLOT(slotVisibilityReady()));
 }
 
 void WUTDialog::initCategories()
@@ -265,99 +272,144 @@ void WUTDialog::slotLoadList(const QString &c)
         return;
 
     WUT->ObjectListWidget->clear();
-    setCursor(QCursor(Qt::WaitCursor));
 
-    if (!isCategoryInitialized(c))
+    if (isCategoryInitialized(c))
     {
-        if (c == m_Categories[0]) //Planets
-        {
-            foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
-            {
-                SkyObject *o = data->skyComposite()->findByName(name);
+        populateList(c);
+        return;
+    }
 
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
-            }
+    QVector<const SkyObject *> candidates;
 
-            m_CategoryInitialized[c] = true;
+    if (c == m_Categories[0]) //Planets
+    {
+        foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
+        {
+            SkyObject *o = data->skyComposite()->findByName(name);
+            if (o)
+                candidates.append(o);
         }
+    }
 
-        else if (c == m_Categories[1]) //Stars
-        {
+    else if (c == m_Categories[1]) //Stars
+    {
+        QVector<QPair<QString, const SkyObject *>> starObjects;
+        starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
+        starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
 
-            QVector<QPair<QString, const SkyObject *>> starObjects;
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-
-            for (QVector<QPair<QString, const SkyObject *>>::ConstIterator it = starObjects.cbegin();it != starObjects.cend(); ++it)
-            {
-               const SkyObject *o =  (*it).second;
-               if (checkVisibility(o) && o->mag() <= m_Mag)
-               {
-                   visibleObjects(c).insert(o);
-               }
-            }
-            m_CategoryInitialized[c] = true;
-        }
+        candidates.reserve(starObjects.size());
+        for (const QPair<QString, const SkyObject *> &star : starObjects)
+            candidates.append(star.second);
+    }
 
-        else if (c == m_Categories[5]) //Constellations
-        {
-            foreach (SkyObject *o, data->skyComposite()->constellationNames())
-                if (checkVisibility(o))
-                    visibleObjects(c).insert(o);
+    else if (c == m_Categories[5]) //Constellations
+    {
+        foreach (SkyObject *o, data->skyComposite()->constellationNames())
+            candidates.append(o);
+    }
 
-            m_CategoryInitialized[c] = true;
-        }
+    else if (c == m_Categories[6]) //Asteroids
+    {
+        foreach (SkyObject *o, data->skyComposite()->asteroids())
+            if (o->name() != i18nc("Asteroid name (optional)", "Pluto"))
+                candidates.append(o);
+    }
 
-        else if (c == m_Categories[6]) //Asteroids
-        {
-            foreach (SkyObject *o, data->skyComposite()->asteroids())
-                if (checkVisibility(o) && o->name() != i18nc("Asteroid name (optional)", "Pluto") && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
+    else if (c == m_Categories[7]) //Comets
+    {
+        foreach (SkyObject *o, data->skyComposite()->comets())
+            candidates.append(o);
+    }
 
-            m_CategoryInitialized[c] = true;
-        }
+    else //all deep-sky objects, need to split clusters, nebulae and galaxies
+    {
+        foreach (DeepSkyObject *dso, data->skyComposite()->deepSkyObjects())
+            candidates.append(dso);
+    }
 
-        else if (c == m_Categories[7]) //Comets
-        {
-            foreach (SkyObject *o, data->skyComposite()->comets())
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
+    // The dialog stays responsive while the visibility is computed, a newer request replaces this one
+    setCursor(QCursor(Qt::WaitCursor));
+    double startJD, endJD;
+    nightInterval(startJD, endJD);
+    m_LoadingCategory      = c;
+    m_Candidates           = candidates;
+    m_VisibilityGeneration = VisibilityService::Instance()->generation();
+    m_VisibilityWatcher.setFuture(VisibilityService::Instance()->visibilityAsync(candidates, geo, startJD, endJD));
+}
+
+void WUTDialog::slotVisibilityReady()
+{
+    // Signal of a request replaced by a newer one
+    if (!m_VisibilityWatcher.future().isFinished())
+        return;
+
+    setCursor(QCursor(Qt::ArrowCursor));
+
+    const QString c       = m_LoadingCategory;
+    const bool isCurrent  = WUT->CategoryListWidget->currentItem() && WUT->CategoryListWidget->currentItem()->text() == c;
+    const QVector<const SkyObject *> candidates = m_Candidates;
+    m_Candidates.clear();
+
+    // Some candidates may have been deleted meanwhile, compute the category again
+    if (VisibilityService::Instance()->generation() != m_VisibilityGeneration)
+    {
+        if (isCurrent)
+            slotLoadList(c);
+        return;
+    }
 
-            m_CategoryInitialized[c] = true;
+    //The constellations are always listed whatever the magnitude limit
+    const bool checkMag = (c != m_Categories[5]);
+    const QVector<VisibilityService::Visibility> visibility = m_VisibilityWatcher.result();
+
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        const SkyObject *o = candidates.at(i);
+        if (!visibility.at(i).isAbove(MIN_ALTITUDE) || (checkMag && o->mag() > m_Mag))
+            continue;
+
+        if (c != m_Categories[2] && c != m_Categories[3] && c != m_Categories[4])
+        {
+            visibleObjects(c).insert(o);
+            continue;
         }
 
-        else //all deep-sky objects, need to split clusters, nebulae and galaxies
+        switch (o->type())
         {
-            foreach (DeepSkyObject *dso, data->skyComposite()->deepSkyObjects())
-            {
-                SkyObject *o = (SkyObject *)dso;
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                {
-                    switch (o->type())
-                    {
-                        case SkyObject::OPEN_CLUSTER: //fall through
-                        case SkyObject::GLOBULAR_CLUSTER:
-                            visibleObjects(m_Categories[4]).insert(o); //star clusters
-                            break;
-                        case SkyObject::GASEOUS_NEBULA:   //fall through
-                        case SkyObject::PLANETARY_NEBULA: //fall through
-                        case SkyObject::SUPERNOVA_REMNANT:
-                            visibleObjects(m_Categories[2]).insert(o); //nebulae
-                            break;
-                        case SkyObject::GALAXY:
-                            visibleObjects(m_Categories[3]).insert(o); //galaxies
-                            break;
-                    }
-                }
-            }
-
-            m_CategoryInitialized[m_Categories[2]] = true;
-            m_CategoryInitialized[m_Categories[3]] = true;
-            m_CategoryInitialized[m_Categories[4]] = true;
+            case SkyObject::OPEN_CLUSTER: //fall through
+            case SkyObject::GLOBULAR_CLUSTER:
+                visibleObjects(m_Categories[4]).insert(o); //star clusters
+                break;
+            case SkyObject::GASEOUS_NEBULA:   //fall through
+            case SkyObject::PLANETARY_NEBULA: //fall through
+            case SkyObject::SUPERNOVA_REMNANT:
+                visibleObjects(m_Categories[2]).insert(o); //nebulae
+                break;
+            case SkyObject::GALAXY:
+                visibleObjects(m_Categories[3]).insert(o); //galaxies
+                break;
         }
     }
 
+    if (c == m_Categories[2] || c == m_Categories[3] || c == m_Categories[4])
+    {
+        m_CategoryInitialized[m_Categories[2]] = true;
+        m_CategoryInitialized[m_Categories[3]] = true;
+        m_CategoryInitialized[m_Categories[4]] = true;
+    }
+    else
+    {
+        m_CategoryInitialized[c] = true;
+    }
+
+    if (isCurrent)
+        populateList(c);
+}
+
+void WUTDialog::populateList(const QString &c)
+{
+    WUT->ObjectListWidget->clear();
+
     //Now the category has been initialized, we can populate the list widget
     foreach (const SkyObject *o, visibleObjects(c))
         //WUT->ObjectListWidget->addItem(o->name());
@@ -373,15 +425,8 @@ void WUTDialog::slotLoadList(const QString &c)
     }
 }
 
-bool WUTDialog::checkVisibility(const SkyObject *o)
+void WUTDialog::nightInterval(double &startJD, double &endJD)
 {
-    bool visible(false);
-    double minAlt = 6.0; //An object is considered 'visible' if it is above horizon during civil twilight.
-
-    // reject objects that never rise
-    if (o->checkCircumpolar(geo->lat()) == true && o->alt().Degrees() <= 0)
-        return false;
-
     //Initial values for T1, T2 assume all night option of EveningMorningBox
     KStarsDateTime T1 = Evening;
     T1.setTime(sunSetToday);
@@ -398,29 +443,25 @@ bool WUTDialog::checkVisibility(const SkyObject *o)
         T1 = T0; //midnight
     }
 
-    for (KStarsDateTime test = T1; test < T2; test = test.addSecs(3600))
-    {
-        //Need LST of the test time, expressed as a dms object.
-        KStarsDateTime ut = geo->LTtoUT(test);
-        dms LST           = geo->GSTtoLST(ut.gst());
-        SkyPoint sp       = o->recomputeCoords(ut, geo);
-
-        //check altitude of object at this time.
-        sp.EquatorialToHorizontal(&LST, geo->lat());
+    startJD = geo->LTtoUT(T1).djd();
+    endJD   = geo->LTtoUT(T2).djd();
+}
 
-        if (sp.alt().Degrees() > minAlt)
-        {
-            visible = true;
-            break;
-        }
-    }
+QVector<VisibilityService::Visibility> WUTDialog::nightVisibility(const QVector<const SkyObject *> &objects)
+{
+    double startJD, endJD;
+    nightInterval(startJD, endJD);
+    return VisibilityService::Instance()->visibility(objects, geo, startJD, endJD);
+}
 
-    return visible;
+bool WUTDialog::checkVisibility(const SkyObject *o)
+{
+    //An object is considered 'visible' if it is above MIN_ALTITUDE during the selected part of the night
+    return nightVisibility(QVector<const SkyObject *>() << o).first().isAbove(MIN_ALTITUDE);
 }
 
 void WUTDialog::slotDisplayObject(const QString &name)
 {
-    QTime tRise, tSet, tTransit;
     QString sRise, sTransit, sSet;
 
     sRise    = "--:--";
@@ -448,38 +489,26 @@ void WUTDialog::slotDisplayObject(const QString &name)
     {
         WUT->ObjectBox->setTitle(o->name());
 
-        if (o->checkCircumpolar(geo->lat()))
+        const VisibilityService::Visibility visibility = nightVisibility(QVector<const SkyObject *>() << o).first();
+        auto localTime = [&](double jd) { return geo->UTtoLT(KStarsDateTime(jd)).time().toString("hh:mm"); };
+
+        if (visibility.circumpolar)
         {
-            if (o->alt().Degrees() > 0.0)
-            {
-                sRise = i18n("circumpolar");
-                sSet  = i18n("circumpolar");
-            }
-            else
-            {
-                sRise = i18n("does not rise");
-                sSet  = i18n("does not rise");
-            }
+            sRise = i18n("circumpolar");
+            sSet  = i18n("circumpolar");
+        }
+        else if (visibility.neverRises)
+        {
+            sRise = i18n("does not rise");
+            sSet  = i18n("does not rise");
         }
         else
         {
-            tRise = o->riseSetTime(T0, geo, true);
-            tSet  = o->riseSetTime(T0, geo, false);
-            //          if ( tSet < tRise )
-            //              tSet = o->riseSetTime( JDTomorrow, geo, false );
-
-            sRise.clear();
-            sRise.sprintf("%02d:%02d", tRise.hour(), tRise.minute());
-            sSet.clear();
-            sSet.sprintf("%02d:%02d", tSet.hour(), tSet.minute());
+            sRise = localTime(visibility.rise);
+            sSet  = localTime(visibility.set);
         }
 
-        tTransit = o->transitTime(T0, geo);
-        //      if ( tTransit < tRise )
-        //          tTransit = o->transitTime( JDTomorrow, geo );
-
-        sTransit.clear();
-        sTransit.sprintf("%02d:%02d", tTransit.hour(), tTransit.minute());
+        sTransit = localTime(visibility.transit);
 
         WUT->DetailButton->setEnabled(true);
     }
@@ -571,7 +600,6 @@ void WUTDialog::slotChangeDate()
         WUT->DateLabel->setText(i18n("The night of %1", QLocale().toString(Evening.date(), QLocale::LongFormat)));
 
         init();
-        slotLoadList(WUT->CategoryListWidget->currentItem()->text());
     }
     delete td;
 }
@@ -592,7 +620,6 @@ void WUTDialog::slotChangeLocation()
             WUT->LocationLabel->setText(i18n("at %1", geo->fullName()));
 
             init();
-            slotLoadList(WUT->CategoryListWidget->currentItem()->text());
         }
     }
     delete ld;
@@ -604,7 +631,6 @@ void WUTDialog::slotEveningMorning(int index)
     {
         EveningFlag = index;
         init();
-        slotLoadList(WUT->CategoryListWidget->currentItem()->text());
     }
 }
 
@@ -612,7 +638,6 @@ void WUTDialog::updateMag()
 {
     m_Mag = WUT->MagnitudeEdit->value();
     init();
-    slotLoadList(WUT->CategoryListWidget->currentItem()->text());
 }
 
 void WUTDialog::slotChangeMagnitude()
@@ -20,9 +20,11 @@
 #include "kstarsdata.h"
 #include "kstarsdatetime.h"
 #include "ui_wutdialog.h"
+#include "visibilityservice.h"
 
 #include <QFrame>
 #include <QDialog>
+#include <QFutureWatcher>
 
 class GeoLocation;
 class SkyObject;
@@ -74,6 +76,9 @@ class WUTDialog : public QDialog
      */
     void slotLoadList(const QString &category);
 
+    /** @short Store the visible objects of the category whose visibility was computed */
+    void slotVisibilityReady();
+
     /** Display the rise/transit/set times for selected object */
     void slotDisplayObject(const QString &name);
 
@@ -114,6 +119,12 @@ class WUTDialog : public QDialog
   private:
     QSet<const SkyObject *> &visibleObjects(const QString &category);
     bool isCategoryInitialized(const QString &category);
+    /** @short Fill the list widget with the visible objects of an initialized category */
+    void populateList(const QString &category);
+    /** @short Set startJD and endJD to the selected part of the night, in UT */
+    void nightInterval(double &startJD, double &endJD);
+    /** @return the visibility of objects during the selected part of the night */
+    QVector<VisibilityService::Visibility> nightVisibility(const QVector<const SkyObject *> &objects);
     /** @short Initialize all SIGNAL/SLOT connections, used in constructor */
     void makeConnections();
     /** @short Initialize catgory list, used in constructor */
@@ -130,4 +141,9 @@ class WUTDialog : public QDialog
     QStringList m_Categories;
     QHash<QString, QSet<const SkyObject *>> m_VisibleList;
     QHash<QString, bool> m_CategoryInitialized;
+    /// Visibility of the candidates of the category being loaded, computed in the background
+    QFutureWatcher<QVector<VisibilityService::Visibility>> m_VisibilityWatcher;
+    QString m_LoadingCategory;
+    QVector<const SkyObject *> m_Candidates;
+    quint64 m_VisibilityGeneration { 0 };
 };